@@ -0,0 +1,243 @@
+/**
+ * \file	benchAvr.c
+ *
+ * \brief	Zyklenmessung zeitkritischer Methoden auf dem AVR-Kern (simavr).
+ *
+ * 			Auf dem Host fehlen die Kosten der Soft-Float-Arithmetik und der
+ * 			Interrupts des AVR. Dieses Programm wird mit avr-gcc für einen
+ * 			ATmega1281 übersetzt (gleicher AVR-Kern, 128 KB Flash, 8 KB RAM; simavr
+ * 			bildet keinen XMEGA nach) und unter simavr ausgeführt. Die Hardware
+ * 			wird wie auf dem Host durch xmegaHost.c ersetzt, Timer1 zählt die
+ * 			Taktzyklen.
+ *
+ * 			Jede Messung wird BENCH_RUNS-mal wiederholt, ausgegeben wird das
+ * 			Minimum abzüglich des Aufwands der Messung selbst. Überschreitet ein
+ * 			Wert die Referenz in BENCH[] um mehr als BENCH_TOLERANCE Prozent, gilt
+ * 			das als Fehler. Eine Referenz von 0 ist noch nicht gemessen, der Wert
+ * 			wird ausgegeben und am Ende gezählt, das Ergebnis ist dann ebenfalls
+ * 			FEHLER. Bisher ist keine Referenz gemessen: der ctest benchAvr
+ * 			(CMakeLists.txt, nur mit avr-gcc und simavr) schlägt fehl, bis die
+ * 			unter simavr ausgegebenen Werte in BENCH[] übernommen sind.
+ *
+ * 			Die ISR-Messung löst INT0 durch Schreiben des als Ausgang geschalteten
+ * 			Pins PD0 aus. Der XMEGA sichert wegen des größeren Flashs einen 3 Byte
+ * 			langen Programmzähler, Ein- und Austritt kosten dort je 1 Zyklus mehr.
+ *
+ * 			Ausgabe über die Konsole von simavr (GPIOR0), siehe CMakeLists.txt.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+#ifdef __AVR__
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "avr_mcu_section.h"
+#include "include/xmega.h"
+#include "include/utils.h"
+#include "include/kinematics.h"
+#include "include/dynamixel.h"
+#include "include/communication.h"
+#include "include/evolutionaryAlgorithm.h"
+
+#define BENCH_RUNS		5
+#define BENCH_TOLERANCE	5
+
+AVR_MCU(F_CPU, "atmega1281");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+/** \brief Eine Messung mit Vorbereitung und Referenz in Taktzyklen. */
+typedef struct {
+	const char* name;
+	void (*setup)();
+	void (*run)();
+	uint32_t reference;
+} DT_bench;
+
+DT_leg leg;
+DT_point point = { 77.8553, 77.8553, -129.1041 };
+DT_byte packet[DT_RESULT_BUFFER_SIZE];
+DT_byte packetLength;
+DT_byte result[DT_RESULT_BUFFER_SIZE];
+
+// lokale Methoden
+void print(const char*);
+void none();
+void setupLeg();
+void runCalcServos();
+void runCalcDH();
+void runSetAngle();
+void setupComReceive();
+void runComReceive();
+void setupRXComplete();
+void runRXComplete();
+void runEvolutionaryAlgorithm();
+uint32_t measure(const DT_bench* const);
+
+/**
+ * \brief	Messungen und Referenzwerte.
+ */
+const DT_bench BENCH[] = {
+		{ "KIN_calcServos", setupLeg, runCalcServos, 0 },
+		{ "KIN_calcDH", setupLeg, runCalcDH, 0 },
+		{ "DNX_setAngle", none, runSetAngle, 0 },
+		{ "COM_receive", setupComReceive, runComReceive, 0 },
+		{ "USART_RXComplete", setupRXComplete, runRXComplete, 0 },
+		{ "evolutionaryAlgorithm", none, runEvolutionaryAlgorithm, 0 } };
+
+ISR(INT0_vect) {
+	USART_RXComplete(&XM_com_data3);
+}
+
+void print(const char* s) {
+	while (*s)
+		XM_debugPutChar(*s++);
+}
+
+void none() {
+}
+
+void setupLeg() {
+	leg.hip.set_value = 0.3;
+	leg.knee.set_value = -0.4;
+	leg.foot.set_value = 1.2;
+}
+
+void runCalcServos() {
+	KIN_calcServos(&point, &leg);
+}
+
+void runCalcDH() {
+	DT_real dh03[4][4];
+	DT_real* rows[4] = { dh03[0], dh03[1], dh03[2], dh03[3] };
+	KIN_calcDH(&leg, rows);
+}
+
+/**
+ * \brief	Paketaufbau von DNX_setAngle() als Broadcast (ohne Antwort).
+ *
+ * 			Die Servo-USARTs sind nicht initialisiert, XM_USART_send() verwirft das
+ * 			Paket.
+ */
+void runSetAngle() {
+	DNX_setAngle(DNX_BRDCAST_ID, 150, true);
+}
+
+/**
+ * \brief	Legt ein COM_POINT-Paket in den Empfangspuffer von XM_com_data3.
+ */
+void setupComReceive() {
+	DT_byte i, checksum = 0;
+	XM_init_com(COM_SLAVE3F);
+	packetLength = 8 + 3 * COM_REAL_SIZE;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = COM_SLAVE3F;
+	packet[3] = packetLength - 4;
+	packet[4] = COM_POINT;
+	packet[5] = COM_CONF_RIGHT | COM_CONF_GLOB;
+	COM_realToByteArray(point.x, &packet[6 + 0 * COM_REAL_SIZE]);
+	COM_realToByteArray(point.y, &packet[6 + 1 * COM_REAL_SIZE]);
+	COM_realToByteArray(point.z, &packet[6 + 2 * COM_REAL_SIZE]);
+	packet[packetLength - 2] = 0; // Korrelations-ID
+	for (i = 2; i < packetLength - 1; i++)
+		checksum += packet[i];
+	packet[packetLength - 1] = ~checksum;
+	for (i = 0; i < packetLength; i++)
+		XM_receiveByte(&XM_com_data3, packet[i]);
+}
+
+void runComReceive() {
+	COM_receive(&XM_com_data3, result);
+}
+
+void setupRXComplete() {
+	XM_init_com(COM_SLAVE3F);
+	DDRD |= _BV(PD0);
+	PORTD &= ~_BV(PD0);
+	EICRA = _BV(ISC01) | _BV(ISC00);
+	EIFR = _BV(INTF0);
+	EIMSK = _BV(INT0);
+}
+
+/**
+ * \brief	Steigende Flanke an PD0 löst INT0 und damit USART_RXComplete() aus.
+ */
+void runRXComplete() {
+	PORTD |= _BV(PD0);
+	__asm__ __volatile__ ("nop");
+	PORTD &= ~_BV(PD0);
+}
+
+void runEvolutionaryAlgorithm() {
+	DT_vector v = { 3, 7 };
+	evolutionaryAlgorithm(10, 5, &v);
+}
+
+/**
+ * \brief	Misst das Minimum aus BENCH_RUNS Durchläufen.
+ *
+ * \param	bench	Messung
+ *
+ * \return	Taktzyklen inklusive Aufruf über den Funktionszeiger
+ */
+uint32_t measure(const DT_bench* const bench) {
+	uint32_t t0, t, best = UINT32_MAX;
+	DT_byte i;
+	for (i = 0; i < BENCH_RUNS; i++) {
+		bench->setup();
+		t0 = XM_getCycles();
+		bench->run();
+		t = XM_getCycles() - t0;
+		if (t < best)
+			best = t;
+	}
+	return best;
+}
+
+int main() {
+	const DT_bench empty = { "", none, none, 0 };
+	uint32_t overhead, cycles;
+	DT_byte i;
+	DT_int errors = 0, missing = 0;
+
+	XM_init_cpu();
+	overhead = measure(&empty);
+
+	for (i = 0; i < sizeof(BENCH) / sizeof(DT_bench); i++) {
+		cycles = measure(&BENCH[i]) - overhead;
+		print(BENCH[i].name);
+		print(" ");
+		UTL_printNumber(cycles);
+		if (BENCH[i].reference == 0) {
+			print(" (ohne Referenz)\n");
+			missing++;
+		}
+		else if (cycles > BENCH[i].reference + BENCH[i].reference / 100
+				* BENCH_TOLERANCE) {
+			print(" FEHLER (Referenz ");
+			UTL_printNumber(BENCH[i].reference);
+			print(")\n");
+			errors++;
+		} else {
+			print(" (Referenz ");
+			UTL_printNumber(BENCH[i].reference);
+			print(")\n");
+		}
+	}
+	print(errors == 0 && missing == 0 ? "OK (" : "FEHLER (");
+	UTL_printNumber(errors);
+	print(" Fehler, ");
+	UTL_printNumber(missing);
+	print(" ohne Referenz)\n");
+
+	// simavr beendet sich bei sleep mit gesperrten Interrupts
+	cli();
+	sleep_enable();
+	sleep_cpu();
+	return errors;
+}
+
+#endif /* __AVR__ */
+#endif /* TEST_ON */
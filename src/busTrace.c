@@ -0,0 +1,325 @@
+/**
+ * \file	busTrace.c
+ *
+ * \brief	Auswertung und Wiedergabe eines Mitschnitts der Busse (Host).
+ *
+ * 			Liest die Ausgabe der Debug-USART mit aktivem Mitschnitt (capture.h).
+ * 			Bytes außerhalb gültiger Einträge werden übersprungen und gezählt.
+ *
+ * 			busTrace stats <Datei>
+ * 				Pakete, Bytes, Auslastung (10 us je Byte bei 1 Mbit/s) und Abstände
+ * 				der Pakete je Kanal.
+ *
+ * 			busTrace index <Datei>
+ * 				Anzahl der Pakete je Kanal, Richtung, ID und Instruktion (bei
+ * 				Antworten der Servos das Fehlerbyte).
+ *
+ * 			busTrace replay <Datei> [cpuID]
+ * 				Spielt die empfangenen COM-Pakete eines Slaves (Standard 3F) mit
+ * 				emulierten Servos in MV_slaveStep() ein und vergleicht die
+ * 				gesendeten Pakete mit dem Mitschnitt. Der Rückgabewert ist die
+ * 				Anzahl der Abweichungen. Der Master kann nicht abgespielt werden,
+ * 				da sein Ablauf im jeweiligen Gangprogramm liegt.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "include/capture.h"
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/trace.h"
+#include "include/xmega.h"
+
+#define BYTE_US		10
+#define MAX_KEYS	1024
+#define REPLAY_SIZE	(1 << 20)
+
+/** \brief Eintrag des Mitschnitts. */
+typedef struct {
+	DT_byte channel;
+	DT_bool tx;
+	int64_t t; /**< Zeit in us ohne Überlauf. */
+	uint16_t raw; /**< Zeitstempel des Eintrags. */
+	const DT_byte* data;
+	DT_byte len;
+} DT_capRecord;
+
+/** \brief Schlüssel und Anzahl für busTrace index. */
+typedef struct {
+	DT_byte channel, tx, id, instr;
+	unsigned int count;
+} DT_capKey;
+
+const char* const CHANNEL_NAMES[CAP_CHANNELS] = { "Servo L", "Servo R",
+		"COM1", "COM3" };
+
+DT_byte replayOut[REPLAY_SIZE];
+size_t replayLen = 0;
+DT_leg leg_r, leg_l;
+
+/**
+ * \brief	Liest den nächsten gültigen Eintrag.
+ *
+ * \param	data	Mitschnitt
+ * \param	size	Länge des Mitschnitts
+ * \param	pos		Position, wird hinter den Eintrag gesetzt
+ * \param	rec		Ziel, die Zeit wird aus der Zeit des letzten Eintrags fortgesetzt
+ * \param	skipped	wird um die übersprungenen Bytes erhöht
+ *
+ * \return	false am Ende des Mitschnitts
+ */
+DT_bool nextRecord(const DT_byte* data, size_t size, size_t* pos,
+		DT_capRecord* rec, size_t* skipped) {
+	uint16_t t;
+
+	for (; *pos + CAP_HEADER <= size; (*pos)++, (*skipped)++) {
+		const DT_byte* const h = &data[*pos];
+		if (h[0] != CAP_SYNC || (h[2] & ~(CAP_TX | CAP_CHANNEL_gm)) != 0
+				|| *pos + CAP_HEADER + h[1] > size)
+			continue;
+		t = h[3] | (h[4] << 8);
+		if (rec->data == NULL)
+			rec->t = t;
+		else
+			rec->t += (uint16_t) (t - rec->raw);
+		rec->raw = t;
+		rec->channel = h[2] & CAP_CHANNEL_gm;
+		rec->tx = (h[2] & CAP_TX) != 0;
+		rec->len = h[1];
+		rec->data = &h[CAP_HEADER];
+		*pos += CAP_HEADER + h[1];
+		return true;
+	}
+	*skipped += size - *pos;
+	*pos = size;
+	return false;
+}
+
+/**
+ * \brief	Bildet einen Mitschnitt in den Speicher ab.
+ *
+ * \return	Mitschnitt oder NULL
+ */
+const DT_byte* mapFile(const char* file, size_t* size) {
+	struct stat st;
+	void* data;
+	const int fd = open(file, O_RDONLY);
+
+	if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+		fprintf(stderr, "%s kann nicht gelesen werden\n", file);
+		if (fd >= 0)
+			close(fd);
+		return NULL;
+	}
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return NULL;
+	*size = st.st_size;
+	return data;
+}
+
+void printStats(const DT_byte* data, size_t size) {
+	DT_capRecord rec = { 0 };
+	size_t pos = 0, skipped = 0;
+	unsigned int frames[CAP_CHANNELS][2] = { { 0 } };
+	uint64_t bytes[CAP_CHANNELS] = { 0 };
+	int64_t first = 0, last[CAP_CHANNELS], gapMin[CAP_CHANNELS],
+			gapMax[CAP_CHANNELS] = { 0 }, gapSum[CAP_CHANNELS] = { 0 }, span, gap;
+	unsigned int total = 0;
+	int c;
+
+	while (nextRecord(data, size, &pos, &rec, &skipped)) {
+		c = rec.channel;
+		if (total++ == 0)
+			first = rec.t;
+		if (frames[c][0] + frames[c][1] > 0) {
+			gap = rec.t - last[c];
+			if (frames[c][0] + frames[c][1] == 1 || gap < gapMin[c])
+				gapMin[c] = gap;
+			if (gap > gapMax[c])
+				gapMax[c] = gap;
+			gapSum[c] += gap;
+		}
+		last[c] = rec.t;
+		frames[c][rec.tx]++;
+		bytes[c] += rec.len;
+	}
+	span = total > 0 ? rec.t - first : 0;
+	printf("%u Pakete in %lld us, %zu Bytes übersprungen\n", total,
+			(long long) span, skipped);
+	printf("%-8s %6s %6s %8s %7s %9s %9s %9s\n", "Kanal", "TX", "RX", "Bytes",
+			"Last", "Abst.min", "Abst.avg", "Abst.max");
+	for (c = 0; c < CAP_CHANNELS; c++) {
+		const unsigned int n = frames[c][0] + frames[c][1];
+		if (n == 0)
+			continue;
+		printf("%-8s %6u %6u %8llu %6.1f%%", CHANNEL_NAMES[c], frames[c][1],
+				frames[c][0], (unsigned long long) bytes[c], span > 0 ? 100.0
+						* bytes[c] * BYTE_US / span : 0.0);
+		if (n > 1)
+			printf(" %9lld %9lld %9lld\n", (long long) gapMin[c],
+					(long long) (gapSum[c] / (n - 1)), (long long) gapMax[c]);
+		else
+			printf(" %9s %9s %9s\n", "-", "-", "-");
+	}
+}
+
+int compareKeys(const void* a, const void* b) {
+	const DT_capKey* const x = a;
+	const DT_capKey* const y = b;
+	if (x->channel != y->channel)
+		return x->channel - y->channel;
+	if (x->tx != y->tx)
+		return y->tx - x->tx;
+	if (x->id != y->id)
+		return x->id - y->id;
+	return x->instr - y->instr;
+}
+
+void printIndex(const DT_byte* data, size_t size) {
+	DT_capKey keys[MAX_KEYS];
+	DT_capRecord rec = { 0 };
+	size_t pos = 0, skipped = 0;
+	int n = 0, i;
+
+	while (nextRecord(data, size, &pos, &rec, &skipped)) {
+		const DT_byte id = rec.len > 2 ? rec.data[2] : 0;
+		const DT_byte instr = rec.len > 4 ? rec.data[4] : 0;
+		for (i = 0; i < n; i++)
+			if (keys[i].channel == rec.channel && keys[i].tx == rec.tx
+					&& keys[i].id == id && keys[i].instr == instr)
+				break;
+		if (i == n) {
+			if (n == MAX_KEYS)
+				continue;
+			keys[n].channel = rec.channel;
+			keys[n].tx = rec.tx;
+			keys[n].id = id;
+			keys[n].instr = instr;
+			keys[n].count = 0;
+			n++;
+		}
+		keys[i].count++;
+	}
+	qsort(keys, n, sizeof(DT_capKey), compareKeys);
+	printf("%-8s %-3s %4s %6s %7s\n", "Kanal", "Ri.", "ID", "Instr.", "Pakete");
+	for (i = 0; i < n; i++)
+		printf("%-8s %-3s 0x%02X   0x%02X %7u\n", CHANNEL_NAMES[keys[i].channel],
+				keys[i].tx ? "TX" : "RX", keys[i].id, keys[i].instr,
+				keys[i].count);
+}
+
+/**
+ * \brief	Empfänger der Debug-USART beim Abspielen.
+ */
+void collect(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_size i;
+	(void) usart_data;
+	for (i = 0; i < l && replayLen < REPLAY_SIZE; i++)
+		replayOut[replayLen++] = data[i];
+}
+
+/**
+ * \brief	Liefert den nächsten gesendeten Eintrag.
+ */
+DT_bool nextTx(const DT_byte* data, size_t size, size_t* pos,
+		DT_capRecord* rec) {
+	size_t skipped = 0;
+	while (nextRecord(data, size, pos, rec, &skipped))
+		if (rec->tx)
+			return true;
+	return false;
+}
+
+int replay(const DT_byte* data, size_t size, DT_byte cpuID) {
+	DT_capRecord rec = { 0 }, a = { 0 }, b = { 0 };
+	size_t pos = 0, skipped = 0, posA = 0, posB = 0;
+	unsigned int frames = 0, compared = 0;
+	int mismatches = 0;
+	DT_bool hasA, hasB;
+	DT_size i;
+
+	if (cpuID != COM_SLAVE1B && cpuID != COM_SLAVE3F) {
+		fprintf(stderr, "Nur Slaves (1 oder 3) können abgespielt werden\n");
+		return 1;
+	}
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(cpuID == COM_SLAVE1B ? 0x7E000 : 0x7E);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	XM_init_com(cpuID);
+	TRC_init(cpuID);
+	XM_setTxHook(&XM_com_data3, XM_ignoreTx); // Antworten an den Master werden nur mitgeschnitten
+	XM_setTxHook(&XM_debug_data, collect);
+	CAP_enable(CAP_ALL);
+
+	while (nextRecord(data, size, &pos, &rec, &skipped)) {
+		if (rec.tx || rec.channel != CAP_COM3)
+			continue;
+		for (i = 0; i < rec.len; i++)
+			XM_receiveByte(&XM_com_data3, rec.data[i]);
+		if (!MV_slaveStep(cpuID, &leg_r, &leg_l))
+			printf("Paket %u wurde nicht angenommen\n", frames);
+		frames++;
+	}
+
+	// Gesendete Pakete in gleicher Reihenfolge vergleichen (ohne Zeit)
+	do {
+		hasA = nextTx(data, size, &posA, &a);
+		hasB = nextTx(replayOut, replayLen, &posB, &b);
+		if (!hasA && !hasB)
+			break;
+		if (hasA != hasB || a.channel != b.channel || a.len != b.len || memcmp(
+				a.data, b.data, a.len) != 0) {
+			if (mismatches < 10)
+				printf("Abweichung bei gesendetem Paket %u (%s)\n", compared,
+						CHANNEL_NAMES[hasA ? a.channel : b.channel]);
+			mismatches++;
+		}
+		compared++;
+	} while (hasA && hasB);
+
+	printf("%u COM-Pakete abgespielt, %u gesendete Pakete verglichen, "
+		"%d Abweichungen, %u verworfen\n", frames, compared, mismatches,
+			CAP_getDropped());
+	return mismatches > 255 ? 255 : mismatches;
+}
+
+int main(int argc, char** argv) {
+	const DT_byte* data;
+	size_t size;
+
+	if (argc < 3) {
+		fprintf(stderr, "busTrace stats|index|replay <Datei> [cpuID]\n");
+		return 1;
+	}
+	data = mapFile(argv[2], &size);
+	if (data == NULL)
+		return 1;
+	if (strcmp(argv[1], "stats") == 0)
+		printStats(data, size);
+	else if (strcmp(argv[1], "index") == 0)
+		printIndex(data, size);
+	else if (strcmp(argv[1], "replay") == 0)
+		return replay(data, size, argc > 3 ? atoi(argv[3]) : COM_SLAVE3F);
+	else {
+		fprintf(stderr, "Unbekannter Befehl %s\n", argv[1]);
+		return 1;
+	}
+	return 0;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,247 @@
+/**
+ * \file	calibration.c
+ *
+ * \brief	Kalibrierung der Servos im EEPROM.
+ *
+ * 			Aufbau im EEPROM ab CAL_EEPROM_ADDR: 'C', 'L', Version, Anzahl,
+ * 			CAL_SERVOS Einträge mit CAL_SIZE Bytes, Prüfsumme (invertierte Summe
+ * 			aller Bytes davor).
+ */
+
+#include "include/calibration.h"
+#include "include/utils.h"
+#include "include/xmega.h"
+#include <math.h>
+
+/**
+ * \def	CAL_VERSION
+ * \brief	Version des Aufbaus im EEPROM.
+ *
+ * \def	CAL_HEADER
+ * \brief	Bytes vor dem ersten Eintrag.
+ *
+ * \def	CAL_EEPROM_SIZE
+ * \brief	Belegte Bytes im EEPROM.
+ */
+#define CAL_VERSION		1
+#define CAL_HEADER		4
+#define CAL_EEPROM_SIZE	(CAL_HEADER + CAL_SERVOS * CAL_SIZE + 1)
+
+DT_calServo CAL_table[CAL_SERVOS];
+DT_bool CAL_loaded = false; /**< CAL_init() wurde aufgerufen. */
+
+// lokale Methoden
+DT_byte CAL_getChecksum(const DT_byte* const, DT_size);
+void CAL_writeEeprom();
+uint16_t CAL_limit(const DT_calServo* const, int32_t);
+
+DT_byte CAL_getChecksum(const DT_byte* const data, DT_size l) {
+	DT_byte sum = 0;
+	DT_size i;
+	for (i = 0; i < l; i++)
+		sum += data[i];
+	return ~sum;
+}
+
+/**
+ * \brief	Lädt die Tabelle aus dem EEPROM.
+ *
+ * 			Einmal beim Start aufrufen. Ist die Tabelle im EEPROM ungültig, gelten
+ * 			die Vorgaben (CAL_setDefaults()).
+ *
+ * \return	true, wenn die Tabelle aus dem EEPROM übernommen wurde
+ */
+DT_bool CAL_init() {
+	DT_byte data[CAL_EEPROM_SIZE];
+	DT_byte i;
+
+	CAL_loaded = true;
+	XM_eepromRead(CAL_EEPROM_ADDR, data, CAL_EEPROM_SIZE);
+	if (data[0] != 'C' || data[1] != 'L' || data[2] != CAL_VERSION || data[3]
+			!= CAL_SERVOS || data[CAL_EEPROM_SIZE - 1] != CAL_getChecksum(data,
+			CAL_EEPROM_SIZE - 1)) {
+		DEBUG_P("CAL_def")
+		CAL_setDefaults();
+		return false;
+	}
+	for (i = 0; i < CAL_SERVOS; i++)
+		CAL_fromByteArray(&CAL_table[i], &data[CAL_HEADER + i * CAL_SIZE]);
+	return true;
+}
+
+/**
+ * \brief	Setzt die Vorgaben des Aufbaus (nur im RAM).
+ *
+ * 			Gespiegelt sind die Servos mit (ID - 1) % 6 in { 0, 2, 3, 4 }.
+ */
+void CAL_setDefaults() {
+	DT_byte i;
+	for (i = 0; i < CAL_SERVOS; i++) {
+		CAL_table[i].flags = (i % 6 == 1 || i % 6 == 5) ? 0 : CAL_MIRRORED;
+		CAL_table[i].offset = 0;
+		CAL_table[i].min = 0;
+		CAL_table[i].max = CAL_TICKS_MAX;
+	}
+}
+
+void CAL_writeEeprom() {
+	DT_byte data[CAL_EEPROM_SIZE];
+	DT_byte i;
+
+	data[0] = 'C';
+	data[1] = 'L';
+	data[2] = CAL_VERSION;
+	data[3] = CAL_SERVOS;
+	for (i = 0; i < CAL_SERVOS; i++)
+		CAL_toByteArray(&CAL_table[i], &data[CAL_HEADER + i * CAL_SIZE]);
+	data[CAL_EEPROM_SIZE - 1] = CAL_getChecksum(data, CAL_EEPROM_SIZE - 1);
+	XM_eepromWrite(CAL_EEPROM_ADDR, data, CAL_EEPROM_SIZE);
+}
+
+/**
+ * \brief	Übernimmt die Kalibrierung eines Servos und schreibt sie in das EEPROM.
+ *
+ * \param	id	ID des Servos (1 - CAL_SERVOS)
+ * \param	cal	Kalibrierung
+ *
+ * \return	false, wenn ID oder Grenzen ungültig sind
+ */
+DT_bool CAL_set(DT_byte id, const DT_calServo* const cal) {
+	if (id == 0 || id > CAL_SERVOS || cal->min > cal->max || cal->max
+			> CAL_TICKS_MAX)
+		return false;
+	if (!CAL_loaded)
+		CAL_init();
+	CAL_table[id - 1] = *cal;
+	CAL_writeEeprom();
+	return true;
+}
+
+/**
+ * \brief	Liefert die Kalibrierung eines Servos.
+ *
+ * 			Für IDs außerhalb der Tabelle (z.B. Broadcast) gilt: nicht
+ * 			gespiegelt, kein Versatz, voller Bereich. Wurde CAL_init() noch nicht
+ * 			aufgerufen, wird die Tabelle zuerst geladen.
+ *
+ * \param	id	ID des Servos
+ * \param	cal	Ziel
+ */
+void CAL_get(DT_byte id, DT_calServo* const cal) {
+	if (!CAL_loaded)
+		CAL_init();
+	if (id == 0 || id > CAL_SERVOS) {
+		cal->flags = 0;
+		cal->offset = 0;
+		cal->min = 0;
+		cal->max = CAL_TICKS_MAX;
+	} else
+		*cal = CAL_table[id - 1];
+}
+
+/**
+ * \brief	Rechnet einen Winkel in die Zielposition eines Servos um.
+ *
+ * \param	id	ID des Servos
+ * \param	centiDeg	Winkel in Hundertstel Grad
+ *
+ * \return	Zielposition in Ticks, begrenzt auf die Grenzen des Servos
+ */
+uint16_t CAL_toTicks(DT_byte id, int32_t centiDeg) {
+	DT_calServo cal;
+	int32_t ticks;
+
+	CAL_get(id, &cal);
+	ticks = CAL_CENTER + ((cal.flags & CAL_MIRRORED) ? -centiDeg : centiDeg);
+	if (ticks < 0)
+		ticks = 0;
+	return CAL_limit(&cal, ticks * 341 / 10000);
+}
+
+/**
+ * \brief	Addiert den Versatz und begrenzt auf die Grenzen des Servos.
+ *
+ * \param	cal	Kalibrierung
+ * \param	ticks	Zielposition ohne Versatz
+ *
+ * \return	Zielposition in Ticks
+ */
+uint16_t CAL_limit(const DT_calServo* const cal, int32_t ticks) {
+	ticks += cal->offset;
+	if (ticks < (int32_t) cal->min)
+		return cal->min;
+	if (ticks > (int32_t) cal->max)
+		return cal->max;
+	return ticks;
+}
+
+/**
+ * \brief	Rechnet einen Winkel in Grad in die Zielposition eines Servos um.
+ *
+ * 			Rechnet wie früher DNX_correctAngles(), DNX_convertAngle() und
+ * 			DNX_setAngle(): floor(3.41 * (150 +/- Winkel)), damit die Servos mit
+ * 			den Vorgaben dieselben Zielpositionen erhalten.
+ *
+ * \param	id	ID des Servos
+ * \param	deg	Winkel in Grad
+ *
+ * \return	Zielposition in Ticks
+ */
+uint16_t CAL_degToTicks(DT_byte id, DT_real deg) {
+	DT_calServo cal;
+	int32_t ticks;
+
+	CAL_get(id, &cal);
+	if (cal.flags & CAL_MIRRORED)
+		deg = 360 - deg;
+	deg += 150;
+	if (deg >= 360)
+		deg -= 360;
+	ticks = floor(3.41 * ((double) deg));
+	if (ticks < 0)
+		ticks = 0;
+	return CAL_limit(&cal, ticks);
+}
+
+/**
+ * \brief	Rechnet einen Winkel im Bogenmaß in die Zielposition eines Servos um.
+ *
+ * 			Ergebnis der inversen Kinematik, wie CAL_degToTicks(UTL_getDegree()).
+ *
+ * \param	id	ID des Servos
+ * \param	rad	Winkel im Bogenmaß
+ *
+ * \return	Zielposition in Ticks
+ */
+uint16_t CAL_radToTicks(DT_byte id, DT_real rad) {
+	return CAL_degToTicks(id, UTL_getDegree(rad));
+}
+
+/**
+ * \brief	Schreibt eine Kalibrierung in ein Byte-Array (Little Endian).
+ *
+ * \param	cal	Kalibrierung
+ * \param	array	Ziel mit CAL_SIZE Bytes
+ */
+void CAL_toByteArray(const DT_calServo* const cal, DT_byte* const array) {
+	array[0] = cal->flags;
+	array[1] = cal->offset;
+	array[2] = (uint16_t) cal->offset >> 8;
+	array[3] = cal->min;
+	array[4] = cal->min >> 8;
+	array[5] = cal->max;
+	array[6] = cal->max >> 8;
+}
+
+/**
+ * \brief	Liest eine Kalibrierung aus einem Byte-Array.
+ *
+ * \param	cal	Ziel
+ * \param	array	Byte-Array aus CAL_toByteArray()
+ */
+void CAL_fromByteArray(DT_calServo* const cal, const DT_byte* const array) {
+	cal->flags = array[0];
+	cal->offset = (int16_t) (array[1] | array[2] << 8);
+	cal->min = array[3] | array[4] << 8;
+	cal->max = array[5] | array[6] << 8;
+}
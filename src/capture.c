@@ -0,0 +1,106 @@
+/**
+ * \file	capture.c
+ *
+ * \brief	Mitschnitt der Pakete ausgewählter USARTs über die Debug-USART.
+ */
+
+#include "include/capture.h"
+#include "include/xmega.h"
+
+DT_byte CAP_buffer[CAP_BUFFER_SIZE];
+uint16_t CAP_head = 0;
+uint16_t CAP_tail = 0;
+uint16_t CAP_dropped = 0;
+DT_byte CAP_mask = 0;
+
+// lokale Methoden
+DT_byte CAP_getChannel(const USART_data_t* const);
+void CAP_put(DT_byte);
+
+/**
+ * \brief	Startet den Mitschnitt mit CAP_BOOT_MASK, wenn CAP_ON gesetzt ist.
+ *
+ * 			Nach XM_init_com() aufrufen.
+ */
+void CAP_boot() {
+#ifdef CAP_ON
+	CAP_enable(CAP_BOOT_MASK);
+#endif
+}
+
+/**
+ * \brief	Wählt die mitzuschneidenden Kanäle.
+ *
+ * \param	mask	Bitmaske (1 << CAP_COM3, ..., CAP_ALL), 0 schaltet ab
+ */
+void CAP_enable(DT_byte mask) {
+	CAP_mask = mask;
+	CAP_head = 0;
+	CAP_tail = 0;
+	CAP_dropped = 0;
+}
+
+DT_byte CAP_getChannel(const USART_data_t* const usart_data) {
+	if (usart_data == &XM_servo_data_L)
+		return CAP_SERVO_L;
+	if (usart_data == &XM_servo_data_R)
+		return CAP_SERVO_R;
+	if (usart_data == &XM_com_data1)
+		return CAP_COM1;
+	if (usart_data == &XM_com_data3)
+		return CAP_COM3;
+	return CAP_CHANNELS;
+}
+
+void CAP_put(DT_byte b) {
+	CAP_buffer[CAP_head] = b;
+	CAP_head = (CAP_head + 1) & (CAP_BUFFER_SIZE - 1);
+}
+
+/**
+ * \brief	Schreibt ein Paket in den Ringpuffer und gibt ihn aus.
+ *
+ * \param	usart_data	USART des Pakets
+ * \param	tx			true für gesendet, false für empfangen
+ * \param	packet		Paket
+ * \param	l			Länge des Pakets
+ */
+void CAP_frame(const USART_data_t* const usart_data, DT_bool tx,
+		const DT_byte* const packet, DT_size l) {
+	const DT_byte channel = CAP_getChannel(usart_data);
+	const uint16_t used = (CAP_head - CAP_tail) & (CAP_BUFFER_SIZE - 1);
+	DT_size t, i;
+
+	if (channel == CAP_CHANNELS || !(CAP_mask & (1 << channel)))
+		return;
+	if (l > 0xFF || used + CAP_HEADER + l >= CAP_BUFFER_SIZE) {
+		CAP_dropped++;
+		return;
+	}
+	t = XM_getTimeUs();
+	CAP_put(CAP_SYNC);
+	CAP_put(l);
+	CAP_put(channel | (tx ? CAP_TX : 0));
+	CAP_put(t);
+	CAP_put(t >> 8);
+	for (i = 0; i < l; i++)
+		CAP_put(packet[i]);
+	CAP_poll();
+}
+
+/**
+ * \brief	Gibt den Ringpuffer aus, solange die Debug-USART frei ist.
+ */
+void CAP_poll() {
+	while (CAP_tail != CAP_head && XM_debugTryPutChar(CAP_buffer[CAP_tail]))
+		CAP_tail = (CAP_tail + 1) & (CAP_BUFFER_SIZE - 1);
+}
+
+/**
+ * \brief	Liefert die Anzahl der verworfenen Pakete seit CAP_enable().
+ *
+ * \return	Anzahl
+ */
+uint16_t CAP_getDropped() {
+	return CAP_dropped;
+}
@@ -7,9 +7,21 @@
 #include "include/communication.h"
 #include "include/utils.h"
 #include "include/xmega.h"
+#include "include/profiler.h"
+#include "include/trace.h"
+#include "include/capture.h"
+#include "include/packetPool.h"
 
 #define COM_START_BYTE 	0xFF
 
+DT_comClock COM_clock = { 0, 0, 0, 0, COM_SYNC_BURST, 0, 0 };
+
+// lokale Methoden
+DT_bool COM_sendForAck(DT_byte* const, DT_size);
+DT_byte COM_pollStatus(DT_byte, DT_byte);
+void COM_timeToByteArray(uint32_t, DT_byte* const);
+int32_t COM_driftUs(int32_t, int32_t);
+
 /**
  * \brief	Berechnet die Checksum.
  *
@@ -71,19 +83,19 @@ DT_byte COM_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 
 	// Init-Fehlerbytes ausfiltern
 	if (buffer->RX[tempTail] != 0xFF && (tempHead != tempTail)) {
-		DEBUG(("COM_i",sizeof("COM_i")))
+		DEBUG_P("COM_i")
 		USART_RXBuffer_GetByte(usart_data);
 		return 0;
 	}
 	// Pruefen ob min. 4 Bytes im Buffer sind, um Laenge zu lesen
 	else if (USART_RXBuffer_checkPointerDiff(tempTail, tempHead, 4)) {
-		DEBUG(("COM_le",sizeof("COM_le")))
+		DEBUG_P("COM_le")
 		return 0;
 	}
 	// Byte #1 und Byte #2 muessen laut Protokoll 0xFF sein
 	else if ((buffer->RX[tempTail] != 0xFF) && (buffer->RX[(tempTail + 1)
 			& USART_RX_BUFFER_MASK] != 0xFF)) {
-		DEBUG(("COM_ff",sizeof("COM_ff")))
+		DEBUG_P("COM_ff")
 		return 0;
 	}
 	// Some data received. All data received if checksum is correct!
@@ -95,7 +107,7 @@ DT_byte COM_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 		length += 4;
 		// Prüfen ob Paket bereits komplett im Buffer
 		if (USART_RXBuffer_checkPointerDiff(tempTail, tempHead, length)) {
-			DEBUG(("COM_uc",sizeof("COM_uc")))
+			DEBUG_P("COM_uc")
 			return 0;
 		}
 		// Copy packet from buffer in destination array
@@ -106,14 +118,19 @@ DT_byte COM_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 
 		// Pruefen ob Checksumme korrekt ist
 		if (dest[length - 1] != COM_getChecksum(dest, length)) {
-			DEBUG(("COM_cks",sizeof("COM_cks")))
+			DEBUG_P("COM_cks")
 			usart_data->buffer.RX_Tail = 0;
 			usart_data->buffer.RX_Head = 0;
 			// DEBUG_BYTE((dest, length))
 			return 0;
 		}
 
-		DEBUG(("COM_ok",sizeof("COM_ok")))
+		// Korrelations-ID vor der Prüfsumme
+		TRC_setCorrelation(dest[length - 2]);
+		TRC_EVENT(TRC_FRAME_RECEIVED, usart_data == &XM_com_data1
+				? COM_SLAVE1B : (dest[2] == COM_MASTER ? COM_SLAVE3F : COM_MASTER))
+		CAP_frame(usart_data, false, dest, length);
+		DEBUG_P("COM_ok")
 		return length;
 	}
 }
@@ -125,41 +142,54 @@ DT_byte COM_receive(USART_data_t* const usart_data, DT_byte* const dest) {
  *
  * \param	packet	Zuversendendes Paket
  * \param	l	Größe des Pakets
- * \param	result	Zielfeld für Antowort
+ * \param	result	Zielfeld für Antowort, NULL für einen Puffer aus PKT_RX
  * \param	hasResponse	Wartet auf eine Antwort, wenn true
  *
  * \return Größe der empfangenen Antwort
  */
 DT_byte COM_send(DT_byte* const packet, DT_size l, DT_byte* const result,
 		DT_bool hasResponse) {
+	packet[l - 2] = TRC_getCorrelation();
 	packet[l - 1] = COM_getChecksum(packet, l);
 	DT_byte cpuID = packet[2];
 	USART_data_t* usart_data;
 	DT_byte len = 0;
 
+	TRC_EVENT(TRC_CMD_BUILT, cpuID)
 	if (cpuID == COM_BRDCAST_ID) {
-		DEBUG(("SND_BDC", sizeof("SND_BDC")));
+		DEBUG_P("SND_BDC")
+		TRC_EVENT(TRC_FRAME_SENT, cpuID)
 		usart_data = &XM_com_data1;
 		XM_USART_send(usart_data, packet, l);
+		CAP_frame(usart_data, true, packet, l);
 		usart_data = &XM_com_data3;
 		XM_USART_send(usart_data, packet, l);
+		CAP_frame(usart_data, true, packet, l);
 	} else {
 		if (cpuID == COM_SLAVE3F || cpuID == COM_MASTER) {
-			DEBUG(("SND_S3_M", sizeof("SND_S3_M")))
+			DEBUG_P("SND_S3_M")
 			usart_data = &XM_com_data3;
 		} else if (cpuID == COM_SLAVE1B) {
-			DEBUG(("SND_S1", sizeof("SND_S1")))
+			DEBUG_P("SND_S1")
 			usart_data = &XM_com_data1;
 		}
 		// packet[2] -> ID
+		TRC_EVENT(TRC_FRAME_SENT, cpuID)
 		XM_USART_send(usart_data, packet, l);
+		CAP_frame(usart_data, true, packet, l);
 
 		DT_size timeout = hasResponse ? 1000 : 0;
+		DT_byte* const dest = (result == NULL && hasResponse) ? PKT_acquire(
+				PKT_RX) : result;
 
-		while (len == 0 && hasResponse /* && timeout > 0 */) {
-			len = COM_receive(usart_data, result);
+		PRF_BEGIN(PRF_COM_WAIT)
+		while (len == 0 && hasResponse && dest != NULL /* && timeout > 0 */) {
+			len = COM_receive(usart_data, dest);
 			timeout--;
 		}
+		PRF_END(PRF_COM_WAIT)
+		if (dest != result)
+			PKT_release(dest);
 	}
 	return len;
 }
@@ -179,48 +209,54 @@ DT_size COM_requestStatus(DT_byte cpuID, DT_byte param, DT_byte* const result) {
 	// Broadcast bei requestStatus nicht möglich
 	if (cpuID == COM_BRDCAST_ID)
 		return 0;
-	const DT_size len = 7;
-	DT_byte packet[len];
+	const DT_size len = 8;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_size l;
+	if (packet == NULL)
+		return 0;
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
 	packet[2] = cpuID;
 	packet[3] = len - 4; // length
 	packet[4] = COM_STATUS;
 	packet[5] = param;
-	// packet[6] = checksum will set in send
-	return COM_send(packet, len, result, true);
-
+	// packet[6] = correlation, packet[7] = checksum will set in send
+	l = COM_send(packet, len, result, true);
+	PKT_release(packet);
+	return l;
 }
 
 /**
- * \brief	Konvertiert einen Double-Wert in ein Byte-Array.
+ * \brief	Konvertiert einen DT_real-Wert in ein Byte-Array.
  *
- * 			Konvertiert einen Double-Wert in ein Byte-Array.
+ * 			Der Wert wird als DT_q16 (Q16.16, Little Endian) mit COM_REAL_SIZE
+ * 			Bytes abgelegt, damit Master und Slaves mit jeder Zahlendarstellung
+ * 			(DT_REAL) dieselben Pakete erzeugen.
  *
- * \param	value	Double-Wert
+ * \param	value	Wert
  * \param	array	Zielfeld
  */
-void COM_doubleToByteArray(const DT_double value, DT_byte* const array) {
-	DT_byte* ptr = (DT_byte*) &value;
-	for (DT_size i = 0; i < sizeof(DT_double); i++)
-		array[i] = ptr[i];
+void COM_realToByteArray(const DT_real value, DT_byte* const array) {
+	const uint32_t q = UTL_realToQ16(value);
+	array[0] = q;
+	array[1] = q >> 8;
+	array[2] = q >> 16;
+	array[3] = q >> 24;
 }
 
 /**
- * \brief	Konvertiert ein Byte-Array zu einem Double-Wert.
+ * \brief	Konvertiert ein Byte-Array zu einem DT_real-Wert.
  *
- * 			Konvertiert ein Byte-Array zu einem Double-Wert.
+ * 			Konvertiert ein Byte-Array aus COM_realToByteArray() zu einem
+ * 			DT_real-Wert.
  *
- * \param	array	Byte-Array mit Double-Wert
+ * \param	array	Byte-Array mit DT_q16-Wert
  *
- * \return	Double-Wert
+ * \return	Wert
  */
-DT_double COM_byteArrayToDouble(const DT_byte* const array) {
-	DT_double value;
-	DT_byte* ptr = (DT_byte*) &value;
-	for (DT_size i = 0; i < sizeof(DT_double); i++)
-		ptr[i] = array[i];
-	return value;
+DT_real COM_byteArrayToReal(const DT_byte* const array) {
+	return UTL_q16ToReal((DT_q16) ((uint32_t) array[0] | (uint32_t) array[1]
+			<< 8 | (uint32_t) array[2] << 16 | (uint32_t) array[3] << 24));
 }
 
 /**
@@ -301,6 +337,25 @@ DT_bool COM_isFoot(const DT_byte* const result) {
 	return (COM_CONF_FOOT == (result[5] & COM_CONF_FOOT));
 }
 
+/**
+ * \brief	Sendet ein Paket und prüft, ob der Controller mit ACK antwortet.
+ *
+ * \param	packet	Zuversendendes Paket
+ * \param	l	Größe des Pakets
+ *
+ * \return	true bei ACK
+ */
+DT_bool COM_sendForAck(DT_byte* const packet, DT_size l) {
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool ack;
+	if (result == NULL)
+		return false;
+	l = COM_send(packet, l, result, true);
+	ack = (l > 0) && (result[4] == COM_ACK);
+	PKT_release(result);
+	return ack;
+}
+
 /**
  * \brief	Sendet einen Punkt an einen Controller.
  *
@@ -314,18 +369,20 @@ DT_bool COM_isFoot(const DT_byte* const result) {
  */
 DT_bool COM_sendPoint(DT_byte cpuID, const DT_point* const point,
 		const DT_byte config) {
-	DEBUG(("pre_snd_pnt",sizeof("pre_snd_pnt")))
+	DEBUG_P("pre_snd_pnt")
 	// Broadcast bei requestStatus nicht möglich
 	if (cpuID == COM_BRDCAST_ID)
 		return 0;
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	DT_size len = 7 + 3 * sizeof(DT_double);
-	DT_byte packet[len];
+	const DT_size len = 8 + 3 * COM_REAL_SIZE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_bool ack;
+	if (packet == NULL)
+		return false;
 
 	// Point auf ByteArray casten
-	COM_doubleToByteArray(point->x, &packet[6 + 0 * sizeof(DT_double)]);
-	COM_doubleToByteArray(point->y, &packet[6 + 1 * sizeof(DT_double)]);
-	COM_doubleToByteArray(point->z, &packet[6 + 2 * sizeof(DT_double)]);
+	COM_realToByteArray(point->x, &packet[6 + 0 * COM_REAL_SIZE]);
+	COM_realToByteArray(point->y, &packet[6 + 1 * COM_REAL_SIZE]);
+	COM_realToByteArray(point->z, &packet[6 + 2 * COM_REAL_SIZE]);
 
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
@@ -334,13 +391,11 @@ DT_bool COM_sendPoint(DT_byte cpuID, const DT_point* const point,
 	packet[4] = COM_POINT;
 	packet[5] = config;
 
-	// packet[17] = checksum will set in send
-	DEBUG(("aft_snd_pnt",sizeof("aft_snd_pnt")))
-	len = COM_send(packet, len, result, true);
-	if ((len > 0) && (result[4] == COM_ACK))
-		return true;
-	else
-		return false;
+	// packet[len - 2] = correlation, packet[len - 1] = checksum will set in send
+	DEBUG_P("aft_snd_pnt")
+	ack = COM_sendForAck(packet, len);
+	PKT_release(packet);
+	return ack;
 }
 
 /**
@@ -356,14 +411,16 @@ DT_bool COM_sendPoint(DT_byte cpuID, const DT_point* const point,
  * \return false, wenn Fehler
  */
 DT_bool COM_sendPointAndSpeed(DT_byte cpuID, const DT_point* const point,
-		const DT_double speed, const DT_byte config) {
-	DEBUG(("pre_snd_pnt",sizeof("pre_snd_pnt")))
+		const DT_real speed, const DT_byte config) {
+	DEBUG_P("pre_snd_pnt")
 	// Broadcast bei requestStatus nicht möglich
 	if (cpuID == COM_BRDCAST_ID)
 		return 0;
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	DT_size len = 24;
-	DT_byte packet[len];
+	const DT_size len = 9 + 4 * COM_REAL_SIZE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_bool ack;
+	if (packet == NULL)
+		return false;
 
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
@@ -373,20 +430,18 @@ DT_bool COM_sendPointAndSpeed(DT_byte cpuID, const DT_point* const point,
 	packet[5] = config;
 
 	// Point auf ByteArray casten
-	COM_doubleToByteArray(point->x, &packet[6 + 0 * sizeof(DT_double)]);
-	COM_doubleToByteArray(point->y, &packet[6 + 1 * sizeof(DT_double)]);
-	COM_doubleToByteArray(point->z, &packet[6 + 2 * sizeof(DT_double)]);
-
-	packet[18] = COM_SPEED;
-	COM_doubleToByteArray(speed, &packet[19]);
-
-	// packet[17] = checksum will set in send
-	DEBUG(("aft_snd_pnt",sizeof("aft_snd_pnt")))
-	len = COM_send(packet, len, result, true);
-	if ((len > 0) && (result[4] == COM_ACK))
-		return true;
-	else
-		return false;
+	COM_realToByteArray(point->x, &packet[6 + 0 * COM_REAL_SIZE]);
+	COM_realToByteArray(point->y, &packet[6 + 1 * COM_REAL_SIZE]);
+	COM_realToByteArray(point->z, &packet[6 + 2 * COM_REAL_SIZE]);
+
+	packet[6 + 3 * COM_REAL_SIZE] = COM_SPEED;
+	COM_realToByteArray(speed, &packet[7 + 3 * COM_REAL_SIZE]);
+
+	// packet[len - 2] = correlation, packet[len - 1] = checksum will set in send
+	DEBUG_P("aft_snd_pnt")
+	ack = COM_sendForAck(packet, len);
+	PKT_release(packet);
+	return ack;
 }
 
 /**
@@ -401,9 +456,9 @@ DT_bool COM_sendPointAndSpeed(DT_byte cpuID, const DT_point* const point,
 DT_point COM_getPointFromPacket(const DT_byte* const result) {
 	DT_point p;
 
-	p.x = COM_byteArrayToDouble(&result[6 + 0 * sizeof(DT_double)]);
-	p.y = COM_byteArrayToDouble(&result[6 + 1 * sizeof(DT_double)]);
-	p.z = COM_byteArrayToDouble(&result[6 + 2 * sizeof(DT_double)]);
+	p.x = COM_byteArrayToReal(&result[6 + 0 * COM_REAL_SIZE]);
+	p.y = COM_byteArrayToReal(&result[6 + 1 * COM_REAL_SIZE]);
+	p.z = COM_byteArrayToReal(&result[6 + 2 * COM_REAL_SIZE]);
 
 	return p;
 }
@@ -417,9 +472,9 @@ DT_point COM_getPointFromPacket(const DT_byte* const result) {
  *
  * \return Anfahrgeschwindigkeit
  */
-DT_double COM_getSpeedFromPacket(const DT_byte* const result) {
-	DT_double speed;
-	speed = COM_byteArrayToDouble(&result[19]);
+DT_real COM_getSpeedFromPacket(const DT_byte* const result) {
+	DT_real speed;
+	speed = COM_byteArrayToReal(&result[7 + 3 * COM_REAL_SIZE]);
 	return speed;
 }
 
@@ -434,18 +489,20 @@ DT_double COM_getSpeedFromPacket(const DT_byte* const result) {
  *
  * \return false, wenn Fehler
  */
-DT_bool COM_sendAngle(DT_byte cpuID, const DT_double angle,
+DT_bool COM_sendAngle(DT_byte cpuID, const DT_real angle,
 		const DT_byte config) {
-	DEBUG(("pre_snd_pnt",sizeof("pre_snd_pnt")))
+	DEBUG_P("pre_snd_pnt")
 	// Broadcast bei requestStatus nicht möglich
 	if (cpuID == COM_BRDCAST_ID)
 		return 0;
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	DT_size len = 7 + sizeof(DT_double);
-	DT_byte packet[len];
+	const DT_size len = 8 + COM_REAL_SIZE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_bool ack;
+	if (packet == NULL)
+		return false;
 
 	// Angle auf ByteArray casten
-	COM_doubleToByteArray(angle, &packet[6]);
+	COM_realToByteArray(angle, &packet[6]);
 
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
@@ -454,12 +511,43 @@ DT_bool COM_sendAngle(DT_byte cpuID, const DT_double angle,
 	packet[4] = COM_ANGLE;
 	packet[5] = config;
 
-	DEBUG(("aft_snd_pnt",sizeof("aft_snd_pnt")))
-	len = COM_send(packet, len, result, true);
-	if ((len > 0) && (result[4] == COM_ACK))
-		return true;
-	else
+	DEBUG_P("aft_snd_pnt")
+	ack = COM_sendForAck(packet, len);
+	PKT_release(packet);
+	return ack;
+}
+
+/**
+ * \brief	Sendet die Kalibrierung eines Servos an einen Controller.
+ *
+ * 			Der Controller übernimmt sie sofort und schreibt sie in sein EEPROM
+ * 			(CAL_set()).
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	id	ID des Servos
+ * \param	cal	Kalibrierung
+ *
+ * \return	true, wenn der Controller mit ACK antwortet
+ */
+DT_bool COM_sendCalibration(DT_byte cpuID, DT_byte id,
+		const DT_calServo* const cal) {
+	const DT_size len = 8 + CAL_SIZE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_bool ack;
+	if (cpuID == COM_BRDCAST_ID || packet == NULL) {
+		PKT_release(packet);
 		return false;
+	}
+	packet[0] = COM_START_BYTE;
+	packet[1] = COM_START_BYTE;
+	packet[2] = cpuID;
+	packet[3] = len - 4; // length
+	packet[4] = COM_CALIBRATE;
+	packet[5] = id;
+	CAL_toByteArray(cal, &packet[6]);
+	ack = COM_sendForAck(packet, len);
+	PKT_release(packet);
+	return ack;
 }
 
 /**
@@ -471,9 +559,9 @@ DT_bool COM_sendAngle(DT_byte cpuID, const DT_double angle,
  *
  * \return Winkel
  */
-DT_double COM_getAngleFromPacket(const DT_byte* const result) {
-	DT_double angle;
-	angle = COM_byteArrayToDouble(&result[6]);
+DT_real COM_getAngleFromPacket(const DT_byte* const result) {
+	DT_real angle;
+	angle = COM_byteArrayToReal(&result[6]);
 	return angle;
 }
 
@@ -485,17 +573,193 @@ DT_double COM_getAngleFromPacket(const DT_byte* const result) {
  * \param	cpuID	ID des Controllers
  */
 void COM_sendAction(DT_byte cpuID) {
-	DEBUG(("snd_act",sizeof("snd_act")))
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	const DT_size len = 6;
-	DT_byte packet[len];
+	DEBUG_P("snd_act")
+	const DT_size len = 7;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
 	packet[2] = cpuID;
 	packet[3] = len - 4; // length
 	packet[4] = COM_ACTION;
-	// packet[5] = checksum will set in send
-	COM_send(packet, len, result, false);
+	// packet[5] = correlation, packet[6] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
+	TRC_next();
+}
+
+void COM_timeToByteArray(uint32_t us, DT_byte* const array) {
+	array[0] = us;
+	array[1] = us >> 8;
+	array[2] = us >> 16;
+	array[3] = us >> 24;
+}
+
+/**
+ * \brief	Ermittelt aus einem Packet (COM_SYNC, COM_ACTION_AT) die Zeit des Masters.
+ *
+ * \param	result	Zu prüfendes Packet
+ *
+ * \return	Zeit in us
+ */
+uint32_t COM_getTimeFromPacket(const DT_byte* const result) {
+	return (uint32_t) result[5] | (uint32_t) result[6] << 8
+			| (uint32_t) result[7] << 16 | (uint32_t) result[8] << 24;
+}
+
+/**
+ * \brief	Sendet das ACTION-Kommando für einen Zeitpunkt an einen Controller.
+ *
+ * 			Der Controller rechnet den Zeitpunkt mit COM_toLocalUs() in seine
+ * 			Zeit um und führt ACTION dann aus (MV_actionAt()).
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	us		Zeitpunkt in Zeit des Masters (COM_getMasterTimeUs())
+ */
+void COM_sendActionAt(DT_byte cpuID, uint32_t us) {
+	const DT_size len = 11;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
+	packet[0] = COM_START_BYTE;
+	packet[1] = COM_START_BYTE;
+	packet[2] = cpuID;
+	packet[3] = len - 4; // length
+	packet[4] = COM_ACTION_AT;
+	COM_timeToByteArray(us, &packet[5]);
+	// packet[9] = correlation, packet[10] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
+	TRC_next();
+}
+
+/**
+ * \brief	Sendet die eigene Zeit zum Abgleich der Uhren an beide Slaves. (Master)
+ *
+ * 			COM_SYNC_BURST Broadcasts im Abstand von COM_SYNC_GAP_US, jeder mit
+ * 			Folgenummer und der Zeit, zu der sein letztes Byte beim Slave ankommt.
+ * 			Ohne Antwort.
+ */
+void COM_syncClocks() {
+	const DT_size len = 12;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	uint32_t start;
+	DT_byte seq;
+
+	if (packet == NULL)
+		return;
+	for (seq = 0; seq < COM_SYNC_BURST; seq++) {
+		// vorheriges Paket ist gesendet, die Zeit gilt ab dem ersten Byte
+		start = XM_getUptimeUs();
+		while (seq > 0 && (uint32_t) (XM_getUptimeUs() - start)
+				< COM_SYNC_GAP_US)
+			;
+		packet[0] = COM_START_BYTE;
+		packet[1] = COM_START_BYTE;
+		packet[2] = COM_BRDCAST_ID;
+		packet[3] = len - 4; // length
+		packet[4] = COM_SYNC;
+		COM_timeToByteArray(XM_getUptimeUs() + len * COM_BYTE_US, &packet[5]);
+		packet[9] = seq;
+		// packet[10] = correlation, packet[11] = checksum will set in send
+		COM_send(packet, len, NULL, false);
+	}
+	PKT_release(packet);
+}
+
+/**
+ * \brief	Wertet ein Paket des Abgleichs aus. (Slave)
+ *
+ * 			Die Verzögerung bis zum Auswerten ist nie negativ, je Abgleich gilt
+ * 			daher der größte Versatz (Zeit des Masters - Empfangszeit). Ist der
+ * 			Abgleich vollständig, wird der Versatz übernommen und aus der Änderung
+ * 			seit dem letzten Abgleich der Gang geschätzt (Mittel mit der letzten
+ * 			Schätzung). Fehlt ein Paket, wird der Abgleich verworfen.
+ *
+ * \param	result	Paket COM_SYNC
+ * \param	len	Länge des Pakets
+ * \param	local_us	Eigene Zeit beim Empfang (XM_getUptimeUs())
+ */
+void COM_onSync(const DT_byte* const result, DT_size len, uint32_t local_us) {
+	DT_comClock* const c = &COM_clock;
+	const int32_t sample = (int32_t) (COM_getTimeFromPacket(result) - local_us);
+
+	if (len != 12)
+		return;
+	if (result[9] == 0)
+		c->next = 0;
+	if (result[9] != c->next) {
+		c->next = COM_SYNC_BURST;
+		return;
+	}
+	if (result[9] == 0 || sample > c->best) {
+		c->best = sample;
+		c->bestLocal_us = local_us;
+	}
+	if (++c->next < COM_SYNC_BURST)
+		return;
+
+	if (c->syncs > 0) {
+		const int32_t span = (int32_t) (c->bestLocal_us - c->local_us);
+		if (span >= COM_DRIFT_SPAN_US) {
+			int32_t drift = (int32_t) ((int64_t) (c->best - c->offset) * 1000000
+					/ span);
+			if (c->syncs > 1)
+				drift = (drift + c->drift) / 2;
+			if (drift > COM_DRIFT_MAX_PPM)
+				drift = COM_DRIFT_MAX_PPM;
+			if (drift < -COM_DRIFT_MAX_PPM)
+				drift = -COM_DRIFT_MAX_PPM;
+			c->drift = drift;
+		}
+	}
+	c->offset = c->best;
+	c->local_us = c->bestLocal_us;
+	if (c->syncs < 0xFF)
+		c->syncs++;
+	DEBUG_P("COM_sync")
+}
+
+/**
+ * \brief	Liefert den Abgleich der eigenen Uhr mit der des Masters.
+ */
+const DT_comClock* COM_getClock() {
+	return &COM_clock;
+}
+
+/**
+ * \brief	Gang der Uhr des Masters über eine Zeitspanne.
+ *
+ * \param	drift	Gang in ppm
+ * \param	span	Zeitspanne in us
+ */
+int32_t COM_driftUs(int32_t drift, int32_t span) {
+	return (int32_t) ((int64_t) span * drift / 1000000);
+}
+
+/**
+ * \brief	Liefert die Zeit des Masters.
+ *
+ * \return	Geschätzte Zeit des Masters in us, auf dem Master XM_getUptimeUs()
+ */
+uint32_t COM_getMasterTimeUs() {
+	const uint32_t local = XM_getUptimeUs();
+	return local + COM_clock.offset + COM_driftUs(COM_clock.drift,
+			(int32_t) (local - COM_clock.local_us));
+}
+
+/**
+ * \brief	Rechnet einen Zeitpunkt des Masters in die eigene Zeit um.
+ *
+ * \param	master_us	Zeitpunkt in Zeit des Masters
+ *
+ * \return	Zeitpunkt in eigener Zeit (XM_getUptimeUs())
+ */
+uint32_t COM_toLocalUs(uint32_t master_us) {
+	const uint32_t local = master_us - COM_clock.offset;
+	return local - COM_driftUs(COM_clock.drift, (int32_t) (local
+			- COM_clock.local_us));
 }
 
 /**
@@ -508,13 +772,280 @@ void COM_sendAction(DT_byte cpuID) {
  * \return	true, wenn Alive
  */
 DT_bool COM_isAlive(DT_byte cpuID) {
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	DT_size len;
-	len = COM_requestStatus(cpuID, COM_IS_ALIVE, result);
-	if ((len > 0) && (result[4] == COM_ACK))
-		return true;
-	else
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool alive;
+	if (result == NULL)
 		return false;
+	alive = (COM_requestStatus(cpuID, COM_IS_ALIVE, result) > 0) && (result[4]
+			== COM_ACK);
+	PKT_release(result);
+	return alive;
+}
+
+/**
+ * \brief	Sendet eine Status-Anfrage an mehrere Slaves gleichzeitig. (Master)
+ *
+ * 			Anders als COM_requestStatus() wird nicht blockierend auf jede Antwort
+ * 			gewartet: die Anfragen gehen zuerst an alle Slaves, danach werden beide
+ * 			Verbindungen höchstens COM_ALIVE_TIMEOUT_US lang abgefragt, bis jeder
+ * 			Slave mit ACK oder NAK geantwortet hat.
+ *
+ * \param	pending	Bitmaske der Slaves (1 << COM_SLAVE1B, 1 << COM_SLAVE3F)
+ * \param	param	Parameter (COM_IS_ALIVE, COM_IS_READY)
+ *
+ * \return	Bitmaske der Slaves, die mit ACK geantwortet haben
+ */
+DT_byte COM_pollStatus(DT_byte pending, DT_byte param) {
+	const DT_byte slaves[] = { COM_SLAVE1B, COM_SLAVE3F };
+	USART_data_t* const usarts[] = { &XM_com_data1, &XM_com_data3 };
+	const DT_size len = 8;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_byte answered = 0, acked = 0, i;
+	DT_size start;
+
+	if (packet != NULL && result != NULL) {
+		for (i = 0; i < sizeof(slaves); i++) {
+			if (!(pending & 1 << slaves[i]))
+				continue;
+			packet[0] = COM_START_BYTE;
+			packet[1] = COM_START_BYTE;
+			packet[2] = slaves[i];
+			packet[3] = len - 4; // length
+			packet[4] = COM_STATUS;
+			packet[5] = param;
+			// packet[6] = correlation, packet[7] = checksum will set in send
+			COM_send(packet, len, NULL, false);
+		}
+		start = XM_getTimeUs();
+		PRF_BEGIN(PRF_COM_WAIT)
+		while ((answered & pending) != pending && (DT_size) (XM_getTimeUs()
+				- start) < COM_ALIVE_TIMEOUT_US) {
+			for (i = 0; i < sizeof(slaves); i++)
+				if ((pending & ~answered & 1 << slaves[i]) && COM_receive(
+						usarts[i], result) > 0 && result[2] == COM_MASTER
+						&& (result[4] == COM_ACK || result[4] == COM_NAK)) {
+					answered |= 1 << slaves[i];
+					if (result[4] == COM_ACK)
+						acked |= 1 << slaves[i];
+				}
+		}
+		PRF_END(PRF_COM_WAIT)
+	}
+	PKT_release(result);
+	PKT_release(packet);
+	return acked;
+}
+
+/**
+ * \brief	Sendet die isAlive-Anfrage an mehrere Slaves gleichzeitig. (Master)
+ *
+ * 			Ein noch nicht gestarteter Slave hält den Master nicht auf, die
+ * 			Anfrage kann wiederholt werden (COM_pollStatus()).
+ *
+ * \param	pending	Bitmaske der Slaves (1 << COM_SLAVE1B, 1 << COM_SLAVE3F)
+ *
+ * \return	Bitmaske der Slaves, die mit ACK geantwortet haben
+ */
+DT_byte COM_pollAlive(DT_byte pending) {
+	return COM_pollStatus(pending, COM_IS_ALIVE);
+}
+
+/**
+ * \brief	Fragt mehrere Slaves gleichzeitig, ob ihre Servos das Ziel erreicht haben. (Master)
+ *
+ * 			Wie COM_pollAlive() mit COM_IS_READY, ein Slave ohne Antwort hält den
+ * 			Master höchstens COM_ALIVE_TIMEOUT_US lang auf.
+ *
+ * \param	pending	Bitmaske der Slaves (1 << COM_SLAVE1B, 1 << COM_SLAVE3F)
+ *
+ * \return	Bitmaske der Slaves, deren Servos nicht mehr in Bewegung sind
+ */
+DT_byte COM_pollReady(DT_byte pending) {
+	return COM_pollStatus(pending, COM_IS_READY);
+}
+
+/**
+ * \brief	Fragt ab, ob die Servos eines Controllers ihre Zielposition erreicht haben.
+ *
+ * \param	cpuID	ID des Controllers
+ *
+ * \return	true, wenn kein Servo mehr in Bewegung ist
+ */
+DT_bool COM_isReady(DT_byte cpuID) {
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool ready;
+	if (result == NULL)
+		return false;
+	ready = (COM_requestStatus(cpuID, COM_IS_READY, result) > 0) && (result[4]
+			== COM_ACK);
+	PKT_release(result);
+	return ready;
+}
+
+/**
+ * \brief	Ruft die Startzeit eines Controllers ab.
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	us	Ziel für die Zeit von XM_init_cpu() bis zur Bereitschaft in us
+ *
+ * \return	true, wenn die Startzeit empfangen wurde
+ */
+DT_bool COM_requestBoot(DT_byte cpuID, uint32_t* const us) {
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool received;
+	if (result == NULL)
+		return false;
+	received = (COM_requestStatus(cpuID, COM_BOOT, result) == 12)
+			&& (result[4] == COM_ACK) && (result[5] == COM_BOOT);
+	if (received)
+		*us = (uint32_t) result[6] | (uint32_t) result[7] << 8
+				| (uint32_t) result[8] << 16 | (uint32_t) result[9] << 24;
+	PKT_release(result);
+	return received;
+}
+
+/**
+ * \brief	Sendet die Startzeit an einen Controller.
+ *
+ * 			Antwort auf COM_BOOT: ACK, COM_BOOT, Zeit in us (Little Endian).
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	us	Zeit von XM_init_cpu() bis zur Bereitschaft in us
+ */
+void COM_sendBoot(DT_byte cpuID, uint32_t us) {
+	const DT_size len = 12;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
+	packet[0] = COM_START_BYTE;
+	packet[1] = COM_START_BYTE;
+	packet[2] = cpuID;
+	packet[3] = len - 4; // length
+	packet[4] = COM_ACK;
+	packet[5] = COM_BOOT;
+	packet[6] = us;
+	packet[7] = us >> 8;
+	packet[8] = us >> 16;
+	packet[9] = us >> 24;
+	// packet[10] = correlation, packet[11] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
+}
+
+/**
+ * \brief	Ruft die Messwerte eines Abschnitts des Profilers von einem Controller ab.
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	scope	Abschnitt (PRF_KIN, ...)
+ * \param	dest	Ziel für die Messwerte
+ *
+ * \return	true, wenn die Messwerte empfangen wurden
+ */
+DT_bool COM_requestProfile(DT_byte cpuID, DT_byte scope,
+		DT_prfScope* const dest) {
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool received;
+	if (result == NULL)
+		return false;
+	received = (COM_requestStatus(cpuID, COM_PROFILE + scope, result) == 8
+			+ PRF_SIZE) && (result[4] == COM_ACK) && (result[5] == scope);
+	if (received)
+		PRF_fromByteArray(dest, &result[6]);
+	PKT_release(result);
+	return received;
+}
+
+/**
+ * \brief	Sendet die Messwerte eines Abschnitts des Profilers an einen Controller.
+ *
+ * 			Antwort auf COM_PROFILE: ACK, Abschnitt, PRF_toByteArray().
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	scope	Abschnitt (PRF_KIN, ...)
+ */
+void COM_sendProfile(DT_byte cpuID, DT_byte scope) {
+	const DT_size len = 8 + PRF_SIZE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
+	packet[0] = COM_START_BYTE;
+	packet[1] = COM_START_BYTE;
+	packet[2] = cpuID;
+	packet[3] = len - 4; // length
+	packet[4] = COM_ACK;
+	packet[5] = scope;
+	PRF_toByteArray(scope, &packet[6]);
+	// packet[len - 2] = correlation, packet[len - 1] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
+}
+
+/**
+ * \brief	Ruft den Stand von RAM und Stack eines Controllers ab.
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	dest	Ziel für den Stand
+ *
+ * \return	true, wenn der Stand empfangen wurde
+ */
+DT_bool COM_requestStack(DT_byte cpuID, DT_stkInfo* const dest) {
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool received;
+	if (result == NULL)
+		return false;
+	received = (COM_requestStatus(cpuID, COM_STACK, result) == 7 + STK_SIZE)
+			&& (result[4] == COM_ACK);
+	if (received)
+		STK_fromByteArray(dest, &result[5]);
+	PKT_release(result);
+	return received;
+}
+
+/**
+ * \brief	Lässt einen Controller sein Ereignisprotokoll ausgeben.
+ *
+ * 			Der Controller bestätigt mit ACK und gibt das Protokoll danach mit
+ * 			TRC_dump() auf seiner Debug-USART aus.
+ *
+ * \param	cpuID	ID des Controllers
+ *
+ * \return	true, wenn die Anfrage bestätigt wurde
+ */
+DT_bool COM_requestTrace(DT_byte cpuID) {
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_bool acked;
+	if (result == NULL)
+		return false;
+	acked = (COM_requestStatus(cpuID, COM_TRACE, result) > 0) && (result[4]
+			== COM_ACK);
+	PKT_release(result);
+	return acked;
+}
+
+/**
+ * \brief	Sendet den Stand von RAM und Stack an einen Controller.
+ *
+ * 			Antwort auf COM_STACK: ACK, STK_toByteArray().
+ *
+ * \param	cpuID	ID des Controllers
+ */
+void COM_sendStack(DT_byte cpuID) {
+	const DT_size len = 7 + STK_SIZE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	DT_stkInfo info;
+	if (packet == NULL)
+		return;
+	STK_getInfo(&info);
+	packet[0] = COM_START_BYTE;
+	packet[1] = COM_START_BYTE;
+	packet[2] = cpuID;
+	packet[3] = len - 4; // length
+	packet[4] = COM_ACK;
+	STK_toByteArray(&info, &packet[5]);
+	// packet[len - 2] = correlation, packet[len - 1] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
 }
 
 /**
@@ -525,16 +1056,18 @@ DT_bool COM_isAlive(DT_byte cpuID) {
  * \param	cpuID	ID des Controllers
  */
 void COM_sendACK(DT_byte cpuID) {
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	const DT_size len = 6;
-	DT_byte packet[len];
+	const DT_size len = 7;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
 	packet[2] = cpuID;
 	packet[3] = len - 4; // length
 	packet[4] = COM_ACK;
-	// packet[5] = checksum will set in send
-	COM_send(packet, len, result, false);
+	// packet[5] = correlation, packet[6] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
 }
 
 /**
@@ -546,15 +1079,17 @@ void COM_sendACK(DT_byte cpuID) {
  * \param	errCode	Fehlercode
  */
 void COM_sendNAK(DT_byte cpuID, DT_byte errCode) {
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	const DT_size len = 7;
-	DT_byte packet[len];
+	const DT_size len = 8;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
 	packet[0] = COM_START_BYTE;
 	packet[1] = COM_START_BYTE;
 	packet[2] = cpuID;
 	packet[3] = len - 4; // length
 	packet[4] = COM_NAK;
 	packet[5] = errCode;
-	// packet[6] = checksum will set in send
-	COM_send(packet, len, result, false);
+	// packet[6] = correlation, packet[7] = checksum will set in send
+	COM_send(packet, len, NULL, false);
+	PKT_release(packet);
 }
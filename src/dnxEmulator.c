@@ -0,0 +1,461 @@
+/**
+ * \file	dnxEmulator.c
+ *
+ * \brief	Emulation der Dynamixel AX-12 am Servo-Bus (Host).
+ *
+ * 			Bildet die Control Table, die Instruktionen PING, READ, WRITE,
+ * 			REG_WRITE, ACTION, RESET und SYNC_WRITE, den Status Return Level und
+ * 			die Return-Delay-Time nach. Die Servos fahren mit der eingestellten
+ * 			Geschwindigkeit auf die Zielposition zu. Für jeden Bus wird die
+ * 			Belegung je Transaktion (Instruktion, Return Delay, Status) erfasst,
+ * 			damit Änderungen an den DNX_*-Methoden vermessen werden können.
+ *
+ * 			Die Servos werden wie in DNX_send() den Bussen zugeordnet: rechts
+ * 			1 - 3, 7 - 9, ..., links 4 - 6, ...
+ *
+ * 			Die virtuelle Zeit ist die des Controllers, beide Busse laufen
+ * 			gleichzeitig. Senden blockiert nicht (Sendepuffer), ein Paket beginnt
+ * 			aber erst, wenn sein Bus frei ist. Hat der Controller eine Antwort
+ * 			vollständig aus dem Empfangspuffer geholt, muss er bis zu ihrem Ende
+ * 			gewartet haben; die Zeit wird dann beim nächsten Paket oder Aufruf von
+ * 			DNE_getTimeUs() bzw. DNE_advance() nachgeführt.
+ */
+
+#include "include/dnxEmulator.h"
+#include "include/dynamixel.h"
+#include "include/xmega.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * \def	DNE_ERR_RANGE
+ * \brief	Fehlerbit: Parameter außerhalb des gültigen Bereichs.
+ *
+ * \def	DNE_ERR_CHECKSUM
+ * \brief	Fehlerbit: Checksumme falsch.
+ *
+ * \def	DNE_ERR_INSTRUCTION
+ * \brief	Fehlerbit: unbekannte Instruktion.
+ *
+ * \def	DNE_MAX_RPM
+ * \brief	Leerlaufdrehzahl bei DNX_MV_SPEED = 0 bzw. 1023.
+ *
+ * \def	DNE_UNITS_PER_DEGREE
+ * \brief	Positionseinheiten je Grad (1023 Einheiten für 300 Grad).
+ */
+#define DNE_ERR_RANGE		0x08
+#define DNE_ERR_CHECKSUM	0x10
+#define DNE_ERR_INSTRUCTION	0x40
+#define DNE_MAX_RPM			114.0
+#define DNE_UNITS_PER_DEGREE	(1023.0 / 300.0)
+
+/** \brief Zustand eines emulierten Servos. */
+typedef struct {
+	DT_bool connected;
+	DT_byte table[DNE_TABLE_SIZE]; /**< Control Table. */
+	DT_byte regAddr; /**< Adresse des mit REG_WRITE gespeicherten Werts. */
+	DT_byte regLen; /**< Länge des mit REG_WRITE gespeicherten Werts. */
+	DT_byte regData[DNE_TABLE_SIZE]; /**< Mit REG_WRITE gespeicherter Wert. */
+	DT_real pos; /**< Istposition in Positionseinheiten. */
+} DT_dneServo;
+
+DT_dneServo DNE_servo[DNE_SERVOS + 1];
+DT_dneStats DNE_stats[2];
+uint32_t DNE_time_us = 0;
+uint32_t DNE_busEnd_us[2]; /**< Ende der letzten Transaktion je Bus. */
+uint32_t DNE_replyEnd_us[2]; /**< Ende der letzten Antwort je Bus, 0 wenn abgerechnet. */
+DT_bool DNE_realTime = false;
+DT_dneActionHook DNE_actionHook = NULL;
+
+// lokale Methoden
+void DNE_reset(DT_dneServo* const, DT_byte);
+DT_bool DNE_isRight(DT_byte);
+uint16_t DNE_getWord(const DT_dneServo* const, DT_byte);
+void DNE_setWord(DT_dneServo* const, DT_byte, uint16_t);
+void DNE_move(DT_dneServo* const, uint32_t);
+void DNE_wait(uint32_t);
+void DNE_elapse(uint32_t);
+void DNE_sync();
+DT_byte DNE_write(DT_dneServo* const, DT_byte, const DT_byte* const, DT_size);
+DT_byte DNE_execute(DT_dneServo* const, const DT_byte* const, DT_size,
+		DT_byte* const, DT_size* const);
+void DNE_syncWrite(DT_int, const DT_byte* const, DT_size);
+void DNE_onPacket(USART_data_t* const, const DT_byte* const, DT_size);
+
+void DNE_reset(DT_dneServo* const servo, DT_byte id) {
+	memset(servo->table, 0, DNE_TABLE_SIZE);
+	servo->table[0x00] = 12; // Model Number AX-12
+	servo->table[0x02] = 0x18; // Version
+	servo->table[DNX_ID] = id;
+	servo->table[DNX_BD] = 1; // 1 Mbps
+	servo->table[DNX_RT_DLY] = 250; // 500us
+	DNE_setWord(servo, 0x08, 1023); // CCW Angle Limit
+	servo->table[DNX_MAX_TMP] = 70;
+	servo->table[0x0C] = 60; // Lowest Limit Voltage
+	servo->table[0x0D] = 140; // Highest Limit Voltage
+	DNE_setWord(servo, 0x0E, 1023); // Max Torque
+	servo->table[DNX_STS_RT_LVL] = 2;
+	servo->table[0x11] = 36; // Alarm LED
+	servo->table[DNX_ALR_SHUTDWN] = 36;
+	servo->table[0x1B] = 32; // CW Compliance Slope
+	servo->table[0x1C] = 32; // CCW Compliance Slope
+	DNE_setWord(servo, 0x22, 1023); // Torque Limit
+	servo->table[0x2A] = 120; // Present Voltage
+	servo->table[DNX_PRT_TMP] = 35;
+	DNE_setWord(servo, 0x30, 32); // Punch
+	servo->regLen = 0;
+	servo->pos = 512;
+	DNE_setWord(servo, DNX_PRT_POS, 512);
+	DNE_setWord(servo, DNX_GL_POS, 512);
+}
+
+DT_bool DNE_isRight(DT_byte id) {
+	return (id - 1) % 6 < 3;
+}
+
+uint16_t DNE_getWord(const DT_dneServo* const servo, DT_byte addr) {
+	return servo->table[addr] | (servo->table[addr + 1] << 8);
+}
+
+void DNE_setWord(DT_dneServo* const servo, DT_byte addr, uint16_t value) {
+	servo->table[addr] = value & 0xFF;
+	servo->table[addr + 1] = value >> 8;
+}
+
+void DNE_move(DT_dneServo* const servo, uint32_t us) {
+	uint16_t goal = DNE_getWord(servo, DNX_GL_POS) & 0x3FF;
+	uint16_t speed = DNE_getWord(servo, DNX_MV_SPEED) & 0x3FF;
+	DT_real rpm = speed == 0 ? DNE_MAX_RPM : fmin(0.111 * speed, DNE_MAX_RPM);
+	DT_real step = rpm * 6 * DNE_UNITS_PER_DEGREE * us / 1e6;
+	DT_real diff = goal - servo->pos;
+
+	if (fabs(diff) <= step)
+		servo->pos = goal;
+	else
+		servo->pos += diff > 0 ? step : -step;
+	DNE_setWord(servo, DNX_PRT_POS, (uint16_t) lround(servo->pos));
+	servo->table[DNX_MOVING] = servo->pos != goal;
+	DNE_setWord(servo, DNX_PRT_SPEED, servo->table[DNX_MOVING] ? speed : 0);
+}
+
+void DNE_wait(uint32_t us) {
+	DT_size t0 = XM_getTimeUs();
+	DNE_elapse(us);
+	if (DNE_realTime)
+		while ((DT_size) (XM_getTimeUs() - t0) < us)
+			;
+}
+
+void DNE_elapse(uint32_t us) {
+	DT_byte id;
+	DNE_time_us += us;
+	for (id = 1; id <= DNE_SERVOS; id++)
+		if (DNE_servo[id].connected)
+			DNE_move(&DNE_servo[id], us);
+}
+
+/*
+ * Führt die Zeit bis zum Ende der Antworten nach, die der Controller bereits
+ * abgeholt hat (Empfangspuffer des Busses leer).
+ */
+void DNE_sync() {
+	USART_data_t* const usarts[] = { &XM_servo_data_R, &XM_servo_data_L };
+	DT_int bus;
+	for (bus = 0; bus < 2; bus++)
+		if (DNE_replyEnd_us[bus] != 0 && !USART_RXBufferData_Available(
+				usarts[bus])) {
+			if (DNE_replyEnd_us[bus] > DNE_time_us)
+				DNE_wait(DNE_replyEnd_us[bus] - DNE_time_us);
+			DNE_replyEnd_us[bus] = 0;
+		}
+}
+
+DT_byte DNE_write(DT_dneServo* const servo, DT_byte addr,
+		const DT_byte* const data, DT_size len) {
+	if (addr + len > DNE_TABLE_SIZE)
+		return DNE_ERR_RANGE;
+	memcpy(&servo->table[addr], data, len);
+	return 0;
+}
+
+/**
+ * \brief	Führt eine Instruktion auf einem Servo aus.
+ *
+ * \param	servo	Servo
+ * \param	packet	Instruktionspaket
+ * \param	l	Länge des Pakets
+ * \param	params	Zielfeld für die Parameter des Statuspakets
+ * \param	cnt	Anzahl der Parameter des Statuspakets
+ *
+ * \return	Fehlerbits des Statuspakets
+ */
+DT_byte DNE_execute(DT_dneServo* const servo, const DT_byte* const packet,
+		DT_size l, DT_byte* const params, DT_size* const cnt) {
+	const DT_byte* const p = &packet[5];
+	const DT_size n = l - 6;
+	*cnt = 0;
+
+	switch (packet[4]) {
+	case DNX_PING:
+		return 0;
+	case DNX_RD_DATA:
+		if (n < 2 || p[0] + p[1] > DNE_TABLE_SIZE)
+			return DNE_ERR_RANGE;
+		memcpy(params, &servo->table[p[0]], p[1]);
+		*cnt = p[1];
+		return 0;
+	case DNX_WR_DATA:
+		if (n < 2)
+			return DNE_ERR_RANGE;
+		return DNE_write(servo, p[0], &p[1], n - 1);
+	case DNX_REG_WR:
+		if (n < 2 || p[0] + n - 1 > DNE_TABLE_SIZE)
+			return DNE_ERR_RANGE;
+		servo->regAddr = p[0];
+		servo->regLen = n - 1;
+		memcpy(servo->regData, &p[1], n - 1);
+		servo->table[DNX_REG_INST] = 1;
+		return 0;
+	case DNX_ACT:
+		if (DNE_actionHook != NULL)
+			DNE_actionHook(servo->table[DNX_ID]);
+		if (servo->table[DNX_REG_INST])
+			DNE_write(servo, servo->regAddr, servo->regData, servo->regLen);
+		servo->table[DNX_REG_INST] = 0;
+		return 0;
+	case DNX_RESET:
+		DNE_reset(servo, 1);
+		return 0;
+	default:
+		return DNE_ERR_INSTRUCTION;
+	}
+}
+
+/**
+ * \brief	SYNC_WRITE: schreibt für jeden adressierten Servo seinen Datenblock.
+ *
+ * \param	bus	0 rechts, 1 links
+ * \param	packet	Instruktionspaket
+ * \param	l	Länge des Pakets
+ */
+void DNE_syncWrite(DT_int bus, const DT_byte* const packet, DT_size l) {
+	const DT_byte addr = packet[5];
+	const DT_byte len = packet[6];
+	DT_size i;
+
+	if (len == 0)
+		return;
+	for (i = 7; i + len + 1 < l; i += len + 1) {
+		DT_byte id = packet[i];
+		if (id >= 1 && id <= DNE_SERVOS && DNE_servo[id].connected
+				&& DNE_isRight(id) == (bus == 0))
+			DNE_write(&DNE_servo[id], addr, &packet[i + 1], len);
+	}
+}
+
+/**
+ * \brief	Empfänger der Instruktionspakete eines Servo-Busses.
+ *
+ * 			Ungültige Pakete werden wie am Bus ignoriert. Broadcasts werden nie
+ * 			beantwortet, sonst abhängig vom Status Return Level: 0 nur PING,
+ * 			1 zusätzlich READ, 2 alle Instruktionen.
+ *
+ * \param	usart_data	Servo-USART
+ * \param	packet	Instruktionspaket
+ * \param	l	Länge des Pakets
+ */
+void DNE_onPacket(USART_data_t* const usart_data, const DT_byte* const packet,
+		DT_size l) {
+	const DT_int bus = usart_data == &XM_servo_data_R ? 0 : 1;
+	DT_dneStats* const stats = &DNE_stats[bus];
+	uint32_t busy = l * DNE_BYTE_US;
+	const uint32_t replies = stats->replies;
+	DT_byte reply[6 + DNE_TABLE_SIZE];
+	DT_size cnt, i;
+
+	stats->transactions++;
+	stats->txBytes += l;
+	DNE_sync();
+
+	if (l >= 6 && packet[0] == DNX_START_BYTE && packet[1] == DNX_START_BYTE
+			&& packet[3] + 4 == l) {
+		const DT_byte id = packet[2];
+		const DT_bool valid = packet[l - 1] == DNX_getChecksum(packet, l);
+
+		if (id == DNX_BRDCAST_ID && valid) {
+			if (packet[4] == DNX_SYC_WR) {
+				DNE_syncWrite(bus, packet, l);
+			} else {
+				for (i = 1; i <= DNE_SERVOS; i++)
+					if (DNE_servo[i].connected && DNE_isRight(i) == (bus == 0))
+						DNE_execute(&DNE_servo[i], packet, l, &reply[5], &cnt);
+			}
+		} else if (id >= 1 && id <= DNE_SERVOS && DNE_servo[id].connected
+				&& DNE_isRight(id) == (bus == 0)) {
+			DT_dneServo* const servo = &DNE_servo[id];
+			const DT_byte instr = packet[4];
+			const DT_byte level = servo->table[DNX_STS_RT_LVL];
+
+			cnt = 0;
+			reply[4] = valid ? DNE_execute(servo, packet, l, &reply[5], &cnt)
+					: DNE_ERR_CHECKSUM;
+			if (instr == DNX_PING || (instr == DNX_RD_DATA && level >= 1) || level >= 2) {
+				DT_size len = cnt + 6;
+				reply[0] = DNX_START_BYTE;
+				reply[1] = DNX_START_BYTE;
+				reply[2] = id;
+				reply[3] = cnt + 2;
+				reply[len - 1] = DNX_getChecksum(reply, len);
+
+				busy += 2 * servo->table[DNX_RT_DLY] + len * DNE_BYTE_US;
+				stats->replies++;
+				stats->rxBytes += len;
+				for (i = 0; i < len; i++)
+					XM_receiveByte(usart_data, reply[i]);
+			}
+		}
+	}
+
+	if (DNE_busEnd_us[bus] < DNE_time_us)
+		DNE_busEnd_us[bus] = DNE_time_us;
+	DNE_busEnd_us[bus] += busy;
+	if (stats->replies != replies)
+		DNE_replyEnd_us[bus] = DNE_busEnd_us[bus];
+	stats->last_us = busy;
+	stats->busy_us += busy;
+	if (busy > stats->max_us)
+		stats->max_us = busy;
+}
+
+/**
+ * \brief	Initialisiert die Servos mit den Werkseinstellungen.
+ *
+ * 			Setzt die virtuelle Zeit und die Statistik zurück und meldet den
+ * 			Emulator als Empfänger an beiden Servo-USARTs an.
+ *
+ * \param	ids	Bitmaske der angeschlossenen Servos (Bit i für ID i)
+ */
+void DNE_init(uint32_t ids) {
+	DT_byte id;
+	for (id = 1; id <= DNE_SERVOS; id++) {
+		DNE_servo[id].connected = (ids >> id) & 1;
+		DNE_reset(&DNE_servo[id], id);
+	}
+	DNE_time_us = 0;
+	DNE_busEnd_us[0] = DNE_busEnd_us[1] = 0;
+	DNE_replyEnd_us[0] = DNE_replyEnd_us[1] = 0;
+	DNE_resetStats();
+	XM_setTxHook(&XM_servo_data_R, DNE_onPacket);
+	XM_setTxHook(&XM_servo_data_L, DNE_onPacket);
+}
+
+/**
+ * \brief	Schaltet den Echtzeitbetrieb ein oder aus.
+ *
+ * 			Im Echtzeitbetrieb blockiert jede Transaktion so lange, wie sie den Bus
+ * 			belegt, z.B. für die Simulation mehrerer Controller.
+ *
+ * \param	on	true für Echtzeit
+ */
+void DNE_setRealTime(DT_bool on) {
+	DNE_realTime = on;
+}
+
+/**
+ * \brief	Setzt die Methode, die bei jeder ACTION-Instruktion aufgerufen wird.
+ *
+ * \param	hook	Methode oder NULL
+ */
+void DNE_setActionHook(DT_dneActionHook hook) {
+	DNE_actionHook = hook;
+}
+
+/**
+ * \brief	Lässt virtuelle Zeit vergehen, die Servos fahren weiter.
+ *
+ * \param	us	Zeit in us
+ */
+void DNE_advance(uint32_t us) {
+	DNE_sync();
+	DNE_elapse(us);
+}
+
+/**
+ * \brief	Liefert die virtuelle Zeit.
+ *
+ * \return	Zeit seit DNE_init() in us
+ */
+uint32_t DNE_getTimeUs() {
+	DNE_sync();
+	return DNE_time_us;
+}
+
+/**
+ * \brief	Prüft, ob ein Servo angeschlossen ist.
+ *
+ * \param	id	ID des Servos
+ *
+ * \return	true, wenn angeschlossen
+ */
+DT_bool DNE_isConnected(DT_byte id) {
+	return id >= 1 && id <= DNE_SERVOS && DNE_servo[id].connected;
+}
+
+/**
+ * \brief	Liest ein Byte aus der Control Table eines Servos.
+ *
+ * \param	id	ID des Servos
+ * \param	addr	Adresse
+ *
+ * \return	Wert
+ */
+DT_byte DNE_readByte(DT_byte id, DT_byte addr) {
+	return DNE_servo[id].table[addr];
+}
+
+/**
+ * \brief	Liest ein Wort (Low, High) aus der Control Table eines Servos.
+ *
+ * \param	id	ID des Servos
+ * \param	addr	Adresse des Low-Bytes
+ *
+ * \return	Wert
+ */
+uint16_t DNE_readWord(DT_byte id, DT_byte addr) {
+	return DNE_getWord(&DNE_servo[id], addr);
+}
+
+/**
+ * \brief	Liefert die Belegung eines Servo-Busses.
+ *
+ * \param	usart_data	XM_servo_data_R oder XM_servo_data_L
+ *
+ * \return	Statistik des Busses
+ */
+const DT_dneStats* DNE_getStats(const USART_data_t* const usart_data) {
+	return &DNE_stats[usart_data == &XM_servo_data_R ? 0 : 1];
+}
+
+/**
+ * \brief	Setzt die Statistik beider Busse zurück.
+ */
+void DNE_resetStats() {
+	memset(DNE_stats, 0, sizeof(DNE_stats));
+}
+
+/**
+ * \brief	Gibt die Belegung beider Busse auf stdo aus.
+ */
+void DNE_printStats() {
+	DT_int bus;
+	for (bus = 0; bus < 2; bus++) {
+		const DT_dneStats* const s = &DNE_stats[bus];
+		printf("Bus %s: %lu Transaktionen, %lu Antworten, %lu/%lu Byte, "
+			"belegt %lu us (max. %lu us je Transaktion)\n", bus == 0 ? "R"
+				: "L", (unsigned long) s->transactions,
+				(unsigned long) s->replies, (unsigned long) s->txBytes,
+				(unsigned long) s->rxBytes, (unsigned long) s->busy_us,
+				(unsigned long) s->max_us);
+	}
+}
@@ -7,31 +7,100 @@
 #include "include/dynamixel.h"
 #include "include/utils.h"
 #include "include/xmega.h"
+#include "include/profiler.h"
+#include "include/trace.h"
+#include "include/capture.h"
+#include "include/packetPool.h"
+#include "include/calibration.h"
 #include <math.h>
 
-#define START_BYTE 0xFF
-
-// Instruction Set (Manual page 19)
-#define PING 0x01
-#define RD_DATA 0x02
-#define WR_DATA 0x03
-#define REG_WR 0x04
-#define ACT 0x05
-#define RESET 0x06
-#define SYC_WR 0x83
-
-// Control Table (Manuel page 12)
-#define ID 0x03
-#define BD 0x04
-#define MAX_TMP 0x0B
-#define STS_RT_LVL 0x10
-#define ALR_SHUTDWN 0x12
-#define GL_POS 0x1E
-#define LED 0x19
-#define MV_SPEED 0x20
-#define PRT_POS 0x24
-#define PRT_SPEED 0x26
-#define PRT_TMP 0x2B
+/**
+ * \def	DNX_TOPOLOGY_SIZE
+ * \brief	Bytes der Liste im EEPROM: 'T', Bitmaske (3 Bytes), Prüfsumme.
+ */
+#define DNX_TOPOLOGY_SIZE	5
+
+/**
+ * \def	DNX_RIGHT_IDS
+ * \brief	Bitmaske der IDs am rechten Bus (1 - 3, 7 - 9, 13 - 15).
+ */
+#define DNX_RIGHT_IDS	0x0000E38E
+
+/**
+ * \def	DNX_CPU_SERVOS
+ * \brief	Servos eines Controllers (zwei Beine mit je drei Gelenken).
+ */
+#define DNX_CPU_SERVOS	6
+
+/*
+ * Abbild der zuletzt an jeden Servo gesendeten bzw. mit DNX_stage()
+ * vorgemerkten Zielposition und Anfahrgeschwindigkeit (Index ID). Ein Bit in
+ * DNX_goalKnown/DNX_speedKnown kennzeichnet einen gültigen Eintrag, ein Bit in
+ * DNX_dirty/DNX_speedDirty einen noch nicht gesendeten.
+ */
+uint16_t DNX_goal[DNX_MAX_ID + 1];
+uint16_t DNX_speed[DNX_MAX_ID + 1];
+uint32_t DNX_goalKnown = 0;
+uint32_t DNX_speedKnown = 0;
+uint32_t DNX_dirty = 0;
+uint32_t DNX_speedDirty = 0;
+DT_dnxStats DNX_stats;
+
+/*
+ * Status Return Level je Servo (Index ID), gültig mit gesetztem Bit in
+ * DNX_levelKnown. Ein unbekannter Servo antwortet wie mit Werkseinstellung
+ * (Level 2) auf jede Instruktion.
+ */
+DT_byte DNX_level[DNX_MAX_ID + 1];
+uint32_t DNX_levelKnown = 0;
+DT_byte DNX_error[DNX_MAX_ID + 1]; /**< Fehlerbyte der letzten Antwort je Servo. */
+uint16_t DNX_errorCount[DNX_ERR_BITS]; /**< Antworten je gesetztem Fehlerbit. */
+
+/** \brief ACTION als Broadcast für DNX_fireAction(). */
+const DT_byte DNX_actionPacket[6] = { DNX_START_BYTE, DNX_START_BYTE, DNX_BRDCAST_ID, 2,
+		DNX_ACT, (DT_byte) ~(DNX_BRDCAST_ID + 2 + DNX_ACT) };
+volatile DT_bool DNX_fired = false; /**< DNX_fireAction() lief, DNX_logFiredAction() steht aus. */
+volatile DT_byte DNX_firedBuses = 0; /**< Busse, auf denen DNX_fireAction() gesendet hat (DNX_BUS_R, DNX_BUS_L). */
+
+/** \brief Warteschlange und ausstehende Transaktion eines Servo-Busses. */
+typedef struct {
+	USART_data_t* usart_data;
+	DT_dnxRequest* queue[DNX_QUEUE_SIZE]; /**< Ring, ältester Eintrag bei head. */
+	DT_byte head;
+	DT_byte count;
+	DT_dnxRequest* active; /**< Gesendet, Antwort steht aus. */
+	DT_size timeout; /**< Verbleibende Abfragen für active. */
+	uint32_t start_us; /**< Sendezeitpunkt von active (XM_getUptimeUs()). */
+	DT_dnxBusStats stats;
+} DT_dnxBus;
+
+DT_dnxBus DNX_bus[2] = { { &XM_servo_data_R }, { &XM_servo_data_L } };
+
+// lokale Methoden
+DT_byte DNX_countIds(uint32_t);
+DT_byte DNX_getTopologyChecksum(const DT_byte* const);
+uint32_t DNX_readTopology();
+void DNX_writeTopology(uint32_t);
+void DNX_dropEcho(USART_data_t* const);
+void DNX_transmit(USART_data_t* const, const DT_byte* const, DT_size);
+void DNX_parseError(DT_byte, DT_byte);
+DT_bool DNX_accepted(const DT_dnxRequest* const);
+DT_bool DNX_write(DT_byte* const, DT_size);
+DT_bool DNX_writeByte(DT_byte, DT_byte, DT_byte);
+void DNX_record(DT_byte, uint16_t, uint16_t, DT_bool);
+DT_byte DNX_syncWrite(USART_data_t* const, uint32_t, DT_bool);
+DT_dnxBus* DNX_getBus(DT_byte);
+void DNX_start(DT_dnxBus* const, DT_byte** const);
+DT_bool DNX_poll(DT_dnxBus* const, DT_byte* const);
+DT_byte DNX_lowestId(uint32_t);
+uint32_t DNX_runPairs(uint32_t, DT_size(*)(DT_byte* const, DT_byte),
+		DT_byte, uint32_t* const);
+DT_size DNX_goalPacket(DT_byte* const, DT_byte, uint16_t, uint16_t, DT_bool);
+DT_size DNX_buildPing(DT_byte* const, DT_byte);
+DT_size DNX_buildReadMoving(DT_byte* const, DT_byte);
+DT_size DNX_buildReadDelay(DT_byte* const, DT_byte);
+DT_size DNX_buildReadLevel(DT_byte* const, DT_byte);
+DT_size DNX_buildStaged(DT_byte* const, DT_byte);
 
 /**
  * \brief	Berechnet die Checksum.
@@ -63,30 +132,25 @@ DT_byte DNX_getChecksum(const DT_byte* const packet, DT_size l) {
 DT_byte DNX_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 	USART_Buffer_t* const buffer = &usart_data->buffer;
 
-	// Phantom-Paket verwerfen
-	while (USART_RXBufferData_Available(usart_data)
-			&& usart_data->lastPacketLength > 0) {
-		usart_data->lastPacketLength--;
-		USART_RXBuffer_GetByte(usart_data);
-	}
+	DNX_dropEcho(usart_data);
 
 	const DT_byte tempHead = buffer->RX_Head;
 	const DT_byte tempTail = buffer->RX_Tail;
 
 	if (usart_data->lastPacketLength > 0) {
-		DEBUG(("DNX_se",sizeof("DNX_se")))
+		DEBUG_P("DNX_se")
 		return 0;
 	}
 
 	// Pruefen ob min. 4 Bytes im Buffer sind, um Laenge zu lesen
 	if (USART_RXBuffer_checkPointerDiff(tempTail, tempHead, 4)) {
-		//DEBUG(("DNX_le",sizeof("DNX_le")))
+		//DEBUG_P("DNX_le")
 		return 0;
 	}
 	// Byte #1 und Byte #2 muessen laut Protokoll 0xFF sein
 	else if ((buffer->RX[tempTail] != 0xFF) && (buffer->RX[(tempTail + 1)
 			& USART_RX_BUFFER_MASK] != 0xFF)) {
-		DEBUG(("DNX_ff",sizeof("DNX_ff")))
+		DEBUG_P("DNX_ff")
 		return 0;
 	}
 	// Some data received. All data received if checksum is correct!
@@ -98,7 +162,7 @@ DT_byte DNX_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 		length += 4;
 		// Prüfen ob Paket bereits komplett im Buffer
 		if (USART_RXBuffer_checkPointerDiff(tempTail, tempHead, length)) {
-			DEBUG(("DNX_uc",sizeof("DNX_uc")))
+			DEBUG_P("DNX_uc")
 			return 0;
 		}
 		// Copy packet from buffer in destination array
@@ -109,139 +173,492 @@ DT_byte DNX_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 		DEBUG_BYTE((dest,25))
 		// Pruefen ob Checksumme korrekt ist
 		if (dest[length - 1] != DNX_getChecksum(dest, length)) {
-			DEBUG(("DNX_cks",sizeof("DNX_cks")))
+			DEBUG_P("DNX_cks")
 			usart_data->buffer.RX_Tail = 0;
 			usart_data->buffer.RX_Head = 0;
 			//DEBUG_BYTE((dest, length))
 			return 0;
 		}
-		DEBUG(("DNX_ok",sizeof("DNX_ok")))
+		CAP_frame(usart_data, false, dest, length);
+		DEBUG_P("DNX_ok")
 		return length;
 	}
 }
 
+/**
+ * \brief	Verwirft die bereits empfangenen Bytes des Phantom-Pakets.
+ *
+ * 			Am Halbduplex-Bus wird jedes gesendete Byte auch empfangen
+ * 			(lastPacketLength). Ohne erwartete Antwort liest DNX_receive() den Bus
+ * 			nicht, das Echo wird daher auch vor jedem Senden verworfen.
+ *
+ * \param	usart_data	Servo-USART
+ */
+void DNX_dropEcho(USART_data_t* const usart_data) {
+	while (USART_RXBufferData_Available(usart_data)
+			&& usart_data->lastPacketLength > 0) {
+		usart_data->lastPacketLength--;
+		USART_RXBuffer_GetByte(usart_data);
+	}
+}
+
 /**
  * \brief	Versenden von Daten an Dynamixel.
  *
- * 			Blockierendes Senden mit gleichzeitigem Empfangen der Antwort.
+ * 			Blockierendes Senden mit gleichzeitigem Empfangen der Antwort. Ein
+ * 			einzelner Servo wird über DNX_submit() und DNX_run() angesprochen,
+ * 			bereits wartende Transaktionen laufen dabei mit. Auf die Antwort wird
+ * 			nur gewartet, wenn der Servo nach seinem Status Return Level
+ * 			antwortet (DNX_expectsReply()).
  *
  * \param	packet	Zuversendendes Paket
  * \param	l	Größe des Pakets
- * \param	result	Zielfeld für Antowort
+ * \param	result	Zielfeld für Antowort, NULL für einen Puffer aus PKT_RX
  * \param	hasResponse	Wartet auf eine Antwort, wenn true
  *
  * \return Größe der empfangenen Antwort
  */
 DT_byte DNX_send(DT_byte* const packet, DT_size l, DT_byte* const result,
 		DT_bool hasResponse) {
-	packet[l - 1] = DNX_getChecksum(packet, l);
-	USART_data_t* usart_data;
 	DT_byte len = 0;
 	// packet[2] -> ID
 	if (packet[2] == DNX_BRDCAST_ID) {
-		XM_USART_send(&XM_servo_data_R, packet, l);
-		XM_USART_send(&XM_servo_data_L, packet, l);
+		packet[l - 1] = DNX_getChecksum(packet, l);
+		DNX_transmit(&XM_servo_data_R, packet, l);
+		DNX_transmit(&XM_servo_data_L, packet, l);
 	} else {
-		if ((packet[2] - 1) % 6 < 3) // Right: 1 - 3, 7 - 9, ...
-			usart_data = &XM_servo_data_R;
-		else
-			// Left:  4 - 6, ...
-			usart_data = &XM_servo_data_L;
-
-		XM_USART_send(usart_data, packet, l);
-
-		DT_size timeout = hasResponse ? 100 : 0;
-		while (len == 0 && timeout > 0) {
-			len = DNX_receive(usart_data, result);
-			timeout--;
+		DT_dnxRequest request;
+		request.packet = packet;
+		request.length = l;
+		request.hasResponse = hasResponse;
+		request.result = result;
+		if (DNX_submit(&request)) {
+			DNX_run();
+			len = request.received;
 		}
 	}
 	return len;
 }
 
+DT_dnxBus* DNX_getBus(DT_byte id) {
+	if ((id - 1) % 6 < 3) // Right: 1 - 3, 7 - 9, ...
+		return &DNX_bus[0];
+	else
+		// Left:  4 - 6, ...
+		return &DNX_bus[1];
+}
+
 /**
- * \brief	Konvertiert Winkel in Bezug auf einen neuen Nullpunkt.
+ * \brief	Stellt eine Transaktion mit einem Servo in die Warteschlange seines Busses.
  *
- * \param	value	Winkel in Grad
+ * 			Gesendet wird erst in DNX_run(). hasResponse wird gelöscht, wenn der
+ * 			Servo nach seinem Status Return Level nicht antwortet.
+ *
+ * \param	request	Transaktion, kein Broadcast
+ *
+ * \return	false, wenn die Warteschlange voll ist
+ */
+DT_bool DNX_submit(DT_dnxRequest* const request) {
+	DT_dnxBus* const bus = DNX_getBus(request->packet[2]);
+
+	if (request->packet[2] == DNX_BRDCAST_ID || bus->count >= DNX_QUEUE_SIZE)
+		return false;
+	request->hasResponse = request->hasResponse && DNX_expectsReply(
+			request->packet[2], request->packet[4]);
+	request->received = 0;
+	request->error = 0;
+	request->value = 0;
+	bus->queue[(bus->head + bus->count) % DNX_QUEUE_SIZE] = request;
+	bus->count++;
+	if (bus->count > bus->stats.maxDepth)
+		bus->stats.maxDepth = bus->count;
+	return true;
+}
+
+/**
+ * \brief	Sendet wartende Transaktionen eines Busses, bis eine Antwort aussteht.
  *
- * \return	Konvertierter Winkel in Grad
+ * \param	bus	Bus
+ * \param	scratch	Gemeinsamer Antwortpuffer aus PKT_RX, wird bei Bedarf geholt
  */
-DT_double DNX_convertAngle(DT_double value) {
-	value += 150;
-	if (value >= 360)
-		value -= 360;
-	return value;
+void DNX_start(DT_dnxBus* const bus, DT_byte** const scratch) {
+	while (bus->active == NULL && bus->count > 0) {
+		DT_dnxRequest* const request = bus->queue[bus->head];
+		bus->head = (bus->head + 1) % DNX_QUEUE_SIZE;
+		bus->count--;
+
+		request->packet[request->length - 1] = DNX_getChecksum(request->packet,
+				request->length);
+		DNX_transmit(bus->usart_data, request->packet, request->length);
+		bus->stats.transactions++;
+		if (DNX_bus[0].active != NULL || DNX_bus[1].active != NULL)
+			bus->stats.overlapped++;
+		if (request->hasResponse && request->result == NULL && *scratch
+				== NULL)
+			*scratch = PKT_acquire(PKT_RX);
+		// ohne Antwortpuffer wird wie ohne Antwort nicht gewartet
+		if (request->hasResponse && (request->result != NULL || *scratch
+				!= NULL)) {
+			bus->active = request;
+			bus->timeout = DNX_TIMEOUT;
+			bus->start_us = XM_getUptimeUs();
+		}
+	}
 }
 
 /**
- * \brief	Korrigiert Winkel für Dynamixel.
+ * \brief	Fragt die ausstehende Antwort eines Busses einmal ab.
  *
- * 			Korrigiert Winkel für Dynamixel um hardwareseitige Veränderungen auszuschließen.
+ * 			Eine Antwort eines anderen Servos (z.B. nach einem Timeout verspätet)
+ * 			wird verworfen.
  *
- * \param	id	ID des Servos
- * \param	value	Winkel in Grad
+ * \param	bus	Bus
+ * \param	dest	Antwortfeld, falls die Transaktion keines hat
  *
- * \return	Korrigierter Winkel in Grad
- */
-DT_double DNX_correctAngles(DT_byte id, DT_double value) {
-	switch ((id - 1) % 6) {
-	case 0:
-		value = 360 - value;
-		break;
-	case 1:
-		// value = value;
-		break;
-	case 2:
-		value = 360 - value;
-		break;
-	case 3:
-		value = 360 - value;
-		break;
-	case 4:
-		value = 360 - value;
-		break;
-	case 5:
-		// value = value;
-		break;
+ * \return	true, wenn die Transaktion beendet ist
+ */
+DT_bool DNX_poll(DT_dnxBus* const bus, DT_byte* const dest) {
+	DT_dnxRequest* const request = bus->active;
+	DT_byte* const reply = request->result != NULL ? request->result : dest;
+	const DT_byte len = DNX_receive(bus->usart_data, reply);
+
+	if (len > 0 && reply[2] == request->packet[2]) {
+		const uint32_t us = XM_getUptimeUs() - bus->start_us;
+		request->received = len;
+		request->error = reply[4];
+		DNX_parseError(reply[2], reply[4]);
+		request->value = len > 6 ? reply[5] : 0;
+		if (len > 7)
+			request->value |= reply[6] << 8;
+		bus->stats.last_us = us;
+		bus->stats.sum_us += us;
+		if (us > bus->stats.max_us)
+			bus->stats.max_us = us;
+	} else if (--bus->timeout > 0)
+		return false;
+	else
+		bus->stats.timeouts++;
+	bus->active = NULL;
+	return true;
+}
+
+/**
+ * \brief	Führt alle wartenden Transaktionen beider Busse aus.
+ *
+ * 			Je Bus steht höchstens eine Antwort aus. Beide Busse werden
+ * 			abwechselnd abgefragt, d.h. das Paket am einen Bus wird gesendet,
+ * 			während die Antwort am anderen noch läuft. Kehrt zurück, wenn alle
+ * 			Transaktionen beantwortet oder abgelaufen sind (DNX_TIMEOUT Abfragen).
+ */
+void DNX_run() {
+	DT_byte* scratch = NULL;
+	DT_bool pending;
+	DT_byte i;
+
+	PRF_BEGIN(PRF_DNX_WAIT)
+	do {
+		pending = false;
+		for (i = 0; i < 2; i++)
+			DNX_start(&DNX_bus[i], &scratch);
+		for (i = 0; i < 2; i++) {
+			if (DNX_bus[i].active != NULL && DNX_poll(&DNX_bus[i], scratch))
+				DNX_start(&DNX_bus[i], &scratch);
+			pending |= DNX_bus[i].active != NULL || DNX_bus[i].count > 0;
+		}
+	} while (pending);
+	PRF_END(PRF_DNX_WAIT)
+	PKT_release(scratch);
+}
+
+/**
+ * \brief	Liefert die Zähler des Ablaufs eines Servo-Busses.
+ *
+ * \param	usart_data	XM_servo_data_R oder XM_servo_data_L
+ */
+const DT_dnxBusStats* DNX_getBusStats(const USART_data_t* const usart_data) {
+	return &DNX_bus[usart_data == &XM_servo_data_R ? 0 : 1].stats;
+}
+
+/**
+ * \brief	Setzt die Zähler des Ablaufs beider Busse zurück.
+ */
+void DNX_resetBusStats() {
+	DT_byte i;
+	for (i = 0; i < 2; i++) {
+		DNX_bus[i].stats.transactions = 0;
+		DNX_bus[i].stats.timeouts = 0;
+		DNX_bus[i].stats.overlapped = 0;
+		DNX_bus[i].stats.maxDepth = 0;
+		DNX_bus[i].stats.last_us = 0;
+		DNX_bus[i].stats.max_us = 0;
+		DNX_bus[i].stats.sum_us = 0;
 	}
-	return value;
 }
 
 /**
- * \brief	Sendet einen Winkel an Servo.
+ * \brief	Liefert die kleinste ID einer Bitmaske.
+ *
+ * \return	ID oder 0, wenn die Maske leer ist
+ */
+DT_byte DNX_lowestId(uint32_t ids) {
+	DT_byte id;
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		if (ids >> id & 1)
+			return id;
+	return 0;
+}
+
+/**
+ * \brief	Führt für alle Servos einer Bitmaske je eine Transaktion aus, beide Busse gleichzeitig.
+ *
+ * 			In jeder Runde wird je Bus ein Paket gesendet (DNX_run()), die
+ * 			Antworten laufen gleichzeitig ein.
+ *
+ * \param	ids	Bitmaske (Bit i für ID i)
+ * \param	build	Schreibt das Paket für eine ID, liefert seine Größe
+ * \param	expected	erwarteter Parameter der Antworten
+ * \param	differs	Bitmaske der Antworten mit Parameter ungleich expected oder NULL
+ *
+ * \return	Bitmaske der Servos, die das Paket angenommen haben (DNX_accepted())
+ */
+uint32_t DNX_runPairs(uint32_t ids, DT_size(*build)(DT_byte* const, DT_byte),
+		DT_byte expected, uint32_t* const differs) {
+	DT_dnxRequest requests[2];
+	DT_byte* const packets[2] = { PKT_acquire(PKT_TX), PKT_acquire(PKT_TX) };
+	uint32_t answered = 0;
+	DT_byte pair[2], i;
+
+	if (differs != NULL)
+		*differs = 0;
+	ids &= DNX_ALL_IDS;
+	while (ids != 0 && packets[0] != NULL && packets[1] != NULL) {
+		for (i = 0; i < 2; i++) {
+			pair[i] = DNX_lowestId(ids & (i == 0 ? DNX_RIGHT_IDS
+					: ~DNX_RIGHT_IDS));
+			if (pair[i] == 0)
+				continue;
+			ids &= ~((uint32_t) 1 << pair[i]);
+			requests[i].packet = packets[i];
+			requests[i].length = build(packets[i], pair[i]);
+			requests[i].hasResponse = true;
+			requests[i].result = NULL;
+			DNX_submit(&requests[i]);
+		}
+		DNX_run();
+		for (i = 0; i < 2; i++) {
+			if (pair[i] == 0 || !DNX_accepted(&requests[i]))
+				continue;
+			answered |= (uint32_t) 1 << pair[i];
+			if (differs != NULL && requests[i].value != expected)
+				*differs |= (uint32_t) 1 << pair[i];
+		}
+	}
+	PKT_release(packets[1]);
+	PKT_release(packets[0]);
+	return answered;
+}
+
+/**
+ * \brief	Sendet ein fertiges Paket an einem Bus (ohne Antwort).
+ *
+ * \param	usart_data	Servo-USART
+ * \param	packet	Paket mit Checksum
+ * \param	l	Größe des Pakets
+ */
+void DNX_transmit(USART_data_t* const usart_data, const DT_byte* const packet,
+		DT_size l) {
+	DNX_dropEcho(usart_data);
+	XM_USART_send(usart_data, packet, l);
+	CAP_frame(usart_data, true, packet, l);
+	TRC_EVENT(TRC_SERVO_SENT, packet[2])
+}
+
+/**
+ * \brief	Prüft, ob ein Servo ein Paket angenommen hat.
+ *
+ * 			Ohne erwartete Antwort (Status Return Level) gilt ein gesendetes Paket
+ * 			als angenommen, sonst muss die Antwort ohne DNX_ERR_REJECTED kommen.
+ *
+ * \param	request	ausgeführte Transaktion (DNX_run())
+ */
+DT_bool DNX_accepted(const DT_dnxRequest* const request) {
+	return !request->hasResponse || (request->received > 0 && !(request->error
+			& DNX_ERR_REJECTED));
+}
+
+/**
+ * \brief	Sendet ein Schreibpaket (WRITE, REG_WRITE) an einen Servo.
+ *
+ * \param	packet	Paket, die Checksum wird beim Senden gesetzt
+ * \param	l	Größe des Pakets
+ *
+ * \return	true, wenn der Servo das Paket angenommen hat, bei Broadcast immer
+ */
+DT_bool DNX_write(DT_byte* const packet, DT_size l) {
+	DT_dnxRequest request;
+
+	if (packet[2] == DNX_BRDCAST_ID) {
+		DNX_send(packet, l, NULL, false);
+		return true;
+	}
+	request.packet = packet;
+	request.length = l;
+	request.hasResponse = true;
+	request.result = NULL;
+	if (!DNX_submit(&request))
+		return false;
+	DNX_run();
+	return DNX_accepted(&request);
+}
+
+/**
+ * \brief	Schreibt ein Byte in die Control Table eines Servos.
+ *
+ * \param	id	ID des Servos oder DNX_BRDCAST_ID
+ * \param	addr	Adresse in der Control Table
+ * \param	value	Wert
+ *
+ * \return	true, wenn der Servo das Paket angenommen hat
+ */
+DT_bool DNX_writeByte(DT_byte id, DT_byte addr, DT_byte value) {
+	DT_bool ok;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return false;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = id;
+	packet[3] = 4; // length
+	packet[4] = DNX_WR_DATA;
+	packet[5] = addr;
+	packet[6] = value;
+	// packet[7] = checksum will set in send
+	ok = DNX_write(packet, 8);
+	PKT_release(packet);
+	return ok;
+}
+
+/**
+ * \brief	Übernimmt direkt gesendete Werte in das Abbild.
+ *
+ * 			Ohne Antwort des Servos oder bei einem Broadcast ist der Inhalt des
+ * 			Servos unbekannt und der nächste Wert aus DNX_stage() wird gesendet.
  *
  * \param	id	ID des Servos
- * \param	value	Winkel in Grad
- * \param	regWrite	Winkel wird in Puffer des Servos gespeichert und erst bei ACTION angefahren, wenn true
+ * \param	ticks	gesendete Zielposition
+ * \param	speed	gesendete Anfahrgeschwindigkeit oder DNX_SPEED_KEEP
+ * \param	ok	Servo hat das Paket angenommen (DNX_accepted())
  */
-DT_bool DNX_setAngle(DT_byte id, DT_double value, DT_bool regWrite) {
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	DT_size len = 9;
-	DT_byte packet[len];
+void DNX_record(DT_byte id, uint16_t ticks, uint16_t speed, DT_bool ok) {
+	const uint32_t bit = (uint32_t) 1 << id;
 
-	value = DNX_correctAngles(id, value);
-	value = DNX_convertAngle(value);
+	if (!ok || id == 0 || id > DNX_MAX_ID) {
+		DNX_invalidate(id);
+		return;
+	}
+	DNX_goal[id] = ticks;
+	DNX_goalKnown |= bit;
+	DNX_dirty &= ~bit;
+	if (speed != DNX_SPEED_KEEP) {
+		DNX_speed[id] = speed;
+		DNX_speedKnown |= bit;
+		DNX_speedDirty &= ~bit;
+	}
+}
 
-	// TODO Rechnung prüfen
-	DT_int tmp = floor(3.41 * ((double) value));
-	DT_byte angle_l = tmp & 0xFF;
-	DT_byte angle_h = tmp >> 8;
+/**
+ * \brief	Schreibt das Paket für Zielposition und ggf. Anfahrgeschwindigkeit.
+ *
+ * \param	packet	Ziel
+ * \param	id	ID des Servos
+ * \param	ticks	Zielposition in Ticks
+ * \param	speed	Anfahrgeschwindigkeit oder DNX_SPEED_KEEP
+ * \param	regWrite	REG_WRITE statt WRITE
+ *
+ * \return	Größe des Pakets mit Checksum
+ */
+DT_size DNX_goalPacket(DT_byte* const packet, DT_byte id, uint16_t ticks,
+		uint16_t speed, DT_bool regWrite) {
+	DT_size len = 9;
 
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = id;
+	packet[4] = regWrite ? DNX_REG_WR : DNX_WR_DATA;
+	packet[5] = DNX_GL_POS;
+	packet[6] = ticks & 0xFF; // Low
+	packet[7] = ticks >> 8; // High
+	if (speed != DNX_SPEED_KEEP) {
+		packet[8] = speed & 0xFF;
+		packet[9] = speed >> 8;
+		len = 11;
+	}
 	packet[3] = len - 4; // length
-	packet[4] = regWrite ? REG_WR : WR_DATA;
-	packet[5] = GL_POS;
-	packet[6] = angle_l; // Low
-	packet[7] = angle_h; // High
-	// packet[8] = checksum will set in send
-	len = DNX_send(packet, len, result, true);
-	// TODO status pruefen
-	if (len > 0)
-		return true;
-	else
+	// packet[len - 1] = checksum will set in send
+	return len;
+}
+
+/**
+ * \brief	Sendet eine Zielposition an einen Servo.
+ *
+ * \param	id	ID des Servos
+ * \param	ticks	Zielposition in Ticks (CAL_toTicks())
+ * \param	regWrite	Position wird in Puffer des Servos gespeichert und erst bei ACTION angefahren, wenn true
+ *
+ * \return	true, wenn der Servo das Paket angenommen hat (DNX_accepted())
+ */
+DT_bool DNX_setTicks(DT_byte id, uint16_t ticks, DT_bool regWrite) {
+	DT_bool ok;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
 		return false;
+
+	ok = DNX_write(packet, DNX_goalPacket(packet, id, ticks, DNX_SPEED_KEEP,
+			regWrite));
+	PKT_release(packet);
+	DNX_record(id, ticks, DNX_SPEED_KEEP, ok);
+	return ok;
+}
+
+/**
+ * \brief	Sendet Zielposition und Speed an einen Servo.
+ *
+ * \param	id	ID des Servos
+ * \param	ticks	Zielposition in Ticks (CAL_toTicks())
+ * \param	speed	Anfahrgeschwindigkeit
+ * \param	regWrite	Werte werden in Puffer des Servos gespeichert und erst bei ACTION ausgeführt, wenn true
+ *
+ * \return	true, wenn der Servo das Paket angenommen hat (DNX_accepted())
+ */
+DT_bool DNX_setTicksAndSpeed(DT_byte id, uint16_t ticks, uint16_t speed,
+		DT_bool regWrite) {
+	DT_bool ok;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return false;
+
+	ok = DNX_write(packet, DNX_goalPacket(packet, id, ticks, speed, regWrite));
+	PKT_release(packet);
+	DNX_record(id, ticks, speed, ok);
+	return ok;
+}
+
+/**
+ * \brief	Sendet einen Winkel an Servo.
+ *
+ * 			Die Zielposition wird mit der Kalibrierung des Servos berechnet
+ * 			(CAL_degToTicks()).
+ *
+ * \param	id	ID des Servos
+ * \param	value	Winkel in Grad
+ * \param	regWrite	Winkel wird in Puffer des Servos gespeichert und erst bei ACTION angefahren, wenn true
+ */
+DT_bool DNX_setAngle(DT_byte id, DT_real value, DT_bool regWrite) {
+	uint16_t ticks;
+	PRF_BEGIN(PRF_DNX_PACKET)
+	ticks = CAL_degToTicks(id, value);
+	PRF_END(PRF_DNX_PACKET)
+	return DNX_setTicks(id, ticks, regWrite);
 }
 
 /**
@@ -252,39 +669,13 @@ DT_bool DNX_setAngle(DT_byte id, DT_double value, DT_bool regWrite) {
  * \param	speed	Anfahrgeschwindigkeit
  * \param	regWrite	Werte werden in Puffer des Servos gespeichert und erst bei ACTION ausgeführt, wenn true
  */
-DT_bool DNX_setAngleAndSpeed(DT_byte id, DT_double angle, DT_double speed,
+DT_bool DNX_setAngleAndSpeed(DT_byte id, DT_real angle, DT_real speed,
 		DT_bool regWrite) {
-
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	DT_size len = 11;
-	DT_byte packet[len];
-	angle = DNX_correctAngles(id, angle);
-	angle = DNX_convertAngle(angle);
-	//DEBUG(("SET_AuS",sizeof("SET_AuS")))
-	DT_int tmp = floor(3.41 * ((double) angle));
-	DT_byte angle_l = tmp & 0xFF;
-	DT_byte angle_h = tmp >> 8;
-	tmp = floor(speed);
-	DT_byte speed_l = tmp & 0xFF;
-	DT_byte speed_h = tmp >> 8;
-
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
-	packet[2] = id;
-	packet[3] = len - 4; // length
-	packet[4] = regWrite ? REG_WR : WR_DATA;
-	packet[5] = GL_POS;
-	packet[6] = angle_l; // Low
-	packet[7] = angle_h; // High
-	packet[8] = speed_l;
-	packet[9] = speed_h;
-	// packet[10] = checksum will set in send
-	len = DNX_send(packet, len, result, true);
-	// TODO status pruefen
-	if (len > 0)
-		return true;
-	else
-		return false;
+	uint16_t ticks;
+	PRF_BEGIN(PRF_DNX_PACKET)
+	ticks = CAL_degToTicks(id, angle);
+	PRF_END(PRF_DNX_PACKET)
+	return DNX_setTicksAndSpeed(id, ticks, (DT_int) floor(speed), regWrite);
 }
 
 /**
@@ -295,17 +686,19 @@ DT_bool DNX_setAngleAndSpeed(DT_byte id, DT_double angle, DT_double speed,
  */
 void DNX_setId(DT_byte idOld, DT_byte idNew) {
 	const DT_size len = 8;
-	DT_byte packet[8];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = idOld;
 	packet[3] = len - 4; // length
-	packet[4] = WR_DATA;
-	packet[5] = ID;
+	packet[4] = DNX_WR_DATA;
+	packet[5] = DNX_ID;
 	packet[6] = idNew;
 	// packet[7] = checksum will set in send
-	DNX_send(packet, len, result, true);
+	DNX_send(packet, len, NULL, true);
+	PKT_release(packet);
 
 }
 
@@ -318,18 +711,21 @@ void DNX_setId(DT_byte idOld, DT_byte idNew) {
 void DNX_setSpeed(DT_byte id, DT_byte speed) {
 	// TODO byte 7 richtige setzen
 	const DT_size len = 9;
-	DT_byte packet[len];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = id;
 	packet[3] = len - 4; // length
-	packet[4] = WR_DATA;
-	packet[5] = MV_SPEED;
+	packet[4] = DNX_WR_DATA;
+	packet[5] = DNX_MV_SPEED;
 	packet[6] = speed;
 	packet[7] = 0x00;
 	// packet[8] = checksum will set in send
-	DNX_send(packet, len, result, true);
+	DNX_send(packet, len, NULL, true);
+	PKT_release(packet);
+	DNX_invalidate(id);
 }
 
 /**
@@ -337,45 +733,88 @@ void DNX_setSpeed(DT_byte id, DT_byte speed) {
  *
  * \param	id	ID des Servos
  * \param	value	Wert für LED (0x00 / 0x01)
+ *
+ * \return	true, wenn der Servo das Paket angenommen hat (DNX_accepted())
  */
 DT_bool DNX_setLed(DT_byte id, DT_byte value) {
-	DT_size len = 8;
-	DT_byte packet[len];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
-	packet[2] = id;
-	packet[3] = len - 4; // length
-	packet[4] = WR_DATA;
-	packet[5] = LED;
-	packet[6] = value;
-	// packet[7] = checksum will set in send
-	len = DNX_send(packet, len, result, true);
-	// TODO status pruefen
-	if (len > 0) {
-		return true;
-	} else
-		return false;
+	return DNX_writeByte(id, DNX_LED, value);
 }
 
 /**
  * \brief	Sendet das ACTION-Kommando an einen Servo.
  *
- * 			Sendet das ACTION-Kommando an einen Servo.
+ * 			Sendet das ACTION-Kommando an einen Servo. Antwortet ein einzelner
+ * 			Servo (Status Return Level 2), wird die Antwort abgeholt, damit sie
+ * 			nicht als Antwort des nächsten Pakets gelesen wird.
  *
  * \param	id	ID des Servo
  */
 void DNX_sendAction(DT_byte id) {
 	DT_size len = 6;
-	DT_byte packet[len];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = id;
 	packet[3] = len - 4; // length
-	packet[4] = ACT;
+	packet[4] = DNX_ACT;
 	// packet[5] = checksum will set in send
-	DNX_send(packet, len, result, false);
+	DNX_send(packet, len, NULL, true);
+	PKT_release(packet);
+}
+
+/**
+ * \brief	Sendet ACTION als Broadcast an beide Busse ohne Puffer aus PKT_TX.
+ *
+ * 			Für den Aufruf aus der ISR von XM_setAlarm(): beide Pakete gehen
+ * 			direkt nacheinander mit XM_USART_trySend() hinaus, das Echo wird wie
+ * 			sonst beim nächsten Empfang verworfen. Ein Bus mit vollem TX-Puffer
+ * 			wird übersprungen, in der ISR wird nicht gewartet. Mitschnitt,
+ * 			Ereignisse und übersprungene Pakete folgen außerhalb der ISR mit
+ * 			DNX_logFiredAction(). Das Programm darf die Servo-Busse bis dahin
+ * 			nicht benutzen (MV_actionAt()).
+ */
+void DNX_fireAction() {
+	DT_byte buses = 0;
+
+	if (XM_USART_trySend(&XM_servo_data_R, DNX_actionPacket,
+			sizeof(DNX_actionPacket)))
+		buses |= DNX_BUS_R;
+	if (XM_USART_trySend(&XM_servo_data_L, DNX_actionPacket,
+			sizeof(DNX_actionPacket)))
+		buses |= DNX_BUS_L;
+	DNX_firedBuses = buses;
+	DNX_fired = true;
+}
+
+/**
+ * \brief	Schließt die ACTION von DNX_fireAction() ab (CAP_frame(), TRC_event()).
+ *
+ * 			Nach dem Aufruf aus der ISR im Hauptprogramm aufrufen. Ein in der ISR
+ * 			übersprungener Bus erhält die ACTION hier verspätet. Ohne Aufruf von
+ * 			DNX_fireAction() geschieht nichts.
+ */
+void DNX_logFiredAction() {
+	if (!DNX_fired)
+		return;
+	DNX_fired = false;
+	if (!(DNX_firedBuses & DNX_BUS_R)) {
+		DEBUG_P("dnx_act_late")
+		XM_USART_send(&XM_servo_data_R, DNX_actionPacket,
+				sizeof(DNX_actionPacket));
+	}
+	if (!(DNX_firedBuses & DNX_BUS_L)) {
+		DEBUG_P("dnx_act_late")
+		XM_USART_send(&XM_servo_data_L, DNX_actionPacket,
+				sizeof(DNX_actionPacket));
+	}
+	CAP_frame(&XM_servo_data_R, true, DNX_actionPacket,
+			sizeof(DNX_actionPacket));
+	TRC_EVENT(TRC_SERVO_SENT, DNX_BRDCAST_ID)
+	CAP_frame(&XM_servo_data_L, true, DNX_actionPacket,
+			sizeof(DNX_actionPacket));
+	TRC_EVENT(TRC_SERVO_SENT, DNX_BRDCAST_ID)
 }
 
 /**
@@ -385,19 +824,21 @@ void DNX_sendAction(DT_byte id) {
  *
  * \return Winkel in Grad
  */
-DT_double DNX_getAngle(DT_byte id) {
+DT_real DNX_getAngle(DT_byte id) {
 	DT_size len = 7;
-	DT_byte packet[len];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return -1;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = id;
 	packet[3] = len - 4; // length
-	packet[4] = RD_DATA;
-	packet[5] = PRT_POS;
+	packet[4] = DNX_RD_DATA;
+	packet[5] = DNX_PRT_POS;
 	// packet[6] = checksum will set in send
 	// TODO
-	len = DNX_send(packet, len, result, true);
+	len = DNX_send(packet, len, NULL, true);
+	PKT_release(packet);
 	return -1;
 }
 
@@ -410,17 +851,19 @@ DT_double DNX_getAngle(DT_byte id) {
  */
 DT_byte DNX_getSpeed(DT_byte id) {
 	DT_size len = 7;
-	DT_byte packet[len];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return 0x00;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = id;
 	packet[3] = len - 4; // length
-	packet[4] = RD_DATA;
-	packet[5] = PRT_SPEED;
+	packet[4] = DNX_RD_DATA;
+	packet[5] = DNX_PRT_SPEED;
 	// packet[6] = checksum will set in send
 	// TODO
-	len = DNX_send(packet, len, result, true);
+	len = DNX_send(packet, len, NULL, true);
+	PKT_release(packet);
 	return 0x00;
 }
 
@@ -433,33 +876,167 @@ DT_byte DNX_getSpeed(DT_byte id) {
  */
 DT_byte DNX_getLed(DT_byte id) {
 	DT_size len = 7;
-	DT_byte packet[len];
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-	packet[0] = START_BYTE;
-	packet[1] = START_BYTE;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return 0x00;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
 	packet[2] = id;
 	packet[3] = len - 4; // length
-	packet[4] = RD_DATA;
-	packet[5] = LED;
+	packet[4] = DNX_RD_DATA;
+	packet[5] = DNX_LED;
 	// packet[6] = checksum will set in send
 	// TODO
-	len = DNX_send(packet, len, result, true);
+	len = DNX_send(packet, len, NULL, true);
+	PKT_release(packet);
 	return 0x00;
 }
 
+/**
+ * \brief	Zählt die IDs einer Bitmaske.
+ *
+ * \param	ids	Bitmaske (Bit i für ID i)
+ *
+ * \return	Anzahl der gesetzten Bits 1 bis DNX_MAX_ID
+ */
+DT_byte DNX_countIds(uint32_t ids) {
+	DT_byte id, n = 0;
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		n += ids >> id & 1;
+	return n;
+}
+
+DT_byte DNX_getTopologyChecksum(const DT_byte* const data) {
+	return ~(data[0] + data[1] + data[2] + data[3]);
+}
+
+/**
+ * \brief	Prüft, ob ein Servo seine Zielposition noch anfährt.
+ *
+ * \param	id	ID des Servos
+ *
+ * \return	true, wenn der Servo in Bewegung ist oder nicht antwortet
+ */
+DT_bool DNX_isMoving(DT_byte id) {
+	return DNX_getMoving((uint32_t) 1 << id) != 0;
+}
+
+DT_size DNX_buildReadMoving(DT_byte* const packet, DT_byte id) {
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = id;
+	packet[3] = 4; // length
+	packet[4] = DNX_RD_DATA;
+	packet[5] = DNX_MOVING;
+	packet[6] = 1;
+	return 8;
+}
+
+/**
+ * \brief	Prüft für mehrere Servos, ob sie ihre Zielposition noch anfahren.
+ *
+ * 			Je Runde wird ein Servo jedes Busses abgefragt (DNX_runPairs()).
+ *
+ * \param	ids	Bitmaske (Bit i für ID i)
+ *
+ * \return	Bitmaske der Servos in Bewegung und der Servos ohne Antwort
+ */
+uint32_t DNX_getMoving(uint32_t ids) {
+	uint32_t moving;
+	const uint32_t answered = DNX_runPairs(ids, DNX_buildReadMoving, 0,
+			&moving);
+	return moving | (ids & DNX_ALL_IDS & ~answered);
+}
+
+/**
+ * \brief	Liest die zuletzt gefundenen Servos aus dem EEPROM.
+ *
+ * \return	Bitmaske (Bit i für ID i), 0 wenn keine gültige Liste abgelegt ist
+ */
+uint32_t DNX_readTopology() {
+	DT_byte data[DNX_TOPOLOGY_SIZE];
+	uint32_t ids;
+
+	XM_eepromRead(DNX_EEPROM_ADDR, data, DNX_TOPOLOGY_SIZE);
+	ids = (uint32_t) data[1] | (uint32_t) data[2] << 8 | (uint32_t) data[3]
+			<< 16;
+	if (data[0] != 'T' || data[4] != DNX_getTopologyChecksum(data) || (ids
+			& ~DNX_ALL_IDS) != 0)
+		return 0;
+	return ids;
+}
+
+/**
+ * \brief	Schreibt die gefundenen Servos in das EEPROM.
+ *
+ * \param	ids	Bitmaske (Bit i für ID i)
+ */
+void DNX_writeTopology(uint32_t ids) {
+	DT_byte data[DNX_TOPOLOGY_SIZE];
+
+	data[0] = 'T';
+	data[1] = ids;
+	data[2] = ids >> 8;
+	data[3] = ids >> 16;
+	data[4] = DNX_getTopologyChecksum(data);
+	XM_eepromWrite(DNX_EEPROM_ADDR, data, DNX_TOPOLOGY_SIZE);
+}
+
+DT_size DNX_buildPing(DT_byte* const packet, DT_byte id) {
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = id;
+	packet[3] = 2; // length
+	packet[4] = DNX_PING;
+	return 6;
+}
+
+/**
+ * \brief	Sendet PING an alle Servos einer Bitmaske, beide Busse gleichzeitig.
+ *
+ * \param	ids	Bitmaske (Bit i für ID i)
+ *
+ * \return	Bitmaske der Servos, die geantwortet haben
+ */
+uint32_t DNX_ping(uint32_t ids) {
+	return DNX_runPairs(ids, DNX_buildPing, 0, NULL);
+}
+
 /**
  * \brief	Ermittlung der angeschlossenen Dynamixel.
  *
+ * 			Prüft die im EEPROM abgelegten Servos des letzten Starts (DNX_ping(),
+ * 			beide Busse gleichzeitig), wenn die Liste mindestens DNX_CPU_SERVOS
+ * 			Servos enthält. Antworten nicht alle, ist die Liste unvollständig oder
+ * 			ist keine abgelegt, werden alle IDs abgefragt und die Liste im EEPROM erneuert. Ein zusätzlicher Servo an
+ * 			einem vollständigen Controller wird daher erst erkannt, wenn einer der
+ * 			bekannten fehlt. Zum Schluss werden die LEDs
+ * 			aller Servos mit einem Broadcast eingeschaltet und Status Return Level
+ * 			(DNX_STATUS_LEVEL) und Return Delay Time (DNX_RETURN_DELAY) geprüft
+ * 			(DNX_applyStatusLevel()).
+ *
  * \param	leg_r	Bein rechts
  * \param	leg_l	Bein links
  */
 void DNX_getConnectedIDs(DT_leg* const leg_r, DT_leg* const leg_l) {
+	const uint32_t cached = DNX_readTopology();
+	uint32_t ids = 0;
 	DT_byte id;
-	DT_bool ans;
 
-	for (id = 1; id <= 18; id++) {
-		ans = DNX_setLed(id, 0x01);
-		if (ans) {
+	DNX_invalidate(DNX_BRDCAST_ID);
+	if (DNX_countIds(cached) >= DNX_CPU_SERVOS)
+		ids = DNX_ping(cached);
+	if (ids != cached || cached == 0) {
+		DEBUG_P("DNX_scan")
+		ids = DNX_ping(DNX_ALL_IDS);
+	}
+	if (ids != cached)
+		DNX_writeTopology(ids);
+	DNX_setLed(DNX_BRDCAST_ID, 0x01);
+	DNX_applyStatusLevel(ids, DNX_STATUS_LEVEL);
+
+	for (id = 1; id <= DNX_MAX_ID; id++) {
+		if (ids >> id & 1) {
 			if ((id - 1) % 6 < 3) { // Right: 1 - 3, 7 - 9, ...
 				if ((id - 1) % 3 == 0) {
 					leg_r->hip.id = id;
@@ -485,3 +1062,316 @@ void DNX_getConnectedIDs(DT_leg* const leg_r, DT_leg* const leg_l) {
 		}
 	}
 }
+
+/**
+ * \brief	Merkt Zielposition und Anfahrgeschwindigkeit eines Servos vor.
+ *
+ * 			Gesendet wird erst mit DNX_flush() und nur, wenn sich ein Wert
+ * 			gegenüber dem zuletzt gesendeten unterscheidet. Unveränderte Werte
+ * 			werden in DNX_getStats() als übersprungen gezählt.
+ *
+ * \param	id	ID des Servos (1 - DNX_MAX_ID)
+ * \param	ticks	Zielposition in Ticks (CAL_toTicks())
+ * \param	speed	Anfahrgeschwindigkeit oder DNX_SPEED_KEEP
+ */
+void DNX_stage(DT_byte id, uint16_t ticks, uint16_t speed) {
+	const uint32_t bit = (uint32_t) 1 << id;
+
+	if (id == 0 || id > DNX_MAX_ID)
+		return;
+	DNX_stats.staged++;
+	if (!(DNX_goalKnown & bit) || DNX_goal[id] != ticks) {
+		DNX_goal[id] = ticks;
+		DNX_goalKnown |= bit;
+		DNX_dirty |= bit;
+	}
+	if (speed != DNX_SPEED_KEEP && (!(DNX_speedKnown & bit) || DNX_speed[id]
+			!= speed)) {
+		DNX_speed[id] = speed;
+		DNX_speedKnown |= bit;
+		DNX_speedDirty |= bit;
+		DNX_dirty |= bit;
+	}
+	if (!(DNX_dirty & bit))
+		DNX_stats.skipped++;
+}
+
+/**
+ * \brief	Sendet vorgemerkte Werte mehrerer Servos eines Busses als SYNC_WRITE.
+ *
+ * \param	usart_data	Servo-USART
+ * \param	ids	Bitmaske der Servos an diesem Bus
+ * \param	withSpeed	Zielposition und Anfahrgeschwindigkeit, sonst nur Zielposition
+ *
+ * \return	Anzahl der gesendeten Pakete (0 oder 1)
+ */
+DT_byte DNX_syncWrite(USART_data_t* const usart_data, uint32_t ids,
+		DT_bool withSpeed) {
+	DT_size l = 7;
+	DT_byte id;
+
+	if (ids == 0)
+		return 0;
+	DT_byte* const packet = PKT_acquire(PKT_TX);
+	if (packet == NULL)
+		return 0;
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = DNX_BRDCAST_ID;
+	packet[4] = DNX_SYC_WR;
+	packet[5] = DNX_GL_POS;
+	packet[6] = withSpeed ? 4 : 2; // Datenbytes je Servo
+	for (id = 1; id <= DNX_MAX_ID; id++) {
+		if (!(ids >> id & 1))
+			continue;
+		packet[l++] = id;
+		packet[l++] = DNX_goal[id] & 0xFF;
+		packet[l++] = DNX_goal[id] >> 8;
+		if (withSpeed) {
+			packet[l++] = DNX_speed[id] & 0xFF;
+			packet[l++] = DNX_speed[id] >> 8;
+		}
+	}
+	l++; // checksum
+	packet[3] = l - 4; // length
+	packet[l - 1] = DNX_getChecksum(packet, l);
+	DNX_transmit(usart_data, packet, l);
+	PKT_release(packet);
+	DNX_dirty &= ~ids;
+	DNX_speedDirty &= ~ids;
+	return 1;
+}
+
+DT_size DNX_buildStaged(DT_byte* const packet, DT_byte id) {
+	return DNX_goalPacket(packet, id, DNX_goal[id], (DNX_speedDirty >> id & 1)
+			? DNX_speed[id] : DNX_SPEED_KEEP, true);
+}
+
+/**
+ * \brief	Sendet alle mit DNX_stage() vorgemerkten und geänderten Werte.
+ *
+ * 			Ohne regWrite werden die geänderten Servos je Bus in einem
+ * 			SYNC_WRITE zusammengefasst, das die Servos sofort ausführen (ein
+ * 			zweites, falls nur ein Teil davon eine bekannte Geschwindigkeit hat).
+ * 			SYNC_WRITE kann nicht bis zum ACTION gespeichert werden, mit regWrite
+ * 			bekommt daher jeder geänderte Servo ein eigenes REG_WRITE, je ein
+ * 			Servo beider Busse gleichzeitig (DNX_runPairs()).
+ *
+ * \param	regWrite	Werte werden in Puffer des Servos gespeichert und erst bei ACTION ausgeführt, wenn true
+ *
+ * \return	Anzahl der gesendeten Pakete
+ */
+DT_byte DNX_flush(DT_bool regWrite) {
+	DT_byte frames = 0;
+	DT_byte id, bus;
+
+	if (regWrite) {
+		const uint32_t dirty = DNX_dirty;
+		const uint32_t accepted = DNX_runPairs(dirty, DNX_buildStaged, 0,
+				NULL);
+		for (id = 1; id <= DNX_MAX_ID; id++) {
+			if (!(dirty >> id & 1))
+				continue;
+			DNX_record(id, DNX_goal[id], (DNX_speedDirty >> id & 1)
+					? DNX_speed[id] : DNX_SPEED_KEEP, accepted >> id & 1);
+			frames++;
+		}
+	} else {
+		for (bus = 0; bus < 2; bus++) {
+			uint32_t ids = DNX_dirty & (bus == 0 ? DNX_RIGHT_IDS : ~DNX_RIGHT_IDS);
+			USART_data_t* const usart_data = bus == 0 ? &XM_servo_data_R
+					: &XM_servo_data_L;
+			if (ids & DNX_speedDirty) {
+				const uint32_t withSpeed = ids & DNX_speedKnown;
+				frames += DNX_syncWrite(usart_data, withSpeed, true);
+				ids &= ~withSpeed;
+			}
+			frames += DNX_syncWrite(usart_data, ids, false);
+		}
+	}
+	DNX_stats.frames += frames;
+	return frames;
+}
+
+/**
+ * \brief	Verwirft das Abbild eines Servos.
+ *
+ * 			Der nächste Wert aus DNX_stage() wird in jedem Fall gesendet, z.B.
+ * 			nachdem der Servo neu gestartet wurde.
+ *
+ * \param	id	ID des Servos, DNX_BRDCAST_ID für alle
+ */
+void DNX_invalidate(DT_byte id) {
+	const uint32_t bit = id == DNX_BRDCAST_ID ? DNX_ALL_IDS : (uint32_t) 1
+			<< id;
+	if (id != DNX_BRDCAST_ID && id > DNX_MAX_ID)
+		return;
+	DNX_goalKnown &= ~bit;
+	DNX_speedKnown &= ~bit;
+	DNX_dirty &= ~bit;
+	DNX_speedDirty &= ~bit;
+}
+
+/**
+ * \brief	Liefert die Zähler von DNX_stage() und DNX_flush().
+ */
+const DT_dnxStats* DNX_getStats() {
+	return &DNX_stats;
+}
+
+/**
+ * \brief	Setzt die Zähler von DNX_stage() und DNX_flush() zurück.
+ */
+void DNX_resetStats() {
+	DNX_stats.staged = 0;
+	DNX_stats.skipped = 0;
+	DNX_stats.frames = 0;
+}
+
+/**
+ * \brief	Setzt den Status Return Level eines Servos.
+ *
+ * 			Der Wert liegt im EEPROM des Servos. Die Return Delay Time setzt nur
+ * 			der Start (DNX_applyStatusLevel()), wenn sie abweicht. Der Level wird
+ * 			je Servo gemerkt, damit DNX_submit() nur auf Antworten wartet, die
+ * 			der Servo sendet.
+ *
+ * \param	id	ID des Servos, DNX_BRDCAST_ID für alle
+ * \param	level	0: nur PING, 1: zusätzlich READ, 2: jede Instruktion wird beantwortet
+ */
+void DNX_setStatusLevel(DT_byte id, DT_byte level) {
+	DNX_writeByte(id, DNX_STS_RT_LVL, level);
+	if (id == DNX_BRDCAST_ID) {
+		for (id = 1; id <= DNX_MAX_ID; id++)
+			DNX_level[id] = level;
+		DNX_levelKnown = DNX_ALL_IDS;
+	} else if (id >= 1 && id <= DNX_MAX_ID) {
+		DNX_level[id] = level;
+		DNX_levelKnown |= (uint32_t) 1 << id;
+	}
+}
+
+DT_size DNX_buildReadDelay(DT_byte* const packet, DT_byte id) {
+	DNX_buildReadMoving(packet, id);
+	packet[5] = DNX_RT_DLY;
+	return 8;
+}
+
+DT_size DNX_buildReadLevel(DT_byte* const packet, DT_byte id) {
+	DNX_buildReadMoving(packet, id);
+	packet[5] = DNX_STS_RT_LVL;
+	return 8;
+}
+
+/**
+ * \brief	Setzt Status Return Level und Return Delay Time nur, wo sie abweichen.
+ *
+ * 			Liest beide Werte, je ein Servo beider Busse gleichzeitig
+ * 			(DNX_runPairs()), und schreibt nur abweichende Werte oder Werte von
+ * 			Servos ohne Antwort. So wird das EEPROM der Servos nicht bei jedem
+ * 			Start beschrieben.
+ *
+ * \param	ids	Bitmaske (Bit i für ID i)
+ * \param	level	Status Return Level wie in DNX_setStatusLevel()
+ */
+void DNX_applyStatusLevel(uint32_t ids, DT_byte level) {
+	uint32_t delay, wrong, answered;
+	DT_byte id;
+
+	ids &= DNX_ALL_IDS;
+	answered = DNX_runPairs(ids, DNX_buildReadDelay, DNX_RETURN_DELAY, &delay);
+	delay |= ids & ~answered;
+	answered = DNX_runPairs(ids, DNX_buildReadLevel, level, &wrong);
+	wrong |= ids & ~answered;
+	DNX_levelKnown &= ~wrong; // Level bis zum WRITE unbekannt
+	for (id = 1; id <= DNX_MAX_ID; id++) {
+		if (delay >> id & 1)
+			DNX_writeByte(id, DNX_RT_DLY, DNX_RETURN_DELAY);
+		if (wrong >> id & 1)
+			DNX_writeByte(id, DNX_STS_RT_LVL, level);
+		if (ids >> id & 1) {
+			DNX_level[id] = level;
+			DNX_levelKnown |= (uint32_t) 1 << id;
+		}
+	}
+}
+
+/**
+ * \brief	Liefert den gemerkten Status Return Level eines Servos.
+ *
+ * \param	id	ID des Servos
+ *
+ * \return	Level aus DNX_setStatusLevel(), 2 (Werkseinstellung) für einen unbekannten Servo
+ */
+DT_byte DNX_getStatusLevel(DT_byte id) {
+	if (id >= 1 && id <= DNX_MAX_ID && (DNX_levelKnown >> id & 1))
+		return DNX_level[id];
+	return 2;
+}
+
+/**
+ * \brief	Prüft, ob ein Servo auf eine Instruktion antwortet.
+ *
+ * \param	id	ID des Servos
+ * \param	instruction	Instruktion (DNX_PING, DNX_RD_DATA, ...)
+ *
+ * \return	false für Broadcasts und nach dem Status Return Level nicht beantwortete Instruktionen
+ */
+DT_bool DNX_expectsReply(DT_byte id, DT_byte instruction) {
+	const DT_byte level = DNX_getStatusLevel(id);
+
+	if (id == DNX_BRDCAST_ID)
+		return false;
+	return instruction == DNX_PING || (instruction == DNX_RD_DATA && level >= 1)
+			|| level >= 2;
+}
+
+/**
+ * \brief	Wertet das Fehlerbyte einer Antwort aus.
+ *
+ * \param	id	ID des antwortenden Servos
+ * \param	error	Fehlerbyte (DNX_ERR_*)
+ */
+void DNX_parseError(DT_byte id, DT_byte error) {
+	DT_byte bit;
+
+	if (id <= DNX_MAX_ID)
+		DNX_error[id] = error;
+	if (error == 0)
+		return;
+	DEBUG_P("DNX_err")
+	for (bit = 0; bit < DNX_ERR_BITS; bit++)
+		if (error >> bit & 1)
+			DNX_errorCount[bit]++;
+}
+
+/**
+ * \brief	Liefert das Fehlerbyte der letzten Antwort eines Servos.
+ *
+ * \param	id	ID des Servos
+ *
+ * \return	DNX_ERR_* oder 0
+ */
+DT_byte DNX_getError(DT_byte id) {
+	return id <= DNX_MAX_ID ? DNX_error[id] : 0;
+}
+
+/**
+ * \brief	Liefert die Anzahl der Antworten mit einem Fehlerbit.
+ *
+ * \param	bit	Nummer des Bits (0 für DNX_ERR_VOLTAGE bis 6 für DNX_ERR_INSTRUCTION)
+ */
+uint16_t DNX_getErrorCount(DT_byte bit) {
+	return bit < DNX_ERR_BITS ? DNX_errorCount[bit] : 0;
+}
+
+/**
+ * \brief	Setzt Fehlerbytes und Fehlerzähler zurück.
+ */
+void DNX_resetErrors() {
+	DT_byte i;
+	for (i = 0; i <= DNX_MAX_ID; i++)
+		DNX_error[i] = 0;
+	for (i = 0; i < DNX_ERR_BITS; i++)
+		DNX_errorCount[i] = 0;
+}
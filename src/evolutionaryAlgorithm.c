@@ -9,6 +9,10 @@
 #include "include/datatypes.h"
 #include "include/evolutionaryHelper.h"
 #include "include/evolutionaryAlgorithm.h"
+#include "include/scoreGrid.h"
+#include "include/workspaceGrid.h"
+#include "include/profiler.h"
+#include "include/utils.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -18,60 +22,157 @@
 #define Y_MIN 42
 #define Y_MAX 129
 
+/**
+ * \def	EVO_PARENT_CNT
+ * \brief	Anzahl der Eltern pro Generation für evolutionaryAlgorithm().
+ *
+ * \def	EVO_SEED
+ * \brief	Startwert des Zufallszahlengenerators für evolutionaryAlgorithm().
+ *
+ * \def	EVO_MAX_TRIES
+ * \brief	Maximale Anzahl der Versuche für Rekombination und Mutation im Arbeitsraum.
+ */
+#define EVO_PARENT_CNT	10
+#define EVO_SEED		211
+#define EVO_MAX_TRIES	50
+
 // lokale Methoden
-void generatePopulation(DT_individuum * const , const DT_int);
+void generatePopulation(DT_evo* const);
 void printPopulation(DT_individuum*, DT_int);
-DT_point generatePoint(DT_int);
-DT_double getRandomNumber(DT_int, DT_int);
-void fitnessproportionalSelection(const DT_individuum * const , DT_int*,
-		const DT_int, const DT_int);
-void recombination(const DT_individuum const *, DT_individuum * const ,
-		const DT_int const *, const DT_int, const DT_int, const DT_double);
-void uniformCrossover(const DT_individuum const *, const DT_individuum const *,
-		DT_individuum *, DT_individuum *);
-void mutation(DT_individuum *, const DT_int, const DT_double);
-void gleichverteilte_reellwertige_mutation(DT_point *, const DT_double);
-void bestSelection(DT_individuum * const , DT_individuum *, const DT_int,
-		const DT_int);
-void getScores(DT_vector* const , DT_individuum* const , const DT_int);
+DT_point generatePoint(DT_rng* const);
+DT_int fitnessproportionalSelection(DT_evo* const);
+void recombination(DT_evo* const);
+void uniformCrossover(DT_rng* const, const DT_individuum* const,
+		const DT_individuum* const, DT_individuum*, DT_individuum*);
+void mutation(DT_evo* const, const DT_int);
+void gleichverteilte_reellwertige_mutation(DT_rng* const, DT_point *,
+		const DT_real);
+void bestSelection(DT_evo* const, const DT_int);
+void getScores(DT_evo* const, const DT_int);
 
+/**
+ * \brief	Evolutionärer Algorithmus zur Startpunktfindung.
+ *
+ * 			Berechnet mit den Standardparametern und festem Startwert des
+ * 			Zufallszahlengenerators das beste Individuum für die Richtung v.
+ *
+ * \param	popsize	Größe der Population (1 - EVO_MAX_POPSIZE)
+ * \param	generations	Anzahl der Generationen
+ * \param	v	Bewegungsrichtung
+ *
+ * \return	Bestes Individuum, F < 0 bei ungültiger popsize
+ */
 DT_individuum evolutionaryAlgorithm(const DT_int popsize,
 		const DT_int generations, DT_vector* const v) {
-	initEvoAlg();
+	DT_evo evo;
+	DT_individuum buffer[EVO_BUFFER_SIZE(EVO_MAX_POPSIZE, EVO_PARENT_CNT)];
+	DT_size index[EVO_MAX_POPSIZE];
+	DT_individuum I;
+	DT_int t;
+	if (popsize < 1 || popsize > EVO_MAX_POPSIZE) {
+		DEBUG_P("evo_popsize")
+		I.G.x = 0;
+		I.G.y = 0;
+		I.G.z = 0;
+		I.S = I.G;
+		I.F = -1;
+		return I;
+	}
+	PRF_BEGIN(PRF_PLANNER)
+	EVO_init(&evo, buffer, index, popsize, EVO_PARENT_CNT, EVO_SEED);
+	EVO_start(&evo, v);
+	for (t = 0; t < generations; t++)
+		EVO_generation(&evo);
+	PRF_END(PRF_PLANNER)
+	return EVO_best(&evo);
+}
+
+/**
+ * \brief	Initialisiert den Evolutionären Algorithmus.
+ *
+ * 			Setzt die Standardparameter (px = 1.0, pm = 0.2, smax = 10), die danach
+ * 			in der Struktur geändert werden können. Die Puffer werden vom Aufrufer
+ * 			bereitgestellt. buffer muss EVO_BUFFER_SIZE(popsize, parentCnt) Individuen
+ * 			fassen, index popsize Einträge.
+ *
+ * \param	evo	Zustand des Algorithmus
+ * \param	buffer	Puffer für beide Populationen
+ * \param	index	Puffer für die Selektion
+ * \param	popsize	Größe der Population
+ * \param	parentCnt	Anzahl der Eltern pro Generation
+ * \param	seed	Startwert des Zufallszahlengenerators
+ */
+void EVO_init(DT_evo* const evo, DT_individuum* const buffer,
+		DT_size* const index, const DT_int popsize, const DT_int parentCnt,
+		const uint32_t seed) {
+	evo->popsize = popsize;
+	evo->parentCnt = parentCnt;
 	// Rekombinationswahrscheinlichkeit
-	DT_double px = 1.0;
+	evo->px = 1.0;
 	// Mutationsrate
-	DT_double pm = 0.2;
+	evo->pm = 0.2;
+	// Maximale Schrittweite der Mutation
+	evo->smax = 10;
+	evo->P = buffer;
+	evo->P_nextGen = &buffer[popsize + 2 * parentCnt];
+	evo->index = index;
+	evo->generation = 0;
+	evo->evaluations = 0;
+	rngSeed(&evo->rng, seed);
+}
 
+/**
+ * \brief	Erzeugt und bewertet die Startpopulation für eine Richtung.
+ *
+ * \param	evo	Zustand des Algorithmus
+ * \param	v	Bewegungsrichtung
+ */
+void EVO_start(DT_evo* const evo, const DT_vector* const v) {
+	initEvoAlg();
 	// Drehen des Koordinatensystems
-	DT_vector v_inv;
-	v_inv.y = v->x;
-	v_inv.x = v->y;
-	// Anzahl der Eltern pro Generation
-	DT_int parentCnt = 10;
-	// Population
-	DT_individuum P[popsize];
+	evo->v.y = v->x;
+	evo->v.x = v->y;
+	evo->generation = 0;
 	// Initialisierung
-	generatePopulation(P, popsize);
+	generatePopulation(evo);
 	// Bewertung
-	getScores(&v_inv, P, popsize);
-	DT_int t = 0;
-	while (generations > t) {
-		// Index-Feld für Elternselektion
-		DT_int I[parentCnt];
-		// Fitnessproportionale Selektion
-		fitnessproportionalSelection(P, I, popsize, parentCnt);
-		DT_int popsizeNextGen = popsize + 2 * parentCnt;
-		DT_individuum P_nextGen[popsizeNextGen];
-		recombination(P, P_nextGen, I, popsize, parentCnt, px);
-		mutation(P_nextGen, popsizeNextGen, pm);
-		getScores(&v_inv, P_nextGen, popsizeNextGen);
-		t++;
-		bestSelection(P_nextGen, P, popsizeNextGen, popsize);
-		printPopulation(P, popsize);
-	}
-	//return getBestIndividuum();
-	return P[0];
+	getScores(evo, evo->popsize);
+}
+
+/**
+ * \brief	Berechnet eine Generation.
+ *
+ * 			Die Nachkommen werden hinter der Population abgelegt. Die besten
+ * 			Individuen werden in den zweiten Puffer übernommen und die Puffer getauscht.
+ *
+ * \param	evo	Zustand des Algorithmus
+ */
+void EVO_generation(DT_evo* const evo) {
+	DT_int popsizeNextGen = evo->popsize + 2 * evo->parentCnt;
+	recombination(evo);
+	mutation(evo, popsizeNextGen);
+	getScores(evo, popsizeNextGen);
+	bestSelection(evo, popsizeNextGen);
+	evo->generation++;
+#ifdef EVO_PRINT_ON
+	printPopulation(evo->P, evo->popsize);
+#endif
+}
+
+/**
+ * \brief	Liefert das beste Individuum der aktuellen Population.
+ *
+ * \param	evo	Zustand des Algorithmus
+ *
+ * \return	Bestes Individuum
+ */
+DT_individuum EVO_best(const DT_evo* const evo) {
+	DT_int i, best = 0;
+	for (i = 1; i < evo->popsize; i++)
+		if (evo->P[i].F <= 1000 && (evo->P[best].F > 1000 || evo->P[i].F
+				> evo->P[best].F))
+			best = i;
+	return evo->P[best];
 }
 
 DT_point getPointFromIndividuum(DT_individuum * A) {
@@ -90,13 +191,10 @@ DT_point getIsectFromIndividuum(DT_individuum * A) {
 	return p;
 }
 
-void generatePopulation(DT_individuum * const P, const DT_int popsize) {
-	DT_int prob = 211;
+void generatePopulation(DT_evo* const evo) {
 	int i;
-	for (i = 0; i < popsize; i++) {
-		P[i].G = generatePoint(prob);
-		prob += prob;
-	}
+	for (i = 0; i < evo->popsize; i++)
+		evo->P[i].G = generatePoint(&evo->rng);
 }
 
 void printPopulation(DT_individuum* P, DT_int size) {
@@ -106,133 +204,136 @@ void printPopulation(DT_individuum* P, DT_int size) {
 				P[i].F);
 }
 
-DT_point generatePoint(DT_int prob) {
-	DT_point p;
-	//unsigned int iseed = (unsigned int) time(NULL);
-	DT_size iseed = prob;
-	do {
-		prob += prob - 123;
-		srand(iseed);
-		p.x = getRandomNumber(X_MIN, X_MAX);
-		iseed += prob;
-		prob += prob;
-		srand(iseed);
-		p.y = getRandomNumber(Y_MIN, Y_MAX);
-		p.z = Z;
-	} while (isInArea(&p) != true);
-	return p;
-}
-
-DT_double getRandomNumber(DT_int min, DT_int max) {
-	double random;
-	random = (rand() % (max - min + 1)) + min;
-	return random;
+DT_point generatePoint(DT_rng* const rng) {
+	// Gleichverteilt aus dem Belegungsraster, ohne Verwerfen
+	return WS_samplePoint(rng);
 }
 
-void fitnessproportionalSelection(const DT_individuum * const P, DT_int* I,
-		const DT_int popsize, const DT_int parentCnt) {
-	DT_int i;
-	DT_double sum[popsize], summe;
-	sum[0] = 0;
-	for (i = 1; i < popsize; i++) {
-		sum[i] = sum[i - 1] + P[i - 1].F;
-		summe = sum[i];
-	}
-	printf("\ndurchschnittliche Güte: %f\n", sum[popsize - 1] / popsize);
-	for (i = 0; i < parentCnt; i++) {
-		DT_int j = 1;
-		DT_double u = getRandomNumber(0, sum[popsize - 1]);
-		while (sum[j] < u) {
-			j++;
+DT_int fitnessproportionalSelection(DT_evo* const evo) {
+	DT_int j;
+	DT_real summe = 0;
+	// Ungültige Individuen (F > 1000) werden nicht ausgewählt
+	for (j = 0; j < evo->popsize; j++)
+		if (evo->P[j].F <= 1000)
+			summe += evo->P[j].F;
+	if (summe <= 0)
+		return rngInt(&evo->rng, evo->popsize);
+	DT_real u = rngUniform(&evo->rng) * summe;
+	DT_int last = 0;
+	for (j = 0; j < evo->popsize; j++) {
+		if (evo->P[j].F <= 1000) {
+			last = j;
+			u -= evo->P[j].F;
+			if (u < 0)
+				return j;
 		}
-		I[i] = j;
 	}
+	// Rundungsfehler: u bleibt >= 0, letztes gültiges Individuum
+	return last;
 }
 
-void recombination(const DT_individuum const * P,
-		DT_individuum * const P_nextGen, const DT_int const * I,
-		const DT_int popsize, const DT_int parentCnt, const DT_double px) {
+void recombination(DT_evo* const evo) {
 	DT_int i;
-	DT_double u;
-	// Übernehmen der Eltern in neue Population
-	for (i = 0; i < popsize; i++)
-		P_nextGen[i] = P[i];
-	// Rekombination
-	for (i = 0; i < parentCnt; i++) {
-		u = getRandomNumber(0, 10000) / 10000;
-		if (u <= px) {
-			DT_int partner = I[i];
-			uniformCrossover(&P[i], &P[partner], &P_nextGen[popsize + (i * 2)],
-					&P_nextGen[popsize + (i * 2) + 1]);
+	DT_individuum * const P = evo->P;
+	const DT_int popsize = evo->popsize;
+	// Nachkommen hinter der Population ablegen
+	for (i = 0; i < evo->parentCnt; i++) {
+		const DT_individuum * const A = &P[i % popsize];
+		// Fitnessproportionale Selektion
+		const DT_individuum * const B = &P[fitnessproportionalSelection(evo)];
+		DT_individuum * const C = &P[popsize + (i * 2)];
+		DT_individuum * const D = &P[popsize + (i * 2) + 1];
+		if (rngUniform(&evo->rng) < evo->px) {
+			uniformCrossover(&evo->rng, A, B, C, D);
+		} else {
+			*C = *A;
+			*D = *B;
 		}
 	}
 }
 
-void uniformCrossover(const DT_individuum const * A,
-		const DT_individuum const * B, DT_individuum * C, DT_individuum * D) {
+void uniformCrossover(DT_rng* const rng, const DT_individuum* const A,
+		const DT_individuum* const B, DT_individuum * C, DT_individuum * D) {
 	// l = 2, da 2-Dimensionales Problem
+	DT_int tries = 0;
 	do {
-		DT_double b = getRandomNumber(0, 1);
-		if (b == 0) {
+		// Eltern übernehmen, wenn keine Kombination im Arbeitsraum liegt
+		if (++tries > EVO_MAX_TRIES) {
+			C->G = A->G;
+			D->G = B->G;
+			break;
+		}
+		if (rngInt(rng, 2) == 0) {
 			C->G.x = A->G.x;
 			D->G.x = B->G.x;
 		} else {
 			C->G.x = B->G.x;
 			D->G.x = A->G.x;
 		}
-		b = getRandomNumber(0, 1);
-		if (b == 0) {
+		if (rngInt(rng, 2) == 0) {
 			C->G.y = A->G.y;
 			D->G.y = B->G.y;
 		} else {
 			C->G.y = B->G.y;
 			D->G.y = A->G.y;
 		}
-	} while ((isInArea(&C->G) != true) || (isInArea(&D->G) != true));
+	} while ((WS_isInAreaFast(&C->G) != true) || (WS_isInAreaFast(&D->G)
+			!= true));
 	C->G.z = Z;
 	D->G.z = Z;
 }
 
-void mutation(DT_individuum * P, const DT_int popsize, const DT_double pm) {
+void mutation(DT_evo* const evo, const DT_int popsize) {
 	DT_int i;
 	for (i = 0; i < popsize; i++) {
-		gleichverteilte_reellwertige_mutation(&P[i].G, pm);
+		if (rngUniform(&evo->rng) < evo->pm)
+			gleichverteilte_reellwertige_mutation(&evo->rng, &evo->P[i].G,
+					evo->smax);
 	}
 }
 
-void gleichverteilte_reellwertige_mutation(DT_point * A, const DT_double pm) {
-	DT_double u = getRandomNumber(0, 10000) / 10000;
-	DT_double unten, oben, smax = 10;
-	if (u <= pm) {
-		//printf("\nMutate:\nBefore: A.x = %f\tA.y = %f\n", A->x, A->y);
-		do {
-			unten = max(X_MIN + 20, A->x - smax);
-			oben = min(X_MAX - 20, A->x + smax);
-			A->x = getRandomNumber(unten, oben);
-			unten = max(Y_MIN + 20, A->y - smax);
-			oben = min(Y_MAX - 20, A->y + smax);
-			A->y = getRandomNumber(unten, oben);
-		} while (isInArea(A) != true);
-		//printf("After: A.x = %f\tA.y = %f\n", A->x, A->y);
-	}
+void gleichverteilte_reellwertige_mutation(DT_rng* const rng, DT_point * A,
+		const DT_real smax) {
+	DT_point B;
+	DT_int tries = 0;
+	B.z = A->z;
+	do {
+		// Ursprünglichen Punkt behalten, wenn keine Mutation im Arbeitsraum liegt
+		if (++tries > EVO_MAX_TRIES)
+			return;
+		B.x = rngRange(rng, max(X_MIN + 20, A->x - smax), min(X_MAX - 20, A->x
+				+ smax));
+		B.y = rngRange(rng, max(Y_MIN + 20, A->y - smax), min(Y_MAX - 20, A->y
+				+ smax));
+	} while (WS_isInAreaFast(&B) != true);
+	*A = B;
 }
 
-void bestSelection(DT_individuum * const P_nextGen, DT_individuum * P,
-		const DT_int popsizeNextGen, const DT_int popsize) {
-	DT_int i;
-	bubblesort(P_nextGen, popsizeNextGen);
-	for (i = 0; i < popsize; i++) {
-		if (P_nextGen[i].F > 1000)
-			continue;
-		else
-			P[i] = P_nextGen[i];
-	}
+void bestSelection(DT_evo* const evo, const DT_int popsizeNextGen) {
+	DT_int i, j;
+	DT_individuum * const P = evo->P;
+	// Beste gültige Individuen (F <= 1000) absteigend übernehmen
+	DT_int cnt = selectBest(P, popsizeNextGen, evo->index, evo->popsize);
+	for (j = 0; j < cnt; j++)
+		evo->P_nextGen[j] = P[evo->index[j]];
+	// Auffüllen, falls nicht genug gültige Individuen vorhanden sind
+	for (i = 0; j < evo->popsize; i++)
+		if (P[i].F > 1000)
+			evo->P_nextGen[j++] = P[i];
+	// Puffer tauschen
+	evo->P = evo->P_nextGen;
+	evo->P_nextGen = P;
 }
 
-void getScores(DT_vector* const v, DT_individuum* const P, const DT_int popsize) {
+void getScores(DT_evo* const evo, const DT_int cnt) {
+	DT_individuum* const P = evo->P;
 	DT_int i;
-	for (i = 0; i < popsize; i++) {
-		P[i].F = scorePoint(v, &P[i].G, &P[i].S);
-
+	for (i = 0; i < cnt; i++) {
+#ifdef EVO_FAST_SCORE_ON
+		P[i].F = SG_scorePointFast(&evo->v, &P[i].G, &P[i].S);
+#else
+		P[i].F = scorePoint(&evo->v, &P[i].G, &P[i].S);
+#endif
+		evo->evaluations++;
 	}
 }
@@ -7,6 +7,7 @@
  */
 
 #include "include/evolutionaryHelper.h"
+#include "include/flash.h"
 #include <math.h>
 #include <stdio.h>
 
@@ -26,85 +27,76 @@
 
 // Lokale Methoden
 DT_bool isectLinFuncs(const DT_lin_func*, const DT_lin_func*, DT_point*);
-void initFunctions();
-void initPoints();
-DT_double f_lin(const DT_lin_func *, const DT_double);
-DT_double f_circ(const DT_half_circle*, const DT_double);
+DT_real f_lin(const DT_lin_func *, const DT_real);
+DT_real f_circ(const DT_half_circle*, const DT_real);
 DT_bool isectLinFuncs(const DT_lin_func*, const DT_lin_func*, DT_point*);
 DT_byte isectLinCirc(const DT_lin_func*, const DT_half_circle*, DT_point*,
 		DT_point*);
 DT_bool isBetweenPoints(const DT_point*, const DT_point*, const DT_point*);
-DT_double getDistance(const DT_point* const , const DT_point* const );
+DT_real getDistance(const DT_point* const , const DT_point* const );
 DT_point getNearerPoint(const DT_point*, const DT_point*, const DT_point*);
 DT_bool isVectorialPoint(const DT_point* const , const DT_vector*,
 		const DT_point* const );
+void heapSiftUp(const DT_individuum* const, DT_size* const, DT_size);
+void heapSiftDown(const DT_individuum* const, DT_size* const, DT_size,
+		const DT_size);
 
-// globale Variablen
-DT_point A, B, C, D, E, F, G;
-DT_lin_func AB, CD;
-DT_half_circle CEA, DFB;
+/** \brief Randfunktionen und Mittelpunkt des Arbeitsraums. */
+typedef struct {
+	DT_lin_func AB, CD;
+	DT_half_circle CEA, DFB;
+	DT_point G;
+} DT_workspace;
 
 // AB:  f(x) = 1.1875x + 0.4375
 // CD:  g(x) = -1.1875x + 0.4375
 // CEA: h(x) = sqrt(2874.60947 - x x)
 // DFB: i(x) = sqrt(16852.36694 - x x)
-
+// G:   Mittelpunkt (0, 100)
 /**
- * \brief	Initialisiert die globalen Funktionen.
- *
- * 			Initialisiert die globalen Funktionen zur Beschreibung der Schnittfläche des Arbeitsraums.
+ * \brief	Schnittfläche des Arbeitsraums im Flash.
  */
-void initFunctions() {
-	AB.m = 1.1875;
-	AB.n = 0.4375;
-	CD.m = -1.1875;
-	CD.n = 0.4375;
-	CEA.sqr_r = 2874.60947;
-	DFB.sqr_r = 16852.36694;
-}
+const DT_workspace EVO_WORKSPACE PROGMEM = { { 1.1875, 0.4375 }, { -1.1875,
+		0.4375 }, { 2874.60947 }, { 16852.36694 }, { 0, 100, Z } };
 
-void initPoints() {
-	A.x = 35.0;
-	A.y = 42.0;
-	A.z = Z;
-	B.x = 83.0;
-	B.y = 99.0;
-	B.z = Z;
-	C.x = -35.0;
-	C.y = 42.0;
-	C.z = Z;
-	D.x = -83.0;
-	D.y = 99.0;
-	D.z = Z;
-	E.x = 0.0;
-	E.y = 55.0;
-	E.z = Z;
-	F.x = 0.0;
-	F.y = 129.0;
-	F.z = Z;
-	// Centerpoint G
-	G.x = 0;
-	G.y = 100;
-	G.z = Z;
-}
+// globale Variablen
+DT_point G;
+DT_lin_func AB, CD;
+DT_half_circle CEA, DFB;
+DT_bool EVO_loaded = false; /**< initEvoAlg() hat die Schnittfläche geladen. */
 
+/**
+ * \brief	Lädt die Schnittfläche des Arbeitsraums aus dem Flash.
+ *
+ * 			Die Arbeitskopien im RAM werden von isInArea() und scorePoint()
+ * 			direkt gelesen. Geladen wird nur beim ersten Aufruf, danach werden
+ * 			die Kopien nicht mehr geschrieben. Threads (testEvoSweep) dürfen den
+ * 			Algorithmus daher nach einem ersten Aufruf gleichzeitig verwenden.
+ */
 void initEvoAlg() {
-	initFunctions();
-	initPoints();
+	if (EVO_loaded)
+		return;
+	FL_readStruct(&AB, &EVO_WORKSPACE.AB);
+	FL_readStruct(&CD, &EVO_WORKSPACE.CD);
+	FL_readStruct(&CEA, &EVO_WORKSPACE.CEA);
+	FL_readStruct(&DFB, &EVO_WORKSPACE.DFB);
+	FL_readStruct(&G, &EVO_WORKSPACE.G);
+	EVO_loaded = true;
 }
+
 // y = mx + n
-DT_double f_lin(const DT_lin_func * f, const DT_double x) {
+DT_real f_lin(const DT_lin_func * f, const DT_real x) {
 	return f->m * x + f->n;
 }
 
 //y = sqrt(r*r - x*x)
-DT_double f_circ(const DT_half_circle* f1, const DT_double x) {
+DT_real f_circ(const DT_half_circle* f1, const DT_real x) {
 	return sqrt(f1->sqr_r - x * x);
 }
 
 DT_bool isectLinFuncs(const DT_lin_func* f1, const DT_lin_func* f2,
 		DT_point* isect) {
-	DT_double x = (f2->n - f1->n) / (f1->m - f2->m);
+	DT_real x = (f2->n - f1->n) / (f1->m - f2->m);
 	if (x != x) {
 		return false;
 	} else {
@@ -118,10 +110,10 @@ DT_bool isectLinFuncs(const DT_lin_func* f1, const DT_lin_func* f2,
 DT_byte isectLinCirc(const DT_lin_func* f1, const DT_half_circle* f2,
 		DT_point* isect1, DT_point* isect2) {
 	DT_int retValue = 0;
-	DT_double p = (2 * f1->m * f1->n) / (f1->m * f1->m + 1);
-	DT_double q = (f1->n * f1->n - f2->sqr_r) / (f1->m * f1->m + 1);
-	DT_double x1 = -p / 2 + sqrt((p * p) / 4 - q);
-	DT_double x2 = -p / 2 - sqrt((p * p) / 4 - q);
+	DT_real p = (2 * f1->m * f1->n) / (f1->m * f1->m + 1);
+	DT_real q = (f1->n * f1->n - f2->sqr_r) / (f1->m * f1->m + 1);
+	DT_real x1 = -p / 2 + sqrt((p * p) / 4 - q);
+	DT_real x2 = -p / 2 - sqrt((p * p) / 4 - q);
 	if (x1 != x1) {
 	} else {
 		isect1->x = x1;
@@ -161,16 +153,16 @@ DT_bool isBetweenPoints(const DT_point* p1, const DT_point* p2,
 	}
 }
 
-DT_double getDistance(const DT_point* const p1, const DT_point* const p2) {
+DT_real getDistance(const DT_point* const p1, const DT_point* const p2) {
 	return sqrt((p1->x - p2->x) * (p1->x - p2->x) + (p1->y - p2->y) * (p1->y
 			- p2->y));
 }
 
 DT_point getNearerPoint(const DT_point* p_ref, const DT_point* p1,
 		const DT_point* p2) {
-	DT_double dist1 = sqrt((p_ref->x - p1->x) * (p_ref->x - p1->x) + (p_ref->y
+	DT_real dist1 = sqrt((p_ref->x - p1->x) * (p_ref->x - p1->x) + (p_ref->y
 			- p1->y) * (p_ref->y - p1->y));
-	DT_double dist2 = sqrt((p_ref->x - p2->x) * (p_ref->x - p2->x) + (p_ref->y
+	DT_real dist2 = sqrt((p_ref->x - p2->x) * (p_ref->x - p2->x) + (p_ref->y
 			- p2->y) * (p_ref->y - p2->y));
 	if (dist1 < dist2)
 		return *p1;
@@ -236,34 +228,27 @@ DT_bool isInArea(const DT_point* p) {
 
 DT_bool isVectorialPoint(const DT_point* const p_ref, const DT_vector* v,
 		const DT_point* const p_chk) {
-	DT_point p_refVec;
-	if (v->x != 0)
-		p_refVec.x = p_ref->x + v->x / fabs(v->x);
-	else
-		p_refVec.x = p_ref->x;
-	if (v->y != 0)
-		p_refVec.y = p_ref->y + v->y / fabs(v->y);
-	else
-		p_refVec.y = p_ref->y;
-	if (getDistance(p_ref, p_chk) >= getDistance(&p_refVec, p_chk))
+	// Punkt liegt in Richtung v, wenn das Skalarprodukt nicht negativ ist
+	if ((p_chk->x - p_ref->x) * v->x + (p_chk->y - p_ref->y) * v->y >= 0)
 		return true;
 	else
 		return false;
 }
 
-DT_double scorePoint(DT_vector* const v, const DT_point* const p, DT_point * s) {
+DT_real scorePoint(DT_vector* const v, const DT_point* const p, DT_point * s) {
 	if ((v->x == 0) && (v->y == 0))
 		return 0.0;
 	// y = mx + n
 	DT_lin_func f;
-	if (v->x == 0) {
+	// Senkrechte Richtung durch steile Gerade annähern
+	if (v->x == 0)
 		v->x += 0.01;
-		f.m = 0;
-	} else
-		f.m = v->y / v->x;
+	f.m = v->y / v->x;
 	f.n = p->y - f.m * p->x;
 
+#ifdef EVO_PRINT_ON
 	printf("\nFunktion f: y = %f x + %f", f.m, f.n);
+#endif
 
 	DT_point isect, isect_tmp, isect_tmp1;
 	isect.x = -10000;
@@ -350,14 +335,98 @@ void bubblesort(DT_individuum * P, const DT_int n) {
 	}
 }
 
-DT_double max(DT_double x, DT_double y) {
+/**
+ * \brief	Bestimmt die Indizes der k besten gültigen Individuen.
+ *
+ * 			Partielle Auswahl mit einem Min-Heap der Größe k über die Indizes,
+ * 			die Individuen selbst werden nicht verschoben. Ungültige Individuen
+ * 			(F > 1000) werden im selben Durchlauf verworfen. Aufwand O(n log k).
+ *
+ * \param	P	Population
+ * \param	n	Größe der Population
+ * \param	index	Zielfeld für die Indizes (min. k Einträge), absteigend nach Güte
+ * \param	k	Anzahl der gesuchten Individuen
+ *
+ * \return	Anzahl der gefundenen gültigen Individuen (max. k)
+ */
+DT_size selectBest(const DT_individuum* const P, const DT_size n,
+		DT_size* const index, const DT_size k) {
+	DT_size i, cnt = 0, swp;
+	for (i = 0; i < n; i++) {
+		if (P[i].F > 1000)
+			continue;
+		if (cnt < k) {
+			index[cnt] = i;
+			heapSiftUp(P, index, cnt);
+			cnt++;
+		} else if (k > 0 && P[i].F > P[index[0]].F) {
+			// Schlechtestes der bisher besten Individuen ersetzen
+			index[0] = i;
+			heapSiftDown(P, index, 0, cnt);
+		}
+	}
+	// Heapsort: Minimum jeweils nach hinten, ergibt absteigende Reihenfolge
+	for (i = cnt; i > 1; i--) {
+		swp = index[0];
+		index[0] = index[i - 1];
+		index[i - 1] = swp;
+		heapSiftDown(P, index, 0, i - 1);
+	}
+	return cnt;
+}
+
+/**
+ * \brief	Stellt die Heap-Eigenschaft vom Element pos aufwärts her (Min-Heap nach F).
+ *
+ * \param	P	Population
+ * \param	heap	Heap mit Indizes
+ * \param	pos	Position des neuen Elements
+ */
+void heapSiftUp(const DT_individuum* const P, DT_size* const heap, DT_size pos) {
+	DT_size swp;
+	while (pos > 0) {
+		DT_size parent = (pos - 1) / 2;
+		if (P[heap[parent]].F <= P[heap[pos]].F)
+			break;
+		swp = heap[parent];
+		heap[parent] = heap[pos];
+		heap[pos] = swp;
+		pos = parent;
+	}
+}
+
+/**
+ * \brief	Stellt die Heap-Eigenschaft vom Element pos abwärts her (Min-Heap nach F).
+ *
+ * \param	P	Population
+ * \param	heap	Heap mit Indizes
+ * \param	pos	Position des geänderten Elements
+ * \param	size	Größe des Heaps
+ */
+void heapSiftDown(const DT_individuum* const P, DT_size* const heap,
+		DT_size pos, const DT_size size) {
+	DT_size swp;
+	while (2 * pos + 1 < size) {
+		DT_size child = 2 * pos + 1;
+		if (child + 1 < size && P[heap[child + 1]].F < P[heap[child]].F)
+			child++;
+		if (P[heap[pos]].F <= P[heap[child]].F)
+			break;
+		swp = heap[child];
+		heap[child] = heap[pos];
+		heap[pos] = swp;
+		pos = child;
+	}
+}
+
+DT_real max(DT_real x, DT_real y) {
 	if (x <= y)
 		return y;
 	else
 		return x;
 }
 
-DT_double min(DT_double x, DT_double y) {
+DT_real min(DT_real x, DT_real y) {
 	if (x > y)
 		return y;
 	else
@@ -373,3 +442,78 @@ void getFunctionOfPoints(DT_lin_func * f, const DT_point* const p1,
 	f->n = p1->y - f->m * p1->x;
 
 }
+
+/**
+ * \brief	Initialisiert einen Zufallszahlengenerator.
+ *
+ * 			Gleicher Startwert ergibt die gleiche Zahlenfolge.
+ *
+ * \param	rng	Zufallszahlengenerator
+ * \param	seed	Startwert
+ */
+void rngSeed(DT_rng* const rng, uint32_t seed) {
+	// xorshift32 darf nicht mit 0 starten
+	rng->state = seed != 0 ? seed : 0x9E3779B9;
+}
+
+/**
+ * \brief	Liefert die nächste Zufallszahl (xorshift32).
+ *
+ * \param	rng	Zufallszahlengenerator
+ *
+ * \return	Zufallszahl aus [1, 2^32 - 1]
+ */
+uint32_t rngNext(DT_rng* const rng) {
+	uint32_t x = rng->state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	rng->state = x;
+	return x;
+}
+
+/**
+ * \brief	Liefert eine gleichverteilte Zufallszahl aus [0, 1).
+ *
+ * 			Verwendet 24 Bit, damit die Zahl auch als 32-Bit-Float exakt ist.
+ *
+ * \param	rng	Zufallszahlengenerator
+ *
+ * \return	Zufallszahl
+ */
+DT_real rngUniform(DT_rng* const rng) {
+	return (rngNext(rng) >> 8) * (1.0 / 16777216.0);
+}
+
+/**
+ * \brief	Liefert eine gleichverteilte reelle Zufallszahl aus [lo, hi).
+ *
+ * \param	rng	Zufallszahlengenerator
+ * \param	lo	untere Grenze
+ * \param	hi	obere Grenze
+ *
+ * \return	Zufallszahl
+ */
+DT_real rngRange(DT_rng* const rng, const DT_real lo, const DT_real hi) {
+	return lo + (hi - lo) * rngUniform(rng);
+}
+
+/**
+ * \brief	Liefert eine gleichverteilte ganze Zufallszahl aus [0, n).
+ *
+ * 			Verwirft Zahlen oberhalb des letzten vollständigen Vielfachen von n,
+ * 			damit kein Modulo-Bias entsteht.
+ *
+ * \param	rng	Zufallszahlengenerator
+ * \param	n	Anzahl der möglichen Werte (> 0)
+ *
+ * \return	Zufallszahl
+ */
+DT_int rngInt(DT_rng* const rng, const DT_int n) {
+	const uint32_t limit = UINT32_MAX - UINT32_MAX % (uint32_t) n;
+	uint32_t x;
+	do {
+		x = rngNext(rng);
+	} while (x >= limit);
+	return x % (uint32_t) n;
+}
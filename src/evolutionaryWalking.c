@@ -13,10 +13,15 @@
 #include "include/utils.h"
 #include "include/evolutionaryHelper.h"
 #include "include/evolutionaryAlgorithm.h"
+#include "include/startPoint.h"
 #include "include/dynamixel.h"
 #include "include/xmega.h"
 #include "include/communication.h"
 #include "include/movement.h"
+#include "include/trace.h"
+#include "include/capture.h"
+#include "include/stack.h"
+#include "include/calibration.h"
 #include "include/remote.h"
 
 #define OFFSET 50
@@ -29,12 +34,16 @@ DT_byte cpuID;
 void master();
 
 int main(void) {
+	STK_paint();
 	XM_init_cpu();
 	XM_init_dnx();
+	CAL_init();
 	// INIT: Hole benoetigte Daten
 	DNX_getConnectedIDs(&leg_r, &leg_l);
 	cpuID = COM_getCpuID(&leg_l);
 	XM_init_com(cpuID);
+	TRC_init(cpuID);
+	CAP_boot();
 
 	XM_init_remote();
 
@@ -43,19 +52,19 @@ int main(void) {
 	switch (cpuID) {
 	case COM_MASTER:
 		XM_init_remote();
-		DEBUG(("Master",sizeof("Master")))
+		DEBUG_P("Master")
 		master();
 		break;
 	case COM_SLAVE1B:
-		DEBUG(("Slave1",sizeof("Slave1")))
+		DEBUG_P("Slave1")
 		//MV_slave(cpuID, &leg_r, &leg_l);
 		break;
 	case COM_SLAVE3F:
-		DEBUG(("Slave3",sizeof("Slave3")))
+		DEBUG_P("Slave3")
 		//MV_slave(cpuID, &leg_r, &leg_l);
 		break;
 	default: //case NOCPUID:
-		DEBUG (("NoCpuID",sizeof("NoCpuID")))
+		DEBUG_P("NoCpuID")
 		XM_LED_OFF
 		break;
 	}
@@ -96,9 +105,9 @@ void initConf() {
 	SlavesInactive = COM_CONF_LEFT;
 }
 
-void TripodGaitMove(DT_point* pM, DT_point* pS, const DT_double speed,
-		const DT_double offset) {
-	DT_double z;
+void TripodGaitMove(DT_point* pM, DT_point* pS, const DT_real speed,
+		const DT_real offset) {
+	DT_real z;
 	z = pM->z;
 	if (MasterActive == COM_CONF_LEFT) {
 		MV_pointAndSpeed(&leg_l, pM, speed, false);
@@ -117,8 +126,7 @@ void TripodGaitMove(DT_point* pM, DT_point* pS, const DT_double speed,
 	COM_sendPointAndSpeed(COM_SLAVE1B, pS, speed, SlavesInactive);
 	COM_sendPointAndSpeed(COM_SLAVE3F, pS, speed, SlavesInactive);
 	pS->z = z;
-	COM_sendAction(COM_BRDCAST_ID);
-	MV_action(&leg_r, &leg_l);
+	MV_masterAction(&leg_r, &leg_l);
 }
 
 DT_point pM, pS, midM, midS, isectM, isectS, pMiddle;
@@ -136,10 +144,10 @@ void init_pMpSpMiddle() {
 }
 
 void calculateMovementPoints() {
-	DT_double distM = getDistance(&pM, &isectM);
-	DT_double distS = getDistance(&pS, &isectS);
+	DT_real distM = getDistance(&pM, &isectM);
+	DT_real distS = getDistance(&pS, &isectS);
 	// Bewegung anhand von 3 Punkten auf einer geraden
-	DT_double ratio;
+	DT_real ratio;
 	DT_point distV;
 	if (distM <= distS) {
 		// Mittelpunkt berechnen
@@ -173,7 +181,7 @@ void calculateMovementPoints() {
 	}
 }
 
-void doStepMove(DT_point* pM, DT_point* pS, const DT_double speed) {
+void doStepMove(DT_point* pM, DT_point* pS, const DT_real speed) {
 	if (MasterActive == COM_CONF_LEFT) {
 		MV_pointAndSpeed(&leg_l, pM, speed, false);
 	} else {
@@ -181,13 +189,12 @@ void doStepMove(DT_point* pM, DT_point* pS, const DT_double speed) {
 	}
 	COM_sendPointAndSpeed(COM_SLAVE1B, pS, speed, SlavesActive);
 	COM_sendPointAndSpeed(COM_SLAVE3F, pS, speed, SlavesActive);
-	COM_sendAction(COM_BRDCAST_ID);
-	MV_action(&leg_r, &leg_l);
+	MV_masterAction(&leg_r, &leg_l);
 }
 
-void prepareStepMove(DT_point* pM, DT_point* pS, const DT_double speed,
-		const DT_double offset) {
-	DT_double z;
+void prepareStepMove(DT_point* pM, DT_point* pS, const DT_real speed,
+		const DT_real offset) {
+	DT_real z;
 	z = pM->z;
 	if (MasterInactive == COM_CONF_LEFT) {
 		pM->z += offset;
@@ -202,23 +209,22 @@ void prepareStepMove(DT_point* pM, DT_point* pS, const DT_double speed,
 	COM_sendPointAndSpeed(COM_SLAVE1B, pS, speed, SlavesInactive);
 	COM_sendPointAndSpeed(COM_SLAVE3F, pS, speed, SlavesInactive);
 	pS->z = z;
-	COM_sendAction(COM_BRDCAST_ID);
-	MV_action(&leg_r, &leg_l);
+	MV_masterAction(&leg_r, &leg_l);
 }
 
-void doStep(const DT_double speed) {
+void doStep(const DT_real speed) {
 
 }
 
-void evolutionaryCalculation(DT_vector * v, const DT_double speed) {
+void evolutionaryCalculation(DT_vector * v, const DT_real speed) {
 	DT_individuum A, B;
 	if (MasterActive == COM_CONF_LEFT)
 		invertVector(v);
-	A = evolutionaryAlgorithm(10, 5, v);
+	A = SP_calcStartPoint(v);
 	pM = getPointFromIndividuum(&A);
 	isectM = getIsectFromIndividuum(&A);
 	invertVector(v);
-	B = evolutionaryAlgorithm(10, 5, v);
+	B = SP_calcStartPoint(v);
 	pS = getPointFromIndividuum(&B);
 	isectS = getIsectFromIndividuum(&B);
 }
@@ -233,7 +239,7 @@ void waitForButton3() {
 void master() {
 	DT_cmd cmd;
 	DT_vector v;
-	DT_double speed = 200;
+	DT_real speed = 200;
 	init_pMpSpMiddle();
 	initConf();
 	DT_point pM_old, pS_old;
@@ -242,7 +248,11 @@ void master() {
 	TripodGaitMove(&pM, &pS, speed, 0);
 	pM_old = copyPoint(&pM);
 	pS_old = copyPoint(&pS);
+	STK_begin(STK_MASTER);
 	while (1) {
+		STK_poll();
+		CAP_poll();
+		MV_masterPollStack();
 		// Lokaler Vektor
 		v.x = 0;
 		v.y = 0;
@@ -261,6 +271,12 @@ void master() {
 				TripodGaitMove(&pMiddle, &pMiddle, speed, NO_OFFSET);
 			if (RMT_isButton2Pressed(cmd))
 				switchLegs();
+			// Ereignisprotokolle aller Controller auf die Debug-USARTs
+			if (RMT_isButton4Pressed(cmd))
+				MV_masterDumpTrace();
+			// Messwerte des Profilers aller Controller auf die Debug-USART des Masters
+			if (RMT_isButton5Pressed(cmd))
+				MV_masterDumpProfile();
 		} while (!RMT_isButton6Pressed(cmd));
 
 		// Inaktive Beine in die Luft
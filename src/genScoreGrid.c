@@ -0,0 +1,87 @@
+/**
+ * \file	genScoreGrid.c
+ *
+ * \brief	Generator für die Tabelle von scoreGrid.c (Host).
+ *
+ * 			Wird wie die Testprogramme mit -DTEST_ON übersetzt und schreibt
+ * 			scoreGridData.c auf stdout:
+ *
+ * 			gcc -DTEST_ON genScoreGrid.c startPoint.c evolutionaryHelper.c -lm
+ * 			./a.out > scoreGridData.c
+ *
+ * 			Die Strecke wird exakt über die Sehnen von startPoint.c bestimmt.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include "include/evolutionaryHelper.h"
+#include "include/scoreGrid.h"
+
+// lokale Methode aus startPoint.c
+DT_bool SP_getInterval(const DT_vector* const, const DT_vector* const,
+		const DT_real, DT_real*, DT_real*);
+
+/**
+ * \brief	Verbleibende Strecke vom Punkt p in Richtung d.
+ *
+ * 			Im Arbeitsraum entspricht sie SP_scorePoint(). Außerhalb wird die
+ * 			Strecke bis zum nächsten Austrittspunkt auf der Geraden linear
+ * 			fortgesetzt, ohne Schnitt mit dem Arbeitsraum ist sie 0.
+ *
+ * \param	d	Bewegungsrichtung (normiert, Koordinatensystem des EA)
+ * \param	x	x-Koordinate des Punkts
+ * \param	y	y-Koordinate des Punkts
+ *
+ * \return	Strecke
+ */
+DT_real getExtendedScore(const DT_vector* const d, const DT_real x,
+		const DT_real y) {
+	DT_vector n;
+	DT_real lo, hi, w;
+	n.x = -d->y;
+	n.y = d->x;
+	DT_real c = n.x * x + n.y * y;
+	DT_real t = d->x * x + d->y * y;
+	if (!SP_getInterval(d, &n, c, &lo, &hi))
+		return 0.0;
+	// Vor dem inneren Kreis endet die Strecke an dessen Rand
+	if (c * c < CEA.sqr_r) {
+		w = sqrt(CEA.sqr_r - c * c);
+		if (t < 0 && lo < -w)
+			hi = min(hi, -w);
+	}
+	return hi - t;
+}
+
+int main() {
+	DT_vector d;
+	DT_int k, row, col;
+
+	initEvoAlg();
+	printf("/**\n * \\file\tscoreGridData.c\n *\n");
+	printf(" * \\brief\tTabelle für scoreGrid.c, generiert mit genScoreGrid.c.\n");
+	printf(" */\n\n#include \"include/scoreGrid.h\"\n\n");
+	printf("const int16_t SG_grid[SG_DIRECTIONS][SG_ROWS][SG_COLS] PROGMEM = {\n");
+	for (k = 0; k < SG_DIRECTIONS; k++) {
+		d.x = cos(2 * M_PI * k / SG_DIRECTIONS);
+		d.y = sin(2 * M_PI * k / SG_DIRECTIONS);
+		printf("\t{ // %d\n", k);
+		for (row = 0; row < SG_ROWS; row++) {
+			printf("\t\t{");
+			for (col = 0; col < SG_COLS; col++) {
+				DT_real F = getExtendedScore(&d, SG_X_MIN + col * SG_STEP,
+						SG_Y_MIN + row * SG_STEP);
+				printf("%s%d", col == 0 ? " " : ", ", (int) lround(F * SG_SCALE));
+			}
+			printf(" }%s\n", row < SG_ROWS - 1 ? "," : "");
+		}
+		printf("\t}%s\n", k < SG_DIRECTIONS - 1 ? "," : "");
+	}
+	printf("};\n");
+	return 0;
+}
+
+#endif /* TEST_ON */
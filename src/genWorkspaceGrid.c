@@ -0,0 +1,102 @@
+/**
+ * \file	genWorkspaceGrid.c
+ *
+ * \brief	Generator für das Belegungsraster von workspaceGrid.c (Host).
+ *
+ * 			Wird wie die Testprogramme mit -DTEST_ON übersetzt und schreibt
+ * 			workspaceGridData.c auf stdout:
+ *
+ * 			gcc -DTEST_ON genWorkspaceGrid.c evolutionaryHelper.c -lm
+ * 			./a.out > workspaceGridData.c
+ *
+ * 			Eine Zelle liegt innen, wenn alle Ecken oberhalb von AB und CD liegen,
+ * 			die fernste Ecke in DFB und der nächste Punkt außerhalb von CEA. Sie
+ * 			liegt außen, wenn eine Randfunktion sie vollständig ausschließt, sonst
+ * 			ist sie eine Randzelle.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include "include/evolutionaryHelper.h"
+#include "include/workspaceGrid.h"
+
+#define CELL_INSIDE		1
+#define CELL_BOUNDARY	2
+#define CELL_OUTSIDE	0
+
+/**
+ * \brief	Klassifiziert eine Zelle.
+ *
+ * \param	row	Zeile
+ * \param	col	Spalte
+ *
+ * \return	CELL_INSIDE, CELL_BOUNDARY oder CELL_OUTSIDE
+ */
+DT_int classifyCell(const DT_int row, const DT_int col) {
+	DT_real x0 = WS_X_MIN + col * WS_CELL, x1 = x0 + WS_CELL;
+	DT_real y0 = WS_Y_MIN + row * WS_CELL, y1 = y0 + WS_CELL;
+	// Nächster und fernster Punkt der Zelle zum Ursprung
+	DT_real nx = (x0 > 0) ? x0 : ((x1 < 0) ? x1 : 0);
+	DT_real ny = (y0 > 0) ? y0 : ((y1 < 0) ? y1 : 0);
+	DT_real fx = max(fabs(x0), fabs(x1)), fy = max(fabs(y0), fabs(y1));
+	DT_real near = nx * nx + ny * ny, far = fx * fx + fy * fy;
+	// Geraden: Minimum/Maximum von y - f(x) liegt an einer Ecke
+	DT_real abMin = min(y0 - f_lin(&AB, x0), y0 - f_lin(&AB, x1));
+	DT_real abMax = max(y1 - f_lin(&AB, x0), y1 - f_lin(&AB, x1));
+	DT_real cdMin = min(y0 - f_lin(&CD, x0), y0 - f_lin(&CD, x1));
+	DT_real cdMax = max(y1 - f_lin(&CD, x0), y1 - f_lin(&CD, x1));
+
+	if (abMax < 0 || cdMax < 0 || near > DFB.sqr_r || far < CEA.sqr_r)
+		return CELL_OUTSIDE;
+	if (abMin >= 0 && cdMin >= 0 && far <= DFB.sqr_r && near >= CEA.sqr_r)
+		return CELL_INSIDE;
+	return CELL_BOUNDARY;
+}
+
+/**
+ * \brief	Gibt ein Bitfeld als C-Initialisierung aus.
+ *
+ * \param	name	Name des Feldes
+ * \param	type	Zellart, deren Bit gesetzt wird
+ */
+void printBits(const char* name, const DT_int type) {
+	DT_int row, byte, bit;
+	printf("const uint8_t %s[WS_ROWS][WS_ROW_BYTES] PROGMEM = {\n", name);
+	for (row = 0; row < WS_ROWS; row++) {
+		printf("\t{");
+		for (byte = 0; byte < WS_ROW_BYTES; byte++) {
+			DT_int bits = 0;
+			for (bit = 0; bit < 8 && byte * 8 + bit < WS_COLS; bit++)
+				if (classifyCell(row, byte * 8 + bit) == type)
+					bits |= 1 << bit;
+			printf("%s0x%02X", byte == 0 ? " " : ", ", bits);
+		}
+		printf(" }%s\n", row < WS_ROWS - 1 ? "," : "");
+	}
+	printf("};\n\n");
+}
+
+int main() {
+	DT_int row, col, cnt = 0;
+
+	initEvoAlg();
+	printf("/**\n * \\file\tworkspaceGridData.c\n *\n");
+	printf(" * \\brief\tBelegungsraster für workspaceGrid.c, generiert mit genWorkspaceGrid.c.\n");
+	printf(" */\n\n#include \"include/workspaceGrid.h\"\n\n");
+	printBits("WS_inside", CELL_INSIDE);
+	printBits("WS_boundary", CELL_BOUNDARY);
+	printf("const uint16_t WS_rowStart[WS_ROWS + 1] PROGMEM = {");
+	for (row = 0; row <= WS_ROWS; row++) {
+		printf("%s%d", row == 0 ? " " : (row % 16 == 0 ? ",\n\t\t" : ", "), cnt);
+		for (col = 0; row < WS_ROWS && col < WS_COLS; col++)
+			if (classifyCell(row, col) == CELL_INSIDE)
+				cnt++;
+	}
+	printf(" };\n");
+	return 0;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,73 @@
+/**
+ * \file	calibration.h
+ *
+ * \brief	Kalibrierung der Servos im EEPROM.
+ *
+ * 			Je Servo-ID werden Drehrichtung, Nullpunktversatz und Grenzen in Ticks
+ * 			(0 - 1023, 300 Grad) gespeichert. CAL_init() lädt die Tabelle einmal
+ * 			beim Start aus dem EEPROM. Ist dort keine gültige Tabelle abgelegt,
+ * 			gelten die Vorgaben des Aufbaus (gespiegelte Servos wie bisher in
+ * 			DNX_correctAngles(), kein Versatz, voller Bereich).
+ *
+ * 			CAL_degToTicks() und CAL_radToTicks() rechnen wie früher mit
+ * 			floor(3.41 * (150 +/- Winkel)), addieren den Versatz und begrenzen auf
+ * 			[min, max]. Mit den Vorgaben erhalten die Servos damit dieselben
+ * 			Zielpositionen wie vor der Kalibrierung. CAL_toTicks() rechnet einen
+ * 			Winkel in Hundertstel Grad nur mit Ganzzahlen um:
+ *
+ * 				ticks = (CAL_CENTER + sign * centiDeg) * 341 / 10000 + offset
+ *
+ * 			Der Master ändert einen Eintrag mit COM_sendCalibration(), der
+ * 			Controller übernimmt ihn sofort und schreibt ihn in sein EEPROM.
+ */
+
+#ifndef CALIBRATION_H_
+#define CALIBRATION_H_
+
+#include "datatypes.h"
+
+/**
+ * \def	CAL_SERVOS
+ * \brief	Anzahl der Einträge (Servo-IDs 1 bis CAL_SERVOS).
+ *
+ * \def	CAL_MIRRORED
+ * \brief	Flag: Drehrichtung des Servos ist gespiegelt.
+ *
+ * \def	CAL_CENTER
+ * \brief	Winkel der Mittelstellung in Hundertstel Grad (150 Grad).
+ *
+ * \def	CAL_TICKS_MAX
+ * \brief	Größte Zielposition eines Servos.
+ *
+ * \def	CAL_SIZE
+ * \brief	Größe eines Eintrags in CAL_toByteArray() und im EEPROM.
+ *
+ * \def	CAL_EEPROM_ADDR
+ * \brief	Adresse der Tabelle im EEPROM.
+ */
+#define CAL_SERVOS		18
+#define CAL_MIRRORED	0x01
+#define CAL_CENTER		15000
+#define CAL_TICKS_MAX	1023
+#define CAL_SIZE		7
+#define CAL_EEPROM_ADDR	0x0000
+
+/** \brief Kalibrierung eines Servos. */
+typedef struct {
+	DT_byte flags; /**< CAL_MIRRORED. */
+	int16_t offset; /**< Nullpunktversatz in Ticks. */
+	uint16_t min; /**< Kleinste erlaubte Zielposition in Ticks. */
+	uint16_t max; /**< Größte erlaubte Zielposition in Ticks. */
+} DT_calServo;
+
+DT_bool CAL_init();
+void CAL_setDefaults();
+DT_bool CAL_set(DT_byte, const DT_calServo* const);
+void CAL_get(DT_byte, DT_calServo* const);
+uint16_t CAL_toTicks(DT_byte, int32_t);
+uint16_t CAL_degToTicks(DT_byte, DT_real);
+uint16_t CAL_radToTicks(DT_byte, DT_real);
+void CAL_toByteArray(const DT_calServo* const, DT_byte* const);
+void CAL_fromByteArray(DT_calServo* const, const DT_byte* const);
+
+#endif /* CALIBRATION_H_ */
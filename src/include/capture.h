@@ -0,0 +1,82 @@
+/**
+ * \file	capture.h
+ *
+ * \brief	Mitschnitt der Pakete ausgewählter USARTs über die Debug-USART.
+ *
+ * 			Jedes gesendete (COM_send(), DNX_send()) und vollständig empfangene
+ * 			(COM_receive(), DNX_receive()) Paket wird mit Zeitstempel und Richtung
+ * 			in einen Ringpuffer kopiert. CAP_poll() gibt den Puffer ohne zu warten
+ * 			binär auf der Debug-USART aus. Passt ein Paket nicht mehr in den
+ * 			Puffer, wird es verworfen und gezählt. Die Debug-USART (250 kbit/s)
+ * 			ist langsamer als die Busse (je 1 Mbit/s), daher nur die benötigten
+ * 			Kanäle wählen. Im Mitschnitt dürfen keine DEBUG-Ausgaben aktiv sein.
+ *
+ * 			Aufbau eines Eintrags (Zeit Little Endian):
+ *
+ * 			CAP_SYNC, Länge, Kanal | CAP_TX, Zeit (2 Bytes, us), Paket
+ *
+ * 			busTrace wertet den Mitschnitt auf dem Host aus. Auf dem XMEGA wird
+ * 			der Mitschnitt mit CAP_ON übersetzt und von CAP_boot() gestartet, die
+ * 			Hauptschleifen geben ihn mit CAP_poll() aus.
+ */
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include "datatypes.h"
+#include "usart_driver.h"
+
+/**
+ * \brief Mitschnitt ab dem Start mit den Kanälen CAP_BOOT_MASK (CAP_boot()).
+ *
+ * Ohne CAP_ON belegt der Ringpuffer auf dem XMEGA keinen RAM, auf dem Host ist
+ * er für die Testprogramme immer vorhanden.
+ */
+#define CAP_OFF
+
+/**
+ * \def	CAP_SERVO_L
+ * \brief	Kanal der linken Servos (XM_servo_data_L).
+ *
+ * \def	CAP_SERVO_R
+ * \brief	Kanal der rechten Servos (XM_servo_data_R).
+ *
+ * \def	CAP_COM1
+ * \brief	Kanal der Verbindung zu Slave 1B (XM_com_data1).
+ *
+ * \def	CAP_COM3
+ * \brief	Kanal der Verbindung Master - Slave 3F bzw. Slave - Master (XM_com_data3).
+ *
+ * \def	CAP_ALL
+ * \brief	Maske für CAP_enable() mit allen Kanälen.
+ */
+#define CAP_SERVO_L		0
+#define CAP_SERVO_R		1
+#define CAP_COM1		2
+#define CAP_COM3		3
+#define CAP_CHANNELS	4
+#define CAP_ALL			0x0F
+
+/**
+ * \def	CAP_BOOT_MASK
+ * \brief	Kanäle für CAP_boot(), nur die Verbindungen der Controller.
+ */
+#define CAP_BOOT_MASK	((1 << CAP_COM1) | (1 << CAP_COM3))
+
+#define CAP_SYNC		0xA5
+#define CAP_TX			0x80 /**< Richtung: gesendet */
+#define CAP_CHANNEL_gm	0x03
+#define CAP_HEADER		5
+#if defined(CAP_ON) || !defined(__AVR__)
+#define CAP_BUFFER_SIZE	512 /**< Zweierpotenz */
+#else
+#define CAP_BUFFER_SIZE	1 /**< ohne CAP_ON wird jedes Paket verworfen */
+#endif
+
+void CAP_boot();
+void CAP_enable(DT_byte);
+void CAP_frame(const USART_data_t* const, DT_bool, const DT_byte* const, DT_size);
+void CAP_poll();
+uint16_t CAP_getDropped();
+
+#endif /* CAPTURE_H_ */
@@ -9,6 +9,9 @@
 
 #include "datatypes.h"
 #include "usart_driver.h"
+#include "profiler.h"
+#include "stack.h"
+#include "calibration.h"
 
 #define COM_MASTER		0x02
 #define COM_SLAVE1B		0x01
@@ -22,9 +25,17 @@
 #define COM_POINT		0x03
 #define COM_ANGLE		0x04
 #define COM_SPEED		0x05
+#define COM_CALIBRATE	0x07 /**< Kalibrierung eines Servos (DT_calServo) */
+#define COM_SYNC		0x08 /**< Zeit des Masters (uint32_t) und Folgenummer für den Abgleich der Uhren */
+#define COM_ACTION_AT	0x09 /**< ACTION zu einem Zeitpunkt des Masters (uint32_t) */
 
 // Status Parameter
 #define COM_IS_ALIVE	0x01
+#define COM_IS_READY	0x02 /**< ACK, wenn kein Servo mehr in Bewegung ist, sonst NAK */
+#define COM_BOOT		0x03 /**< Startzeit des Controllers in us (uint32_t) */
+#define COM_PROFILE		0x10 /**< + Abschnitt des Profilers (PRF_KIN, ...) */
+#define COM_STACK		0x20 /**< Stand von RAM und Stack (DT_stkInfo) */
+#define COM_TRACE		0x21 /**< ACK, danach Ausgabe des Ereignisprotokolls (TRC_dump()) */
 
 // Responses
 #define COM_ACK			0x06
@@ -34,6 +45,8 @@
 #define COM_ERR_ANGLE_LIMIT			0x01
 #define COM_ERR_POINT_OUT_OF_BOUNDS	0x02
 #define COM_ERR_DEFAULT_ERROR		0x03
+#define COM_ERR_CALIBRATION			0x04
+#define COM_ERR_MOVING				0x05
 
 // Config
 #define COM_CONF_RIGHT		0x01
@@ -43,25 +56,93 @@
 #define COM_CONF_KNEE		0x10
 #define COM_CONF_FOOT		0x20
 
+/**
+ * \def	COM_REAL_SIZE
+ * \brief	Bytes eines DT_real im Paket (DT_q16, Little Endian), unabhängig von DT_REAL.
+ */
+#define COM_REAL_SIZE		4
+
+/**
+ * \def	COM_ALIVE_TIMEOUT_US
+ * \brief	Wartezeit von COM_pollAlive() und COM_pollReady() auf die Antworten der Slaves.
+ */
+#define COM_ALIVE_TIMEOUT_US	20000
+
+/**
+ * \def	COM_BYTE_US
+ * \brief	Übertragungsdauer eines Bytes auf den Verbindungen (1 Mbps).
+ *
+ * \def	COM_SYNC_BURST
+ * \brief	Pakete je Abgleich (COM_syncClocks()), der Slave verwendet das mit der kleinsten Verzögerung.
+ *
+ * \def	COM_SYNC_GAP_US
+ * \brief	Abstand der Pakete eines Abgleichs.
+ *
+ * \def	COM_DRIFT_SPAN_US
+ * \brief	Kleinster Abstand zweier Abgleiche für eine neue Schätzung des Gangs.
+ *
+ * \def	COM_DRIFT_MAX_PPM
+ * \brief	Größter angenommener Gang zwischen zwei Uhren.
+ */
+#define COM_BYTE_US			10
+#define COM_SYNC_BURST		4
+#define COM_SYNC_GAP_US		500
+#define COM_DRIFT_SPAN_US	100000
+#define COM_DRIFT_MAX_PPM	1000
+
+/**
+ * \brief	Abgleich der eigenen Uhr (XM_getUptimeUs()) mit der des Masters.
+ *
+ * 			Zeit des Masters = eigene Zeit + offset + drift * (eigene Zeit -
+ * 			local_us) / 10^6. Auf dem Master bleibt alles 0.
+ */
+typedef struct {
+	int32_t offset; /**< Zeit des Masters - eigene Zeit beim letzten Abgleich in us. */
+	int32_t drift; /**< Gang der Uhr des Masters gegenüber der eigenen in ppm. */
+	uint32_t local_us; /**< Eigene Zeit des letzten Abgleichs. */
+	DT_byte syncs; /**< Abgeschlossene Abgleiche (höchstens 255). */
+	DT_byte next; /**< Erwartete Folgenummer, COM_SYNC_BURST ohne laufenden Abgleich. */
+	int32_t best; /**< Größter Versatz des laufenden Abgleichs (kleinste Verzögerung). */
+	uint32_t bestLocal_us; /**< Eigene Zeit zu best. */
+} DT_comClock;
+
 
 DT_byte COM_send(DT_byte* const, DT_size, DT_byte* const, DT_bool);
 DT_byte COM_receive(USART_data_t* const, DT_byte* const);
 
 DT_size COM_requestStatus(DT_byte, DT_byte, DT_byte* const);
 DT_bool COM_sendPoint(DT_byte, const DT_point* const, const DT_byte);
-DT_bool COM_sendPointAndSpeed(DT_byte, const DT_point* const, const DT_double, const DT_byte);
-DT_bool COM_sendAngle(DT_byte, const DT_double, const DT_byte);
+DT_bool COM_sendPointAndSpeed(DT_byte, const DT_point* const, const DT_real, const DT_byte);
+DT_bool COM_sendAngle(DT_byte, const DT_real, const DT_byte);
 void COM_sendAction(DT_byte);
+void COM_sendActionAt(DT_byte, uint32_t);
+void COM_syncClocks();
+void COM_onSync(const DT_byte* const, DT_size, uint32_t);
+const DT_comClock* COM_getClock();
+uint32_t COM_getMasterTimeUs();
+uint32_t COM_toLocalUs(uint32_t);
+uint32_t COM_getTimeFromPacket(const DT_byte* const);
 DT_bool COM_isAlive(DT_byte);
+DT_byte COM_pollAlive(DT_byte);
+DT_byte COM_pollReady(DT_byte);
+DT_bool COM_isReady(DT_byte);
+DT_bool COM_requestBoot(DT_byte, uint32_t* const);
+void COM_sendBoot(DT_byte, uint32_t);
+DT_bool COM_requestProfile(DT_byte, DT_byte, DT_prfScope* const);
+void COM_sendProfile(DT_byte, DT_byte);
+DT_bool COM_requestStack(DT_byte, DT_stkInfo* const);
+void COM_sendStack(DT_byte);
+DT_bool COM_requestTrace(DT_byte);
+DT_bool COM_sendCalibration(DT_byte, DT_byte, const DT_calServo* const);
 void COM_sendACK(DT_byte);
 void COM_sendNAK(DT_byte, DT_byte);
 
 DT_byte COM_getCpuID(const DT_leg* const);
-DT_double COM_byteArrayToDouble(const DT_byte* const);
-void COM_doubleToByteArray(const DT_double, DT_byte* const);
+DT_real COM_byteArrayToReal(const DT_byte* const);
+void COM_realToByteArray(const DT_real, DT_byte* const);
 DT_point COM_getPointFromPacket(const DT_byte* const);
-DT_double COM_getAngleFromPacket(const DT_byte* const);
-DT_double COM_getSpeedFromPacket(const DT_byte* const);
+DT_real COM_getAngleFromPacket(const DT_byte* const);
+DT_real COM_getSpeedFromPacket(const DT_byte* const);
 DT_bool COM_isLeftLeg(const DT_byte* const result);
 DT_bool COM_isRightLeg(const DT_byte* const result);
 DT_bool COM_isGlobal(const DT_byte* const result);
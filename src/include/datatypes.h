@@ -12,10 +12,37 @@
 #include <stdbool.h>
 
 #define DT_RESULT_BUFFER_SIZE 128	/**< Größe des Buffers für ein empfangenes Paket. */
+#define DT_SPS_POPSIZE 10			/**< Populationsgröße der unterbrechbaren Startpunktsuche. */
+#define DT_SPS_PARENT_CNT 5			/**< Anzahl der Eltern pro Generation der unterbrechbaren Startpunktsuche. */
+
+/**
+ * \def	DT_REAL
+ * \brief	Zahlendarstellung von DT_real: DT_REAL_FLOAT32 oder DT_REAL_FLOAT64.
+ *
+ * 			Ohne Vorgabe (-DDT_REAL=...) auf dem AVR float32 (double hat dort
+ * 			ebenfalls 4 Bytes) und auf dem Host float64. Über den Bus werden
+ * 			Werte unabhängig davon als DT_q16 übertragen (COM_REAL_SIZE).
+ */
+#define DT_REAL_FLOAT32 32
+#define DT_REAL_FLOAT64 64
+#ifndef DT_REAL
+#ifdef __AVR__
+#define DT_REAL DT_REAL_FLOAT32
+#else
+#define DT_REAL DT_REAL_FLOAT64
+#endif
+#endif
 
 typedef bool DT_bool;
 typedef int DT_int;
-typedef double DT_double;
+#if DT_REAL == DT_REAL_FLOAT32
+typedef float DT_real;
+#elif DT_REAL == DT_REAL_FLOAT64
+typedef double DT_real;
+#else
+#error "DT_REAL: DT_REAL_FLOAT32 oder DT_REAL_FLOAT64"
+#endif
+typedef int32_t DT_q16; /**< Festkomma Q16.16, Übertragungsformat für DT_real. */
 typedef uint8_t DT_byte;
 typedef uint16_t DT_size;
 typedef uint8_t DT_type;
@@ -25,13 +52,14 @@ typedef uint16_t DT_cmd;
 /** \brief Datenstruktur zur Speicherung von ID, Soll- und Ist-Wert eines Servos. */
 typedef struct {
 	DT_byte id; /**< Servo-ID. */
-	DT_double set_value; /**< Soll-Wert. */
-	DT_double act_value; /**< Ist-Wert. */
+	DT_real set_value; /**< Soll-Wert. */
+	DT_real act_value; /**< Ist-Wert. */
+	uint16_t ticks; /**< Soll-Position in Ticks aus set_value (CAL_radToTicks()). */
 } DT_servo;
 
 /** \brief Struktur zur vereinfachten Koordinatentransformation. */
 typedef struct {
-	DT_double x, y;
+	DT_real x, y;
 	DT_bool zRotation;
 } DT_transformation;
 
@@ -45,30 +73,63 @@ typedef struct {
 
 /** \brief Datenstruktur zur Speicherung karthesischer Koordinaten. */
 typedef struct {
-	DT_double x, y, z;
+	DT_real x, y, z;
 } DT_point;
 
 /** \brief Datenstruktur zur Speicherung eines Vektors. */
 typedef struct {
-	DT_double x, y;
+	DT_real x, y;
 } DT_vector;
 
 /** \brief Datenstruktur zur Speicherung einer linearen Funktion: y = mx + n. */
 typedef struct {
-	DT_double m;
-	DT_double n;
+	DT_real m;
+	DT_real n;
 } DT_lin_func;
 
 /** \brief Datenstruktur zur Speicherung einer Kreisfunktion: y = sqrt(r² - x²). */
 typedef struct {
-	DT_double sqr_r;
+	DT_real sqr_r;
 } DT_half_circle;
 
 /** \brief Datenstruktur für ein Individuum des Evolutionären Algorithmus zur Startpunktfindung. */
 typedef struct {
 	DT_point G;
-	DT_double F;
+	DT_real F;
 	DT_point S;
 } DT_individuum;
 
+/** \brief Zustand eines Pseudozufallszahlengenerators (xorshift32). */
+typedef struct {
+	uint32_t state;
+} DT_rng;
+
+/** \brief Parameter, Puffer und Zustand des Evolutionären Algorithmus zur Startpunktfindung. */
+typedef struct {
+	DT_int popsize; /**< Größe der Population. */
+	DT_int parentCnt; /**< Anzahl der Eltern pro Generation. */
+	DT_real px; /**< Rekombinationswahrscheinlichkeit. */
+	DT_real pm; /**< Mutationsrate. */
+	DT_real smax; /**< Maximale Schrittweite der Mutation. */
+	DT_individuum* P; /**< Aktuelle Population. */
+	DT_individuum* P_nextGen; /**< Population der nächsten Generation. */
+	DT_size* index; /**< Indizes für die Selektion der besten Individuen (popsize). */
+	DT_vector v; /**< Bewegungsrichtung (gedrehtes Koordinatensystem). */
+	DT_int generation; /**< Anzahl der berechneten Generationen. */
+	uint32_t evaluations; /**< Anzahl der Bewertungen seit EVO_init(). */
+	DT_rng rng; /**< Zufallszahlengenerator. */
+} DT_evo;
+
+/** \brief Zustand der unterbrechbaren Startpunktsuche. */
+typedef struct {
+	DT_evo evo; /**< Evolutionärer Algorithmus. */
+	DT_individuum buffer[2 * (DT_SPS_POPSIZE + 2 * DT_SPS_PARENT_CNT)]; /**< Puffer für beide Populationen. */
+	DT_size index[DT_SPS_POPSIZE]; /**< Puffer für die Selektion. */
+	uint32_t elapsed_us; /**< Bisher verbrauchte Rechenzeit. */
+	DT_size generation_us; /**< Längste gemessene Dauer einer Generation. */
+	DT_int stall; /**< Anzahl der Generationen ohne Verbesserung. */
+	DT_real bestF; /**< Güte beim letzten Fortschritt. */
+	DT_individuum best; /**< Bestes bisher gefundenes Individuum. */
+} DT_sps;
+
 #endif /* DATATYPES_H_ */
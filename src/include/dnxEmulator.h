@@ -0,0 +1,62 @@
+/**
+ * \file	dnxEmulator.h
+ *
+ * \brief	Emulation der Dynamixel AX-12 am Servo-Bus (Host).
+ *
+ * 			Die Servos hängen über XM_setTxHook() an XM_servo_data_R und
+ * 			XM_servo_data_L und antworten über XM_receiveByte(). Die Zeit wird
+ * 			virtuell aus der Übertragungsdauer bei 1 Mbps und der Return-Delay-Time
+ * 			berechnet.
+ */
+
+#ifndef DNXEMULATOR_H_
+#define DNXEMULATOR_H_
+
+#include "datatypes.h"
+#include "usart_driver.h"
+
+/**
+ * \def	DNE_SERVOS
+ * \brief	Anzahl der Servo-IDs (1 bis DNE_SERVOS).
+ *
+ * \def	DNE_TABLE_SIZE
+ * \brief	Größe der Control Table eines AX-12.
+ *
+ * \def	DNE_ALL_IDS
+ * \brief	Maske für DNE_init() mit allen Servos.
+ *
+ * \def	DNE_BYTE_US
+ * \brief	Übertragungsdauer eines Bytes bei 1 Mbps (Start, 8 Daten, Stop).
+ */
+#define DNE_SERVOS		18
+#define DNE_TABLE_SIZE	0x32
+#define DNE_ALL_IDS		0x0007FFFE
+#define DNE_BYTE_US		10
+
+/** \brief Belegung eines emulierten Servo-Busses. */
+typedef struct {
+	uint32_t transactions; /**< Anzahl der Instruktionspakete. */
+	uint32_t replies; /**< Anzahl der Statuspakete. */
+	uint32_t txBytes; /**< Gesendete Bytes des Controllers. */
+	uint32_t rxBytes; /**< Gesendete Bytes der Servos. */
+	uint32_t busy_us; /**< Summe der Belegung. */
+	uint32_t last_us; /**< Belegung der letzten Transaktion. */
+	uint32_t max_us; /**< Längste Transaktion. */
+} DT_dneStats;
+
+/** \brief Wird aufgerufen, wenn ein Servo eine ACTION-Instruktion ausführt. */
+typedef void (*DT_dneActionHook)(DT_byte);
+
+void DNE_init(uint32_t);
+void DNE_setRealTime(DT_bool);
+void DNE_setActionHook(DT_dneActionHook);
+void DNE_advance(uint32_t);
+uint32_t DNE_getTimeUs();
+DT_bool DNE_isConnected(DT_byte);
+DT_byte DNE_readByte(DT_byte, DT_byte);
+uint16_t DNE_readWord(DT_byte, DT_byte);
+const DT_dneStats* DNE_getStats(const USART_data_t* const);
+void DNE_resetStats();
+void DNE_printStats();
+
+#endif /* DNXEMULATOR_H_ */
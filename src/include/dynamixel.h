@@ -11,21 +11,148 @@
 #include "usart_driver.h"
 
 #define DNX_BRDCAST_ID 0xFE
+#define DNX_MAX_ID 18 /**< Größte ID der angeschlossenen Servos. */
+#define DNX_ALL_IDS 0x0007FFFE /**< Bitmaske der IDs 1 bis DNX_MAX_ID. */
+#define DNX_EEPROM_ADDR 0x0100 /**< Zuletzt gefundene Servos im EEPROM, hinter der Kalibrierung. */
+#define DNX_SPEED_KEEP 0xFFFF /**< DNX_stage(): Anfahrgeschwindigkeit nicht ändern. */
+#define DNX_QUEUE_SIZE 4 /**< Wartende Transaktionen je Bus in DNX_submit(). */
+#define DNX_TIMEOUT 100 /**< Abfragen von DNX_receive() je Antwort. */
+#define DNX_BUS_R 0x01 /**< Rechter Servo-Bus in DNX_fireAction(). */
+#define DNX_BUS_L 0x02 /**< Linker Servo-Bus in DNX_fireAction(). */
+
+/**
+ * \brief	Alle Servos beantworten jede Instruktion (Diagnose), sonst nur PING und READ.
+ */
+#define DNX_DIAG_OFF
+
+/**
+ * \def	DNX_STATUS_LEVEL
+ * \brief	Status Return Level, den DNX_getConnectedIDs() an alle Servos sendet.
+ *
+ * \def	DNX_RETURN_DELAY
+ * \brief	Return Delay Time beim Start (2 us je Einheit, Werkseinstellung 250).
+ */
+#ifdef DNX_DIAG_ON
+#define DNX_STATUS_LEVEL 2
+#else
+#define DNX_STATUS_LEVEL 1
+#endif
+#define DNX_RETURN_DELAY 0
+
+#define DNX_START_BYTE 0xFF
+
+// Instruction Set (Manual page 19)
+#define DNX_PING 0x01
+#define DNX_RD_DATA 0x02
+#define DNX_WR_DATA 0x03
+#define DNX_REG_WR 0x04
+#define DNX_ACT 0x05
+#define DNX_RESET 0x06
+#define DNX_SYC_WR 0x83
+
+// Control Table (Manuel page 12)
+#define DNX_ID 0x03
+#define DNX_BD 0x04
+#define DNX_RT_DLY 0x05
+#define DNX_MAX_TMP 0x0B
+#define DNX_STS_RT_LVL 0x10
+#define DNX_ALR_SHUTDWN 0x12
+#define DNX_GL_POS 0x1E
+#define DNX_LED 0x19
+#define DNX_MV_SPEED 0x20
+#define DNX_PRT_POS 0x24
+#define DNX_PRT_SPEED 0x26
+#define DNX_PRT_TMP 0x2B
+#define DNX_REG_INST 0x2C
+#define DNX_MOVING 0x2E
+
+// Fehlerbyte des Statuspakets (Manual page 12)
+#define DNX_ERR_VOLTAGE 0x01
+#define DNX_ERR_ANGLE 0x02
+#define DNX_ERR_OVERHEAT 0x04
+#define DNX_ERR_RANGE 0x08
+#define DNX_ERR_CHECKSUM 0x10
+#define DNX_ERR_OVERLOAD 0x20
+#define DNX_ERR_INSTRUCTION 0x40
+#define DNX_ERR_BITS 7 /**< Anzahl der Fehlerbits. */
+#define DNX_ERR_REJECTED (DNX_ERR_RANGE | DNX_ERR_CHECKSUM | DNX_ERR_INSTRUCTION) /**< Instruktion wurde nicht ausgeführt. */
+
+/**
+ * \brief	Zähler der vorgemerkten Zielpositionen (DNX_stage(), DNX_flush()).
+ */
+typedef struct {
+	uint32_t staged; /**< Vorgemerkte Zielpositionen. */
+	uint32_t skipped; /**< Davon unverändert und nicht gesendet. */
+	uint32_t frames; /**< Von DNX_flush() gesendete Instruktionspakete. */
+} DT_dnxStats;
+
+/**
+ * \brief	Transaktion mit einem Servo für DNX_submit().
+ *
+ * 			Paket und Antwortfeld gehören dem Aufrufer und müssen bis zum Ende
+ * 			von DNX_run() gültig bleiben.
+ */
+typedef struct {
+	DT_byte* packet; /**< Instruktionspaket, die Checksum wird beim Senden gesetzt. */
+	DT_size length; /**< Größe des Pakets. */
+	DT_bool hasResponse; /**< Auf eine Antwort warten. */
+	DT_byte* result; /**< Ziel der ganzen Antwort, NULL für einen Puffer aus PKT_RX. */
+	DT_byte received; /**< Größe der Antwort, 0 ohne Antwort. */
+	DT_byte error; /**< Fehlerbyte der Antwort. */
+	uint16_t value; /**< Bis zu zwei Parameterbytes der Antwort (Low, High). */
+} DT_dnxRequest;
+
+/**
+ * \brief	Zähler des Ablaufs eines Servo-Busses (DNX_run()).
+ */
+typedef struct {
+	uint32_t transactions; /**< Gesendete Instruktionspakete. */
+	uint32_t timeouts; /**< Erwartete Antworten, die nicht kamen. */
+	uint32_t overlapped; /**< Gesendet, während am anderen Bus eine Antwort ausstand. */
+	DT_byte maxDepth; /**< Größte Anzahl wartender Transaktionen. */
+	uint32_t last_us; /**< Latenz der letzten Antwort (Senden bis Antwort). */
+	uint32_t max_us; /**< Größte Latenz. */
+	uint32_t sum_us; /**< Summe der Latenzen. */
+} DT_dnxBusStats;
 
 DT_byte DNX_send(DT_byte* const, DT_size, DT_byte* const, DT_bool);
 DT_byte DNX_receive(USART_data_t* const, DT_byte* const);
+DT_bool DNX_submit(DT_dnxRequest* const);
+void DNX_run();
+const DT_dnxBusStats* DNX_getBusStats(const USART_data_t* const);
+void DNX_resetBusStats();
 
 DT_byte DNX_getChecksum(const DT_byte* const, DT_size);
-DT_bool DNX_setAngle(DT_byte, DT_double, DT_bool);
-DT_bool DNX_setAngleAndSpeed(DT_byte id, DT_double angle, DT_double speed, DT_bool regWrite);
+DT_bool DNX_setTicks(DT_byte, uint16_t, DT_bool);
+DT_bool DNX_setTicksAndSpeed(DT_byte, uint16_t, uint16_t, DT_bool);
+DT_bool DNX_setAngle(DT_byte, DT_real, DT_bool);
+DT_bool DNX_setAngleAndSpeed(DT_byte id, DT_real angle, DT_real speed, DT_bool regWrite);
 void DNX_setId(DT_byte, DT_byte);
 void DNX_setSpeed(DT_byte, DT_byte);
 DT_bool DNX_setLed(DT_byte, DT_byte);
 
-DT_double DNX_getAngle(DT_byte);
+DT_real DNX_getAngle(DT_byte);
 DT_byte DNX_getSpeed(DT_byte);
 DT_byte DNX_getLed(DT_byte);
+DT_bool DNX_isMoving(DT_byte);
+uint32_t DNX_getMoving(uint32_t);
+uint32_t DNX_ping(uint32_t);
 void DNX_getConnectedIDs(DT_leg* const, DT_leg* const);
 void DNX_sendAction(DT_byte);
+void DNX_fireAction();
+void DNX_logFiredAction();
+void DNX_stage(DT_byte, uint16_t, uint16_t);
+DT_byte DNX_flush(DT_bool);
+void DNX_invalidate(DT_byte);
+const DT_dnxStats* DNX_getStats();
+void DNX_resetStats();
+
+void DNX_setStatusLevel(DT_byte, DT_byte);
+void DNX_applyStatusLevel(uint32_t, DT_byte);
+DT_byte DNX_getStatusLevel(DT_byte);
+DT_bool DNX_expectsReply(DT_byte, DT_byte);
+DT_byte DNX_getError(DT_byte);
+uint16_t DNX_getErrorCount(DT_byte);
+void DNX_resetErrors();
 
 #endif /* DYNAMIXEL_H_ */
@@ -9,6 +9,25 @@
 
 #include "datatypes.h"
 
+/**
+ * \brief	Anzahl der Individuen im Puffer für EVO_init().
+ *
+ * 			Population und Nachkommen, jeweils für die aktuelle und die nächste Generation.
+ */
+#define EVO_BUFFER_SIZE(popsize, parentCnt) (2 * ((popsize) + 2 * (parentCnt)))
+
+/**
+ * \brief	Maximale Populationsgröße für evolutionaryAlgorithm().
+ *
+ * 			Die Puffer für EVO_BUFFER_SIZE() Individuen liegen auf dem Stack und
+ * 			sind für diese Größe bemessen, größere Populationen werden abgewiesen.
+ */
+#define EVO_MAX_POPSIZE	10
+
 DT_individuum evolutionaryAlgorithm(const DT_int popsize, const DT_int generations, DT_vector* const);
+void EVO_init(DT_evo* const, DT_individuum* const, DT_size* const, const DT_int, const DT_int, const uint32_t);
+void EVO_start(DT_evo* const, const DT_vector* const);
+void EVO_generation(DT_evo* const);
+DT_individuum EVO_best(const DT_evo* const);
 DT_point getPointFromIndividuum(DT_individuum *);
 DT_point getIsectFromIndividuum(DT_individuum *);
@@ -10,12 +10,33 @@
 
 #define Z  -129.1041
 
+/**
+ * \brief Ausgabe der Zwischenergebnisse auf stdo.
+ */
+#define EVO_PRINT_OFF
+
+/**
+ * \brief Bewertung der Individuen mit SG_scorePointFast() statt scorePoint().
+ */
+#define EVO_FAST_SCORE_OFF
+
+extern DT_lin_func AB, CD;		/**< Seitliche Randgeraden des Arbeitsraums. */
+extern DT_half_circle CEA, DFB;	/**< Innerer und äußerer Randkreis des Arbeitsraums. */
+
 DT_bool isInArea(const DT_point*);
-DT_double scorePoint(DT_vector* const , const DT_point* const , DT_point *);
+DT_real scorePoint(DT_vector* const , const DT_point* const , DT_point *);
 void bubblesort(DT_individuum*, const DT_int);
+DT_size selectBest(const DT_individuum* const, const DT_size, DT_size* const,
+		const DT_size);
 void initEvoAlg();
-DT_double max(DT_double, DT_double);
-DT_double min(DT_double, DT_double);
-DT_double getDistance(const DT_point* const , const DT_point* const );
+DT_real max(DT_real, DT_real);
+DT_real min(DT_real, DT_real);
+DT_real f_lin(const DT_lin_func *, const DT_real);
+DT_real getDistance(const DT_point* const , const DT_point* const );
+void rngSeed(DT_rng* const, uint32_t);
+uint32_t rngNext(DT_rng* const);
+DT_real rngUniform(DT_rng* const);
+DT_real rngRange(DT_rng* const, const DT_real, const DT_real);
+DT_int rngInt(DT_rng* const, const DT_int);
 void getFunctionOfPoints(DT_lin_func *, const DT_point* const ,
 		const DT_point * const );
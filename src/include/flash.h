@@ -0,0 +1,50 @@
+/**
+ * \file	flash.h
+ *
+ * \brief	Zugriff auf Konstanten im Flash.
+ *
+ * 			Auf dem XMEGA werden Tabellen mit PROGMEM und Texte mit PSTR() im
+ * 			Flash abgelegt und mit pgm_read_* bzw. den typisierten FL_read*
+ * 			gelesen. Auf dem Host liegen sie im normalen Speicher.
+ */
+
+#ifndef FLASH_H_
+#define FLASH_H_
+
+#include "datatypes.h"
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#include <string.h>
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+#define pgm_read_word(addr) (*(const uint16_t*) (addr))
+#define pgm_read_dword(addr) (*(const uint32_t*) (addr))
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+#endif
+
+/**
+ * \def	FL_readByte
+ * \brief	Liest ein DT_byte aus dem Flash.
+ *
+ * \def	FL_readWord
+ * \brief	Liest ein uint16_t bzw. int16_t aus dem Flash.
+ *
+ * \def	FL_readReal
+ * \brief	Liest ein DT_real aus dem Flash (auf dem AVR 4 Bytes).
+ *
+ * \def	FL_readStruct
+ * \brief	Kopiert eine Struktur aus dem Flash in das Ziel dest (Pointer).
+ */
+#define FL_readByte(addr) pgm_read_byte(addr)
+#define FL_readWord(addr) pgm_read_word(addr)
+#ifdef __AVR__
+#define FL_readReal(addr) pgm_read_float(addr)
+#else
+#define FL_readReal(addr) (*(const DT_real*) (addr))
+#endif
+#define FL_readStruct(dest, addr) memcpy_P((dest), (addr), sizeof(*(dest)))
+
+#endif /* FLASH_H_ */
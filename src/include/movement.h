@@ -12,15 +12,28 @@
 #define MV_DST_Y	208.5
 #define MV_DST_X	168.5
 
+extern uint32_t MV_bootUs[];
+
 void MV_action(DT_leg* const, DT_leg* const);
+void MV_actionAt(DT_leg* const, DT_leg* const, uint32_t);
+void MV_masterAction(DT_leg* const, DT_leg* const);
 void MV_slave(DT_byte, DT_leg* const, DT_leg* const);
+DT_bool MV_slaveStep(DT_byte, DT_leg* const, DT_leg* const);
 void MV_slaveStatus(const DT_byte* const, const DT_size);
+void MV_slaveReady(DT_leg* const, DT_leg* const);
 void MV_slavePoint(DT_leg* const, DT_leg* const, const DT_byte* const, DT_size);
 void MV_slavePointAndSpeed(DT_leg* const, DT_leg* const, const DT_byte* const, DT_size);
 void MV_slaveAngle(DT_leg* const, DT_leg* const, const DT_byte* const, DT_size);
+void MV_slaveCalibration(const DT_byte* const, DT_size);
+void MV_setTicks(DT_leg* const);
 DT_bool MV_point(DT_leg* const, const DT_point* const, DT_bool);
-DT_bool MV_pointAndSpeed(DT_leg* const, const DT_point* const, const DT_double, DT_bool);
+DT_bool MV_pointAndSpeed(DT_leg* const, const DT_point* const, const DT_real, DT_bool);
 void MV_masterCheckAlive();
+DT_bool MV_isReady(DT_leg* const, DT_leg* const);
+DT_bool MV_masterCheckStack();
+void MV_masterPollStack();
+DT_bool MV_masterDumpTrace();
+DT_bool MV_masterDumpProfile();
 void MV_doInitPosition (DT_leg* const, DT_leg* const);
 void MV_switchLegs(DT_byte* side, DT_byte* master_dwn, DT_byte* master_up,
 		DT_byte* slave_dwn, DT_byte* slave_up);
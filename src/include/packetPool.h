@@ -0,0 +1,48 @@
+/**
+ * \file	packetPool.h
+ *
+ * \brief	Gemeinsame Puffer für Sende- und Empfangspakete von COM und DNX.
+ *
+ * 			Statt in jeder Protokollmethode ein Paket und ein Antwortfeld mit
+ * 			DT_RESULT_BUFFER_SIZE Bytes auf dem Stack anzulegen, werden die Puffer
+ * 			mit PKT_acquire() aus zwei festen Pools geholt und mit PKT_release()
+ * 			zurückgegeben (beides O(1)). Die Anzahl der Puffer entspricht der
+ * 			größten Verschachtelung der Aufrufe, z.B. MV_slaveStep() (Empfang) ->
+ * 			MV_point() -> DNX_setAngle() (Senden, Antwort) -> COM_sendACK()
+ * 			(Senden). Ist ein Pool erschöpft, liefert PKT_acquire() NULL, die
+ * 			Methode bricht ohne zu senden ab und der Fehlschlag wird gezählt.
+ * 			Eine doppelte Rückgabe mit PKT_release() wird ebenso gezählt.
+ *
+ * 			Nur im Hauptprogramm verwenden, nicht in Interrupts.
+ */
+
+#ifndef PACKETPOOL_H_
+#define PACKETPOOL_H_
+
+#include "datatypes.h"
+
+/**
+ * \def	PKT_TX
+ * \brief	Pool der Sendepakete (PKT_TX_SIZE Bytes).
+ *
+ * \def	PKT_RX
+ * \brief	Pool der Empfangspakete (DT_RESULT_BUFFER_SIZE Bytes).
+ *
+ * \def	PKT_TX_SIZE
+ * \brief	Größe eines Sendepakets, das größte ist COM_sendProfile() (8 + PRF_SIZE).
+ */
+#define PKT_TX			0
+#define PKT_RX			1
+#define PKT_POOLS		2
+#define PKT_TX_SIZE		64
+#define PKT_TX_COUNT	3
+#define PKT_RX_COUNT	2
+
+DT_byte* PKT_acquire(DT_byte);
+void PKT_release(DT_byte* const);
+DT_byte PKT_getFree(DT_byte);
+DT_byte PKT_getMinFree(DT_byte);
+uint16_t PKT_getFailed(DT_byte);
+void PKT_resetStats();
+
+#endif /* PACKETPOOL_H_ */
@@ -0,0 +1,92 @@
+/**
+ * \file	profiler.h
+ *
+ * \brief	Laufzeitmessung instrumentierter Abschnitte auf dem Controller.
+ *
+ * 			Misst mit der Zeit seit dem Start (XM_getUptimeUs(), 32 Bit) die Dauer
+ * 			zwischen PRF_BEGIN und PRF_END und führt je Abschnitt Anzahl, Minimum,
+ * 			Mittelwert, Maximum und ein Histogramm mit logarithmischen Klassen
+ * 			(Zweierpotenzen) im RAM. Die Werte werden mit PRF_dump() über die
+ * 			Debug-USART oder mit dem Status-Parameter COM_PROFILE an den Master
+ * 			ausgegeben und mit showProfile auf dem Host dargestellt. Der Master
+ * 			gibt die Werte aller Controller mit MV_masterDumpProfile() aus.
+ *
+ * 			Lange Abschnitte wie PRF_PLANNER werden vollständig gemessen, die
+ * 			letzte Klasse des Histogramms enthält alle Dauern ab 32768 us.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "datatypes.h"
+
+/**
+ * \brief Instrumentierung der Abschnitte mit PRF_BEGIN und PRF_END.
+ */
+#define PRF_OFF
+
+/**
+ * \def	PRF_KIN
+ * \brief	Inverse Kinematik eines Beines (MV_point()).
+ *
+ * \def	PRF_DNX_PACKET
+ * \brief	Aufbau eines Servo-Pakets (DNX_setAngle()).
+ *
+ * \def	PRF_DNX_WAIT
+ * \brief	Warten auf die Antwort eines Servos (DNX_send()).
+ *
+ * \def	PRF_COM_WAIT
+ * \brief	Warten auf die Antwort eines Controllers (COM_send()).
+ *
+ * \def	PRF_PLANNER
+ * \brief	Startpunktsuche (evolutionaryAlgorithm(), SPS_step()).
+ *
+ * \def	PRF_BUCKETS
+ * \brief	Klassen des Histogramms: 0 us, 1 us, 2-3 us, ..., ab 32768 us.
+ */
+#define PRF_KIN			0
+#define PRF_DNX_PACKET	1
+#define PRF_DNX_WAIT	2
+#define PRF_COM_WAIT	3
+#define PRF_PLANNER		4
+#define PRF_SCOPES		5
+#define PRF_BUCKETS		17
+
+/**
+ * \def	PRF_SIZE
+ * \brief	Größe eines Abschnitts in PRF_toByteArray().
+ */
+#define PRF_SIZE		(4 + 4 + 4 + 4 + 2 * PRF_BUCKETS)
+
+#ifdef PRF_ON
+	#define PRF_BEGIN(scope) PRF_enter(scope);
+	#define PRF_END(scope) PRF_exit(scope);
+#else
+	#define PRF_BEGIN(scope) /* no profiling */
+	#define PRF_END(scope) /* no profiling */
+#endif
+
+/** \brief Messwerte eines Abschnitts. */
+typedef struct {
+	uint32_t count; /**< Anzahl der Messungen. */
+	uint32_t sum_us; /**< Summe der Dauer. */
+	uint32_t min_us; /**< Kürzeste Dauer. */
+	uint32_t max_us; /**< Längste Dauer. */
+	uint16_t hist[PRF_BUCKETS]; /**< Anzahl je Klasse (sättigend). */
+	uint32_t start; /**< Zeitpunkt von PRF_enter() (XM_getUptimeUs()). */
+} DT_prfScope;
+
+void PRF_reset();
+void PRF_enter(DT_byte);
+void PRF_exit(DT_byte);
+void PRF_record(DT_byte, uint32_t);
+DT_byte PRF_getBucket(uint32_t);
+const DT_prfScope* PRF_get(DT_byte);
+const DT_char* PRF_getName(DT_byte);
+DT_byte PRF_toByteArray(DT_byte, DT_byte* const);
+void PRF_fromByteArray(DT_prfScope* const, const DT_byte* const);
+void PRF_dump();
+void PRF_dumpCpu(DT_byte);
+void PRF_dumpScope(const DT_char* const, const DT_prfScope* const);
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,60 @@
+/**
+ * \file	scoreGrid.h
+ *
+ * \brief	Tabellenbasierte Bewertung von Startpunkten.
+ *
+ * 			Für SG_DIRECTIONS quantisierte Bewegungsrichtungen und ein grobes
+ * 			(x,y)-Gitter über den Arbeitsraum wird die in Bewegungsrichtung
+ * 			verbleibende Strecke offline berechnet (genScoreGrid.c) und im Flash
+ * 			abgelegt. SG_scorePointFast() interpoliert daraus in O(1).
+ */
+
+#ifndef SCOREGRID_H_
+#define SCOREGRID_H_
+
+#include "datatypes.h"
+#include "flash.h"
+
+/**
+ * \def	SG_DIRECTIONS
+ * \brief	Anzahl der quantisierten Bewegungsrichtungen (über 360°).
+ *
+ * \def	SG_X_MIN
+ * \brief	x-Koordinate der ersten Gitterspalte (Koordinatensystem des EA).
+ *
+ * \def	SG_Y_MIN
+ * \brief	y-Koordinate der ersten Gitterzeile (Koordinatensystem des EA).
+ *
+ * \def	SG_STEP
+ * \brief	Abstand der Gitterpunkte.
+ *
+ * \def	SG_COLS
+ * \brief	Anzahl der Gitterspalten.
+ *
+ * \def	SG_ROWS
+ * \brief	Anzahl der Gitterzeilen.
+ *
+ * \def	SG_SCALE
+ * \brief	Auflösung der gespeicherten Strecken (Einträge pro Längeneinheit).
+ */
+#define SG_DIRECTIONS	32
+#define SG_X_MIN		-84
+#define SG_Y_MIN		40
+#define SG_STEP			8
+#define SG_COLS			22
+#define SG_ROWS			13
+#define SG_SCALE		100
+
+/**
+ * \brief	Verbleibende Strecke je Richtung und Gitterpunkt in 1/SG_SCALE.
+ *
+ * 			Außerhalb des Arbeitsraums wird die Strecke linear fortgesetzt
+ * 			(negativ hinter dem Austrittspunkt), damit die Interpolation am Rand
+ * 			nicht mit Nullwerten mittelt. Generiert mit genScoreGrid.c.
+ */
+extern const int16_t SG_grid[SG_DIRECTIONS][SG_ROWS][SG_COLS] PROGMEM;
+
+DT_real SG_scorePointFast(const DT_vector* const, const DT_point* const,
+		DT_point*);
+
+#endif /* SCOREGRID_H_ */
@@ -0,0 +1,78 @@
+/**
+ * \file	stack.h
+ *
+ * \brief	Überwachung des höchsten Stands von Stack und RAM.
+ *
+ * 			STK_paint() füllt beim Start den freien RAM zwischen dem Ende von .bss
+ * 			und dem Stack mit STK_PATTERN. STK_poll() prüft bei jedem Aufruf
+ * 			höchstens STK_SCAN Bytes ab dem unteren Ende und verschiebt die Marke
+ * 			des höchsten Stands, sobald ein überschriebenes Byte gefunden wird.
+ * 			Die Hauptschleifen von Master und Slave setzen mit STK_begin() die
+ * 			Basis ihrer Aufrufkette. Der Verbrauch ab dieser Basis wird mit dem
+ * 			Budget der Kette verglichen.
+ *
+ * 			Der Master fragt die Werte der Slaves mit dem Status-Parameter
+ * 			COM_STACK ab, ramReport stellt sie auf dem Host neben dem statischen
+ * 			RAM je Modul dar.
+ *
+ * 			Auf dem Host wird nur ein mit STK_setRegion() gesetzter Bereich (z.B.
+ * 			der Stack eines ucontext) überwacht.
+ */
+
+#ifndef STACK_H_
+#define STACK_H_
+
+#include "datatypes.h"
+
+#define STK_PATTERN		0xC5
+#define STK_GUARD		32 /**< Nicht gefüllte Bytes unter dem Stackpointer in STK_paint(). */
+#define STK_SCAN		32 /**< Geprüfte Bytes je STK_poll(). */
+
+/**
+ * \def	STK_MASTER
+ * \brief	Aufrufkette der Hauptschleife des Masters (Gangprogramme).
+ *
+ * \def	STK_SLAVE
+ * \brief	Aufrufkette von MV_slave().
+ *
+ * \def	STK_BUDGET_MASTER
+ * \brief	Erlaubter Stack der Kette STK_MASTER in Bytes (enthält die
+ * 			Populationen von evolutionaryAlgorithm()).
+ *
+ * \def	STK_BUDGET_SLAVE
+ * \brief	Erlaubter Stack der Kette STK_SLAVE in Bytes.
+ */
+#define STK_MASTER			0
+#define STK_SLAVE			1
+#define STK_CHAINS			2
+#define STK_BUDGET_MASTER	2048
+#define STK_BUDGET_SLAVE	1024
+
+/**
+ * \def	STK_SIZE
+ * \brief	Größe von DT_stkInfo in STK_toByteArray().
+ */
+#define STK_SIZE			11
+
+/** \brief Stand von RAM und Stack eines Controllers. */
+typedef struct {
+	DT_size staticRam; /**< .data und .bss in Bytes. */
+	DT_size used; /**< Höchster Stand des Stacks in Bytes. */
+	DT_size free; /**< Nie benutzter RAM zwischen .bss und Stack in Bytes. */
+	DT_byte chain; /**< Aktive Aufrufkette oder STK_CHAINS. */
+	DT_size chainUsed; /**< Höchster Stand ab der Basis der Kette in Bytes. */
+	DT_size chainBudget; /**< Budget der Kette in Bytes. */
+} DT_stkInfo;
+
+#ifndef __AVR__
+void STK_setRegion(DT_byte* const, DT_byte* const);
+#endif
+void STK_paint();
+void STK_poll();
+void STK_begin(DT_byte);
+void STK_getInfo(DT_stkInfo* const);
+void STK_toByteArray(const DT_stkInfo* const, DT_byte* const);
+void STK_fromByteArray(DT_stkInfo* const, const DT_byte* const);
+void STK_dump(DT_byte, const DT_stkInfo* const);
+
+#endif /* STACK_H_ */
@@ -0,0 +1,18 @@
+/**
+ * \file	startPoint.h
+ *
+ * \brief	Analytische Startpunktfindung.
+ *
+ * 			Bestimmt für eine Bewegungsrichtung die längste Sehne des Arbeitsraums
+ * 			direkt aus den Randfunktionen AB, CD, CEA und DFB.
+ */
+
+#ifndef STARTPOINT_H_
+#define STARTPOINT_H_
+
+#include "datatypes.h"
+
+DT_individuum SP_calcStartPoint(DT_vector* const);
+DT_real SP_scorePoint(DT_vector* const, const DT_point* const, DT_point*);
+
+#endif /* STARTPOINT_H_ */
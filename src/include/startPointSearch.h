@@ -0,0 +1,24 @@
+/**
+ * \file	startPointSearch.h
+ *
+ * \brief	Unterbrechbare Startpunktsuche mit Zeitbudget.
+ *
+ * 			Führt den Evolutionären Algorithmus in Zeitscheiben aus, sodass die
+ * 			Suche zwischen den Aufgaben der Steuerschleife fortgesetzt werden kann.
+ */
+
+#ifndef STARTPOINTSEARCH_H_
+#define STARTPOINTSEARCH_H_
+
+#include "datatypes.h"
+
+/**
+ * \brief Ausgabe von Generation, Rechenzeit und Güte nach jedem Schritt auf stdo.
+ */
+#define SPS_LOG_OFF
+
+void SPS_init(DT_sps* const, const DT_vector* const);
+DT_bool SPS_step(DT_sps* const, const DT_size);
+DT_individuum SPS_best(const DT_sps* const);
+
+#endif /* STARTPOINTSEARCH_H_ */
@@ -0,0 +1,17 @@
+/**
+ * \file	test.h
+ *
+ * \brief	Gemeinsame Prüfung der Testprogramme (Host).
+ *
+ * 			CHECK gibt eine fehlgeschlagene Bedingung mit Zeile aus und erhöht die
+ * 			lokale Variable errors, die das Testprogramm am Ende zurückgibt.
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+#define CHECK(cond) if (!(cond)) { printf("FEHLER: %s (Zeile %d)\n", #cond, __LINE__); errors++; }
+
+#endif /* TEST_H_ */
@@ -0,0 +1,82 @@
+/**
+ * \file	trace.h
+ *
+ * \brief	Ereignisprotokoll mit Korrelations-ID für die Latenz eines Schritts.
+ *
+ * 			Jedes COM-Paket trägt vor der Prüfsumme die Korrelations-ID des
+ * 			aktuellen Schritts. Der Master erhöht sie nach COM_sendAction(), die
+ * 			Slaves übernehmen sie aus jedem empfangenen Paket. Jeder Controller
+ * 			schreibt die wichtigen Ereignisse mit Zeitstempel (XM_getUptimeUs()) in
+ * 			einen Ringpuffer, der mit TRC_dump() ausgegeben wird. Der Master löst
+ * 			die Ausgabe aller Controller mit MV_masterDumpTrace() aus (COM_TRACE).
+ * 			traceMerge führt
+ * 			die Protokolle der drei Controller auf dem Host zu einer Zeitleiste je
+ * 			Schritt zusammen.
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "datatypes.h"
+
+/**
+ * \brief Aufzeichnung der Ereignisse mit TRC_EVENT, die Korrelations-ID wird immer weitergegeben.
+ */
+#define TRC_ON
+
+/**
+ * \def	TRC_SIZE
+ * \brief	Anzahl der Ereignisse im Ringpuffer (Zweierpotenz).
+ */
+#define TRC_SIZE		64
+
+/**
+ * \def	TRC_CMD_BUILT
+ * \brief	COM-Paket aufgebaut (Argument: Ziel).
+ *
+ * \def	TRC_FRAME_SENT
+ * \brief	Beginn der Übertragung eines COM-Pakets (Argument: Ziel).
+ *
+ * \def	TRC_FRAME_RECEIVED
+ * \brief	COM-Paket vollständig empfangen (Argument: Gegenstelle).
+ *
+ * \def	TRC_IK_DONE
+ * \brief	Inverse Kinematik eines Beines berechnet (Argument: Hüft-Servo).
+ *
+ * \def	TRC_SERVO_SENT
+ * \brief	Servo-Paket an die USART übergeben (Argument: Servo-ID).
+ *
+ * \def	TRC_ACTION
+ * \brief	ACTION an alle Servos eines Controllers gesendet.
+ */
+#define TRC_CMD_BUILT		1
+#define TRC_FRAME_SENT		2
+#define TRC_FRAME_RECEIVED	3
+#define TRC_IK_DONE			4
+#define TRC_SERVO_SENT		5
+#define TRC_ACTION			6
+
+#ifdef TRC_ON
+	#define TRC_EVENT(event, arg) TRC_event(event, arg);
+#else
+	#define TRC_EVENT(event, arg) /* no trace */
+#endif
+
+/** \brief Ereignis im Ringpuffer. */
+typedef struct {
+	uint32_t t; /**< Zeitstempel in us (XM_getUptimeUs(), modulo 2^32). */
+	DT_byte corr; /**< Korrelations-ID. */
+	DT_byte event; /**< Ereignis (TRC_CMD_BUILT, ...). */
+	DT_byte arg; /**< Argument des Ereignisses. */
+} DT_trcEvent;
+
+void TRC_init(DT_byte);
+DT_byte TRC_getCorrelation();
+void TRC_setCorrelation(DT_byte);
+void TRC_next();
+void TRC_event(DT_byte, DT_byte);
+DT_byte TRC_count();
+const DT_trcEvent* TRC_get(DT_byte);
+void TRC_dump();
+
+#endif /* TRACE_H_ */
@@ -59,7 +59,11 @@
 #ifndef USART_DRIVER_H
 #define USART_DRIVER_H
 
+#ifdef __AVR_XMEGA__
 #include "avr_compiler.h"
+#else
+#include "xmegaHost.h"
+#endif
 #include "datatypes.h"
 
 /* USART buffer defines. */
@@ -108,7 +112,7 @@ typedef struct Usart_and_buffer {
 	USART_DREINTLVL_t dreIntLevel;
 	/* \brief Data buffer. */
 	USART_Buffer_t buffer;
-	/* \brief Größe des zuletzt gesendeten Pakets */
+	/* \brief Anzahl der gesendeten Bytes, deren Echo noch verworfen werden muss */
 	DT_byte lastPacketLength;
 	/* \brief Größe des zuletzt gesendeten Pakets */
 	PORT_t* port;
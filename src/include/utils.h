@@ -9,30 +9,65 @@
 #ifndef UTILS_H_
 #define UTILS_H_
 
+#include <math.h>
 #include "datatypes.h"
+#include "flash.h"
 
 #define UTL_DEG 1
 #define UTL_RAD 0
 
+/**
+ * \brief	Mathematische Funktionen in der Genauigkeit von DT_real.
+ *
+ * 			Mit DT_REAL_FLOAT32 werden die float-Varianten der libm benutzt, damit
+ * 			auf dem Host nicht in double gerechnet wird.
+ */
+#if DT_REAL == DT_REAL_FLOAT32
+#define UTL_sin sinf
+#define UTL_cos cosf
+#define UTL_asin asinf
+#define UTL_acos acosf
+#define UTL_atan atanf
+#define UTL_sqrt sqrtf
+#define UTL_fabs fabsf
+#else
+#define UTL_sin sin
+#define UTL_cos cos
+#define UTL_asin asin
+#define UTL_acos acos
+#define UTL_atan atan
+#define UTL_sqrt sqrt
+#define UTL_fabs fabs
+#endif
+#define UTL_PI ((DT_real) M_PI)
+#define UTL_RAD_PER_DEG ((DT_real) (M_PI / 180)) /**< Faktor Grad nach Bogenmaß. */
+#define UTL_DEG_PER_RAD ((DT_real) (180 / M_PI)) /**< Faktor Bogenmaß nach Grad. */
+
 #define DEBUG_ON debug
 #ifdef DEBUG_ON
 	#define DEBUG(output) UTL_printDebug output;
 	#define DEBUG_BYTE(output) UTL_printDebugByte output;
+	#define DEBUG_P(msg) UTL_printDebugP(PSTR(msg), sizeof(msg));
 #else
 	#define DEBUG(output) /* no debug */
 	#define DEBUG_BYTE(output) /* no debug */
+	#define DEBUG_P(msg) /* no debug */
 #endif
 
-void UTL_printMatrix(const DT_double** const, DT_size, DT_size);
+void UTL_printMatrix(const DT_real** const, DT_size, DT_size);
 void UTL_printLeg(const DT_leg* const, DT_type);
 void UTL_printPoint(const DT_point* const);
 
-DT_double UTL_getRadiant(DT_double);
-DT_double UTL_getDegree(DT_double);
-DT_point UTL_getPointOfDH(const DT_double** const);
+DT_real UTL_getRadiant(DT_real);
+DT_real UTL_getDegree(DT_real);
+DT_point UTL_getPointOfDH(const DT_real** const);
+DT_q16 UTL_realToQ16(DT_real);
+DT_real UTL_q16ToReal(DT_q16);
 
 void UTL_printDebug(const DT_char* const, DT_size);
+void UTL_printDebugP(const DT_char* const, DT_size);
 void UTL_printDebugByte(const DT_byte* const, DT_size);
+void UTL_printNumber(uint32_t);
 DT_byte UTL_byteToHexChar(DT_char* const, const DT_byte* const, DT_size);
 
 void UTL_wait(DT_size);
@@ -0,0 +1,52 @@
+/**
+ * \file	workspaceGrid.h
+ *
+ * \brief	Belegungsraster des Arbeitsraums.
+ *
+ * 			Der Arbeitsraum (Koordinatensystem des EA) wird in Zellen der Größe
+ * 			WS_CELL eingeteilt. Je Zelle speichern zwei Bitfelder im Flash, ob sie
+ * 			vollständig im Arbeitsraum liegt oder vom Rand geschnitten wird.
+ * 			Generiert mit genWorkspaceGrid.c.
+ */
+
+#ifndef WORKSPACEGRID_H_
+#define WORKSPACEGRID_H_
+
+#include "datatypes.h"
+#include "flash.h"
+
+/**
+ * \def	WS_X_MIN
+ * \brief	x-Koordinate der ersten Zellspalte.
+ *
+ * \def	WS_Y_MIN
+ * \brief	y-Koordinate der ersten Zellzeile.
+ *
+ * \def	WS_CELL
+ * \brief	Kantenlänge einer Zelle.
+ *
+ * \def	WS_COLS
+ * \brief	Anzahl der Zellspalten.
+ *
+ * \def	WS_ROWS
+ * \brief	Anzahl der Zellzeilen.
+ *
+ * \def	WS_ROW_BYTES
+ * \brief	Anzahl der Bytes je Zeile eines Bitfelds.
+ */
+#define WS_X_MIN		-84
+#define WS_Y_MIN		40
+#define WS_CELL			1
+#define WS_COLS			168
+#define WS_ROWS			90
+#define WS_ROW_BYTES	((WS_COLS + 7) / 8)
+
+extern const uint8_t WS_inside[WS_ROWS][WS_ROW_BYTES] PROGMEM; /**< Zelle liegt vollständig im Arbeitsraum. */
+extern const uint8_t WS_boundary[WS_ROWS][WS_ROW_BYTES] PROGMEM; /**< Zelle wird vom Rand geschnitten. */
+extern const uint16_t WS_rowStart[WS_ROWS + 1] PROGMEM; /**< Anzahl der inneren Zellen vor jeder Zeile. */
+
+DT_bool WS_isInAreaExact(const DT_point* const);
+DT_bool WS_isInAreaFast(const DT_point* const);
+DT_point WS_samplePoint(DT_rng* const);
+
+#endif /* WORKSPACEGRID_H_ */
@@ -2,6 +2,10 @@
  * \file 	xmega.h
  *
  * \brief 	Spezifische Funktionen für den Mikrocontroller ATXmega128A1.
+ *
+ * 			Schnittstelle zur Hardware (USARTs, Ports, LED, Taster, Zeitbasis).
+ * 			Implementiert in xmega.c für den XMEGA und in xmegaHost.c für den Host
+ * 			und für andere AVR-Kerne (simavr, siehe benchAvr.c).
  */
 
 #ifndef XMEGA_H_
@@ -10,6 +14,8 @@
 #include "usart_driver.h"
 #include "datatypes.h"
 
+#ifdef __AVR_XMEGA__
+
 #define XM_PORT_SERVO_L PORTC
 #define XM_PORT_SERVO_R PORTD
 #define XM_PORT_COM1	PORTD
@@ -39,19 +45,67 @@
 
 #define XM_OE_MASK (1<<PIN0)
 
-USART_data_t XM_servo_data_L;	/**< USART-Struktur für linke Dynamixel. */
-USART_data_t XM_servo_data_R;	/**< USART-Struktur für rechte Dynamixel. */
-USART_data_t XM_debug_data;		/**< USART-Struktur für Debug-Ausgaben. */
-USART_data_t XM_remote_data;	/**< USART-Struktur für Remote-Controller. */
-USART_data_t XM_com_data1;		/**< USART-Struktur für Communication (Master -> Slave 1). */
-USART_data_t XM_com_data3;		/**< USART-Struktur für Communication (Master -> Slave 3).*/
+#else
+
+/* LED und Taster des Hosts, siehe xmegaHost.c */
+#define XM_LED_ON XM_setLed(true);
+#define XM_LED_OFF XM_setLed(false);
+#define XM_LED_TGL XM_setLed(!XM_getLed());
+
+#define SWITCH_PRESSED XM_isSwitchPressed()
+#define SWITCH_RELEASED !XM_isSwitchPressed()
+
+/**
+ * \brief	Empfänger der gesendeten Bytes einer USART auf dem Host.
+ *
+ * 			Wird von XM_USART_send() mit dem vollständigen Paket aufgerufen und kann
+ * 			die Antwort über XM_receiveByte() zurückgeben.
+ */
+typedef void (*DT_txHook)(USART_data_t* const, const DT_byte* const, DT_size);
+
+void XM_setLed(DT_bool);
+DT_bool XM_getLed();
+DT_bool XM_isSwitchPressed();
+void XM_setSwitch(DT_bool);
+void XM_setTxHook(USART_data_t* const, DT_txHook);
+void XM_ignoreTx(USART_data_t* const, const DT_byte* const, DT_size);
+void XM_receiveByte(USART_data_t* const, DT_byte);
+#ifdef __AVR__
+uint32_t XM_getCycles();
+#endif
+
+#endif /* __AVR_XMEGA__ */
+
+extern USART_data_t XM_servo_data_L;	/**< USART-Struktur für linke Dynamixel. */
+extern USART_data_t XM_servo_data_R;	/**< USART-Struktur für rechte Dynamixel. */
+extern USART_data_t XM_debug_data;		/**< USART-Struktur für Debug-Ausgaben. */
+extern USART_data_t XM_remote_data;		/**< USART-Struktur für Remote-Controller. */
+extern USART_data_t XM_com_data1;		/**< USART-Struktur für Communication (Master -> Slave 1). */
+extern USART_data_t XM_com_data3;		/**< USART-Struktur für Communication (Master -> Slave 3).*/
+
+/**
+ * \brief	Wird von XM_setAlarm() zum vereinbarten Zeitpunkt aufgerufen.
+ *
+ * 			Auf dem XMEGA in der ISR des Timers (Interrupt-Level hoch).
+ */
+typedef void (*DT_alarmHook)();
 
 #define XM_USART_FAILURE  0xFF /**< signalisiert Fehler beim Empfangen */
+#define XM_EEPROM_SIZE	2048 /**< Größe des EEPROM des ATXmega128A1 in Bytes. */
 
 void XM_init_cpu();
 void XM_init_remote();
 void XM_init_dnx();
 void XM_init_com(DT_byte);
+DT_size XM_getTimeUs();
+uint32_t XM_getUptimeUs();
+void XM_setAlarm(uint32_t, DT_alarmHook);
+DT_bool XM_isAlarmPending();
+void XM_debugPutChar(DT_char);
+DT_bool XM_debugTryPutChar(DT_byte);
 void XM_USART_send(USART_data_t* const, const DT_byte* const, DT_size);
+DT_bool XM_USART_trySend(USART_data_t* const, const DT_byte* const, DT_size);
+void XM_eepromRead(DT_size, DT_byte* const, DT_size);
+void XM_eepromWrite(DT_size, const DT_byte* const, DT_size);
 
 #endif /* XMEGA_H_ */
@@ -0,0 +1,64 @@
+/**
+ * \file 	xmegaHost.h
+ *
+ * \brief 	Nachbildung der XMEGA-Register für den Host.
+ *
+ * 			Ersetzt auf dem Host avr_compiler.h und <avr/io.h>. Definiert nur die
+ * 			Registerstrukturen und Bitmasken, die usart_driver.c benötigt, damit
+ * 			der Treiber unverändert übersetzt werden kann. Die Hardware selbst
+ * 			bildet xmegaHost.c nach.
+ *
+ * 			Wird auch für AVR-Kerne ohne XMEGA-Peripherie verwendet (simavr).
+ */
+
+#ifndef XMEGAHOST_H_
+#define XMEGAHOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * \brief	Register einer USART.
+ */
+typedef struct USART_struct {
+	volatile uint8_t DATA;
+	volatile uint8_t STATUS;
+	volatile uint8_t CTRLA;
+	volatile uint8_t CTRLB;
+	volatile uint8_t CTRLC;
+	volatile uint8_t BAUDCTRLA;
+	volatile uint8_t BAUDCTRLB;
+} USART_t;
+
+/**
+ * \brief	Register eines I/O-Ports.
+ */
+typedef struct PORT_struct {
+	volatile uint8_t DIR;
+	volatile uint8_t OUT;
+	volatile uint8_t IN;
+} PORT_t;
+
+/**
+ * \brief	Interrupt-Level für "Data Register Empty".
+ */
+typedef enum USART_DREINTLVL_enum {
+	USART_DREINTLVL_OFF_gc = (0x00 << 0),
+	USART_DREINTLVL_LO_gc = (0x01 << 0),
+	USART_DREINTLVL_MED_gc = (0x02 << 0),
+	USART_DREINTLVL_HI_gc = (0x03 << 0)
+} USART_DREINTLVL_t;
+
+#define USART_DREINTLVL_gm	0x03
+#define USART_TXB8_bm		0x01
+#define USART_RXB8_bm		0x02
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#else
+#define cli()
+#define sei()
+#endif
+
+#endif /* XMEGAHOST_H_ */
@@ -12,6 +12,7 @@
 #include "include/kinematics.h"
 #include "include/utils.h"
 #include "include/dynamixel.h"
+#include "include/flash.h"
 
 /**
  * \def	DIST_HK
@@ -31,52 +32,47 @@
 #define DIST_FE 55
 #define DIST_DZ -14
 
+/**
+ * \def	KIN_LEGS
+ * \brief	Anzahl der Beine in KIN_LEG_TRANS.
+ *
+ * \def	KIN_HIP_STEP
+ * \brief	Abstand der Hüft-IDs benachbarter Beine (1, 4, 7, ...).
+ */
+#define KIN_LEGS 6
+#define KIN_HIP_STEP 3
+
+/**
+ * \brief	Koordinatentransformation je Bein im Flash, Index (Hüft-ID - 1) / 3.
+ */
+const DT_transformation KIN_LEG_TRANS[KIN_LEGS] PROGMEM = {
+		{ 168.5, 208.5, false }, // 1
+		{ -168.5, 208.5, true }, // 4
+		{ 168.5, 0, false }, // 7
+		{ -168.5, 0, true }, // 10
+		{ 168.5, -208.5, false }, // 13
+		{ -168.5, -208.5, true } // 16
+};
+
 /**
  * \brief	Liefert fuer ein Bein die Struktur zur Koordinatentransformation.
  *
- * 			Liefert fuer ein Bein die Struktur zur Koordinatentransformation.
+ * 			Liest die Struktur zur Koordinatentransformation über die Hüft-ID aus
+ * 			KIN_LEG_TRANS.
  *
  * \param	leg		Bein
  */
 void KIN_setTransMat(DT_leg* const leg) {
-	switch (leg->hip.id) {
-	case 1:
-		leg->trans.x = 168.5;
-		leg->trans.y = 208.5;
-		leg->trans.zRotation = false;
-		break;
-	case 4:
-		leg->trans.x = -168.5;
-		leg->trans.y = 208.5;
-		leg->trans.zRotation = true;
-		break;
-	case 7:
-		leg->trans.x = 168.5;
-		leg->trans.y = 0;
-		leg->trans.zRotation = false;
-		break;
-	case 10:
-		leg->trans.x = -168.5;
-		leg->trans.y = 0;
-		leg->trans.zRotation = true;
-		break;
-	case 13:
-		leg->trans.x = 168.5;
-		leg->trans.y = -208.5;
-		leg->trans.zRotation = false;
-		break;
-	case 16:
-		leg->trans.x = -168.5;
-		leg->trans.y = -208.5;
-		leg->trans.zRotation = true;
-		break;
-	default:
-		DEBUG(("KIN_noID", sizeof("KIN_noID")))
+	const DT_byte index = (leg->hip.id - 1) / KIN_HIP_STEP;
+	if (leg->hip.id == 0 || (leg->hip.id - 1) % KIN_HIP_STEP != 0 || index
+			>= KIN_LEGS) {
+		DEBUG_P("KIN_noID")
 		leg->trans.x = 0;
 		leg->trans.y = 0;
 		leg->trans.zRotation = false;
-		break;
+		return;
 	}
+	FL_readStruct(&leg->trans, &KIN_LEG_TRANS[index]);
 }
 
 /**
@@ -87,40 +83,40 @@ void KIN_setTransMat(DT_leg* const leg) {
  * \param	leg		Bein mit den Soll-Winkel der Gelenke
  * \param	dh03	Zielmatrix für die Lösung
  */
-void KIN_calcDH(const DT_leg* const leg, DT_double** dh03) {
-	dh03[0][0] = cos(leg->hip.set_value) * cos(leg->knee.set_value) * cos(
-			leg->foot.set_value) - cos(leg->hip.set_value) * sin(
-			leg->knee.set_value) * sin(leg->foot.set_value);
-	dh03[0][1] = -cos(leg->hip.set_value) * cos(leg->knee.set_value) * sin(
-			leg->foot.set_value) - cos(leg->hip.set_value) * cos(
-			leg->foot.set_value) * sin(leg->knee.set_value);
-	dh03[0][2] = -sin(leg->hip.set_value);
-	dh03[0][3] = 50 * cos(leg->hip.set_value) + 85 * cos(leg->hip.set_value)
-			* cos(leg->knee.set_value) - 55 * cos(leg->hip.set_value) * sin(
-			leg->knee.set_value) * sin(leg->foot.set_value) + 55 * cos(
-			leg->hip.set_value) * cos(leg->knee.set_value) * cos(
+void KIN_calcDH(const DT_leg* const leg, DT_real** dh03) {
+	dh03[0][0] = UTL_cos(leg->hip.set_value) * UTL_cos(leg->knee.set_value) * UTL_cos(
+			leg->foot.set_value) - UTL_cos(leg->hip.set_value) * UTL_sin(
+			leg->knee.set_value) * UTL_sin(leg->foot.set_value);
+	dh03[0][1] = -UTL_cos(leg->hip.set_value) * UTL_cos(leg->knee.set_value) * UTL_sin(
+			leg->foot.set_value) - UTL_cos(leg->hip.set_value) * UTL_cos(
+			leg->foot.set_value) * UTL_sin(leg->knee.set_value);
+	dh03[0][2] = -UTL_sin(leg->hip.set_value);
+	dh03[0][3] = 50 * UTL_cos(leg->hip.set_value) + 85 * UTL_cos(leg->hip.set_value)
+			* UTL_cos(leg->knee.set_value) - 55 * UTL_cos(leg->hip.set_value) * UTL_sin(
+			leg->knee.set_value) * UTL_sin(leg->foot.set_value) + 55 * UTL_cos(
+			leg->hip.set_value) * UTL_cos(leg->knee.set_value) * UTL_cos(
 			leg->foot.set_value);
 
-	dh03[1][0] = cos(leg->knee.set_value) * cos(leg->foot.set_value) * sin(
-			leg->hip.set_value) - sin(leg->hip.set_value) * sin(
-			leg->knee.set_value) * sin(leg->foot.set_value);
-	dh03[1][1] = -cos(leg->knee.set_value) * sin(leg->hip.set_value) * sin(
-			leg->foot.set_value) - cos(leg->foot.set_value) * sin(
-			leg->hip.set_value) * sin(leg->knee.set_value);
-	dh03[1][2] = cos(leg->hip.set_value);
-	dh03[1][3] = 50 * sin(leg->hip.set_value) + 85 * cos(leg->knee.set_value)
-			* sin(leg->hip.set_value) - 55 * sin(leg->hip.set_value) * sin(
-			leg->knee.set_value) * sin(leg->foot.set_value) + 55 * cos(
-			leg->knee.set_value) * cos(leg->foot.set_value) * sin(
+	dh03[1][0] = UTL_cos(leg->knee.set_value) * UTL_cos(leg->foot.set_value) * UTL_sin(
+			leg->hip.set_value) - UTL_sin(leg->hip.set_value) * UTL_sin(
+			leg->knee.set_value) * UTL_sin(leg->foot.set_value);
+	dh03[1][1] = -UTL_cos(leg->knee.set_value) * UTL_sin(leg->hip.set_value) * UTL_sin(
+			leg->foot.set_value) - UTL_cos(leg->foot.set_value) * UTL_sin(
+			leg->hip.set_value) * UTL_sin(leg->knee.set_value);
+	dh03[1][2] = UTL_cos(leg->hip.set_value);
+	dh03[1][3] = 50 * UTL_sin(leg->hip.set_value) + 85 * UTL_cos(leg->knee.set_value)
+			* UTL_sin(leg->hip.set_value) - 55 * UTL_sin(leg->hip.set_value) * UTL_sin(
+			leg->knee.set_value) * UTL_sin(leg->foot.set_value) + 55 * UTL_cos(
+			leg->knee.set_value) * UTL_cos(leg->foot.set_value) * UTL_sin(
 			leg->hip.set_value);
 
-	dh03[2][0] = -cos(leg->knee.set_value) * sin(leg->foot.set_value) - cos(
-			leg->foot.set_value) * sin(leg->knee.set_value);
-	dh03[2][1] = sin(leg->knee.set_value) * sin(leg->foot.set_value) - cos(
-			leg->knee.set_value) * cos(leg->foot.set_value);
+	dh03[2][0] = -UTL_cos(leg->knee.set_value) * UTL_sin(leg->foot.set_value) - UTL_cos(
+			leg->foot.set_value) * UTL_sin(leg->knee.set_value);
+	dh03[2][1] = UTL_sin(leg->knee.set_value) * UTL_sin(leg->foot.set_value) - UTL_cos(
+			leg->knee.set_value) * UTL_cos(leg->foot.set_value);
 	dh03[2][2] = 0;
-	dh03[2][3] = -85 * sin(leg->knee.set_value) - 55 * cos(leg->knee.set_value)
-			* sin(leg->foot.set_value) - 55 * cos(leg->foot.set_value) * sin(
+	dh03[2][3] = -85 * UTL_sin(leg->knee.set_value) - 55 * UTL_cos(leg->knee.set_value)
+			* UTL_sin(leg->foot.set_value) - 55 * UTL_cos(leg->foot.set_value) * UTL_sin(
 			leg->knee.set_value) - 14;
 
 	dh03[3][0] = 0;
@@ -140,39 +136,39 @@ void KIN_calcDH(const DT_leg* const leg, DT_double** dh03) {
  * \return	true, wenn Berechnung erfolgreich
  */
 DT_bool KIN_calcServos(const DT_point* const p, DT_leg* const leg) {
-	DT_double z = p->z - DIST_DZ;
-	DT_double h, h2, h3;
-	DT_double hip, knee, foot;
-	DT_double alpha, beta, gamma;
+	DT_real z = p->z - DIST_DZ;
+	DT_real h, h2, h3;
+	DT_real hip, knee, foot;
+	DT_real alpha, beta, gamma;
 	// STEP 1 (without dummy-axis)
 	// angle for hip axis in x-y-plane
-	h = sqrt(p->x * p->x + p->y * p->y);
+	h = UTL_sqrt(p->x * p->x + p->y * p->y);
 	// v1 = asin(p.y / h);
-	hip = atan(p->y / p->x); // should have better precision
+	hip = UTL_atan(p->y / p->x); // should have better precision
 
 	// STEP 2
 	// angle for hip & foot axis in z-h' plane
 	h2 = h - DIST_HK;
-	h3 = sqrt(h2 * h2 + z * z);
+	h3 = UTL_sqrt(h2 * h2 + z * z);
 
-	alpha = h2 != h3 ? acos(
+	alpha = h2 != h3 ? UTL_acos(
 			(-(h3 * h3) + DIST_FE * DIST_FE + DIST_KF * DIST_KF) / (2 * DIST_FE
-					* DIST_KF)) : M_PI; // law of cosine
-	beta = asin((DIST_FE / h3) * sin(alpha)); // law of sines
-	gamma = asin(abs(z) / h3); // rules of right angle triangle, abs(z) 'cause length of trianglearm!
+					* DIST_KF)) : UTL_PI; // law of cosine
+	beta = UTL_asin((DIST_FE / h3) * UTL_sin(alpha)); // law of sines
+	gamma = UTL_asin(UTL_fabs(z) / h3); // rules of right angle triangle, fabs(z) 'cause length of trianglearm!
 
 	// CASES
 	if (z < 0) { // defined for z < 0: foot-axis is between h3 and h-axis
 		knee = gamma - beta;
-		foot = M_PI - alpha;
+		foot = UTL_PI - alpha;
 	} else { // defined for z >= 0: foot-axis is not between h3 and h-axis
 		/* Knick nach oben */
 		knee = -(gamma + beta);
-		foot = M_PI - alpha;
+		foot = UTL_PI - alpha;
 
 		/* Knick nach unten
 		 knee = -(gamma - beta);
-		 foot = -(M_PI - alpha);
+		 foot = -(UTL_PI - alpha);
 		 */
 	}
 
@@ -10,25 +10,126 @@
 #include "include/communication.h"
 #include "include/dynamixel.h"
 #include "include/kinematics.h"
+#include "include/profiler.h"
+#include "include/trace.h"
+#include "include/capture.h"
+#include "include/packetPool.h"
+#include "include/stack.h"
+#include "include/calibration.h"
 
 #define MV_DST_X	168.5
 
 /**
- * \brief	Sendet das ACTION-Kommando an ein Bein.
+ * \def	MV_READY_TIMEOUT_US
+ * \brief	Längste Wartezeit in MV_waitReady(), falls ein Servo sein Ziel nicht
+ * 			erreicht oder nicht antwortet. Eine halbe Umdrehung bei voller
+ * 			Geschwindigkeit dauert etwa 0,5 s.
+ */
+#define MV_READY_TIMEOUT_US	2000000
+
+/**
+ * \def	MV_ACTION_LEAD_US
+ * \brief	Vorlauf von MV_masterAction() bis zur ACTION, deckt COM_ACTION_AT und
+ * 			die REG_WRITE-Pakete der Slaves ab. Nur auf dem Host ermittelt, auf
+ * 			der Hardware noch nicht vermessen.
+ *
+ * \def	MV_ACTION_MAX_US
+ * \brief	Weiter entfernte Zeitpunkte in MV_actionAt() gelten als ungültig
+ * 			(Uhr nicht abgeglichen), ACTION wird sofort ausgeführt.
+ *
+ * \def	MV_SYNC_INTERVAL_US
+ * \brief	Abstand der Abgleiche der Uhren in MV_masterAction().
  *
- * 			Sendet das ACTION-Kommando an alle Servos eines Beines.
+ * \def	MV_STACK_CYCLES
+ * \brief	Durchläufe der Hauptschleife je MV_masterCheckStack() in
+ * 			MV_masterPollStack().
+ */
+#define MV_ACTION_LEAD_US	3000
+#define MV_ACTION_MAX_US	100000
+#define MV_SYNC_INTERVAL_US	2000000
+#define MV_STACK_CYCLES		32
+
+uint32_t MV_bootUs[COM_SLAVE3F + 1]; /**< Startzeit je Controller (Index cpuID) in us, 0 wenn unbekannt. */
+uint32_t MV_syncUs; /**< Zeitpunkt des letzten COM_syncClocks(). (Master) */
+DT_bool MV_synced = false;
+DT_byte MV_stackCycles = 0; /**< Durchläufe seit dem letzten MV_masterCheckStack(). (Master) */
+
+// lokale Methoden
+void MV_bootDone(DT_byte);
+DT_bool MV_waitReady(DT_leg* const, DT_leg* const);
+void MV_stageAngles(const DT_leg* const, DT_real, DT_real, DT_real);
+
+/**
+ * \brief	Führt die vorgemerkten Zielpositionen beider Beine aus.
+ *
+ * 			Speichert die mit MV_point() geänderten Zielpositionen mit REG_WRITE
+ * 			(DNX_flush()), soweit das nicht schon beim Empfang geschehen ist, und
+ * 			startet sie mit ACTION als Broadcast an beide Busse (ohne Antworten).
+ * 			Alle Servos beginnen ihre Bewegung daher mit demselben Paket.
  *
  * \param	leg_r	rechtes Bein
  * \param	leg_l	linkes Bein
  */
 void MV_action(DT_leg* const leg_r, DT_leg* const leg_l) {
-	DNX_sendAction(leg_r->hip.id);
-	DNX_sendAction(leg_r->knee.id);
-	DNX_sendAction(leg_r->foot.id);
+	// Die Zielpositionen liegen bereits vorgemerkt in DNX (MV_point()).
+	(void) leg_r;
+	(void) leg_l;
+	DNX_flush(true);
+	DNX_sendAction(DNX_BRDCAST_ID);
+	TRC_EVENT(TRC_ACTION, 0)
+}
+
+/**
+ * \brief	Führt die vorgemerkten Zielpositionen beider Beine zu einem Zeitpunkt aus.
+ *
+ * 			Die geänderten Zielpositionen werden sofort mit REG_WRITE gespeichert
+ * 			(DNX_flush()), ACTION sendet die ISR des Timers zum Zeitpunkt als
+ * 			Broadcast an beide Busse (XM_setAlarm(), DNX_fireAction()). Bis dahin
+ * 			wird gewartet, damit kein anderes Paket die Busse belegt.
+ *
+ * \param	leg_r	rechtes Bein
+ * \param	leg_l	linkes Bein
+ * \param	us		Zeitpunkt in eigener Zeit (XM_getUptimeUs())
+ */
+void MV_actionAt(DT_leg* const leg_r, DT_leg* const leg_l, uint32_t us) {
+	// Die Zielpositionen liegen bereits vorgemerkt in DNX (MV_point()).
+	(void) leg_r;
+	(void) leg_l;
+	DNX_flush(true);
+	if ((int32_t) (us - XM_getUptimeUs()) > MV_ACTION_MAX_US) {
+		DEBUG_P("mv_act_far")
+		us = XM_getUptimeUs();
+	}
+	XM_setAlarm(us, DNX_fireAction);
+	while (XM_isAlarmPending())
+		;
+	DNX_logFiredAction();
+	TRC_EVENT(TRC_ACTION, 0)
+}
 
-	DNX_sendAction(leg_l->hip.id);
-	DNX_sendAction(leg_l->knee.id);
-	DNX_sendAction(leg_l->foot.id);
+/**
+ * \brief	Startet die vorgemerkten Bewegungen aller Controller gleichzeitig. (Master)
+ *
+ * 			Gleicht zuerst die Uhren ab, wenn der letzte Abgleich länger als
+ * 			MV_SYNC_INTERVAL_US zurückliegt (COM_syncClocks()). Sendet dann
+ * 			COM_ACTION_AT für einen Zeitpunkt MV_ACTION_LEAD_US in der Zukunft an
+ * 			beide Slaves und führt die eigene ACTION zum selben Zeitpunkt aus.
+ *
+ * \param	leg_r	rechtes Bein
+ * \param	leg_l	linkes Bein
+ */
+void MV_masterAction(DT_leg* const leg_r, DT_leg* const leg_l) {
+	uint32_t us;
+
+	if (!MV_synced || (uint32_t) (XM_getUptimeUs() - MV_syncUs)
+			>= MV_SYNC_INTERVAL_US) {
+		COM_syncClocks();
+		MV_syncUs = XM_getUptimeUs();
+		MV_synced = true;
+	}
+	us = XM_getUptimeUs() + MV_ACTION_LEAD_US;
+	COM_sendActionAt(COM_BRDCAST_ID, us);
+	MV_actionAt(leg_r, leg_l, us);
 }
 
 /**
@@ -41,67 +142,278 @@ void MV_action(DT_leg* const leg_r, DT_leg* const leg_l) {
  * \param	leg_l	linkes Bein
  */
 void MV_slave(DT_byte cpuID, DT_leg* const leg_r, DT_leg* const leg_l) {
+	MV_bootDone(cpuID);
+	STK_begin(STK_SLAVE);
+	while (1)
+		MV_slaveStep(cpuID, leg_r, leg_l);
+}
+
+/**
+ * \brief	Bearbeitet höchstens einen Befehl des Masters. (Slave)
+ *
+ * 			Ein Durchlauf von MV_slave(). Wird auch vom Host zum Abspielen
+ * 			aufgezeichneter Pakete verwendet (busTrace).
+ *
+ * \param	cpuID	ID des Controllers auf dem die Methode ausgeführt wird
+ * \param	leg_r	rechtes Bein
+ * \param	leg_l	linkes Bein
+ *
+ * \return	true, wenn ein Paket bearbeitet wurde
+ */
+DT_bool MV_slaveStep(DT_byte cpuID, DT_leg* const leg_r, DT_leg* const leg_l) {
 	DT_size len;
-	DT_byte result[DT_RESULT_BUFFER_SIZE];
-
-	while (1) {
-		XM_LED_OFF
-		len = COM_receive(&XM_com_data3, result);
-
-		if (len == 0)
-			continue;
-		DEBUG (("sl_pck_rec",sizeof("sl_pck_rec")))
-		if (result[2] != cpuID && result[2] != COM_BRDCAST_ID)
-			continue;
-		DEBUG (("sl_pck_acc",sizeof("sl_pck_acc")))
-
-		XM_LED_ON
-		switch (result[4]) {
-		case COM_STATUS:
-			DEBUG(("sl_rec_sts",sizeof("sl_rec_sts")))
+	uint32_t rx_us;
+	DT_byte* const result = PKT_acquire(PKT_RX);
+
+	XM_LED_OFF
+	CAP_poll();
+	STK_poll();
+	if (result == NULL)
+		return false;
+	len = COM_receive(&XM_com_data3, result);
+	rx_us = XM_getUptimeUs();
+
+	if (len == 0) {
+		PKT_release(result);
+		return false;
+	}
+	DEBUG_P("sl_pck_rec")
+	if (result[2] != cpuID && result[2] != COM_BRDCAST_ID) {
+		PKT_release(result);
+		return true;
+	}
+	DEBUG_P("sl_pck_acc")
+
+	XM_LED_ON
+	switch (result[4]) {
+	case COM_STATUS:
+		DEBUG_P("sl_rec_sts")
+		if (result[5] == COM_IS_READY)
+			MV_slaveReady(leg_r, leg_l);
+		else
 			MV_slaveStatus(result, len);
-			break;
-		case COM_ACTION:
-			DEBUG(("sl_rec_act",sizeof("sl_rec_act")))
-			MV_action(leg_r, leg_l);
-			break;
-		case COM_POINT:
-			DEBUG(("sl_rec_pnt",sizeof("sl_rec_pnt")))
-			if(result[18] == COM_SPEED){
-				DEBUG(("sl_rec_spd",sizeof("sl_rec_spd")))
-				MV_slavePointAndSpeed(leg_r, leg_l, result, len);
-			}else{
-				MV_slavePoint(leg_r, leg_l, result, len);
-			}
-			break;
-		case COM_ANGLE:
-			DEBUG(("sl_rec_ang",sizeof("sl_rec_ang")))
-			MV_slaveAngle(leg_r, leg_l, result, len);
-			break;
-		default:
-			DEBUG (("sl_err",sizeof("sl_err")))
-			break;
+		break;
+	case COM_ACTION:
+		DEBUG_P("sl_rec_act")
+		MV_action(leg_r, leg_l);
+		break;
+	case COM_ACTION_AT:
+		DEBUG_P("sl_rec_act_at")
+		if (len == 11)
+			MV_actionAt(leg_r, leg_l, COM_toLocalUs(COM_getTimeFromPacket(
+					result)));
+		break;
+	case COM_SYNC:
+		COM_onSync(result, len, rx_us);
+		break;
+	case COM_POINT:
+		DEBUG_P("sl_rec_pnt")
+		if(len == 9 + 4 * COM_REAL_SIZE && result[6 + 3 * COM_REAL_SIZE] == COM_SPEED){
+			DEBUG_P("sl_rec_spd")
+			MV_slavePointAndSpeed(leg_r, leg_l, result, len);
+		}else{
+			MV_slavePoint(leg_r, leg_l, result, len);
 		}
+		// Nach der Antwort an den Master bis zur ACTION speichern
+		DNX_flush(true);
+		break;
+	case COM_ANGLE:
+		DEBUG_P("sl_rec_ang")
+		MV_slaveAngle(leg_r, leg_l, result, len);
+		DNX_flush(true);
+		break;
+	case COM_CALIBRATE:
+		DEBUG_P("sl_rec_cal")
+		MV_slaveCalibration(result, len);
+		break;
+	default:
+		DEBUG_P("sl_err")
+		break;
 	}
+	PKT_release(result);
+	return true;
+}
+
+/**
+ * \brief	Merkt sich die Startzeit eines Controllers beim ersten Aufruf.
+ *
+ * \param	cpuID	ID des Controllers
+ */
+void MV_bootDone(DT_byte cpuID) {
+	if (cpuID <= COM_SLAVE3F && MV_bootUs[cpuID] == 0)
+		MV_bootUs[cpuID] = XM_getUptimeUs();
 }
 
 /**
  * \brief	Prüft ob die Slaves alive sind. (Master)
  *
- * 			Prüft blockierend ob die Slaves alive sind.
+ * 			Fragt beide Slaves gleichzeitig ab (COM_pollAlive()) und wiederholt die
+ * 			Anfrage nur für Slaves, die noch nicht geantwortet haben. Danach werden
+ * 			die Startzeiten aller Controller in MV_bootUs abgelegt und auf der
+ * 			Debug-USART ausgegeben (BOOT cpuID us) und die Uhren der Slaves
+ * 			abgeglichen (COM_syncClocks()).
  */
 void MV_masterCheckAlive() {
-	// CHECK CPUs
-	DT_bool isAlive = false;
+	const DT_byte slaves[] = { COM_SLAVE1B, COM_SLAVE3F };
+	DT_byte pending = 1 << COM_SLAVE1B | 1 << COM_SLAVE3F;
+	DT_byte i;
+
 	XM_LED_OFF
+	while (pending != 0)
+		pending &= ~COM_pollAlive(pending);
+	DEBUG_P("ma_alv")
+	MV_bootDone(COM_MASTER);
+	for (i = 0; i < sizeof(slaves); i++)
+		COM_requestBoot(slaves[i], &MV_bootUs[slaves[i]]);
+	COM_syncClocks();
+	MV_syncUs = XM_getUptimeUs();
+	MV_synced = true;
+	for (i = COM_SLAVE1B; i <= COM_SLAVE3F; i++) {
+		XM_debugPutChar('B');
+		XM_debugPutChar('O');
+		XM_debugPutChar('O');
+		XM_debugPutChar('T');
+		XM_debugPutChar(' ');
+		UTL_printNumber(i);
+		XM_debugPutChar(' ');
+		UTL_printNumber(MV_bootUs[i]);
+		XM_debugPutChar('\n');
+	}
+	XM_LED_ON
+}
+
+/**
+ * \brief	Prüft, ob alle Servos beider Beine ihre Zielposition erreicht haben.
+ *
+ * 			Beide Beine werden gleichzeitig abgefragt (DNX_getMoving()).
+ *
+ * \param	leg_r	rechtes Bein
+ * \param	leg_l	linkes Bein
+ *
+ * \return	true, wenn alle Servos antworten und keiner mehr in Bewegung ist
+ */
+DT_bool MV_isReady(DT_leg* const leg_r, DT_leg* const leg_l) {
+	return DNX_getMoving((uint32_t) 1 << leg_r->hip.id | (uint32_t) 1
+			<< leg_r->knee.id | (uint32_t) 1 << leg_r->foot.id | (uint32_t) 1
+			<< leg_l->hip.id | (uint32_t) 1 << leg_l->knee.id | (uint32_t) 1
+			<< leg_l->foot.id) == 0;
+}
+
+/**
+ * \brief	Wartet, bis die Servos aller Controller ihre Zielposition erreicht haben. (Master)
+ *
+ * 			Die Slaves werden mit COM_pollReady() gleichzeitig und ohne Blockieren
+ * 			abgefragt, bis jeder einmal mit ACK geantwortet hat. Ein Slave ohne
+ * 			Antwort hält den Master daher nicht über MV_READY_TIMEOUT_US auf.
+ *
+ * \param	leg_r	rechtes Bein
+ * \param	leg_l	linkes Bein
+ *
+ * \return	false, wenn nach MV_READY_TIMEOUT_US noch ein Servo in Bewegung ist
+ * 			oder nicht antwortet
+ */
+DT_bool MV_waitReady(DT_leg* const leg_r, DT_leg* const leg_l) {
+	const uint32_t start = XM_getUptimeUs();
+	DT_byte pending = 1 << COM_SLAVE1B | 1 << COM_SLAVE3F;
+	DT_bool ready = false;
 	do {
-		if (COM_isAlive(COM_SLAVE1B) && COM_isAlive(COM_SLAVE3F)) {
-			isAlive = true;
+		if (!ready)
+			ready = MV_isReady(leg_r, leg_l);
+		if (pending != 0)
+			pending &= ~COM_pollReady(pending);
+		if (ready && pending == 0)
+			return true;
+	} while (XM_getUptimeUs() - start < MV_READY_TIMEOUT_US);
+	DEBUG_P("ma_rdy_to")
+	return false;
+}
+
+/**
+ * \brief	Gibt den Stand von RAM und Stack aller Controller aus. (Master)
+ *
+ * 			Fragt die Slaves mit COM_STACK ab und gibt je Controller eine Zeile
+ * 			von STK_dump() auf der Debug-USART aus.
+ *
+ * \return	false, wenn ein Controller nicht antwortet oder sein Budget überschreitet
+ */
+DT_bool MV_masterCheckStack() {
+	const DT_byte slaves[] = { COM_SLAVE1B, COM_SLAVE3F };
+	DT_stkInfo info;
+	DT_bool ok = true;
+	DT_byte i;
+
+	STK_getInfo(&info);
+	STK_dump(COM_MASTER, &info);
+	ok = info.chainUsed <= info.chainBudget;
+	for (i = 0; i < sizeof(slaves); i++) {
+		if (COM_requestStack(slaves[i], &info)) {
+			STK_dump(slaves[i], &info);
+			ok = ok && info.chainUsed <= info.chainBudget;
 		} else
-			UTL_wait(5);
-	} while (isAlive == false);
-	DEBUG (("ma_alv",sizeof("ma_alv")))
-	XM_LED_ON
+			ok = false;
+	}
+	return ok;
+}
+
+/**
+ * \brief	Ruft MV_masterCheckStack() in jedem MV_STACK_CYCLES-ten Durchlauf auf. (Master)
+ *
+ * 			Für die Hauptschleife neben STK_poll(), der erste Aufruf prüft sofort.
+ */
+void MV_masterPollStack() {
+	if (MV_stackCycles == 0 && !MV_masterCheckStack()) {
+		DEBUG_P("ma_stk_ovf")
+	}
+	if (++MV_stackCycles == MV_STACK_CYCLES)
+		MV_stackCycles = 0;
+}
+
+/**
+ * \brief	Gibt die Ereignisprotokolle aller Controller aus. (Master)
+ *
+ * 			Jeder Controller schreibt sein Protokoll auf die eigene Debug-USART
+ * 			(TRC_dump()), die Mitschnitte werden mit traceMerge zusammengeführt.
+ *
+ * \return	true, wenn beide Slaves die Ausgabe bestätigt haben
+ */
+DT_bool MV_masterDumpTrace() {
+	const DT_byte slaves[] = { COM_SLAVE1B, COM_SLAVE3F };
+	DT_bool ok = true;
+	DT_byte i;
+
+	TRC_dump();
+	for (i = 0; i < sizeof(slaves); i++)
+		ok = COM_requestTrace(slaves[i]) && ok;
+	return ok;
+}
+
+/**
+ * \brief	Gibt die Messwerte des Profilers aller Controller aus. (Master)
+ *
+ * 			Die Werte der Slaves werden mit COM_PROFILE abgefragt und wie die
+ * 			eigenen auf der Debug-USART des Masters ausgegeben, jeweils nach einer
+ * 			Zeile PRF_CPU (PRF_dumpCpu(), showProfile).
+ *
+ * \return	true, wenn alle Abschnitte beider Slaves empfangen wurden
+ */
+DT_bool MV_masterDumpProfile() {
+	const DT_byte slaves[] = { COM_SLAVE1B, COM_SLAVE3F };
+	DT_prfScope scope;
+	DT_bool ok = true;
+	DT_byte i, s;
+
+	PRF_dumpCpu(COM_MASTER);
+	PRF_dump();
+	for (i = 0; i < sizeof(slaves); i++) {
+		PRF_dumpCpu(slaves[i]);
+		for (s = 0; s < PRF_SCOPES; s++) {
+			if (COM_requestProfile(slaves[i], s, &scope))
+				PRF_dumpScope(PRF_getName(s), &scope);
+			else
+				ok = false;
+		}
+	}
+	return ok;
 }
 
 /**
@@ -116,13 +428,46 @@ void MV_slaveStatus(const DT_byte* const result, const DT_size len) {
 	switch (result[5]) {
 	case COM_IS_ALIVE:
 		COM_sendACK(COM_MASTER);
-		DEBUG(("sl_snd_ack",sizeof("sl_snd_ack")))
+		DEBUG_P("sl_snd_ack")
+		break;
+	case COM_STACK:
+		COM_sendStack(COM_MASTER);
+		DEBUG_P("sl_snd_stk")
+		break;
+	case COM_TRACE:
+		// Erst bestätigen, damit der Master nicht auf die Ausgabe wartet
+		COM_sendACK(COM_MASTER);
+		TRC_dump();
+		break;
+	case COM_BOOT:
+		COM_sendBoot(COM_MASTER, MV_bootUs[result[2] <= COM_SLAVE3F ? result[2]
+				: COM_NOCPUID]);
+		DEBUG_P("sl_snd_boot")
 		break;
 	default:
+		if (result[5] >= COM_PROFILE && result[5] < COM_PROFILE + PRF_SCOPES) {
+			COM_sendProfile(COM_MASTER, result[5] - COM_PROFILE);
+			DEBUG_P("sl_snd_prf")
+		}
 		break;
 	}
 }
 
+/**
+ * \brief	Antwortet auf COM_IS_READY eines Masters. (Slave)
+ *
+ * 			ACK, wenn kein Servo mehr in Bewegung ist, sonst NAK COM_ERR_MOVING.
+ *
+ * \param	leg_r	rechtes Bein
+ * \param	leg_l	linkes Bein
+ */
+void MV_slaveReady(DT_leg* const leg_r, DT_leg* const leg_l) {
+	if (MV_isReady(leg_r, leg_l))
+		COM_sendACK(COM_MASTER);
+	else
+		COM_sendNAK(COM_MASTER, COM_ERR_MOVING);
+}
+
 /**
  * \brief	Führt die benötigten Aktionen für einen empfangenen Punkt aus. (Slave)
  *
@@ -164,11 +509,11 @@ void MV_slavePoint(DT_leg* const leg_r, DT_leg* const leg_l,
  */
 void MV_slavePointAndSpeed(DT_leg* const leg_r, DT_leg* const leg_l,
 		const DT_byte* const result, DT_size len) {
-	DEBUG(("SPEED", sizeof("SPEED")))
+	DEBUG_P("SPEED")
 	DT_point p = COM_getPointFromPacket(result);
 	DT_bool isGlobal = COM_isGlobal(result);
 	DT_bool ret;
-	DT_double speed = COM_getSpeedFromPacket(result);
+	DT_real speed = COM_getSpeedFromPacket(result);
 	if (COM_isLeftLeg(result)) {
 		ret = MV_pointAndSpeed(leg_l, &p, speed, isGlobal);
 	}
@@ -194,32 +539,62 @@ void MV_slavePointAndSpeed(DT_leg* const leg_r, DT_leg* const leg_l,
  */
 void MV_slaveAngle(DT_leg* const leg_r, DT_leg* const leg_l,
 		const DT_byte* const result, DT_size len) {
-	DT_double angle = COM_getAngleFromPacket(result);
+	DT_real angle = COM_getAngleFromPacket(result);
 
 	if (COM_isLeftLeg(result)) {
 		if (COM_isHip(result))
-			DNX_setAngle(leg_l->hip.id, angle, true);
+			DNX_stage(leg_l->hip.id, CAL_degToTicks(leg_l->hip.id, angle),
+					DNX_SPEED_KEEP);
 		if (COM_isKnee(result))
-			DNX_setAngle(leg_l->knee.id, angle, true);
+			DNX_stage(leg_l->knee.id, CAL_degToTicks(leg_l->knee.id, angle),
+					DNX_SPEED_KEEP);
 		if (COM_isFoot(result))
-			DNX_setAngle(leg_l->foot.id, angle, true);
+			DNX_stage(leg_l->foot.id, CAL_degToTicks(leg_l->foot.id, angle),
+					DNX_SPEED_KEEP);
 	}
 	if (COM_isRightLeg(result)) {
 		if (COM_isHip(result))
-			DNX_setAngle(leg_r->hip.id, angle, true);
+			DNX_stage(leg_r->hip.id, CAL_degToTicks(leg_r->hip.id, angle),
+					DNX_SPEED_KEEP);
 		if (COM_isKnee(result))
-			DNX_setAngle(leg_r->knee.id, angle, true);
+			DNX_stage(leg_r->knee.id, CAL_degToTicks(leg_r->knee.id, angle),
+					DNX_SPEED_KEEP);
 		if (COM_isFoot(result))
-			DNX_setAngle(leg_r->foot.id, angle, true);
+			DNX_stage(leg_r->foot.id, CAL_degToTicks(leg_r->foot.id, angle),
+					DNX_SPEED_KEEP);
 	}
 	COM_sendACK(COM_MASTER);
 	// TODO COM_sendNAK(COM_MASTER, COM_ERR_POINT_OUT_OF_BOUNDS);
 }
 
 /**
- * \brief	Berechnet Winkel anhand des Punktes für die Servos und versendet diese.
+ * \brief	Übernimmt die Kalibrierung eines Servos. (Slave)
  *
- * 			Berechnet Winkel anhand des Punktes für die Servos und versendet diese.
+ * 			Antwortet mit ACK oder mit NAK und COM_ERR_CALIBRATION, wenn Länge,
+ * 			ID oder Grenzen ungültig sind.
+ *
+ * \param	result	Anfrage-Paket zum Auswerten
+ * \param	len	Länge des Pakets
+ */
+void MV_slaveCalibration(const DT_byte* const result, DT_size len) {
+	DT_calServo cal;
+
+	if (len == 8 + CAL_SIZE) {
+		CAL_fromByteArray(&cal, &result[6]);
+		if (CAL_set(result[5], &cal)) {
+			COM_sendACK(COM_MASTER);
+			return;
+		}
+	}
+	COM_sendNAK(COM_MASTER, COM_ERR_CALIBRATION);
+}
+
+/**
+ * \brief	Berechnet Winkel anhand des Punktes für die Servos und merkt diese vor.
+ *
+ * 			Berechnet Winkel anhand des Punktes für die Servos. Die Zielpositionen
+ * 			werden mit DNX_stage() vorgemerkt und mit MV_action() gesendet, soweit
+ * 			sie sich geändert haben.
  *
  * \param	leg	Bein
  * \param	point	Punkt
@@ -228,20 +603,20 @@ void MV_slaveAngle(DT_leg* const leg_r, DT_leg* const leg_l,
 DT_bool MV_point(DT_leg* const leg, const DT_point* const point,
 		DT_bool isGlobal) {
 	DT_bool ret;
+	PRF_BEGIN(PRF_KIN)
 	if (isGlobal == true) {
 		DT_point pLocal = KIN_calcLocalPoint(point, &leg->trans);
 		ret = KIN_calcServos(&pLocal, leg);
 	} else
 		ret = KIN_calcServos(point, leg);
+	PRF_END(PRF_KIN)
+	TRC_EVENT(TRC_IK_DONE, leg->hip.id)
 
 	if (ret == true) {
-		leg->hip.set_value = UTL_getDegree(leg->hip.set_value);
-		leg->knee.set_value = UTL_getDegree(leg->knee.set_value);
-		leg->foot.set_value = UTL_getDegree(leg->foot.set_value);
-
-		DNX_setAngle(leg->hip.id, leg->hip.set_value, true);
-		DNX_setAngle(leg->knee.id, leg->knee.set_value, true);
-		DNX_setAngle(leg->foot.id, leg->foot.set_value, true);
+		MV_setTicks(leg);
+		DNX_stage(leg->hip.id, leg->hip.ticks, DNX_SPEED_KEEP);
+		DNX_stage(leg->knee.id, leg->knee.ticks, DNX_SPEED_KEEP);
+		DNX_stage(leg->foot.id, leg->foot.ticks, DNX_SPEED_KEEP);
 		return true;
 	} else {
 		return false;
@@ -249,42 +624,77 @@ DT_bool MV_point(DT_leg* const leg, const DT_point* const point,
 }
 
 /**
- * \brief	Berechnet Winkel anhand des Punktes für die Servos und versendet diese zusammen mit der Anfahrgeschwindigkeit.
+ * \brief	Rechnet die Winkel der inversen Kinematik (Bogenmaß) in Zielpositionen um.
+ *
+ * 			Einziger Schritt mit Gleitkomma zwischen KIN_calcServos() und dem
+ * 			Paket: set_value bleibt im Bogenmaß, ticks enthält die Zielposition mit
+ * 			Drehrichtung und Versatz des Servos (CAL_radToTicks()).
+ *
+ * \param	leg	Bein
+ */
+void MV_setTicks(DT_leg* const leg) {
+	PRF_BEGIN(PRF_DNX_PACKET)
+	leg->hip.ticks = CAL_radToTicks(leg->hip.id, leg->hip.set_value);
+	leg->knee.ticks = CAL_radToTicks(leg->knee.id, leg->knee.set_value);
+	leg->foot.ticks = CAL_radToTicks(leg->foot.id, leg->foot.set_value);
+	PRF_END(PRF_DNX_PACKET)
+}
+
+/**
+ * \brief	Berechnet Winkel anhand des Punktes für die Servos und merkt diese zusammen mit der Anfahrgeschwindigkeit vor.
  *
- * 			Berechnet Winkel anhand des Punktes für die Servos und versendet diese zusammen mit der Anfahrgeschwindigkeit.
+ * 			Wie MV_point(), zusätzlich mit der Anfahrgeschwindigkeit.
  *
  * \param	leg	Bein
  * \param	point	Punkt
  * \param	speed	Anfahrgeschwindigkeit
  * \param	isGlobal	Weltkoordinate, wenn true
  */
-DT_bool MV_pointAndSpeed(DT_leg* const leg, const DT_point* const point, const DT_double speed,
+DT_bool MV_pointAndSpeed(DT_leg* const leg, const DT_point* const point, const DT_real speed,
 		DT_bool isGlobal) {
 	DT_bool ret;
+	PRF_BEGIN(PRF_KIN)
 	if (isGlobal == true) {
 		DT_point pLocal = KIN_calcLocalPoint(point, &leg->trans);
 		ret = KIN_calcServos(&pLocal, leg);
 	} else
 		ret = KIN_calcServos(point, leg);
+	PRF_END(PRF_KIN)
+	TRC_EVENT(TRC_IK_DONE, leg->hip.id)
 
 	if (ret == true) {
-		leg->hip.set_value = UTL_getDegree(leg->hip.set_value);
-		leg->knee.set_value = UTL_getDegree(leg->knee.set_value);
-		leg->foot.set_value = UTL_getDegree(leg->foot.set_value);
-
-		DNX_setAngleAndSpeed(leg->hip.id, leg->hip.set_value, speed, true);
-		DNX_setAngleAndSpeed(leg->knee.id, leg->knee.set_value, speed, true);
-		DNX_setAngleAndSpeed(leg->foot.id, leg->foot.set_value, speed, true);
+		const uint16_t speedValue = (DT_int) floor(speed);
+		MV_setTicks(leg);
+		DNX_stage(leg->hip.id, leg->hip.ticks, speedValue);
+		DNX_stage(leg->knee.id, leg->knee.ticks, speedValue);
+		DNX_stage(leg->foot.id, leg->foot.ticks, speedValue);
 		return true;
 	} else {
 		return false;
 	}
 }
 
+/**
+ * \brief	Merkt Winkel in Grad für die Servos eines Beines vor (DNX_stage()).
+ *
+ * \param	leg	Bein
+ * \param	hip	Winkel der Hüfte
+ * \param	knee	Winkel des Knies
+ * \param	foot	Winkel des Fußes
+ */
+void MV_stageAngles(const DT_leg* const leg, DT_real hip, DT_real knee,
+		DT_real foot) {
+	DNX_stage(leg->hip.id, CAL_degToTicks(leg->hip.id, hip), DNX_SPEED_KEEP);
+	DNX_stage(leg->knee.id, CAL_degToTicks(leg->knee.id, knee), DNX_SPEED_KEEP);
+	DNX_stage(leg->foot.id, CAL_degToTicks(leg->foot.id, foot), DNX_SPEED_KEEP);
+}
+
 /**
  * \brief	Fährt das rechte und linke Bein in eine Startposition.
  *
- * 			Fährt das rechte und linke Bein in eine Startposition.
+ * 			Fährt das rechte und linke Bein in eine Startposition. Nach jedem
+ * 			Schritt wird mit MV_waitReady() gewartet, bis die Servos aller
+ * 			Controller ihr Ziel erreicht haben.
  *
  * \param	leg_r	rechtes Bein
  * \param	leg_l	linkes Bein
@@ -292,39 +702,30 @@ DT_bool MV_pointAndSpeed(DT_leg* const leg, const DT_point* const point, const D
 void MV_doInitPosition(DT_leg* const leg_r, DT_leg* const leg_l) {
 	XM_LED_OFF
 	DT_byte config;
-	DT_double angleHip, angleKnee, angleFoot;
+	DT_real angleHip, angleKnee, angleFoot;
 	// Punkt fuer Null-Stellung mittleres rechtes Bein als Bezug
 	angleHip = 0;
 	angleKnee = 0;
 	angleFoot = 0;
 
-	DNX_setAngle(leg_r->hip.id, angleHip, true);
-	DNX_setAngle(leg_r->knee.id, angleKnee, true);
-	DNX_setAngle(leg_r->foot.id, angleFoot, true);
-	DNX_setAngle(leg_l->hip.id, angleHip, true);
-	DNX_setAngle(leg_l->knee.id, angleKnee, true);
-	DNX_setAngle(leg_l->foot.id, angleFoot, true);
+	MV_stageAngles(leg_r, angleHip, angleKnee, angleFoot);
+	MV_stageAngles(leg_l, angleHip, angleKnee, angleFoot);
 
 	config = COM_CONF_HIP | COM_CONF_KNEE | COM_CONF_FOOT | COM_CONF_LEFT
 			| COM_CONF_RIGHT;
 	COM_sendAngle(COM_SLAVE1B, angleHip, config);
 	COM_sendAngle(COM_SLAVE3F, angleHip, config);
 
-	COM_sendAction(COM_BRDCAST_ID);
-	MV_action(leg_r, leg_l);
+	MV_masterAction(leg_r, leg_l);
 
-	UTL_wait(40);
+	MV_waitReady(leg_r, leg_l);
 
 	angleHip = 0;
 	angleKnee = 45;
 	angleFoot = 45;
 
-	DNX_setAngle(leg_r->hip.id, angleHip, true);
-	DNX_setAngle(leg_r->knee.id, angleKnee, true);
-	DNX_setAngle(leg_r->foot.id, angleFoot, true);
-	DNX_setAngle(leg_l->hip.id, angleHip, true);
-	DNX_setAngle(leg_l->knee.id, angleKnee, true);
-	DNX_setAngle(leg_l->foot.id, angleFoot, true);
+	MV_stageAngles(leg_r, angleHip, angleKnee, angleFoot);
+	MV_stageAngles(leg_l, angleHip, angleKnee, angleFoot);
 
 	config = COM_CONF_HIP | COM_CONF_LEFT | COM_CONF_RIGHT;
 	COM_sendAngle(COM_SLAVE1B, angleHip, config);
@@ -334,12 +735,11 @@ void MV_doInitPosition(DT_leg* const leg_r, DT_leg* const leg_l) {
 	COM_sendAngle(COM_SLAVE1B, angleKnee, config);
 	COM_sendAngle(COM_SLAVE3F, angleKnee, config);
 
-	COM_sendAction(COM_BRDCAST_ID);
-	MV_action(leg_r, leg_l);
+	MV_masterAction(leg_r, leg_l);
 
-	UTL_wait(40);
+	MV_waitReady(leg_r, leg_l);
 
-	DEBUG(("ma_int_pos_ok",sizeof("ma_int_pos_ok")))
+	DEBUG_P("ma_int_pos_ok")
 	XM_LED_ON
 }
 
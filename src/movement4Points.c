@@ -13,6 +13,10 @@
 #include "include/dynamixel.h"
 #include "include/communication.h"
 #include "include/movement.h"
+#include "include/trace.h"
+#include "include/capture.h"
+#include "include/stack.h"
+#include "include/calibration.h"
 
 DT_leg leg_r, leg_l;
 DT_byte cpuID;
@@ -47,17 +51,21 @@ void ma_setPoints(DT_point* const pFntDwn, DT_point* const pFntUp,
 	pBckDwn->y = -55.05204;
 	pBckDwn->z = -129.10408;
 
-	DEBUG (("ma_set_pnt",sizeof("ma_set_pnt")))
+	DEBUG_P("ma_set_pnt")
 	XM_LED_ON
 }
 
 int main() {
+	STK_paint();
 	XM_init_cpu();
 	XM_init_dnx();
+	CAL_init();
 	// INIT: Hole benoetigte Daten
 	DNX_getConnectedIDs(&leg_r, &leg_l);
 	cpuID = COM_getCpuID(&leg_l);
 	XM_init_com(cpuID);
+	TRC_init(cpuID);
+	CAP_boot();
 
 	XM_LED_OFF
 
@@ -69,19 +77,19 @@ int main() {
 	switch (cpuID) {
 	case COM_MASTER:
 		XM_init_remote();
-		DEBUG(("Master",sizeof("Master")))
+		DEBUG_P("Master")
 		master();
 		break;
 	case COM_SLAVE1B:
-		DEBUG(("Slave1",sizeof("Slave1")))
+		DEBUG_P("Slave1")
 		MV_slave(cpuID, &leg_r, &leg_l);
 		break;
 	case COM_SLAVE3F:
-		DEBUG(("Slave3",sizeof("Slave3")))
+		DEBUG_P("Slave3")
 		MV_slave(cpuID, &leg_r, &leg_l);
 		break;
 	default: //case NOCPUID:
-		DEBUG (("NoCpuID",sizeof("NoCpuID")))
+		DEBUG_P("NoCpuID")
 		XM_LED_OFF
 		break;
 	}
@@ -91,10 +99,10 @@ int main() {
 
 /* ___ Methoden fuer Master ___ */
 void master() {
-	DEBUG(("ma_chk_al",sizeof("ma_chk_al")))
+	DEBUG_P("ma_chk_al")
 	MV_masterCheckAlive();
 
-	DEBUG(("ma_int_pnt",sizeof("ma_int_pnt")))
+	DEBUG_P("ma_int_pnt")
 	DT_point pFntDwn, pFntUp, pBckUp, pBckDwn, pTmp;
 	ma_setPoints(&pFntDwn, &pFntUp, &pBckUp, &pBckDwn);
 
@@ -105,13 +113,16 @@ void master() {
 	DT_byte state = 0;
 
 	// Automat: 0(->1->2)+
+	STK_begin(STK_MASTER);
 	while (1) {
+		STK_poll();
+		CAP_poll();
+		MV_masterPollStack();
 		XM_LED_ON
 		switch (state) {
 		case 0:
-			DEBUG(("ma_int_pos",sizeof("ma_int_pos")))
+			DEBUG_P("ma_int_pos")
 			MV_doInitPosition(&leg_r, &leg_l);
-			UTL_wait(30);
 			state = 1;
 			break;
 		case 1:
@@ -125,8 +136,7 @@ void master() {
 			pTmp = MV_getPntForCpuSide(&pFntDwn, COM_SLAVE3F, slaveDwn);
 			COM_sendPoint(COM_SLAVE3F, &pTmp, config);
 
-			MV_action(&leg_r, &leg_l);
-			COM_sendAction(COM_BRDCAST_ID);
+			MV_masterAction(&leg_r, &leg_l);
 
 			UTL_wait(5);
 
@@ -138,8 +148,7 @@ void master() {
 			pTmp = MV_getPntForCpuSide(&pBckUp, COM_SLAVE3F, slaveUp);
 			COM_sendPoint(COM_SLAVE3F, &pTmp, config);
 
-			MV_action(&leg_r, &leg_l);
-			COM_sendAction(COM_BRDCAST_ID);
+			MV_masterAction(&leg_r, &leg_l);
 
 			state = 2;
 			break;
@@ -160,15 +169,14 @@ void master() {
 			pTmp = MV_getPntForCpuSide(&pFntUp, COM_SLAVE3F, slaveUp);
 			COM_sendPoint(COM_SLAVE3F, &pTmp, config);
 
-			MV_action(&leg_r, &leg_l);
-			COM_sendAction(COM_BRDCAST_ID);
+			MV_masterAction(&leg_r, &leg_l);
 
 			MV_switchLegs(&side, &masterDwn, &masterUp, &slaveDwn, &slaveUp);
 
 			state = 1;
 			break;
 		default:
-			DEBUG(("ma_err",sizeof("ma_err")))
+			DEBUG_P("ma_err")
 			break;
 		}
 	}
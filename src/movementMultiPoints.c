@@ -13,6 +13,10 @@
 #include "include/dynamixel.h"
 #include "include/communication.h"
 #include "include/movement.h"
+#include "include/trace.h"
+#include "include/capture.h"
+#include "include/stack.h"
+#include "include/calibration.h"
 #include "include/remote.h"
 #include <math.h>
 
@@ -30,7 +34,7 @@ DT_point ma_calcStartPoint(const DT_point* const v, DT_bool isDown,
 	 *   berechnen für 30, 22.5, 15, 7.5 und 0
 	 */
 	DT_leg leg;
-	DT_double alpha = v->y != 0 ? atan(v->y / v->x) : M_PI / 2;
+	DT_real alpha = v->y != 0 ? atan(v->y / v->x) : M_PI / 2;
 	alpha = UTL_getDegree(alpha);
 	if (40 < alpha && alpha < 50)
 		alpha = 15;
@@ -43,7 +47,7 @@ DT_point ma_calcStartPoint(const DT_point* const v, DT_bool isDown,
 	leg.knee.set_value = isDown == true ? 45 : 0;
 	leg.hip.set_value = 90;
 
-	DT_double dh03[4][4];
+	DT_real dh03[4][4];
 	dh03[0][1] = 0;
 	KIN_calcDH(&leg, &dh03[0]);
 	DT_point p = UTL_getPointOfDH(&dh03[0]);
@@ -150,12 +154,16 @@ void ma_changeActiveLeg();
 void ma_doStep(const DT_point* const );
 
 int main() {
+	STK_paint();
 	XM_init_cpu();
 	XM_init_dnx();
+	CAL_init();
 	// INIT: Hole benoetigte Daten
 	DNX_getConnectedIDs(&leg_r, &leg_l);
 	cpuID = COM_getCpuID(&leg_l);
 	XM_init_com(cpuID);
+	TRC_init(cpuID);
+	CAP_boot();
 
 	XM_init_remote();
 
@@ -169,19 +177,19 @@ int main() {
 	switch (cpuID) {
 	case COM_MASTER:
 		XM_init_remote();
-		DEBUG(("Master",sizeof("Master")))
+		DEBUG_P("Master")
 		master();
 		break;
 	case COM_SLAVE1B:
-		DEBUG(("Slave1",sizeof("Slave1")))
+		DEBUG_P("Slave1")
 		MV_slave(cpuID, &leg_r, &leg_l);
 		break;
 	case COM_SLAVE3F:
-		DEBUG(("Slave3",sizeof("Slave3")))
+		DEBUG_P("Slave3")
 		MV_slave(cpuID, &leg_r, &leg_l);
 		break;
 	default: //case NOCPUID:
-		DEBUG (("NoCpuID",sizeof("NoCpuID")))
+		DEBUG_P("NoCpuID")
 		XM_LED_OFF
 		break;
 	}
@@ -191,15 +199,15 @@ int main() {
 
 /* ___ Methoden fuer Master ___ */
 void master() {
-	DEBUG(("ma_chk_al",sizeof("ma_chk_al")))
+	DEBUG_P("ma_chk_al")
 	MV_masterCheckAlive();
 
 	//DT_cmd cmd = 0x0000;
 
 	MV_doInitPosition(&leg_r, &leg_l);
 
-	//DT_double zUp = 101.1041;
-	//DT_double zDwn = -129.1041;
+	//DT_real zUp = 101.1041;
+	//DT_real zDwn = -129.1041;
 	DT_point vDwn, vUp, pDwn, pUp, pTmp;
 
 	vUp = ma_negateVec(&vDwn);
@@ -214,7 +222,11 @@ void master() {
 	leg_dwn = leg_r;
 	leg_up = leg_l;
 
+	STK_begin(STK_MASTER);
 	while (1) {
+		STK_poll();
+		CAP_poll();
+		MV_masterPollStack();
 		XM_LED_ON
 
 		vDwn.x = 0;
@@ -243,8 +255,7 @@ void master() {
 			if (firstStepOfMovement == true) {
 				firstStepOfMovement = false;
 				if (resUp && resDwn) {
-					MV_action(&leg_r, &leg_l);
-					COM_sendAction(COM_BRDCAST_ID);
+					MV_masterAction(&leg_r, &leg_l);
 				}
 				UTL_wait(5);
 			}
@@ -259,8 +270,7 @@ void master() {
 			MV_point(ma_getLegForSide(masterUp), &pUp, true);
 
 			if (resUp && resDwn) {
-				MV_action(&leg_r, &leg_l);
-				COM_sendAction(COM_BRDCAST_ID);
+				MV_masterAction(&leg_r, &leg_l);
 			}
 
 			//UTL_wait(20);
@@ -268,7 +278,7 @@ void master() {
 			pDwn = ma_movePnt(&pDwn, &vDwn);
 			pUp = ma_movePnt(&pUp, &vUp);
 		} while (resDwn && resUp);
-		DEBUG(("switch_leg",sizeof("switch_leg")))
+		DEBUG_P("switch_leg")
 		ma_switchLegs(&side, &masterDwn, &masterUp, &slaveDwn, &slaveUp);
 		resDwn = true;
 		resUp = true;
@@ -280,29 +290,29 @@ void master() {
 
 		 // Vorwärts & Rückwärts
 		 if (RMT_isUpPressed(cmd)) {
-		 DEBUG(("UP",sizeof("UP")))
+		 DEBUG_P("UP")
 		 p1.y = p1.y + STEP_SIZE;
 		 }
 		 if (RMT_isDownPressed(cmd)) {
-		 DEBUG(("DWN",sizeof("DWN")))
+		 DEBUG_P("DWN")
 		 p1.y = p1.y - STEP_SIZE;
 		 }
 		 // Links & Rechts
 		 if (RMT_isLeftPressed(cmd)) {
-		 DEBUG(("LFT",sizeof("LFT")))
+		 DEBUG_P("LFT")
 		 p1.x = p1.x - STEP_SIZE;
 		 }
 		 if (RMT_isRightPressed(cmd)) {
-		 DEBUG(("RGT",sizeof("RGT")))
+		 DEBUG_P("RGT")
 		 p1.x = p1.x + STEP_SIZE;
 		 }
 		 // Hoch & Runter
 		 if (RMT_isButton1Pressed(cmd)) {
-		 DEBUG(("B1",sizeof("B1")))
+		 DEBUG_P("B1")
 		 p1.z = p1.z + STEP_SIZE;
 		 }
 		 if (RMT_isButton3Pressed(cmd)) {
-		 DEBUG(("B3",sizeof("B3")))
+		 DEBUG_P("B3")
 		 p1.z = p1.z - STEP_SIZE;
 		 }
 
@@ -321,8 +331,7 @@ void ma_doStep(const DT_point* const point) {
 	MV_point(&leg_l, point, false);
 	MV_point(&leg_r, point, false);
 
-	COM_sendAction(COM_BRDCAST_ID);
-	MV_action(&leg_r, &leg_l);
+	MV_masterAction(&leg_r, &leg_l);
 }
 
 void ma_setInitialPoint(DT_point* const initPoint) {
@@ -0,0 +1,130 @@
+/**
+ * \file	packetPool.c
+ *
+ * \brief	Gemeinsame Puffer für Sende- und Empfangspakete von COM und DNX.
+ */
+
+#include "include/packetPool.h"
+#include "include/utils.h"
+
+/** \brief Pool gleich großer Puffer mit Stapel der freien Indizes. */
+typedef struct {
+	DT_byte* const data; /**< Erster Puffer. */
+	const DT_size size; /**< Größe eines Puffers. */
+	const DT_byte count; /**< Anzahl der Puffer. */
+	DT_byte* const free; /**< Freie Indizes, gültig bis top. */
+	DT_byte top; /**< Anzahl der freien Puffer. */
+	DT_byte minFree; /**< Tiefststand der freien Puffer. */
+	uint16_t failed; /**< Fehlgeschlagene PKT_acquire() und abgewiesene PKT_release(). */
+} DT_pktPool;
+
+DT_byte PKT_txData[PKT_TX_COUNT][PKT_TX_SIZE];
+DT_byte PKT_rxData[PKT_RX_COUNT][DT_RESULT_BUFFER_SIZE];
+DT_byte PKT_txFree[PKT_TX_COUNT] = { 0, 1, 2 };
+DT_byte PKT_rxFree[PKT_RX_COUNT] = { 0, 1 };
+
+DT_pktPool PKT_pools[PKT_POOLS] = { { &PKT_txData[0][0], PKT_TX_SIZE,
+		PKT_TX_COUNT, PKT_txFree, PKT_TX_COUNT, PKT_TX_COUNT, 0 }, {
+		&PKT_rxData[0][0], DT_RESULT_BUFFER_SIZE, PKT_RX_COUNT, PKT_rxFree,
+		PKT_RX_COUNT, PKT_RX_COUNT, 0 } };
+
+// lokale Methoden
+DT_pktPool* PKT_getPool(const DT_byte* const);
+
+/**
+ * \brief	Holt einen Puffer aus einem Pool.
+ *
+ * \param	pool	PKT_TX oder PKT_RX
+ *
+ * \return	Puffer oder NULL, wenn der Pool erschöpft ist
+ */
+DT_byte* PKT_acquire(DT_byte pool) {
+	DT_pktPool* const p = &PKT_pools[pool];
+	if (p->top == 0) {
+		DEBUG_P("PKT_ex")
+		p->failed++;
+		return NULL;
+	}
+	p->top--;
+	if (p->top < p->minFree)
+		p->minFree = p->top;
+	return &p->data[p->free[p->top] * p->size];
+}
+
+DT_pktPool* PKT_getPool(const DT_byte* const buffer) {
+	DT_byte i;
+	for (i = 0; i < PKT_POOLS; i++)
+		if (buffer >= PKT_pools[i].data && buffer < PKT_pools[i].data
+				+ PKT_pools[i].count * PKT_pools[i].size)
+			return &PKT_pools[i];
+	return NULL;
+}
+
+/**
+ * \brief	Gibt einen Puffer an seinen Pool zurück.
+ *
+ * 			Ein bereits freier Puffer (doppelte Rückgabe) wird abgewiesen und
+ * 			wie ein fehlgeschlagenes PKT_acquire() gezählt, der Stapel der
+ * 			freien Indizes bleibt unverändert.
+ *
+ * \param	buffer	Puffer aus PKT_acquire() oder NULL
+ */
+void PKT_release(DT_byte* const buffer) {
+	DT_pktPool* const p = PKT_getPool(buffer);
+	DT_byte index, i;
+	if (p == NULL)
+		return;
+	index = (buffer - p->data) / p->size;
+	for (i = 0; i < p->top && p->free[i] != index; i++)
+		;
+	if (p->top >= p->count || i < p->top) {
+		DEBUG_P("PKT_rel")
+		p->failed++;
+		return;
+	}
+	p->free[p->top++] = index;
+}
+
+/**
+ * \brief	Liefert die Anzahl der freien Puffer eines Pools.
+ *
+ * \param	pool	PKT_TX oder PKT_RX
+ *
+ * \return	Anzahl
+ */
+DT_byte PKT_getFree(DT_byte pool) {
+	return PKT_pools[pool].top;
+}
+
+/**
+ * \brief	Liefert den Tiefststand der freien Puffer eines Pools.
+ *
+ * \param	pool	PKT_TX oder PKT_RX
+ *
+ * \return	Anzahl
+ */
+DT_byte PKT_getMinFree(DT_byte pool) {
+	return PKT_pools[pool].minFree;
+}
+
+/**
+ * \brief	Liefert die Anzahl der fehlgeschlagenen PKT_acquire() und PKT_release() eines Pools.
+ *
+ * \param	pool	PKT_TX oder PKT_RX
+ *
+ * \return	Anzahl
+ */
+uint16_t PKT_getFailed(DT_byte pool) {
+	return PKT_pools[pool].failed;
+}
+
+/**
+ * \brief	Setzt Tiefststand und Fehlschläge aller Pools zurück.
+ */
+void PKT_resetStats() {
+	DT_byte i;
+	for (i = 0; i < PKT_POOLS; i++) {
+		PKT_pools[i].minFree = PKT_pools[i].top;
+		PKT_pools[i].failed = 0;
+	}
+}
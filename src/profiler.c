@@ -0,0 +1,223 @@
+/**
+ * \file	profiler.c
+ *
+ * \brief	Laufzeitmessung instrumentierter Abschnitte auf dem Controller.
+ *
+ * 			Ausgabe von PRF_dump() je Abschnitt als eine Zeile:
+ *
+ * 			PRF <Name> <Anzahl> <Min> <Mittel> <Max> <Klasse 0> ... <Klasse 16>
+ *
+ * 			Vor den Abschnitten eines Controllers steht bei MV_masterDumpProfile()
+ * 			die Zeile PRF_CPU <Controller> (PRF_dumpCpu()).
+ */
+
+#include "include/profiler.h"
+#include "include/xmega.h"
+#include "include/utils.h"
+
+DT_prfScope PRF_scopes[PRF_SCOPES];
+
+const DT_char* const PRF_NAMES[PRF_SCOPES] = { "KIN", "DNX_PACKET",
+		"DNX_WAIT", "COM_WAIT", "PLANNER" };
+
+// lokale Methoden
+void PRF_print(const DT_char*);
+uint32_t PRF_readLong(const DT_byte* const);
+void PRF_writeLong(uint32_t, DT_byte* const);
+
+/**
+ * \brief	Setzt die Messwerte aller Abschnitte zurück.
+ */
+void PRF_reset() {
+	DT_byte s, k;
+	for (s = 0; s < PRF_SCOPES; s++) {
+		PRF_scopes[s].count = 0;
+		PRF_scopes[s].sum_us = 0;
+		PRF_scopes[s].min_us = 0xFFFFFFFF;
+		PRF_scopes[s].max_us = 0;
+		for (k = 0; k < PRF_BUCKETS; k++)
+			PRF_scopes[s].hist[k] = 0;
+	}
+}
+
+/**
+ * \brief	Beginn eines Abschnitts.
+ *
+ * \param	scope	Abschnitt (PRF_KIN, ...)
+ */
+void PRF_enter(DT_byte scope) {
+	PRF_scopes[scope].start = XM_getUptimeUs();
+}
+
+/**
+ * \brief	Ende eines Abschnitts.
+ *
+ * \param	scope	Abschnitt (PRF_KIN, ...)
+ */
+void PRF_exit(DT_byte scope) {
+	PRF_record(scope, XM_getUptimeUs() - PRF_scopes[scope].start);
+}
+
+/**
+ * \brief	Übernimmt eine gemessene Dauer.
+ *
+ * \param	scope	Abschnitt
+ * \param	t		Dauer in us
+ */
+void PRF_record(DT_byte scope, uint32_t t) {
+	DT_prfScope* const s = &PRF_scopes[scope];
+	const DT_byte k = PRF_getBucket(t);
+	if (s->count == 0) {
+		s->min_us = t;
+		s->max_us = t;
+	}
+	s->count++;
+	s->sum_us += t;
+	if (t < s->min_us)
+		s->min_us = t;
+	if (t > s->max_us)
+		s->max_us = t;
+	if (s->hist[k] < 0xFFFF)
+		s->hist[k]++;
+}
+
+/**
+ * \brief	Liefert die Klasse des Histogramms für eine Dauer.
+ *
+ * \param	t	Dauer in us
+ *
+ * \return	Anzahl der signifikanten Bits von t, höchstens PRF_BUCKETS - 1
+ */
+DT_byte PRF_getBucket(uint32_t t) {
+	DT_byte k = 0;
+	while (t > 0 && k < PRF_BUCKETS - 1) {
+		t >>= 1;
+		k++;
+	}
+	return k;
+}
+
+/**
+ * \brief	Liefert die Messwerte eines Abschnitts.
+ *
+ * \param	scope	Abschnitt
+ *
+ * \return	Messwerte
+ */
+const DT_prfScope* PRF_get(DT_byte scope) {
+	return &PRF_scopes[scope];
+}
+
+/**
+ * \brief	Liefert den Namen eines Abschnitts.
+ *
+ * \param	scope	Abschnitt
+ *
+ * \return	Name oder "?"
+ */
+const DT_char* PRF_getName(DT_byte scope) {
+	return scope < PRF_SCOPES ? PRF_NAMES[scope] : "?";
+}
+
+uint32_t PRF_readLong(const DT_byte* const array) {
+	return (uint32_t) array[0] | (uint32_t) array[1] << 8
+			| (uint32_t) array[2] << 16 | (uint32_t) array[3] << 24;
+}
+
+void PRF_writeLong(uint32_t value, DT_byte* const array) {
+	array[0] = value;
+	array[1] = value >> 8;
+	array[2] = value >> 16;
+	array[3] = value >> 24;
+}
+
+/**
+ * \brief	Schreibt die Messwerte eines Abschnitts in ein Byte-Array (Little Endian).
+ *
+ * 			Anzahl (4), Summe (4), Minimum (4), Maximum (4), Histogramm (2 je Klasse)
+ *
+ * \param	scope	Abschnitt
+ * \param	array	Zielfeld mit mindestens PRF_SIZE Bytes
+ *
+ * \return	Anzahl der geschriebenen Bytes (PRF_SIZE)
+ */
+DT_byte PRF_toByteArray(DT_byte scope, DT_byte* const array) {
+	const DT_prfScope* const s = &PRF_scopes[scope];
+	DT_byte k;
+	PRF_writeLong(s->count, &array[0]);
+	PRF_writeLong(s->sum_us, &array[4]);
+	PRF_writeLong(s->min_us, &array[8]);
+	PRF_writeLong(s->max_us, &array[12]);
+	for (k = 0; k < PRF_BUCKETS; k++) {
+		array[16 + 2 * k] = s->hist[k];
+		array[17 + 2 * k] = s->hist[k] >> 8;
+	}
+	return PRF_SIZE;
+}
+
+/**
+ * \brief	Liest die Messwerte eines Abschnitts aus einem Byte-Array.
+ *
+ * \param	scope	Ziel
+ * \param	array	Byte-Array aus PRF_toByteArray()
+ */
+void PRF_fromByteArray(DT_prfScope* const scope, const DT_byte* const array) {
+	DT_byte k;
+	scope->count = PRF_readLong(&array[0]);
+	scope->sum_us = PRF_readLong(&array[4]);
+	scope->min_us = PRF_readLong(&array[8]);
+	scope->max_us = PRF_readLong(&array[12]);
+	for (k = 0; k < PRF_BUCKETS; k++)
+		scope->hist[k] = array[16 + 2 * k] | array[17 + 2 * k] << 8;
+	scope->start = 0;
+}
+
+void PRF_print(const DT_char* s) {
+	while (*s)
+		XM_debugPutChar(*s++);
+}
+
+/**
+ * \brief	Gibt die Messwerte eines Abschnitts als Zeile auf der Debug-USART aus.
+ *
+ * \param	name	Name des Abschnitts
+ * \param	scope	Messwerte
+ */
+void PRF_dumpScope(const DT_char* const name, const DT_prfScope* const scope) {
+	DT_byte k;
+	PRF_print("PRF ");
+	PRF_print(name);
+	XM_debugPutChar(' ');
+	UTL_printNumber(scope->count);
+	XM_debugPutChar(' ');
+	UTL_printNumber(scope->count ? scope->min_us : 0);
+	XM_debugPutChar(' ');
+	UTL_printNumber(scope->count ? scope->sum_us / scope->count : 0);
+	XM_debugPutChar(' ');
+	UTL_printNumber(scope->max_us);
+	for (k = 0; k < PRF_BUCKETS; k++) {
+		XM_debugPutChar(' ');
+		UTL_printNumber(scope->hist[k]);
+	}
+	XM_debugPutChar('\n');
+}
+
+/**
+ * \brief	Gibt die Zeile vor den Abschnitten eines Controllers aus.
+ *
+ * \param	cpuID	ID des Controllers
+ */
+void PRF_dumpCpu(DT_byte cpuID) {
+	PRF_print("PRF_CPU ");
+	UTL_printNumber(cpuID);
+	XM_debugPutChar('\n');
+}
+
+/**
+ * \brief	Gibt die Messwerte aller Abschnitte auf der Debug-USART aus.
+ */
+void PRF_dump() {
+	DT_byte s;
+	for (s = 0; s < PRF_SCOPES; s++)
+		PRF_dumpScope(PRF_NAMES[s], &PRF_scopes[s]);
+}
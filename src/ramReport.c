@@ -0,0 +1,229 @@
+/**
+ * \file	ramReport.c
+ *
+ * \brief	Statischer RAM je Modul und Stand der Stacks (Host).
+ *
+ * 			Summiert die Objekte in .data und .bss einer ELF-Datei (Firmware
+ * 			oder Host-Programm, 32 oder 64 Bit) je Modul. Das Modul ist der
+ * 			Präfix des Symbols bis zum ersten '_' (KIN_, DNX_, ...), andere
+ * 			Symbole werden unter "sonstige" gezählt. Optional werden die Zeilen
+ * 			von STK_dump() (MV_masterCheckStack()) aus einer Datei daneben
+ * 			ausgegeben.
+ *
+ * 			ramReport <ELF-Datei> [STK-Protokoll] [SRAM in Bytes, Standard 8192]
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "include/communication.h"
+#include "include/stack.h"
+
+#define MAX_MODULES	64
+#define NAME_SIZE	16
+
+/** \brief Statischer RAM eines Moduls. */
+typedef struct {
+	char name[NAME_SIZE];
+	unsigned long data, bss;
+} DT_ramModule;
+
+DT_ramModule modules[MAX_MODULES];
+int moduleCnt = 0;
+
+/**
+ * \brief	Ordnet ein Symbol seinem Modul zu und zählt seine Größe.
+ */
+void addSymbol(const char* name, unsigned long size, DT_bool bss) {
+	char module[NAME_SIZE] = "sonstige";
+	const char* const sep = strchr(name, '_');
+	const char* p;
+	int i;
+
+	if (sep != NULL && sep > name && sep - name < NAME_SIZE) {
+		for (p = name; p < sep && (isupper((unsigned char) *p) || isdigit(
+				(unsigned char) *p)); p++)
+			;
+		if (p == sep) {
+			memcpy(module, name, sep - name);
+			module[sep - name] = 0x00;
+		}
+	}
+	for (i = 0; i < moduleCnt && strcmp(modules[i].name, module) != 0; i++)
+		;
+	if (i == moduleCnt) {
+		if (moduleCnt == MAX_MODULES)
+			return;
+		strcpy(modules[moduleCnt++].name, module);
+	}
+	if (bss)
+		modules[i].bss += size;
+	else
+		modules[i].data += size;
+}
+
+/**
+ * \brief	Liest die Symboltabelle einer ELF-Datei mit ELFCLASS32.
+ */
+void readSymbols32(const unsigned char* const elf) {
+	const Elf32_Ehdr* const eh = (const Elf32_Ehdr*) elf;
+	const Elf32_Shdr* const sh = (const Elf32_Shdr*) (elf + eh->e_shoff);
+	const char* const names = (const char*) elf + sh[eh->e_shstrndx].sh_offset;
+	const Elf32_Sym* sym;
+	const char* str;
+	int data = -1, bss = -1, s;
+	unsigned long k;
+
+	for (s = 0; s < eh->e_shnum; s++) {
+		if (strcmp(names + sh[s].sh_name, ".data") == 0)
+			data = s;
+		else if (strcmp(names + sh[s].sh_name, ".bss") == 0)
+			bss = s;
+	}
+	for (s = 0; s < eh->e_shnum; s++) {
+		if (sh[s].sh_type != SHT_SYMTAB)
+			continue;
+		sym = (const Elf32_Sym*) (elf + sh[s].sh_offset);
+		str = (const char*) elf + sh[sh[s].sh_link].sh_offset;
+		for (k = 0; k < sh[s].sh_size / sizeof(Elf32_Sym); k++)
+			if (ELF32_ST_TYPE(sym[k].st_info) == STT_OBJECT && sym[k].st_size > 0
+					&& (sym[k].st_shndx == data || sym[k].st_shndx == bss))
+				addSymbol(str + sym[k].st_name, sym[k].st_size,
+						sym[k].st_shndx == bss);
+	}
+}
+
+/**
+ * \brief	Liest die Symboltabelle einer ELF-Datei mit ELFCLASS64.
+ */
+void readSymbols64(const unsigned char* const elf) {
+	const Elf64_Ehdr* const eh = (const Elf64_Ehdr*) elf;
+	const Elf64_Shdr* const sh = (const Elf64_Shdr*) (elf + eh->e_shoff);
+	const char* const names = (const char*) elf + sh[eh->e_shstrndx].sh_offset;
+	const Elf64_Sym* sym;
+	const char* str;
+	int data = -1, bss = -1, s;
+	unsigned long k;
+
+	for (s = 0; s < eh->e_shnum; s++) {
+		if (strcmp(names + sh[s].sh_name, ".data") == 0)
+			data = s;
+		else if (strcmp(names + sh[s].sh_name, ".bss") == 0)
+			bss = s;
+	}
+	for (s = 0; s < eh->e_shnum; s++) {
+		if (sh[s].sh_type != SHT_SYMTAB)
+			continue;
+		sym = (const Elf64_Sym*) (elf + sh[s].sh_offset);
+		str = (const char*) elf + sh[sh[s].sh_link].sh_offset;
+		for (k = 0; k < sh[s].sh_size / sizeof(Elf64_Sym); k++)
+			if (ELF64_ST_TYPE(sym[k].st_info) == STT_OBJECT && sym[k].st_size > 0
+					&& (sym[k].st_shndx == data || sym[k].st_shndx == bss))
+				addSymbol(str + sym[k].st_name, sym[k].st_size,
+						sym[k].st_shndx == bss);
+	}
+}
+
+int readElf(const char* file) {
+	struct stat st;
+	const unsigned char* elf;
+	const int fd = open(file, O_RDONLY);
+
+	if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < (off_t) EI_NIDENT) {
+		fprintf(stderr, "%s kann nicht gelesen werden\n", file);
+		if (fd >= 0)
+			close(fd);
+		return 1;
+	}
+	elf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (elf == MAP_FAILED || memcmp(elf, ELFMAG, SELFMAG) != 0) {
+		fprintf(stderr, "%s ist keine ELF-Datei\n", file);
+		return 1;
+	}
+	if (elf[EI_CLASS] == ELFCLASS32)
+		readSymbols32(elf);
+	else
+		readSymbols64(elf);
+	munmap((void*) elf, st.st_size);
+	return 0;
+}
+
+int compareModules(const void* a, const void* b) {
+	const DT_ramModule* const x = a;
+	const DT_ramModule* const y = b;
+	const unsigned long sx = x->data + x->bss, sy = y->data + y->bss;
+	return sx < sy ? 1 : sx > sy ? -1 : strcmp(x->name, y->name);
+}
+
+const char* cpuName(unsigned int cpu) {
+	switch (cpu) {
+	case COM_MASTER:
+		return "Master";
+	case COM_SLAVE1B:
+		return "1B";
+	case COM_SLAVE3F:
+		return "3F";
+	default:
+		return "?";
+	}
+}
+
+int main(int argc, char** argv) {
+	const unsigned long sram = argc > 3 ? strtoul(argv[3], NULL, 0) : 8192;
+	unsigned long data = 0, bss = 0;
+	unsigned int cpu, staticRam, used, unused, chain, chainUsed, budget;
+	char line[128];
+	FILE* log;
+	int i;
+
+	if (argc < 2) {
+		fprintf(stderr, "ramReport <ELF-Datei> [STK-Protokoll] [SRAM]\n");
+		return 1;
+	}
+	if (readElf(argv[1]) != 0)
+		return 1;
+
+	qsort(modules, moduleCnt, sizeof(DT_ramModule), compareModules);
+	printf("%-10s %8s %8s %8s\n", "Modul", ".data", ".bss", "Summe");
+	for (i = 0; i < moduleCnt; i++) {
+		printf("%-10s %8lu %8lu %8lu\n", modules[i].name, modules[i].data,
+				modules[i].bss, modules[i].data + modules[i].bss);
+		data += modules[i].data;
+		bss += modules[i].bss;
+	}
+	printf("%-10s %8lu %8lu %8lu\n", "gesamt", data, bss, data + bss);
+	printf("Budgets: Master %d, Slave %d Bytes, frei für Stack bei %lu Bytes SRAM: "
+		"%ld Bytes\n", STK_BUDGET_MASTER, STK_BUDGET_SLAVE, sram, (long) sram
+			- (long) (data + bss));
+
+	if (argc < 3)
+		return 0;
+	log = fopen(argv[2], "r");
+	if (log == NULL) {
+		fprintf(stderr, "%s kann nicht gelesen werden\n", argv[2]);
+		return 1;
+	}
+	printf("\n%-8s %8s %8s %8s %-8s %8s %8s\n", "CPU", "statisch", "Stack",
+			"frei", "Kette", "benutzt", "Budget");
+	while (fgets(line, sizeof(line), log) != NULL)
+		if (sscanf(line, "STK %u %u %u %u %u %u %u", &cpu, &staticRam, &used,
+				&unused, &chain, &chainUsed, &budget) == 7)
+			printf("%-8s %8u %8u %8u %-8s %8u %8u%s\n", cpuName(cpu),
+					staticRam, used, unused, chain == STK_MASTER ? "Master"
+							: chain == STK_SLAVE ? "Slave" : "-", chainUsed,
+					budget, chainUsed > budget ? "  ÜBERSCHRITTEN" : "");
+	fclose(log);
+	return 0;
+}
+
+#endif /* TEST_ON */
@@ -7,6 +7,7 @@
 #include "include/remote.h"
 #include "include/xmega.h"
 #include "include/utils.h"
+#include "include/packetPool.h"
 
 // Commands
 #define B_NON_PRESSED 0x0000
@@ -39,15 +40,18 @@
  *      L = Paket[2]
  */
 DT_cmd RMT_getCommand() {
-	DT_byte result[DT_RESULT_BUFFER_SIZE], i;
+	DT_byte* const result = PKT_acquire(PKT_RX);
+	DT_byte i;
 	DT_cmd cmd = 0x0000;
 	DT_cmd tmp_cmd = 0xFFFF;
 	DT_bool button_release = false;
 	// DT_size timeout = 65000;
+	if (result == NULL)
+		return B_NON_PRESSED;
 	for (i = 0; i < DT_RESULT_BUFFER_SIZE; i++)
 		result[i] = 0x00;
 	if (RMT_receive(&XM_remote_data, result) > 0) {
-		DEBUG(("CMD_EX", sizeof("CMD_EX")))
+		DEBUG_P("CMD_EX")
 		cmd = (result[4] << 8) | result[2];
 	} else {
 		cmd = B_NON_PRESSED;
@@ -60,6 +64,7 @@ DT_cmd RMT_getCommand() {
 		//timeout--;
 	}
 	//if(cmd!=0)DEBUG_BYTE((&cmd,sizeof(&cmd)))
+	PKT_release(result);
 	return cmd;
 }
 
@@ -82,21 +87,21 @@ DT_byte RMT_receive(USART_data_t* const usart_data, DT_byte* const dest) {
 
 	// Sind Daten vorhanden
 	if (USART_RXBuffer_checkPointerDiff(tempTail, tempHead, length)) {
-		//DEBUG(("RMT_nd",sizeof("RMT_nd")))
+		//DEBUG_P("RMT_nd")
 		return 0;
 	}
 	// Byte #1 und Byte #2 muessen laut Protokoll 0xFF und 0x55 sein
 	else if ((buffer->RX[buffer->RX_Tail] != 0xFF)
 			&& (buffer->RX[(buffer->RX_Tail + 1) & USART_RX_BUFFER_MASK]
 					!= 0x55)) {
-		DEBUG(("RMT_ff",sizeof("RMT_ff")))
+		DEBUG_P("RMT_ff")
 		return 0;
 	} else {
 		DT_byte i;
 		for (i = 0; i < length; i++) {
 			dest[i] = USART_RXBuffer_GetByte(usart_data);
 		}
-		DEBUG(("RMT_ok",sizeof("RMT_ok")))
+		DEBUG_P("RMT_ok")
 		return length;
 	}
 }
@@ -0,0 +1,111 @@
+/**
+ * \file	scoreGrid.c
+ *
+ * \brief	Tabellenbasierte Bewertung von Startpunkten.
+ *
+ * 			Ersetzt die Schnittpunktberechnung von scorePoint() durch eine
+ * 			bilineare Interpolation im Gitter der beiden benachbarten
+ * 			quantisierten Richtungen und eine lineare Interpolation zwischen
+ * 			diesen Richtungen. Der Endpunkt ergibt sich aus Startpunkt, Richtung
+ * 			und Strecke und wird deshalb nicht in der Tabelle gespeichert.
+ */
+
+#include "include/scoreGrid.h"
+#include "include/evolutionaryHelper.h"
+#include <math.h>
+
+// lokale Methoden
+void SG_setDirection(const DT_vector* const);
+DT_real SG_interpolate(const DT_byte, const DT_byte, const DT_byte,
+		const DT_real, const DT_real);
+
+// globale Variablen
+DT_vector SG_v = { 0, 0 };
+DT_vector SG_d;
+DT_byte SG_k0, SG_k1;
+DT_real SG_wk;
+
+/**
+ * \brief	Bestimmt Einheitsvektor und benachbarte Tabellenrichtungen für v.
+ *
+ * 			Das Ergebnis wird zwischengespeichert, da der EA alle Individuen einer
+ * 			Generation mit derselben Richtung bewertet.
+ *
+ * \param	v	Bewegungsrichtung (Koordinatensystem des EA)
+ */
+void SG_setDirection(const DT_vector* const v) {
+	DT_real len = sqrt(v->x * v->x + v->y * v->y);
+	DT_real a = atan2(v->y, v->x) * SG_DIRECTIONS / (2 * M_PI);
+	if (a < 0)
+		a += SG_DIRECTIONS;
+	SG_k0 = (DT_byte) a % SG_DIRECTIONS;
+	SG_k1 = (SG_k0 + 1) % SG_DIRECTIONS;
+	SG_wk = a - floor(a);
+	SG_d.x = v->x / len;
+	SG_d.y = v->y / len;
+	SG_v = *v;
+}
+
+/**
+ * \brief	Bilineare Interpolation in der Tabelle einer Richtung.
+ *
+ * \param	k	Richtungsindex
+ * \param	row	Zeile des unteren linken Gitterpunkts
+ * \param	col	Spalte des unteren linken Gitterpunkts
+ * \param	fy	Anteil in y-Richtung (0..1)
+ * \param	fx	Anteil in x-Richtung (0..1)
+ *
+ * \return	Interpolierte Strecke in 1/SG_SCALE
+ */
+DT_real SG_interpolate(const DT_byte k, const DT_byte row, const DT_byte col,
+		const DT_real fy, const DT_real fx) {
+	DT_real f00 = (int16_t) pgm_read_word(&SG_grid[k][row][col]);
+	DT_real f01 = (int16_t) pgm_read_word(&SG_grid[k][row][col + 1]);
+	DT_real f10 = (int16_t) pgm_read_word(&SG_grid[k][row + 1][col]);
+	DT_real f11 = (int16_t) pgm_read_word(&SG_grid[k][row + 1][col + 1]);
+	return (1 - fy) * (f00 + fx * (f01 - f00)) + fy * (f10 + fx * (f11 - f10));
+}
+
+/**
+ * \brief	Schnelle Bewertung eines Startpunkts.
+ *
+ * 			Ersetzt scorePoint() mit derselben Schnittstelle. p muss wie bei
+ * 			scorePoint() im Arbeitsraum liegen. Die Abweichung zur exakten Strecke
+ * 			ist am Rand und am Schatten des inneren Kreises am größten.
+ *
+ * \param	v	Bewegungsrichtung (Koordinatensystem des EA)
+ * \param	p	Startpunkt (Koordinatensystem des EA)
+ * \param	s	Zielpunkt für den Endpunkt
+ *
+ * \return	Güte des Startpunkts
+ */
+DT_real SG_scorePointFast(const DT_vector* const v, const DT_point* const p,
+		DT_point* s) {
+	DT_real gx, gy, fx, fy, F;
+	DT_byte row, col;
+	*s = *p;
+	if ((v->x == 0) && (v->y == 0))
+		return 0.0;
+	if ((v->x != SG_v.x) || (v->y != SG_v.y))
+		SG_setDirection(v);
+
+	// Gitterzelle, am Rand auf die äußeren Zellen begrenzt
+	gx = min(max((p->x - SG_X_MIN) / SG_STEP, 0), SG_COLS - 1.001);
+	gy = min(max((p->y - SG_Y_MIN) / SG_STEP, 0), SG_ROWS - 1.001);
+	col = (DT_byte) gx;
+	row = (DT_byte) gy;
+	fx = gx - col;
+	fy = gy - row;
+
+	F = (1 - SG_wk) * SG_interpolate(SG_k0, row, col, fy, fx) + SG_wk
+			* SG_interpolate(SG_k1, row, col, fy, fx);
+	F = max(F / SG_SCALE, 0);
+
+	// Endpunkt wie in scorePoint() leicht in den Arbeitsraum setzen
+	s->x = p->x + F * SG_d.x;
+	s->y = p->y + F * SG_d.y;
+	s->x = (s->x > 0) ? s->x - 1 : s->x + 1;
+	s->y = (s->y > 0) ? s->y - 1 : s->y + 1;
+	s->z = Z;
+	return F;
+}
@@ -0,0 +1,490 @@
+/**
+ * \file	scoreGridData.c
+ *
+ * \brief	Tabelle für scoreGrid.c, generiert mit genScoreGrid.c.
+ */
+
+#include "include/scoreGrid.h"
+
+const int16_t SG_grid[SG_DIRECTIONS][SG_ROWS][SG_COLS] PROGMEM = {
+	{ // 0
+		{ 11732, 10932, 10132, 9332, 8532, 7732, 6932, 6132, 5332, 4532, 3732, 2932, 2132, 1332, 532, -268, -1068, -1868, -2668, -3468, -4268, -5068 },
+		{ 6011, 5211, 4411, 3611, 2811, 2011, 1211, 411, -389, -1189, -1989, 3605, 2805, 2005, 1205, 405, -395, -1195, -1995, -2795, -3595, -4395 },
+		{ 13079, 12279, 11479, 10679, 9879, 9079, 8279, 7479, 6679, 5879, 5079, 4279, 3479, 2679, 1879, 1079, 279, -521, -1321, -2121, -2921, -3721 },
+		{ 13753, 12953, 12153, 11353, 10553, 9753, 8953, 8153, 7353, 6553, 5753, 4953, 4153, 3353, 2553, 1753, 953, 153, -647, -1447, -2247, -3047 },
+		{ 14426, 13626, 12826, 12026, 11226, 10426, 9626, 8826, 8026, 7226, 6426, 5626, 4826, 4026, 3226, 2426, 1626, 826, 26, -774, -1574, -2374 },
+		{ 15100, 14300, 13500, 12700, 11900, 11100, 10300, 9500, 8700, 7900, 7100, 6300, 5500, 4700, 3900, 3100, 2300, 1500, 700, -100, -900, -1700 },
+		{ 15774, 14974, 14174, 13374, 12574, 11774, 10974, 10174, 9374, 8574, 7774, 6974, 6174, 5374, 4574, 3774, 2974, 2174, 1374, 574, -226, -1026 },
+		{ 16447, 15647, 14847, 14047, 13247, 12447, 11647, 10847, 10047, 9247, 8447, 7647, 6847, 6047, 5247, 4447, 3647, 2847, 2047, 1247, 447, -353 },
+		{ 16169, 15369, 14569, 13769, 12969, 12169, 11369, 10569, 9769, 8969, 8169, 7369, 6569, 5769, 4969, 4169, 3369, 2569, 1769, 969, 169, -631 },
+		{ 14964, 14164, 13364, 12564, 11764, 10964, 10164, 9364, 8564, 7764, 6964, 6164, 5364, 4564, 3764, 2964, 2164, 1364, 564, -236, -1036, -1836 },
+		{ 13352, 12552, 11752, 10952, 10152, 9352, 8552, 7752, 6952, 6152, 5352, 4552, 3752, 2952, 2152, 1352, 552, -248, -1048, -1848, -2648, -3448 },
+		{ 10564, 9764, 8964, 8164, 7364, 6564, 5764, 4964, 4164, 3364, 2564, 1764, 964, 164, -636, -1436, -2236, -3036, -3836, -4636, -5436, -6236 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 1
+		{ 14368, 13388, 4800, 3431, 2230, 1110, 8489, 7510, 6530, 5550, 4570, 3590, 2611, 1631, 651, -329, -1309, -2288, -3268, -4248, -5228, -6208 },
+		{ 15193, 14213, 13234, 12254, 11274, 10294, 9314, 741, -635, -1839, 5395, 4416, 3436, 2456, 1476, 496, -483, -1463, -2443, -3423, -4403, -5382 },
+		{ 16018, 15039, 14059, 13079, 12099, 11119, 10140, 9160, 8180, 7200, 6220, 5241, 4261, 3281, 2301, 1321, 342, -638, -1618, -2598, -3578, -4557 },
+		{ 16843, 15864, 14884, 13904, 12924, 11944, 10965, 9985, 9005, 8025, 7045, 6066, 5086, 4106, 3126, 2147, 1167, 187, -793, -1773, -2752, -3732 },
+		{ 16469, 15823, 15172, 14518, 13749, 12770, 11790, 10810, 9830, 8850, 7871, 6891, 5911, 4931, 3951, 2972, 1992, 1012, 32, -948, -1927, -2907 },
+		{ 15541, 14921, 14295, 13663, 13027, 12386, 11740, 11089, 10435, 9675, 8696, 7716, 6736, 5756, 4776, 3797, 2817, 1837, 857, -122, -1102, -2082 },
+		{ 14463, 13876, 13281, 12680, 12072, 11457, 10837, 10211, 9580, 8944, 8302, 7657, 7007, 6352, 5602, 4622, 3642, 2662, 1682, 703, -277, -1257 },
+		{ 13172, 12635, 12085, 11526, 10956, 10378, 9791, 9197, 8596, 7988, 7374, 6753, 6128, 5497, 4860, 4219, 3574, 2924, 2270, 1528, 548, -432 },
+		{ 11535, 11085, 10612, 10119, 9610, 9086, 8549, 8000, 7441, 6871, 6293, 5707, 5113, 4512, 3904, 3290, 2670, 2044, 1413, 777, 136, -509 },
+		{ 9082, 8886, 8602, 8257, 7869, 7447, 6997, 6524, 6032, 5523, 5000, 4463, 3914, 3355, 2786, 2208, 1622, 1029, 428, -180, -794, -1414 },
+		{ 0, 0, 0, 4583, 5016, 4985, 4792, 4510, 4167, 3779, 3358, 2909, 2437, 1945, 1437, 914, 377, -171, -730, -1299, -1876, -2462 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 450, 913, 887, 698, 418, 76, -310, -731, -1179, -1651, -2142, -2650, -3173, -3709 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -3687, -3191, -3210, -3396, -3674, -4015, -4400, -4820, -5267 }
+	},
+	{ // 2
+		{ 17220, 16667, 16103, 15511, 14181, 12851, 11522, 10192, 8862, 7532, 6203, 4873, 3543, 2213, 884, -446, -1776, -3106, -4435, -5765, -7095, -8425 },
+		{ 16412, 15890, 15354, 14807, 14248, 13678, 12641, 11312, -1295, 8652, 7322, 5993, 4663, 3333, 2003, 674, -656, -1986, -3316, -4645, -5975, -7305 },
+		{ 15525, 15037, 14534, 14017, 13487, 12945, 12390, 11825, 11102, 9772, 8442, 7112, 5783, 4453, 3123, 1793, 464, -866, -2196, -3526, -4855, -6185 },
+		{ 14543, 14096, 13632, 13151, 12654, 12143, 11618, 11080, 10531, 9970, 9398, 8232, 6902, 5573, 4243, 2913, 1583, 254, -1076, -2406, -3736, -5065 },
+		{ 13442, 13048, 12631, 12193, 11736, 11262, 10771, 10266, 9746, 9214, 8669, 8113, 7545, 6692, 5363, 4033, 2703, 1373, 44, -1286, -2616, -3945 },
+		{ 12185, 11862, 11507, 11124, 10716, 10286, 9837, 9370, 8886, 8386, 7873, 7346, 6806, 6254, 5691, 5117, 3823, 2493, 1164, -166, -1496, -2826 },
+		{ 10703, 10486, 10218, 9910, 9567, 9195, 8797, 8376, 7935, 7475, 6998, 6504, 5997, 5475, 4940, 4394, 3835, 3266, 2283, 954, -376, -1706 },
+		{ 8831, 8808, 8686, 8492, 8244, 7952, 7622, 7262, 6874, 6463, 6030, 5577, 5107, 4620, 4118, 3602, 3073, 2531, 1977, 1413, 744, -586 },
+		{ 5805, 6485, 6710, 6741, 6655, 6489, 6262, 5987, 5672, 5324, 4948, 4546, 4121, 3676, 3213, 2733, 2237, 1727, 1203, 666, 118, -443 },
+		{ 0, 0, 2907, 4201, 4557, 4655, 4612, 4476, 4272, 4016, 3716, 3382, 3016, 2624, 2209, 1772, 1317, 843, 354, -150, -669, -1200 },
+		{ 0, 0, 0, 0, 0, 1806, 2362, 2545, 2552, 2451, 2273, 2037, 1755, 1434, 1081, 699, 293, -135, -583, -1049, -1532, -2030 },
+		{ 0, 0, 0, 0, 0, 0, 0, -833, 110, 406, 475, 413, 264, 50, -214, -520, -860, -1230, -1626, -2046, -2486, -2944 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -2231, -1770, -1625, -1639, -1756, -1945, -2189, -2479, -2806, -3164, -3550, -3960 }
+	},
+	{ // 3
+		{ 14991, 14659, 14297, 13910, 13499, 13065, 12610, 12135, 11641, 11128, 10262, 8062, 5862, 3662, 1462, -738, -2938, -5138, 0, 0, 0, 0 },
+		{ 13991, 13705, 13388, 13040, 12665, 12266, 11843, 11398, 10933, 10448, 9945, 9423, 7715, 5515, 3315, 1115, -1086, -3286, -5486, -7686, 0, 0 },
+		{ 12907, 12679, 12411, 12109, 11776, 11415, 11027, 10616, 10182, 9727, 9252, 8757, 8244, 7367, 5167, 2967, 767, -1433, -3633, -5833, -8033, 0 },
+		{ 11721, 11564, 11357, 11109, 10824, 10505, 10158, 9783, 9383, 8960, 8515, 8050, 7565, 7061, 6540, 4820, 2620, 420, -1780, -3980, -6181, -8381 },
+		{ 10402, 10338, 10208, 10025, 9797, 9530, 9227, 8894, 8532, 8145, 7733, 7299, 6844, 6368, 5874, 5361, 4473, 2272, 72, -2128, -4328, -6528 },
+		{ 8897, 8965, 8939, 8840, 8682, 8476, 8227, 7942, 7623, 7275, 6900, 6500, 6077, 5632, 5167, 4682, 4178, 3656, 1925, -275, -2475, -4675 },
+		{ 7087, 7377, 7505, 7522, 7457, 7327, 7144, 6915, 6648, 6345, 6012, 5650, 5262, 4850, 4416, 3961, 3485, 2990, 2478, 1578, -622, -2822 },
+		{ 4571, 5410, 5818, 6018, 6085, 6059, 5959, 5801, 5594, 5345, 5060, 4741, 4393, 4018, 3618, 3194, 2749, 2284, 1798, 1295, 773, -970 },
+		{ 0, 2243, 3636, 4210, 4499, 4626, 4642, 4577, 4446, 4263, 4034, 3766, 3463, 3129, 2767, 2379, 1968, 1533, 1078, 602, 107, -406 },
+		{ 0, 0, 0, 1700, 2534, 2940, 3139, 3206, 3178, 3078, 2920, 2713, 2464, 2178, 1859, 1511, 1135, 735, 312, -134, -599, -1085 },
+		{ 0, 0, 0, 0, -619, 762, 1332, 1620, 1746, 1762, 1696, 1565, 1381, 1152, 884, 581, 247, -115, -503, -915, -1350, -1806 },
+		{ 0, 0, 0, 0, 0, 0, -1172, -342, 62, 260, 326, 298, 198, 39, -169, -418, -704, -1023, -1372, -1747, -2148, -2571 },
+		{ 0, 0, 0, 0, 0, 0, 0, -3481, -2113, -1545, -1258, -1133, -1118, -1185, -1316, -1500, -1729, -1998, -2301, -2635, -2998, -3386 }
+	},
+	{ // 4
+		{ 12684, 12608, 12478, 12301, 12083, 11826, 11534, 11210, 10855, 10470, 10058, 9618, 9153, 8662, 4761, -2404, 0, 0, 0, 0, 0, 0 },
+		{ 11568, 11553, 11476, 11346, 11170, 10951, 10695, 10403, 10078, 9723, 9339, 8926, 8487, 8021, 7530, 3630, -3536, 0, 0, 0, 0, 0 },
+		{ 10378, 10437, 10422, 10345, 10215, 10038, 9820, 9563, 9272, 8947, 8592, 8207, 7795, 7356, 6890, 6399, 2498, -4667, 0, 0, 0, 0 },
+		{ 9096, 9246, 9305, 9290, 9213, 9084, 8907, 8688, 8432, 8140, 7816, 7460, 7076, 6664, 6224, 5759, 5268, 1367, -5798, 0, 0, 0 },
+		{ 7693, 7964, 8115, 8174, 8159, 8082, 7952, 7776, 7557, 7300, 7009, 6684, 6329, 5945, 5532, 5093, 4627, 4136, 236, -6930, 0, 0 },
+		{ 6118, 6561, 6833, 6984, 7042, 7027, 6951, 6821, 6644, 6426, 6169, 5877, 5553, 5198, 4813, 4401, 3962, 3496, 3005, -896, -8061, 0 },
+		{ 4256, 4986, 5430, 5701, 5852, 5911, 5896, 5819, 5689, 5513, 5294, 5038, 4746, 4422, 4066, 3682, 3270, 2830, 2365, 1874, -2027, -9192 },
+		{ 1706, 3125, 3855, 4299, 4570, 4721, 4780, 4765, 4688, 4558, 4381, 4163, 3906, 3615, 3290, 2935, 2551, 2138, 1699, 1233, 742, -3158 },
+		{ 0, 574, 1994, 2723, 3167, 3439, 3590, 3648, 3633, 3557, 3427, 3250, 3032, 2775, 2483, 2159, 1804, 1419, 1007, 567, 102, -389 },
+		{ 0, 0, -557, 862, 1592, 2036, 2307, 2458, 2517, 2502, 2425, 2295, 2119, 1900, 1644, 1352, 1027, 672, 288, -125, -564, -1029 },
+		{ 0, 0, 0, -1688, -269, 461, 905, 1176, 1327, 1386, 1371, 1294, 1164, 987, 769, 512, 221, -104, -459, -844, -1256, -1695 },
+		{ 0, 0, 0, 0, -2820, -1401, -671, -227, 45, 195, 254, 239, 162, 33, -144, -363, -619, -911, -1235, -1590, -1975, -2387 },
+		{ 0, 0, 0, 0, 0, -3951, -2532, -1802, -1358, -1087, -936, -877, -892, -969, -1099, -1275, -1494, -1750, -2042, -2367, -2722, -3106 }
+	},
+	{ // 5
+		{ 10493, 10672, 10771, 10802, 10774, 10692, 10562, 10388, 10172, 9917, 9624, 9295, 8931, 8533, 8100, 7633, 0, 0, 0, 0, 0, 0 },
+		{ 9358, 9600, 9751, 9826, 9837, 9790, 9692, 9547, 9358, 9129, 8862, 8557, 8216, 7841, 7431, 6986, 6508, 0, 0, 0, 0, 0 },
+		{ 8172, 8488, 8697, 8822, 8874, 8865, 8801, 8687, 8527, 8325, 8083, 7802, 7486, 7133, 6746, 6325, 5869, 5380, 0, 0, 0, 0 },
+		{ 6924, 7328, 7606, 7785, 7885, 7916, 7887, 7806, 7676, 7502, 7287, 7032, 6739, 6410, 6046, 5648, 5215, 4749, 0, 0, 0, 0 },
+		{ 5599, 6112, 6470, 6713, 6864, 6940, 6950, 6904, 6806, 6661, 6473, 6244, 5976, 5672, 5331, 4956, 4546, 4102, 3624, 0, 0, 0 },
+		{ 4172, 4828, 5284, 5600, 5810, 5935, 5988, 5979, 5915, 5801, 5641, 5439, 5197, 4917, 4601, 4248, 3862, 3440, 2985, 2496, 0, 0 },
+		{ 2598, 3455, 4035, 4440, 4718, 4898, 4998, 5029, 5001, 4920, 4791, 4617, 4401, 4146, 3854, 3526, 3162, 2763, 2331, 1864, 0, 0 },
+		{ 783, 1962, 2709, 3224, 3582, 3826, 3977, 4053, 4064, 4018, 3920, 3775, 3587, 3359, 3091, 2787, 2447, 2071, 1662, 1218, 740, 0 },
+		{ 0, 285, 1282, 1939, 2395, 2712, 2923, 3048, 3101, 3093, 3029, 2915, 2756, 2554, 2312, 2032, 1716, 1364, 977, 556, 101, -389 },
+		{ 0, 0, -293, 566, 1147, 1552, 1831, 2011, 2111, 2143, 2115, 2034, 1905, 1731, 1516, 1261, 969, 641, 277, -121, -553, -1020 },
+		{ 0, 0, -2111, -929, -180, 335, 695, 938, 1090, 1167, 1178, 1132, 1034, 890, 702, 473, 206, -98, -438, -813, -1223, -1667 },
+		{ 0, 0, 0, -2607, -1608, -950, -493, -175, 36, 161, 215, 206, 143, 29, -130, -332, -573, -853, -1169, -1521, -1908, -2329 },
+		{ 0, 0, 0, 0, -3184, -2324, -1742, -1336, -1057, -876, -776, -744, -771, -852, -981, -1155, -1370, -1624, -1916, -2244, -2608, -3006 }
+	},
+	{ // 6
+		{ 8585, 8979, 9274, 9486, 9625, 9702, 9721, 9687, 9604, 9474, 9299, 9081, 8820, 8517, 8172, 7784, 7353, 6877, 0, 0, 0, 0 },
+		{ 7521, 7963, 8297, 8541, 8710, 8812, 8854, 8842, 8779, 8668, 8511, 8311, 8067, 7782, 7454, 7084, 6671, 6213, 5711, 0, 0, 0 },
+		{ 6434, 6929, 7305, 7584, 7783, 7911, 7977, 7987, 7945, 7853, 7716, 7533, 7307, 7039, 6729, 6376, 5981, 5542, 5059, 0, 0, 0 },
+		{ 5319, 5874, 6296, 6613, 6843, 7000, 7091, 7124, 7102, 7031, 6912, 6748, 6540, 6290, 5997, 5662, 5284, 4863, 4399, 3888, 0, 0 },
+		{ 4174, 4797, 5269, 5627, 5892, 6078, 6195, 6251, 6252, 6201, 6101, 5956, 5766, 5533, 5257, 4940, 4580, 4177, 3731, 3239, 0, 0 },
+		{ 2993, 3694, 4223, 4625, 4926, 5143, 5288, 5369, 5392, 5362, 5282, 5155, 4984, 4768, 4510, 4210, 3868, 3483, 3055, 2582, 0, 0 },
+		{ 1769, 2562, 3155, 3606, 3947, 4197, 4370, 4477, 4523, 4515, 4455, 4348, 4194, 3997, 3757, 3474, 3149, 2782, 2372, 1918, 1418, 0 },
+		{ 492, 1397, 2064, 2569, 2952, 3237, 3441, 3575, 3645, 3659, 3620, 3532, 3397, 3218, 2995, 2730, 2423, 2073, 1681, 1245, 765, 0 },
+		{ 0, 192, 944, 1510, 1940, 2264, 2500, 2661, 2757, 2794, 2776, 2708, 2593, 2432, 2227, 1979, 1689, 1357, 983, 565, 104, -404 },
+		{ 0, -1062, -207, 429, 910, 1275, 1546, 1737, 1859, 1919, 1924, 1876, 1780, 1638, 1451, 1221, 949, 634, 277, -122, -566, -1054 },
+		{ 0, 0, -1394, -679, -139, 271, 578, 801, 950, 1036, 1063, 1036, 960, 836, 668, 456, 201, -97, -436, -818, -1243, -1712 },
+		{ 0, 0, -2627, -1816, -1211, -751, -404, -148, 31, 142, 192, 187, 131, 27, -123, -317, -555, -834, -1156, -1520, -1927, -2378 },
+		{ 0, 0, -3915, -2988, -2307, -1793, -1402, -1110, -900, -762, -688, -670, -705, -790, -921, -1097, -1317, -1579, -1884, -2230, -2619, -3052 }
+	},
+	{ // 7
+		{ 7053, 7595, 8035, 8387, 8665, 8875, 9024, 9117, 9156, 9144, 9083, 8975, 8818, 8614, 8363, 8061, 7710, 7304, 6842, 6319, 0, 0 },
+		{ 6115, 6681, 7139, 7508, 7799, 8022, 8183, 8287, 8336, 8335, 8284, 8184, 8038, 7843, 7601, 7310, 6968, 6574, 6123, 5613, 0, 0 },
+		{ 5172, 5762, 6240, 6625, 6932, 7168, 7340, 7455, 7515, 7523, 7482, 7392, 7255, 7070, 6837, 6556, 6224, 5841, 5402, 4904, 0, 0 },
+		{ 4223, 4838, 5337, 5740, 6061, 6310, 6495, 6621, 6692, 6710, 6679, 6598, 6470, 6295, 6072, 5800, 5479, 5106, 4678, 4192, 3643, 0 },
+		{ 3268, 3910, 4430, 4851, 5187, 5450, 5648, 5785, 5866, 5895, 5873, 5802, 5684, 5518, 5304, 5042, 4731, 4368, 3952, 3478, 2942, 0 },
+		{ 2307, 2978, 3520, 3959, 4311, 4588, 4798, 4946, 5039, 5078, 5066, 5005, 4896, 4739, 4535, 4283, 3981, 3629, 3224, 2761, 2238, 0 },
+		{ 1339, 2040, 2605, 3063, 3431, 3723, 3945, 4106, 4209, 4258, 4256, 4205, 4105, 3958, 3764, 3521, 3230, 2888, 2493, 2042, 1532, 0 },
+		{ 365, 1097, 1686, 2164, 2549, 2855, 3090, 3263, 3377, 3437, 3445, 3403, 3313, 3176, 2990, 2757, 2476, 2144, 1760, 1321, 822, 0 },
+		{ 0, 148, 763, 1261, 1663, 1984, 2233, 2418, 2543, 2614, 2632, 2600, 2519, 2391, 2215, 1992, 1720, 1399, 1025, 597, 111, -439 },
+		{ 0, -806, -165, 354, 774, 1110, 1373, 1570, 1707, 1788, 1816, 1794, 1724, 1605, 1438, 1225, 962, 651, 288, -129, -603, -1140 },
+		{ 0, -1767, -1097, -556, -118, 234, 511, 720, 869, 961, 999, 987, 926, 817, 660, 455, 203, -99, -451, -857, -1320, -1843 },
+		{ 0, -2735, -2035, -1470, -1013, -645, -354, -132, 28, 131, 180, 178, 126, 26, -121, -316, -559, -850, -1193, -1588, -2039, -2550 },
+		{ 0, -3709, -2978, -2389, -1912, -1528, -1222, -987, -815, -701, -641, -633, -675, -766, -904, -1089, -1322, -1604, -1936, -2320, -2760, -3259 }
+	},
+	{ // 8
+		{ 0, 6524, 7058, 7512, 7895, 8213, 8473, 8676, 8827, 8926, 8976, 8976, 8926, 8827, 8676, 8473, 8213, 7895, 7512, 7058, 6524, 0 },
+		{ 0, 5724, 6258, 6712, 7095, 7413, 7673, 7876, 8027, 8126, 8176, 8176, 8126, 8027, 7876, 7673, 7413, 7095, 6712, 6258, 5724, 0 },
+		{ 0, 4924, 5458, 5912, 6295, 6613, 6873, 7076, 7227, 7326, 7376, 7376, 7326, 7227, 7076, 6873, 6613, 6295, 5912, 5458, 4924, 0 },
+		{ 0, 4124, 4658, 5112, 5495, 5813, 6073, 6276, 6427, 6526, 6576, 6576, 6526, 6427, 6276, 6073, 5813, 5495, 5112, 4658, 4124, 0 },
+		{ 0, 3324, 3858, 4312, 4695, 5013, 5273, 5476, 5627, 5726, 5776, 5776, 5726, 5627, 5476, 5273, 5013, 4695, 4312, 3858, 3324, 0 },
+		{ 0, 2524, 3058, 3512, 3895, 4213, 4473, 4676, 4827, 4926, 4976, 4976, 4926, 4827, 4676, 4473, 4213, 3895, 3512, 3058, 2524, 0 },
+		{ 0, 1724, 2258, 2712, 3095, 3413, 3673, 3876, 4027, 4126, 4176, 4176, 4126, 4027, 3876, 3673, 3413, 3095, 2712, 2258, 1724, 0 },
+		{ 0, 924, 1458, 1912, 2295, 2613, 2873, 3076, 3227, 3326, 3376, 3376, 3326, 3227, 3076, 2873, 2613, 2295, 1912, 1458, 924, 0 },
+		{ 0, 124, 658, 1112, 1495, 1813, 2073, 2276, 2427, 2526, 2576, 2576, 2526, 2427, 2276, 2073, 1813, 1495, 1112, 658, 124, 0 },
+		{ 0, -676, -142, 312, 695, 1013, 1273, 1476, 1627, 1726, 1776, 1776, 1726, 1627, 1476, 1273, 1013, 695, 312, -142, -676, 0 },
+		{ 0, -1476, -942, -488, -105, 213, 473, 676, 827, 926, 976, 976, 926, 827, 676, 473, 213, -105, -488, -942, -1476, 0 },
+		{ 0, -2276, -1742, -1288, -905, -587, -327, -124, 27, 126, 176, 176, 126, 27, -124, -327, -587, -905, -1288, -1742, -2276, 0 },
+		{ 0, -3076, -2542, -2088, -1705, -1387, -1127, -924, -773, -674, -624, -624, -674, -773, -924, -1127, -1387, -1705, -2088, -2542, -3076, 0 }
+	},
+	{ // 9
+		{ 0, 0, 6319, 6842, 7304, 7710, 8061, 8363, 8614, 8818, 8975, 9083, 9144, 9156, 9117, 9024, 8875, 8665, 8387, 8035, 7595, 7053 },
+		{ 0, 0, 5613, 6123, 6574, 6968, 7310, 7601, 7843, 8038, 8184, 8284, 8335, 8336, 8287, 8183, 8022, 7799, 7508, 7139, 6681, 6115 },
+		{ 0, 0, 4904, 5402, 5841, 6224, 6556, 6837, 7070, 7255, 7392, 7482, 7523, 7515, 7455, 7340, 7168, 6932, 6625, 6240, 5762, 5172 },
+		{ 0, 3643, 4192, 4678, 5106, 5479, 5800, 6072, 6295, 6470, 6598, 6679, 6710, 6692, 6621, 6495, 6310, 6061, 5740, 5337, 4838, 4223 },
+		{ 0, 2942, 3478, 3952, 4368, 4731, 5042, 5304, 5518, 5684, 5802, 5873, 5895, 5866, 5785, 5648, 5450, 5187, 4851, 4430, 3910, 3268 },
+		{ 0, 2238, 2761, 3224, 3629, 3981, 4283, 4535, 4739, 4896, 5005, 5066, 5078, 5039, 4946, 4798, 4588, 4311, 3959, 3520, 2978, 2307 },
+		{ 0, 1532, 2042, 2493, 2888, 3230, 3521, 3764, 3958, 4105, 4205, 4256, 4258, 4209, 4106, 3945, 3723, 3431, 3063, 2605, 2040, 1339 },
+		{ 0, 822, 1321, 1760, 2144, 2476, 2757, 2990, 3176, 3313, 3403, 3445, 3437, 3377, 3263, 3090, 2855, 2549, 2164, 1686, 1097, 365 },
+		{ -439, 111, 597, 1025, 1399, 1720, 1992, 2215, 2391, 2519, 2600, 2632, 2614, 2543, 2418, 2233, 1984, 1663, 1261, 763, 148, 0 },
+		{ -1140, -603, -129, 288, 651, 962, 1225, 1438, 1605, 1724, 1794, 1816, 1788, 1707, 1570, 1373, 1110, 774, 354, -165, -806, 0 },
+		{ -1843, -1320, -857, -451, -99, 203, 455, 660, 817, 926, 987, 999, 961, 869, 720, 511, 234, -118, -556, -1097, -1767, 0 },
+		{ -2550, -2039, -1588, -1193, -850, -559, -316, -121, 26, 126, 178, 180, 131, 28, -132, -354, -645, -1013, -1470, -2035, -2735, 0 },
+		{ -3259, -2760, -2320, -1936, -1604, -1322, -1089, -904, -766, -675, -633, -641, -701, -815, -987, -1222, -1528, -1912, -2389, -2978, -3709, 0 }
+	},
+	{ // 10
+		{ 0, 0, 0, 0, 6877, 7353, 7784, 8172, 8517, 8820, 9081, 9299, 9474, 9604, 9687, 9721, 9702, 9625, 9486, 9274, 8979, 8585 },
+		{ 0, 0, 0, 5711, 6213, 6671, 7084, 7454, 7782, 8067, 8311, 8511, 8668, 8779, 8842, 8854, 8812, 8710, 8541, 8297, 7963, 7521 },
+		{ 0, 0, 0, 5059, 5542, 5981, 6376, 6729, 7039, 7307, 7533, 7716, 7853, 7945, 7987, 7977, 7911, 7783, 7584, 7305, 6929, 6434 },
+		{ 0, 0, 3888, 4399, 4863, 5284, 5662, 5997, 6290, 6540, 6748, 6912, 7031, 7102, 7124, 7091, 7000, 6843, 6613, 6296, 5874, 5319 },
+		{ 0, 0, 3239, 3731, 4177, 4580, 4940, 5257, 5533, 5766, 5956, 6101, 6201, 6252, 6251, 6195, 6078, 5892, 5627, 5269, 4797, 4174 },
+		{ 0, 0, 2582, 3055, 3483, 3868, 4210, 4510, 4768, 4984, 5155, 5282, 5362, 5392, 5369, 5288, 5143, 4926, 4625, 4223, 3694, 2993 },
+		{ 0, 1418, 1918, 2372, 2782, 3149, 3474, 3757, 3997, 4194, 4348, 4455, 4515, 4523, 4477, 4370, 4197, 3947, 3606, 3155, 2562, 1769 },
+		{ 0, 765, 1245, 1681, 2073, 2423, 2730, 2995, 3218, 3397, 3532, 3620, 3659, 3645, 3575, 3441, 3237, 2952, 2569, 2064, 1397, 492 },
+		{ -404, 104, 565, 983, 1357, 1689, 1979, 2227, 2432, 2593, 2708, 2776, 2794, 2757, 2661, 2500, 2264, 1940, 1510, 944, 192, 0 },
+		{ -1054, -566, -122, 277, 634, 949, 1221, 1451, 1638, 1780, 1876, 1924, 1919, 1859, 1737, 1546, 1275, 910, 429, -207, -1062, 0 },
+		{ -1712, -1243, -818, -436, -97, 201, 456, 668, 836, 960, 1036, 1063, 1036, 950, 801, 578, 271, -139, -679, -1394, 0, 0 },
+		{ -2378, -1927, -1520, -1156, -834, -555, -317, -123, 27, 131, 187, 192, 142, 31, -148, -404, -751, -1211, -1816, -2627, 0, 0 },
+		{ -3052, -2619, -2230, -1884, -1579, -1317, -1097, -921, -790, -705, -670, -688, -762, -900, -1110, -1402, -1793, -2307, -2988, -3915, 0, 0 }
+	},
+	{ // 11
+		{ 0, 0, 0, 0, 0, 0, 7633, 8100, 8533, 8931, 9295, 9624, 9917, 10172, 10388, 10562, 10692, 10774, 10802, 10771, 10672, 10493 },
+		{ 0, 0, 0, 0, 0, 6508, 6986, 7431, 7841, 8216, 8557, 8862, 9129, 9358, 9547, 9692, 9790, 9837, 9826, 9751, 9600, 9358 },
+		{ 0, 0, 0, 0, 5380, 5869, 6325, 6746, 7133, 7486, 7802, 8083, 8325, 8527, 8687, 8801, 8865, 8874, 8822, 8697, 8488, 8172 },
+		{ 0, 0, 0, 0, 4749, 5215, 5648, 6046, 6410, 6739, 7032, 7287, 7502, 7676, 7806, 7887, 7916, 7885, 7785, 7606, 7328, 6924 },
+		{ 0, 0, 0, 3624, 4102, 4546, 4956, 5331, 5672, 5976, 6244, 6473, 6661, 6806, 6904, 6950, 6940, 6864, 6713, 6470, 6112, 5599 },
+		{ 0, 0, 2496, 2985, 3440, 3862, 4248, 4601, 4917, 5197, 5439, 5641, 5801, 5915, 5979, 5988, 5935, 5810, 5600, 5284, 4828, 4172 },
+		{ 0, 0, 1864, 2331, 2763, 3162, 3526, 3854, 4146, 4401, 4617, 4791, 4920, 5001, 5029, 4998, 4898, 4718, 4440, 4035, 3455, 2598 },
+		{ 0, 740, 1218, 1662, 2071, 2447, 2787, 3091, 3359, 3587, 3775, 3920, 4018, 4064, 4053, 3977, 3826, 3582, 3224, 2709, 1962, 783 },
+		{ -389, 101, 556, 977, 1364, 1716, 2032, 2312, 2554, 2756, 2915, 3029, 3093, 3101, 3048, 2923, 2712, 2395, 1939, 1282, 285, 0 },
+		{ -1020, -553, -121, 277, 641, 969, 1261, 1516, 1731, 1905, 2034, 2115, 2143, 2111, 2011, 1831, 1552, 1147, 566, -293, 0, 0 },
+		{ -1667, -1223, -813, -438, -98, 206, 473, 702, 890, 1034, 1132, 1178, 1167, 1090, 938, 695, 335, -180, -929, -2111, 0, 0 },
+		{ -2329, -1908, -1521, -1169, -853, -573, -332, -130, 29, 143, 206, 215, 161, 36, -175, -493, -950, -1608, -2607, 0, 0, 0 },
+		{ -3006, -2608, -2244, -1916, -1624, -1370, -1155, -981, -852, -771, -744, -776, -876, -1057, -1336, -1742, -2324, -3184, 0, 0, 0, 0 }
+	},
+	{ // 12
+		{ 0, 0, 0, 0, 0, 0, -2404, 4761, 8662, 9153, 9618, 10058, 10470, 10855, 11210, 11534, 11826, 12083, 12301, 12478, 12608, 12684 },
+		{ 0, 0, 0, 0, 0, -3536, 3630, 7530, 8021, 8487, 8926, 9339, 9723, 10078, 10403, 10695, 10951, 11170, 11346, 11476, 11553, 11568 },
+		{ 0, 0, 0, 0, -4667, 2498, 6399, 6890, 7356, 7795, 8207, 8592, 8947, 9272, 9563, 9820, 10038, 10215, 10345, 10422, 10437, 10378 },
+		{ 0, 0, 0, -5798, 1367, 5268, 5759, 6224, 6664, 7076, 7460, 7816, 8140, 8432, 8688, 8907, 9084, 9213, 9290, 9305, 9246, 9096 },
+		{ 0, 0, -6930, 236, 4136, 4627, 5093, 5532, 5945, 6329, 6684, 7009, 7300, 7557, 7776, 7952, 8082, 8159, 8174, 8115, 7964, 7693 },
+		{ 0, -8061, -896, 3005, 3496, 3962, 4401, 4813, 5198, 5553, 5877, 6169, 6426, 6644, 6821, 6951, 7027, 7042, 6984, 6833, 6561, 6118 },
+		{ -9192, -2027, 1874, 2365, 2830, 3270, 3682, 4066, 4422, 4746, 5038, 5294, 5513, 5689, 5819, 5896, 5911, 5852, 5701, 5430, 4986, 4256 },
+		{ -3158, 742, 1233, 1699, 2138, 2551, 2935, 3290, 3615, 3906, 4163, 4381, 4558, 4688, 4765, 4780, 4721, 4570, 4299, 3855, 3125, 1706 },
+		{ -389, 102, 567, 1007, 1419, 1804, 2159, 2483, 2775, 3032, 3250, 3427, 3557, 3633, 3648, 3590, 3439, 3167, 2723, 1994, 574, 0 },
+		{ -1029, -564, -125, 288, 672, 1027, 1352, 1644, 1900, 2119, 2295, 2425, 2502, 2517, 2458, 2307, 2036, 1592, 862, -557, 0, 0 },
+		{ -1695, -1256, -844, -459, -104, 221, 512, 769, 987, 1164, 1294, 1371, 1386, 1327, 1176, 905, 461, -269, -1688, 0, 0, 0 },
+		{ -2387, -1975, -1590, -1235, -911, -619, -363, -144, 33, 162, 239, 254, 195, 45, -227, -671, -1401, -2820, 0, 0, 0, 0 },
+		{ -3106, -2722, -2367, -2042, -1750, -1494, -1275, -1099, -969, -892, -877, -936, -1087, -1358, -1802, -2532, -3951, 0, 0, 0, 0, 0 }
+	},
+	{ // 13
+		{ 0, 0, 0, 0, -5138, -2938, -738, 1462, 3662, 5862, 8062, 10262, 11128, 11641, 12135, 12610, 13065, 13499, 13910, 14297, 14659, 14991 },
+		{ 0, 0, -7686, -5486, -3286, -1086, 1115, 3315, 5515, 7715, 9423, 9945, 10448, 10933, 11398, 11843, 12266, 12665, 13040, 13388, 13705, 13991 },
+		{ 0, -8033, -5833, -3633, -1433, 767, 2967, 5167, 7367, 8244, 8757, 9252, 9727, 10182, 10616, 11027, 11415, 11776, 12109, 12411, 12679, 12907 },
+		{ -8381, -6181, -3980, -1780, 420, 2620, 4820, 6540, 7061, 7565, 8050, 8515, 8960, 9383, 9783, 10158, 10505, 10824, 11109, 11357, 11564, 11721 },
+		{ -6528, -4328, -2128, 72, 2272, 4473, 5361, 5874, 6368, 6844, 7299, 7733, 8145, 8532, 8894, 9227, 9530, 9797, 10025, 10208, 10338, 10402 },
+		{ -4675, -2475, -275, 1925, 3656, 4178, 4682, 5167, 5632, 6077, 6500, 6900, 7275, 7623, 7942, 8227, 8476, 8682, 8840, 8939, 8965, 8897 },
+		{ -2822, -622, 1578, 2478, 2990, 3485, 3961, 4416, 4850, 5262, 5650, 6012, 6345, 6648, 6915, 7144, 7327, 7457, 7522, 7505, 7377, 7087 },
+		{ -970, 773, 1295, 1798, 2284, 2749, 3194, 3618, 4018, 4393, 4741, 5060, 5345, 5594, 5801, 5959, 6059, 6085, 6018, 5818, 5410, 4571 },
+		{ -406, 107, 602, 1078, 1533, 1968, 2379, 2767, 3129, 3463, 3766, 4034, 4263, 4446, 4577, 4642, 4626, 4499, 4210, 3636, 2243, 0 },
+		{ -1085, -599, -134, 312, 735, 1135, 1511, 1859, 2178, 2464, 2713, 2920, 3078, 3178, 3206, 3139, 2940, 2534, 1700, 0, 0, 0 },
+		{ -1806, -1350, -915, -503, -115, 247, 581, 884, 1152, 1381, 1565, 1696, 1762, 1746, 1620, 1332, 762, -619, 0, 0, 0, 0 },
+		{ -2571, -2148, -1747, -1372, -1023, -704, -418, -169, 39, 198, 298, 326, 260, 62, -342, -1172, 0, 0, 0, 0, 0, 0 },
+		{ -3386, -2998, -2635, -2301, -1998, -1729, -1500, -1316, -1185, -1118, -1133, -1258, -1545, -2113, -3481, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 14
+		{ -8425, -7095, -5765, -4435, -3106, -1776, -446, 884, 2213, 3543, 4873, 6203, 7532, 8862, 10192, 11522, 12851, 14181, 15511, 16103, 16667, 17220 },
+		{ -7305, -5975, -4645, -3316, -1986, -656, 674, 2003, 3333, 4663, 5993, 7322, 8652, -1295, 11312, 12641, 13678, 14248, 14807, 15354, 15890, 16412 },
+		{ -6185, -4855, -3526, -2196, -866, 464, 1793, 3123, 4453, 5783, 7112, 8442, 9772, 11102, 11825, 12390, 12945, 13487, 14017, 14534, 15037, 15525 },
+		{ -5065, -3736, -2406, -1076, 254, 1583, 2913, 4243, 5573, 6902, 8232, 9398, 9970, 10531, 11080, 11618, 12143, 12654, 13151, 13632, 14096, 14543 },
+		{ -3945, -2616, -1286, 44, 1373, 2703, 4033, 5363, 6692, 7545, 8113, 8669, 9214, 9746, 10266, 10771, 11262, 11736, 12193, 12631, 13048, 13442 },
+		{ -2826, -1496, -166, 1164, 2493, 3823, 5117, 5691, 6254, 6806, 7346, 7873, 8386, 8886, 9370, 9837, 10286, 10716, 11124, 11507, 11862, 12185 },
+		{ -1706, -376, 954, 2283, 3266, 3835, 4394, 4940, 5475, 5997, 6504, 6998, 7475, 7935, 8376, 8797, 9195, 9567, 9910, 10218, 10486, 10703 },
+		{ -586, 744, 1413, 1977, 2531, 3073, 3602, 4118, 4620, 5107, 5577, 6030, 6463, 6874, 7262, 7622, 7952, 8244, 8492, 8686, 8808, 8831 },
+		{ -443, 118, 666, 1203, 1727, 2237, 2733, 3213, 3676, 4121, 4546, 4948, 5324, 5672, 5987, 6262, 6489, 6655, 6741, 6710, 6485, 5805 },
+		{ -1200, -669, -150, 354, 843, 1317, 1772, 2209, 2624, 3016, 3382, 3716, 4016, 4272, 4476, 4612, 4655, 4557, 4201, 2907, 0, 0 },
+		{ -2030, -1532, -1049, -583, -135, 293, 699, 1081, 1434, 1755, 2037, 2273, 2451, 2552, 2545, 2362, 1806, 0, 0, 0, 0, 0 },
+		{ -2944, -2486, -2046, -1626, -1230, -860, -520, -214, 50, 264, 413, 475, 406, 110, -833, 0, 0, 0, 0, 0, 0, 0 },
+		{ -3960, -3550, -3164, -2806, -2479, -2189, -1945, -1756, -1639, -1625, -1770, -2231, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 15
+		{ -6208, -5228, -4248, -3268, -2288, -1309, -329, 651, 1631, 2611, 3590, 4570, 5550, 6530, 7510, 8489, 1110, 2230, 3431, 4800, 13388, 14368 },
+		{ -5382, -4403, -3423, -2443, -1463, -483, 496, 1476, 2456, 3436, 4416, 5395, -1839, -635, 741, 9314, 10294, 11274, 12254, 13234, 14213, 15193 },
+		{ -4557, -3578, -2598, -1618, -638, 342, 1321, 2301, 3281, 4261, 5241, 6220, 7200, 8180, 9160, 10140, 11119, 12099, 13079, 14059, 15039, 16018 },
+		{ -3732, -2752, -1773, -793, 187, 1167, 2147, 3126, 4106, 5086, 6066, 7045, 8025, 9005, 9985, 10965, 11944, 12924, 13904, 14884, 15864, 16843 },
+		{ -2907, -1927, -948, 32, 1012, 1992, 2972, 3951, 4931, 5911, 6891, 7871, 8850, 9830, 10810, 11790, 12770, 13749, 14518, 15172, 15823, 16469 },
+		{ -2082, -1102, -122, 857, 1837, 2817, 3797, 4776, 5756, 6736, 7716, 8696, 9675, 10435, 11089, 11740, 12386, 13027, 13663, 14295, 14921, 15541 },
+		{ -1257, -277, 703, 1682, 2662, 3642, 4622, 5602, 6352, 7007, 7657, 8302, 8944, 9580, 10211, 10837, 11457, 12072, 12680, 13281, 13876, 14463 },
+		{ -432, 548, 1528, 2270, 2924, 3574, 4219, 4860, 5497, 6128, 6753, 7374, 7988, 8596, 9197, 9791, 10378, 10956, 11526, 12085, 12635, 13172 },
+		{ -509, 136, 777, 1413, 2044, 2670, 3290, 3904, 4512, 5113, 5707, 6293, 6871, 7441, 8000, 8549, 9086, 9610, 10119, 10612, 11085, 11535 },
+		{ -1414, -794, -180, 428, 1029, 1622, 2208, 2786, 3355, 3914, 4463, 5000, 5523, 6032, 6524, 6997, 7447, 7869, 8257, 8602, 8886, 9082 },
+		{ -2462, -1876, -1299, -730, -171, 377, 914, 1437, 1945, 2437, 2909, 3358, 3779, 4167, 4510, 4792, 4985, 5016, 4583, 0, 0, 0 },
+		{ -3709, -3173, -2650, -2142, -1651, -1179, -731, -310, 76, 418, 698, 887, 913, 450, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ -5267, -4820, -4400, -4015, -3674, -3396, -3210, -3191, -3687, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 16
+		{ -5068, -4268, -3468, -2668, -1868, -1068, -268, 532, 1332, 2132, 2932, 3732, 4532, 5332, 6132, 6932, 7732, 8532, 9332, 10132, 10932, 11732 },
+		{ -4395, -3595, -2795, -1995, -1195, -395, 405, 1205, 2005, 2805, 3605, -1989, -1189, -389, 411, 1211, 2011, 2811, 3611, 4411, 5211, 6011 },
+		{ -3721, -2921, -2121, -1321, -521, 279, 1079, 1879, 2679, 3479, 4279, 5079, 5879, 6679, 7479, 8279, 9079, 9879, 10679, 11479, 12279, 13079 },
+		{ -3047, -2247, -1447, -647, 153, 953, 1753, 2553, 3353, 4153, 4953, 5753, 6553, 7353, 8153, 8953, 9753, 10553, 11353, 12153, 12953, 13753 },
+		{ -2374, -1574, -774, 26, 826, 1626, 2426, 3226, 4026, 4826, 5626, 6426, 7226, 8026, 8826, 9626, 10426, 11226, 12026, 12826, 13626, 14426 },
+		{ -1700, -900, -100, 700, 1500, 2300, 3100, 3900, 4700, 5500, 6300, 7100, 7900, 8700, 9500, 10300, 11100, 11900, 12700, 13500, 14300, 15100 },
+		{ -1026, -226, 574, 1374, 2174, 2974, 3774, 4574, 5374, 6174, 6974, 7774, 8574, 9374, 10174, 10974, 11774, 12574, 13374, 14174, 14974, 15774 },
+		{ -353, 447, 1247, 2047, 2847, 3647, 4447, 5247, 6047, 6847, 7647, 8447, 9247, 10047, 10847, 11647, 12447, 13247, 14047, 14847, 15647, 16447 },
+		{ -631, 169, 969, 1769, 2569, 3369, 4169, 4969, 5769, 6569, 7369, 8169, 8969, 9769, 10569, 11369, 12169, 12969, 13769, 14569, 15369, 16169 },
+		{ -1836, -1036, -236, 564, 1364, 2164, 2964, 3764, 4564, 5364, 6164, 6964, 7764, 8564, 9364, 10164, 10964, 11764, 12564, 13364, 14164, 14964 },
+		{ -3448, -2648, -1848, -1048, -248, 552, 1352, 2152, 2952, 3752, 4552, 5352, 6152, 6952, 7752, 8552, 9352, 10152, 10952, 11752, 12552, 13352 },
+		{ -6236, -5436, -4636, -3836, -3036, -2236, -1436, -636, 164, 964, 1764, 2564, 3364, 4164, 4964, 5764, 6564, 7364, 8164, 8964, 9764, 10564 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 17
+		{ -4426, -3728, -3029, -2330, -1632, -933, -234, 464, 1163, 1862, -3181, -2564, -1933, -1291, -638, 6053, 6752, 7451, 8149, 8848, 9547, 10245 },
+		{ -3838, -3139, -2441, -1742, -1043, -345, 354, 1053, 1751, 2450, -1873, -1375, -842, -281, 302, 903, 1520, 2150, 2792, 3445, 10135, 10834 },
+		{ -3250, -2551, -1852, -1154, -455, 244, 942, 1641, 2340, 3038, 3737, 4435, 1222, 1407, 1769, 2215, 2711, 3244, 3804, 4387, 4987, 5603 },
+		{ -2661, -1963, -1264, -565, 133, 832, 1531, 2229, 2928, 3627, 4325, 5024, 5722, 6421, 7120, 7818, 8517, 5323, 5499, 5859, 6302, 6798 },
+		{ -2073, -1374, -676, 23, 722, 1420, 2119, 2818, 3516, 4215, 4914, 5612, 6311, 7009, 7708, 8407, 9105, 9804, 10503, 11201, 11900, 12599 },
+		{ -1485, -786, -87, 611, 1310, 2009, 2707, 3406, 4105, 4803, 5502, 6200, 6899, 7598, 8296, 8995, 9694, 10392, 11091, 11790, 12488, 13187 },
+		{ -896, -198, 501, 1200, 1898, 2597, 3296, 3994, 4693, 5392, 6090, 6789, 7487, 8186, 8885, 9583, 10282, 10981, 11679, 12378, 13077, 13775 },
+		{ -308, 391, 1089, 1788, 2487, 3185, 3884, 4583, 5281, 5980, 6679, 7377, 8076, 8774, 9473, 10172, 10870, 11569, 12268, 12966, 13665, 14364 },
+		{ -884, 235, 1331, 2376, 3075, 3774, 4472, 5171, 5870, 6568, 7267, 7965, 8664, 9363, 10061, 10760, 11459, 12157, 12856, 13555, 14253, 14952 },
+		{ -3025, -1652, -367, 858, 2039, 3186, 4305, 5402, 6458, 7157, 7855, 8554, 9252, 9951, 10650, 11348, 12047, 12746, 13444, 14143, 14842, 15540 },
+		{ 0, 0, 0, -2504, -502, 1036, 2413, 3699, 4926, 6108, 7255, 8376, 9473, 10539, 11238, 11937, 12635, 13334, 14033, 14731, 15430, 16129 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 1521, 3553, 5097, 6477, 7766, 8993, 10177, 11325, 12446, 13544, 14621, 15320, 16018, 16717 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5542, 7608, 9158, 10542, 11832, 13061, 14245, 15395, 16516 }
+	},
+	{ // 18
+		{ -4067, -3425, -2783, -2141, -1499, -857, -215, 427, 1069, -2967, -2572, -2124, -1635, -1112, -558, 5562, 6204, 6846, 7488, 8130, 8772, 9414 },
+		{ -3527, -2885, -2243, -1601, -959, -317, 325, 967, 1609, -1462, -1307, -1021, -652, -225, 248, 758, 1300, 7387, 8029, 8671, 9313, 9955 },
+		{ -2986, -2344, -1702, -1060, -418, 224, 866, 1508, 2150, 2792, 1164, 631, 698, 939, 1278, 1683, 2138, 2633, 3162, 3721, 9854, 10496 },
+		{ -2445, -1803, -1161, -519, 122, 764, 1406, 2048, 2690, 3332, 3974, 4616, 5258, 2797, 2732, 2915, 3219, 3599, 4035, 4514, 5030, 5577 },
+		{ -1905, -1263, -621, 21, 663, 1305, 1947, 2589, 3231, 3873, 4515, 5157, 5799, 6441, 7083, 5118, 4804, 4911, 5172, 5524, 5939, 6401 },
+		{ -1364, -722, -80, 562, 1204, 1846, 2488, 3130, 3772, 4414, 5056, 5698, 6340, 6982, 7624, 8266, 8908, 9549, 6935, 6933, 7142, 7460 },
+		{ -824, -182, 460, 1102, 1744, 2386, 3028, 3670, 4312, 4954, 5596, 6238, 6880, 7522, 8164, 8806, 9448, 10090, 10732, 11374, 9173, 8987 },
+		{ -283, 359, 1001, 1643, 2285, 2927, 3569, 4211, 4853, 5495, 6137, 6779, 7421, 8063, 8705, 9347, 9989, 10631, 11273, 11915, 12557, 13199 },
+		{ -1757, 402, 1542, 2184, 2826, 3468, 4110, 4752, 5394, 6035, 6677, 7319, 7961, 8603, 9245, 9887, 10529, 11171, 11813, 12455, 13097, 13739 },
+		{ 0, 0, -1086, 1686, 3366, 4008, 4650, 5292, 5934, 6576, 7218, 7860, 8502, 9144, 9786, 10428, 11070, 11712, 12354, 12996, 13638, 14280 },
+		{ 0, 0, 0, 0, 0, 2860, 4895, 5833, 6475, 7117, 7759, 8401, 9043, 9685, 10327, 10969, 11611, 12253, 12895, 13537, 14179, 14821 },
+		{ 0, 0, 0, 0, 0, 0, 0, 3790, 6211, 7657, 8299, 8941, 9583, 10225, 10867, 11509, 12151, 12793, 13435, 14077, 14719, 15361 },
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7439, 9378, 10124, 10766, 11408, 12050, 12692, 13334, 13976, 14618, 15260, 15902 }
+	},
+	{ // 19
+		{ -3901, -3285, -2669, -2054, -1438, -822, -207, 409, -2450, -2354, -2130, -1817, -1436, -998, -510, 5335, 5950, 6566, 0, 0, 0, 0 },
+		{ -3382, -2767, -2151, -1535, -920, -304, 312, 928, -644, -987, -982, -814, -542, -193, 218, 682, 1192, 7085, 7700, 8316, 0, 0 },
+		{ -2864, -2248, -1632, -1017, -401, 215, 830, 1446, 2062, 1471, 554, 430, 527, 752, 1065, 1447, 1886, 2373, 8219, 8835, 9450, 0 },
+		{ -2345, -1730, -1114, -498, 117, 733, 1349, 1965, 2580, 3196, 3812, 2232, 1893, 1899, 2067, 2340, 2690, 3101, 3565, 4075, 9969, 10584 },
+		{ -1827, -1211, -595, 20, 636, 1252, 1867, 2483, 3099, 3714, 4330, 4946, 4331, 3432, 3310, 3408, 3634, 3948, 4330, 4769, 5256, 11103 },
+		{ -1308, -693, -77, 539, 1154, 1770, 2386, 3002, 3617, 4233, 4849, 5464, 6080, 6696, 5107, 4772, 4780, 4949, 5222, 5572, 5984, 6448 },
+		{ -790, -174, 442, 1057, 1673, 2289, 2904, 3520, 4136, 4751, 5367, 5983, 6599, 7214, 7830, 7192, 6310, 6190, 6289, 6515, 6830, 7213 },
+		{ -271, 344, 960, 1576, 2191, 2807, 3423, 4039, 4654, 5270, 5886, 6501, 7117, 7733, 8349, 8964, 9580, 7982, 7651, 7660, 7830, 8104 },
+		{ 0, 863, 1479, 2094, 2710, 3326, 3941, 4557, 5173, 5788, 6404, 7020, 7636, 8251, 8867, 9483, 10098, 10714, 10053, 9188, 9070, 9170 },
+		{ 0, 0, 0, 2613, 3228, 3844, 4460, 5076, 5691, 6307, 6923, 7538, 8154, 8770, 9385, 10001, 10617, 11233, 11848, 12464, 10857, 10530 },
+		{ 0, 0, 0, 0, 3747, 4363, 4978, 5594, 6210, 6825, 7441, 8057, 8673, 9288, 9904, 10520, 11135, 11751, 12367, 12983, 13598, 12916 },
+		{ 0, 0, 0, 0, 0, 0, 5497, 6113, 6728, 7344, 7960, 8575, 9191, 9807, 10422, 11038, 11654, 12270, 12885, 13501, 14117, 14732 },
+		{ 0, 0, 0, 0, 0, 0, 0, 6631, 7247, 7862, 8478, 9094, 9710, 10325, 10941, 11557, 12172, 12788, 13404, 14019, 14635, 15251 }
+	},
+	{ // 20
+		{ -3891, -3277, -2663, -2049, -1434, -820, -206, -1523, -1864, -1922, -1821, -1607, -1306, -929, -486, 5321, 0, 0, 0, 0, 0, 0 },
+		{ -3374, -2760, -2146, -1531, -917, -303, 311, 925, -392, -733, -791, -690, -476, -174, 202, 646, 6453, 0, 0, 0, 0, 0 },
+		{ -2857, -2243, -1628, -1014, -400, 214, 828, 1442, 2057, 739, 399, 341, 442, 655, 957, 1334, 1777, 7584, 0, 0, 0, 0 },
+		{ -2340, -1725, -1111, -497, 117, 731, 1346, 1960, 2574, 3188, 1871, 1530, 1472, 1573, 1787, 2088, 2465, 2908, 8716, 0, 0, 0 },
+		{ -1822, -1208, -594, 20, 634, 1249, 1863, 2477, 3091, 3705, 4319, 3002, 2662, 2603, 2705, 2918, 3220, 3596, 4040, 9847, 0, 0 },
+		{ -1305, -691, -77, 537, 1152, 1766, 2380, 2994, 3608, 4222, 4837, 5451, 4133, 3793, 3735, 3836, 4049, 4351, 4728, 5171, 10978, 0 },
+		{ -788, -174, 440, 1055, 1669, 2283, 2897, 3511, 4125, 4740, 5354, 5968, 6582, 5265, 4924, 4866, 4967, 5181, 5483, 5859, 6303, 12110 },
+		{ -271, 343, 958, 1572, 2186, 2800, 3414, 4028, 4643, 5257, 5871, 6485, 7099, 7714, 6396, 6056, 5997, 6099, 6312, 6614, 6991, 7434 },
+		{ 0, 861, 1475, 2089, 2703, 3317, 3932, 4546, 5160, 5774, 6388, 7002, 7617, 8231, 8845, 7528, 7187, 7129, 7230, 7444, 7745, 8122 },
+		{ 0, 0, 1992, 2606, 3220, 3835, 4449, 5063, 5677, 6291, 6905, 7520, 8134, 8748, 9362, 9976, 8659, 8318, 8260, 8361, 8575, 8877 },
+		{ 0, 0, 0, 3123, 3738, 4352, 4966, 5580, 6194, 6808, 7423, 8037, 8651, 9265, 9879, 10493, 11108, 9790, 9450, 9392, 9493, 9706 },
+		{ 0, 0, 0, 0, 4255, 4869, 5483, 6097, 6711, 7326, 7940, 8554, 9168, 9782, 10396, 11011, 11625, 12239, 10922, 10581, 10523, 10624 },
+		{ 0, 0, 0, 0, 0, 5386, 6000, 6614, 7229, 7843, 8457, 9071, 9685, 10300, 10914, 11528, 12142, 12756, 13370, 12053, 11713, 11654 }
+	},
+	{ // 21
+		{ -4036, -3399, -2762, -2125, -1488, -851, -214, -1065, -1480, -1628, -1610, -1469, -1227, -895, -479, -1856, 0, 0, 0, 0, 0, 0 },
+		{ -3500, -2863, -2226, -1588, -951, -314, 323, 487, -282, -589, -675, -614, -437, -165, 196, 640, -2730, 0, 0, 0, 0, 0 },
+		{ -2963, -2326, -1689, -1052, -415, 222, 859, 1496, 1105, 545, 325, 293, 395, 605, 908, 1296, 1767, -3603, 0, 0, 0, 0 },
+		{ -2427, -1790, -1153, -516, 122, 759, 1396, 2033, 2670, 1824, 1408, 1259, 1276, 1416, 1658, 1989, 2405, 1055, 0, 0, 0, 0 },
+		{ -1890, -1253, -616, 21, 658, 1295, 1932, 2569, 3206, 3379, 2606, 2298, 2211, 2272, 2448, 2720, 3080, 3524, 182, 0, 0, 0 },
+		{ -1354, -717, -80, 557, 1195, 1832, 2469, 3106, 3743, 4380, 3995, 3433, 3212, 3179, 3281, 3490, 3793, 4181, 4651, -691, 0, 0 },
+		{ -817, -180, 457, 1094, 1731, 2368, 3005, 3642, 4279, 4916, 5553, 4713, 4295, 4146, 4162, 4302, 4543, 4874, 5290, 3967, 0, 0 },
+		{ -281, 356, 993, 1630, 2267, 2905, 3542, 4179, 4816, 5453, 6090, 6271, 5495, 5185, 5098, 5158, 5333, 5605, 5965, 6408, 3094, 0 },
+		{ 0, 893, 1530, 2167, 2804, 3441, 4078, 4715, 5352, 5989, 6626, 7263, 6886, 6321, 6099, 6066, 6167, 6376, 6678, 7065, 7535, 2220 },
+		{ 0, 0, 2066, 2703, 3340, 3977, 4615, 5252, 5889, 6526, 7163, 7800, 8437, 7603, 7183, 7032, 7048, 7187, 7428, 7759, 8174, 6879 },
+		{ 0, 0, 2603, 3240, 3877, 4514, 5151, 5788, 6425, 7062, 7699, 8336, 8973, 9163, 8383, 8072, 7984, 8044, 8219, 8491, 8850, 9292 },
+		{ 0, 0, 0, 3776, 4413, 5050, 5687, 6325, 6962, 7599, 8236, 8873, 9510, 10147, 9776, 9209, 8986, 8952, 9053, 9261, 9562, 9950 },
+		{ 0, 0, 0, 0, 4950, 5587, 6224, 6861, 7498, 8135, 8772, 9409, 10046, 10683, 11321, 10492, 10070, 9919, 9934, 10073, 10313, 10644 }
+	},
+	{ // 22
+		{ -4367, -3677, -2988, -2299, -1610, -921, -231, -810, -1233, -1431, -1471, -1386, -1190, -891, -489, -679, -2703, -4726, 0, 0, 0, 0 },
+		{ -3786, -3097, -2408, -1719, -1029, -340, 349, 334, -226, -505, -605, -569, -418, -162, 197, 662, -999, -3022, -5046, 0, 0, 0 },
+		{ -3206, -2517, -1827, -1138, -449, 240, 930, 1577, 828, 452, 284, 267, 372, 586, 902, 1322, 706, -1318, -3342, 0, 0, 0 },
+		{ -2625, -1936, -1247, -558, 132, 821, 1510, 2199, 1941, 1443, 1199, 1124, 1181, 1350, 1625, 2001, 2410, 386, -1638, -3661, 0, 0 },
+		{ -2045, -1356, -667, 23, 712, 1401, 2090, 2780, 3137, 2476, 2142, 2004, 2009, 2133, 2365, 2699, 3137, 2090, 67, -1957, 0, 0 },
+		{ -1465, -775, -86, 603, 1292, 1982, 2671, 3360, 4049, 3562, 3118, 2907, 2857, 2934, 3122, 3414, 3808, 3794, 1771, -253, 0, 0 },
+		{ -884, -195, 494, 1184, 1873, 2562, 3251, 3940, 4630, 4720, 4133, 3838, 3727, 3754, 3897, 4146, 4498, 4955, 3475, 1451, -572, 0 },
+		{ -304, 385, 1075, 1764, 2453, 3142, 3832, 4521, 5210, 5899, 5195, 4800, 4620, 4594, 4691, 4897, 5206, 5618, 5179, 3155, 1132, 0 },
+		{ 0, 966, 1655, 2344, 3034, 3723, 4412, 5101, 5791, 6480, 6320, 5798, 5540, 5454, 5502, 5664, 5931, 6301, 6776, 4859, 2836, 812 },
+		{ 0, 1546, 2236, 2925, 3614, 4303, 4993, 5682, 6371, 7060, 7535, 6839, 6488, 6338, 6334, 6450, 6674, 7001, 7431, 6564, 4540, 2516 },
+		{ 0, 0, 2816, 3505, 4194, 4884, 5573, 6262, 6951, 7641, 8330, 7936, 7470, 7246, 7186, 7254, 7435, 7719, 8106, 8268, 6244, 4220 },
+		{ 0, 0, 3396, 4086, 4775, 5464, 6153, 6843, 7532, 8221, 8910, 9109, 8492, 8182, 8059, 8078, 8213, 8455, 8799, 9248, 7948, 5925 },
+		{ 0, 0, 3977, 4666, 5355, 6045, 6734, 7423, 8112, 8802, 9491, 10180, 9564, 9149, 8957, 8921, 9010, 9208, 9510, 9915, 9652, 7629 }
+	},
+	{ // 23
+		{ -4964, -4181, -3397, -2613, -1830, -1046, -263, -662, -1074, -1302, -1387, -1346, -1190, -916, -519, -426, -1694, -2962, -4230, -5498, 0, 0 },
+		{ -4304, -3521, -2737, -1954, -1170, -387, 397, 265, -193, -454, -565, -548, -414, -165, 207, 642, -626, -1894, -3162, -4430, 0, 0 },
+		{ -3644, -2861, -2077, -1294, -510, 273, 1057, 1203, 696, 401, 263, 255, 366, 592, 939, 1420, 442, -826, -2094, -3362, 0, 0 },
+		{ -2985, -2201, -1418, -634, 149, 933, 1717, 2155, 1593, 1261, 1095, 1062, 1150, 1353, 1675, 2128, 1510, 242, -1026, -2294, -3563, 0 },
+		{ -2325, -1541, -758, 26, 809, 1593, 2376, 3122, 2498, 2128, 1932, 1875, 1939, 2119, 2417, 2842, 2578, 1310, 42, -1226, -2495, 0 },
+		{ -1665, -881, -98, 686, 1469, 2253, 3036, 3820, 3414, 3002, 2775, 2692, 2733, 2890, 3164, 3562, 3646, 2378, 1110, -159, -1427, 0 },
+		{ -1005, -222, 562, 1345, 2129, 2912, 3696, 4480, 4340, 3883, 3624, 3514, 3531, 3665, 3915, 4288, 4714, 3446, 2178, 909, -359, 0 },
+		{ -345, 438, 1222, 2005, 2789, 3572, 4356, 5139, 5278, 4772, 4478, 4341, 4333, 4445, 4672, 5019, 5501, 4514, 3245, 1977, 709, 0 },
+		{ 0, 1098, 1882, 2665, 3449, 4232, 5016, 5799, 6229, 5669, 5338, 5173, 5141, 5229, 5433, 5756, 6209, 5582, 4313, 3045, 1777, 509 },
+		{ 0, 1758, 2541, 3325, 4108, 4892, 5675, 6459, 7196, 6574, 6205, 6010, 5953, 6018, 6199, 6497, 6923, 6650, 5381, 4113, 2845, 1577 },
+		{ 0, 2418, 3201, 3985, 4768, 5552, 6335, 7119, 7902, 7489, 7079, 6853, 6770, 6812, 6969, 7244, 7643, 7717, 6449, 5181, 3913, 2645 },
+		{ 0, 3077, 3861, 4645, 5428, 6212, 6995, 7779, 8562, 8415, 7960, 7701, 7592, 7610, 7745, 7995, 8369, 8785, 7517, 6249, 4981, 3713 },
+		{ 0, 3737, 4521, 5304, 6088, 6871, 7655, 8438, 9222, 9353, 8848, 8555, 8419, 8412, 8524, 8752, 9100, 9583, 8585, 7317, 6049, 4781 }
+	},
+	{ // 24
+		{ 0, -5069, -4119, -3169, -2219, -1269, -319, -572, -975, -1226, -1347, -1347, -1226, -975, -572, -319, -1269, -2219, -3169, -4119, -5069, 0 },
+		{ 0, -4269, -3319, -2369, -1419, -469, 481, 228, -175, -426, -547, -547, -426, -175, 228, 481, -469, -1419, -2369, -3319, -4269, 0 },
+		{ 0, -3469, -2519, -1569, -619, 331, 1281, 1028, 625, 374, 253, 253, 374, 625, 1028, 1281, 331, -619, -1569, -2519, -3469, 0 },
+		{ 0, -2669, -1719, -769, 181, 1131, 2081, 1828, 1425, 1174, 1053, 1053, 1174, 1425, 1828, 2081, 1131, 181, -769, -1719, -2669, 0 },
+		{ 0, -1869, -919, 31, 981, 1931, 2881, 2628, 2225, 1974, 1853, 1853, 1974, 2225, 2628, 2881, 1931, 981, 31, -919, -1869, 0 },
+		{ 0, -1069, -119, 831, 1781, 2731, 3681, 3428, 3025, 2774, 2653, 2653, 2774, 3025, 3428, 3681, 2731, 1781, 831, -119, -1069, 0 },
+		{ 0, -269, 681, 1631, 2581, 3531, 4481, 4228, 3825, 3574, 3453, 3453, 3574, 3825, 4228, 4481, 3531, 2581, 1631, 681, -269, 0 },
+		{ 0, 531, 1481, 2431, 3381, 4331, 5281, 5028, 4625, 4374, 4253, 4253, 4374, 4625, 5028, 5281, 4331, 3381, 2431, 1481, 531, 0 },
+		{ 0, 1331, 2281, 3231, 4181, 5131, 6081, 5828, 5425, 5174, 5053, 5053, 5174, 5425, 5828, 6081, 5131, 4181, 3231, 2281, 1331, 0 },
+		{ 0, 2131, 3081, 4031, 4981, 5931, 6881, 6628, 6225, 5974, 5853, 5853, 5974, 6225, 6628, 6881, 5931, 4981, 4031, 3081, 2131, 0 },
+		{ 0, 2931, 3881, 4831, 5781, 6731, 7681, 7428, 7025, 6774, 6653, 6653, 6774, 7025, 7428, 7681, 6731, 5781, 4831, 3881, 2931, 0 },
+		{ 0, 3731, 4681, 5631, 6581, 7531, 8481, 8228, 7825, 7574, 7453, 7453, 7574, 7825, 8228, 8481, 7531, 6581, 5631, 4681, 3731, 0 },
+		{ 0, 4531, 5481, 6431, 7381, 8331, 9281, 9028, 8625, 8374, 8253, 8253, 8374, 8625, 9028, 9281, 8331, 7381, 6431, 5481, 4531, 0 }
+	},
+	{ // 25
+		{ 0, 0, -5498, -4230, -2962, -1694, -426, -519, -916, -1190, -1346, -1387, -1302, -1074, -662, -263, -1046, -1830, -2613, -3397, -4181, -4964 },
+		{ 0, 0, -4430, -3162, -1894, -626, 642, 207, -165, -414, -548, -565, -454, -193, 265, 397, -387, -1170, -1954, -2737, -3521, -4304 },
+		{ 0, 0, -3362, -2094, -826, 442, 1420, 939, 592, 366, 255, 263, 401, 696, 1203, 1057, 273, -510, -1294, -2077, -2861, -3644 },
+		{ 0, -3563, -2294, -1026, 242, 1510, 2128, 1675, 1353, 1150, 1062, 1095, 1261, 1593, 2155, 1717, 933, 149, -634, -1418, -2201, -2985 },
+		{ 0, -2495, -1226, 42, 1310, 2578, 2842, 2417, 2119, 1939, 1875, 1932, 2128, 2498, 3122, 2376, 1593, 809, 26, -758, -1541, -2325 },
+		{ 0, -1427, -159, 1110, 2378, 3646, 3562, 3164, 2890, 2733, 2692, 2775, 3002, 3414, 3820, 3036, 2253, 1469, 686, -98, -881, -1665 },
+		{ 0, -359, 909, 2178, 3446, 4714, 4288, 3915, 3665, 3531, 3514, 3624, 3883, 4340, 4480, 3696, 2912, 2129, 1345, 562, -222, -1005 },
+		{ 0, 709, 1977, 3245, 4514, 5501, 5019, 4672, 4445, 4333, 4341, 4478, 4772, 5278, 5139, 4356, 3572, 2789, 2005, 1222, 438, -345 },
+		{ 509, 1777, 3045, 4313, 5582, 6209, 5756, 5433, 5229, 5141, 5173, 5338, 5669, 6229, 5799, 5016, 4232, 3449, 2665, 1882, 1098, 0 },
+		{ 1577, 2845, 4113, 5381, 6650, 6923, 6497, 6199, 6018, 5953, 6010, 6205, 6574, 7196, 6459, 5675, 4892, 4108, 3325, 2541, 1758, 0 },
+		{ 2645, 3913, 5181, 6449, 7717, 7643, 7244, 6969, 6812, 6770, 6853, 7079, 7489, 7902, 7119, 6335, 5552, 4768, 3985, 3201, 2418, 0 },
+		{ 3713, 4981, 6249, 7517, 8785, 8369, 7995, 7745, 7610, 7592, 7701, 7960, 8415, 8562, 7779, 6995, 6212, 5428, 4645, 3861, 3077, 0 },
+		{ 4781, 6049, 7317, 8585, 9583, 9100, 8752, 8524, 8412, 8419, 8555, 8848, 9353, 9222, 8438, 7655, 6871, 6088, 5304, 4521, 3737, 0 }
+	},
+	{ // 26
+		{ 0, 0, 0, 0, -4726, -2703, -679, -489, -891, -1190, -1386, -1471, -1431, -1233, -810, -231, -921, -1610, -2299, -2988, -3677, -4367 },
+		{ 0, 0, 0, -5046, -3022, -999, 662, 197, -162, -418, -569, -605, -505, -226, 334, 349, -340, -1029, -1719, -2408, -3097, -3786 },
+		{ 0, 0, 0, -3342, -1318, 706, 1322, 902, 586, 372, 267, 284, 452, 828, 1577, 930, 240, -449, -1138, -1827, -2517, -3206 },
+		{ 0, 0, -3661, -1638, 386, 2410, 2001, 1625, 1350, 1181, 1124, 1199, 1443, 1941, 2199, 1510, 821, 132, -558, -1247, -1936, -2625 },
+		{ 0, 0, -1957, 67, 2090, 3137, 2699, 2365, 2133, 2009, 2004, 2142, 2476, 3137, 2780, 2090, 1401, 712, 23, -667, -1356, -2045 },
+		{ 0, 0, -253, 1771, 3794, 3808, 3414, 3122, 2934, 2857, 2907, 3118, 3562, 4049, 3360, 2671, 1982, 1292, 603, -86, -775, -1465 },
+		{ 0, -572, 1451, 3475, 4955, 4498, 4146, 3897, 3754, 3727, 3838, 4133, 4720, 4630, 3940, 3251, 2562, 1873, 1184, 494, -195, -884 },
+		{ 0, 1132, 3155, 5179, 5618, 5206, 4897, 4691, 4594, 4620, 4800, 5195, 5899, 5210, 4521, 3832, 3142, 2453, 1764, 1075, 385, -304 },
+		{ 812, 2836, 4859, 6776, 6301, 5931, 5664, 5502, 5454, 5540, 5798, 6320, 6480, 5791, 5101, 4412, 3723, 3034, 2344, 1655, 966, 0 },
+		{ 2516, 4540, 6564, 7431, 7001, 6674, 6450, 6334, 6338, 6488, 6839, 7535, 7060, 6371, 5682, 4993, 4303, 3614, 2925, 2236, 1546, 0 },
+		{ 4220, 6244, 8268, 8106, 7719, 7435, 7254, 7186, 7246, 7470, 7936, 8330, 7641, 6951, 6262, 5573, 4884, 4194, 3505, 2816, 0, 0 },
+		{ 5925, 7948, 9248, 8799, 8455, 8213, 8078, 8059, 8182, 8492, 9109, 8910, 8221, 7532, 6843, 6153, 5464, 4775, 4086, 3396, 0, 0 },
+		{ 7629, 9652, 9915, 9510, 9208, 9010, 8921, 8957, 9149, 9564, 10180, 9491, 8802, 8112, 7423, 6734, 6045, 5355, 4666, 3977, 0, 0 }
+	},
+	{ // 27
+		{ 0, 0, 0, 0, 0, 0, -1856, -479, -895, -1227, -1469, -1610, -1628, -1480, -1065, -214, -851, -1488, -2125, -2762, -3399, -4036 },
+		{ 0, 0, 0, 0, 0, -2730, 640, 196, -165, -437, -614, -675, -589, -282, 487, 323, -314, -951, -1588, -2226, -2863, -3500 },
+		{ 0, 0, 0, 0, -3603, 1767, 1296, 908, 605, 395, 293, 325, 545, 1105, 1496, 859, 222, -415, -1052, -1689, -2326, -2963 },
+		{ 0, 0, 0, 0, 1055, 2405, 1989, 1658, 1416, 1276, 1259, 1408, 1824, 2670, 2033, 1396, 759, 122, -516, -1153, -1790, -2427 },
+		{ 0, 0, 0, 182, 3524, 3080, 2720, 2448, 2272, 2211, 2298, 2606, 3379, 3206, 2569, 1932, 1295, 658, 21, -616, -1253, -1890 },
+		{ 0, 0, -691, 4651, 4181, 3793, 3490, 3281, 3179, 3212, 3433, 3995, 4380, 3743, 3106, 2469, 1832, 1195, 557, -80, -717, -1354 },
+		{ 0, 0, 3967, 5290, 4874, 4543, 4302, 4162, 4146, 4295, 4713, 5553, 4916, 4279, 3642, 3005, 2368, 1731, 1094, 457, -180, -817 },
+		{ 0, 3094, 6408, 5965, 5605, 5333, 5158, 5098, 5185, 5495, 6271, 6090, 5453, 4816, 4179, 3542, 2905, 2267, 1630, 993, 356, -281 },
+		{ 2220, 7535, 7065, 6678, 6376, 6167, 6066, 6099, 6321, 6886, 7263, 6626, 5989, 5352, 4715, 4078, 3441, 2804, 2167, 1530, 893, 0 },
+		{ 6879, 8174, 7759, 7428, 7187, 7048, 7032, 7183, 7603, 8437, 7800, 7163, 6526, 5889, 5252, 4615, 3977, 3340, 2703, 2066, 0, 0 },
+		{ 9292, 8850, 8491, 8219, 8044, 7984, 8072, 8383, 9163, 8973, 8336, 7699, 7062, 6425, 5788, 5151, 4514, 3877, 3240, 2603, 0, 0 },
+		{ 9950, 9562, 9261, 9053, 8952, 8986, 9209, 9776, 10147, 9510, 8873, 8236, 7599, 6962, 6325, 5687, 5050, 4413, 3776, 0, 0, 0 },
+		{ 10644, 10313, 10073, 9934, 9919, 10070, 10492, 11321, 10683, 10046, 9409, 8772, 8135, 7498, 6861, 6224, 5587, 4950, 0, 0, 0, 0 }
+	},
+	{ // 28
+		{ 0, 0, 0, 0, 0, 0, 5321, -486, -929, -1306, -1607, -1821, -1922, -1864, -1523, -206, -820, -1434, -2049, -2663, -3277, -3891 },
+		{ 0, 0, 0, 0, 0, 6453, 646, 202, -174, -476, -690, -791, -733, -392, 925, 311, -303, -917, -1531, -2146, -2760, -3374 },
+		{ 0, 0, 0, 0, 7584, 1777, 1334, 957, 655, 442, 341, 399, 739, 2057, 1442, 828, 214, -400, -1014, -1628, -2243, -2857 },
+		{ 0, 0, 0, 8716, 2908, 2465, 2088, 1787, 1573, 1472, 1530, 1871, 3188, 2574, 1960, 1346, 731, 117, -497, -1111, -1725, -2340 },
+		{ 0, 0, 9847, 4040, 3596, 3220, 2918, 2705, 2603, 2662, 3002, 4319, 3705, 3091, 2477, 1863, 1249, 634, 20, -594, -1208, -1822 },
+		{ 0, 10978, 5171, 4728, 4351, 4049, 3836, 3735, 3793, 4133, 5451, 4837, 4222, 3608, 2994, 2380, 1766, 1152, 537, -77, -691, -1305 },
+		{ 12110, 6303, 5859, 5483, 5181, 4967, 4866, 4924, 5265, 6582, 5968, 5354, 4740, 4125, 3511, 2897, 2283, 1669, 1055, 440, -174, -788 },
+		{ 7434, 6991, 6614, 6312, 6099, 5997, 6056, 6396, 7714, 7099, 6485, 5871, 5257, 4643, 4028, 3414, 2800, 2186, 1572, 958, 343, -271 },
+		{ 8122, 7745, 7444, 7230, 7129, 7187, 7528, 8845, 8231, 7617, 7002, 6388, 5774, 5160, 4546, 3932, 3317, 2703, 2089, 1475, 861, 0 },
+		{ 8877, 8575, 8361, 8260, 8318, 8659, 9976, 9362, 8748, 8134, 7520, 6905, 6291, 5677, 5063, 4449, 3835, 3220, 2606, 1992, 0, 0 },
+		{ 9706, 9493, 9392, 9450, 9790, 11108, 10493, 9879, 9265, 8651, 8037, 7423, 6808, 6194, 5580, 4966, 4352, 3738, 3123, 0, 0, 0 },
+		{ 10624, 10523, 10581, 10922, 12239, 11625, 11011, 10396, 9782, 9168, 8554, 7940, 7326, 6711, 6097, 5483, 4869, 4255, 0, 0, 0, 0 },
+		{ 11654, 11713, 12053, 13370, 12756, 12142, 11528, 10914, 10300, 9685, 9071, 8457, 7843, 7229, 6614, 6000, 5386, 0, 0, 0, 0, 0 }
+	},
+	{ // 29
+		{ 0, 0, 0, 0, 6566, 5950, 5335, -510, -998, -1436, -1817, -2130, -2354, -2450, 409, -207, -822, -1438, -2054, -2669, -3285, -3901 },
+		{ 0, 0, 8316, 7700, 7085, 1192, 682, 218, -193, -542, -814, -982, -987, -644, 928, 312, -304, -920, -1535, -2151, -2767, -3382 },
+		{ 0, 9450, 8835, 8219, 2373, 1886, 1447, 1065, 752, 527, 430, 554, 1471, 2062, 1446, 830, 215, -401, -1017, -1632, -2248, -2864 },
+		{ 10584, 9969, 4075, 3565, 3101, 2690, 2340, 2067, 1899, 1893, 2232, 3812, 3196, 2580, 1965, 1349, 733, 117, -498, -1114, -1730, -2345 },
+		{ 11103, 5256, 4769, 4330, 3948, 3634, 3408, 3310, 3432, 4331, 4946, 4330, 3714, 3099, 2483, 1867, 1252, 636, 20, -595, -1211, -1827 },
+		{ 6448, 5984, 5572, 5222, 4949, 4780, 4772, 5107, 6696, 6080, 5464, 4849, 4233, 3617, 3002, 2386, 1770, 1154, 539, -77, -693, -1308 },
+		{ 7213, 6830, 6515, 6289, 6190, 6310, 7192, 7830, 7214, 6599, 5983, 5367, 4751, 4136, 3520, 2904, 2289, 1673, 1057, 442, -174, -790 },
+		{ 8104, 7830, 7660, 7651, 7982, 9580, 8964, 8349, 7733, 7117, 6501, 5886, 5270, 4654, 4039, 3423, 2807, 2191, 1576, 960, 344, -271 },
+		{ 9170, 9070, 9188, 10053, 10714, 10098, 9483, 8867, 8251, 7636, 7020, 6404, 5788, 5173, 4557, 3941, 3326, 2710, 2094, 1479, 863, 0 },
+		{ 10530, 10857, 12464, 11848, 11233, 10617, 10001, 9385, 8770, 8154, 7538, 6923, 6307, 5691, 5076, 4460, 3844, 3228, 2613, 0, 0, 0 },
+		{ 12916, 13598, 12983, 12367, 11751, 11135, 10520, 9904, 9288, 8673, 8057, 7441, 6825, 6210, 5594, 4978, 4363, 3747, 0, 0, 0, 0 },
+		{ 14732, 14117, 13501, 12885, 12270, 11654, 11038, 10422, 9807, 9191, 8575, 7960, 7344, 6728, 6113, 5497, 0, 0, 0, 0, 0, 0 },
+		{ 15251, 14635, 14019, 13404, 12788, 12172, 11557, 10941, 10325, 9710, 9094, 8478, 7862, 7247, 6631, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 30
+		{ 9414, 8772, 8130, 7488, 6846, 6204, 5562, -558, -1112, -1635, -2124, -2572, -2967, 1069, 427, -215, -857, -1499, -2141, -2783, -3425, -4067 },
+		{ 9955, 9313, 8671, 8029, 7387, 1300, 758, 248, -225, -652, -1021, -1307, -1462, 1609, 967, 325, -317, -959, -1601, -2243, -2885, -3527 },
+		{ 10496, 9854, 3721, 3162, 2633, 2138, 1683, 1278, 939, 698, 631, 1164, 2792, 2150, 1508, 866, 224, -418, -1060, -1702, -2344, -2986 },
+		{ 5577, 5030, 4514, 4035, 3599, 3219, 2915, 2732, 2797, 5258, 4616, 3974, 3332, 2690, 2048, 1406, 764, 122, -519, -1161, -1803, -2445 },
+		{ 6401, 5939, 5524, 5172, 4911, 4804, 5118, 7083, 6441, 5799, 5157, 4515, 3873, 3231, 2589, 1947, 1305, 663, 21, -621, -1263, -1905 },
+		{ 7460, 7142, 6933, 6935, 9549, 8908, 8266, 7624, 6982, 6340, 5698, 5056, 4414, 3772, 3130, 2488, 1846, 1204, 562, -80, -722, -1364 },
+		{ 8987, 9173, 11374, 10732, 10090, 9448, 8806, 8164, 7522, 6880, 6238, 5596, 4954, 4312, 3670, 3028, 2386, 1744, 1102, 460, -182, -824 },
+		{ 13199, 12557, 11915, 11273, 10631, 9989, 9347, 8705, 8063, 7421, 6779, 6137, 5495, 4853, 4211, 3569, 2927, 2285, 1643, 1001, 359, -283 },
+		{ 13739, 13097, 12455, 11813, 11171, 10529, 9887, 9245, 8603, 7961, 7319, 6677, 6035, 5394, 4752, 4110, 3468, 2826, 2184, 1542, 402, -1757 },
+		{ 14280, 13638, 12996, 12354, 11712, 11070, 10428, 9786, 9144, 8502, 7860, 7218, 6576, 5934, 5292, 4650, 4008, 3366, 1686, -1086, 0, 0 },
+		{ 14821, 14179, 13537, 12895, 12253, 11611, 10969, 10327, 9685, 9043, 8401, 7759, 7117, 6475, 5833, 4895, 2860, 0, 0, 0, 0, 0 },
+		{ 15361, 14719, 14077, 13435, 12793, 12151, 11509, 10867, 10225, 9583, 8941, 8299, 7657, 6211, 3790, 0, 0, 0, 0, 0, 0, 0 },
+		{ 15902, 15260, 14618, 13976, 13334, 12692, 12050, 11408, 10766, 10124, 9378, 7439, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	},
+	{ // 31
+		{ 10245, 9547, 8848, 8149, 7451, 6752, 6053, -638, -1291, -1933, -2564, -3181, 1862, 1163, 464, -234, -933, -1632, -2330, -3029, -3728, -4426 },
+		{ 10834, 10135, 3445, 2792, 2150, 1520, 903, 302, -281, -842, -1375, -1873, 2450, 1751, 1053, 354, -345, -1043, -1742, -2441, -3139, -3838 },
+		{ 5603, 4987, 4387, 3804, 3244, 2711, 2215, 1769, 1407, 1222, 4435, 3737, 3038, 2340, 1641, 942, 244, -455, -1154, -1852, -2551, -3250 },
+		{ 6798, 6302, 5859, 5499, 5323, 8517, 7818, 7120, 6421, 5722, 5024, 4325, 3627, 2928, 2229, 1531, 832, 133, -565, -1264, -1963, -2661 },
+		{ 12599, 11900, 11201, 10503, 9804, 9105, 8407, 7708, 7009, 6311, 5612, 4914, 4215, 3516, 2818, 2119, 1420, 722, 23, -676, -1374, -2073 },
+		{ 13187, 12488, 11790, 11091, 10392, 9694, 8995, 8296, 7598, 6899, 6200, 5502, 4803, 4105, 3406, 2707, 2009, 1310, 611, -87, -786, -1485 },
+		{ 13775, 13077, 12378, 11679, 10981, 10282, 9583, 8885, 8186, 7487, 6789, 6090, 5392, 4693, 3994, 3296, 2597, 1898, 1200, 501, -198, -896 },
+		{ 14364, 13665, 12966, 12268, 11569, 10870, 10172, 9473, 8774, 8076, 7377, 6679, 5980, 5281, 4583, 3884, 3185, 2487, 1788, 1089, 391, -308 },
+		{ 14952, 14253, 13555, 12856, 12157, 11459, 10760, 10061, 9363, 8664, 7965, 7267, 6568, 5870, 5171, 4472, 3774, 3075, 2376, 1331, 235, -884 },
+		{ 15540, 14842, 14143, 13444, 12746, 12047, 11348, 10650, 9951, 9252, 8554, 7855, 7157, 6458, 5402, 4305, 3186, 2039, 858, -367, -1652, -3025 },
+		{ 16129, 15430, 14731, 14033, 13334, 12635, 11937, 11238, 10539, 9473, 8376, 7255, 6108, 4926, 3699, 2413, 1036, -502, -2504, 0, 0, 0 },
+		{ 16717, 16018, 15320, 14621, 13544, 12446, 11325, 10177, 8993, 7766, 6477, 5097, 3553, 1521, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ 16516, 15395, 14245, 13061, 11832, 10542, 9158, 7608, 5542, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+	}
+};
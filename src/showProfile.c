@@ -0,0 +1,83 @@
+/**
+ * \file	showProfile.c
+ *
+ * \brief	Darstellung der Messwerte des Profilers auf dem Host.
+ *
+ * 			Liest die Ausgabe von PRF_dump() (mitgeschnittene Debug-USART) von
+ * 			stdin, andere Zeilen werden ignoriert. Für jeden Abschnitt werden
+ * 			Anzahl, Minimum, Mittelwert und Maximum sowie das Histogramm als
+ * 			Balken ausgegeben. Eine Zeile PRF_CPU leitet die Abschnitte eines
+ * 			Controllers ein (MV_masterDumpProfile()).
+ *
+ * 			showProfile < debug.log
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <string.h>
+#include "include/profiler.h"
+
+#define BAR_WIDTH 50
+
+/**
+ * \brief	Gibt das Histogramm eines Abschnitts aus.
+ */
+void printHistogram(const unsigned long* const hist) {
+	unsigned long most = 0, lower;
+	int k, first = PRF_BUCKETS, last = 0, i;
+	for (k = 0; k < PRF_BUCKETS; k++)
+		if (hist[k] > 0) {
+			if (k < first)
+				first = k;
+			last = k;
+			if (hist[k] > most)
+				most = hist[k];
+		}
+	for (k = first; k <= last; k++) {
+		lower = k == 0 ? 0 : 1UL << (k - 1);
+		if (k == PRF_BUCKETS - 1)
+			printf("  ab %6lu us       %8lu |", lower, hist[k]);
+		else
+			printf("  %6lu - %6lu us %8lu |", lower, k == 0 ? 0 : 2 * lower
+					- 1, hist[k]);
+		for (i = 0; i < (int) (BAR_WIDTH * hist[k] / most); i++)
+			putchar('#');
+		putchar('\n');
+	}
+}
+
+int main() {
+	char line[512], name[32];
+	unsigned long count, min, avg, max, hist[PRF_BUCKETS];
+	unsigned int cpu;
+	int k, n, pos, scopes = 0;
+
+	while (fgets(line, sizeof(line), stdin) != NULL) {
+		if (sscanf(line, "PRF_CPU %u", &cpu) == 1) {
+			printf("Controller %u\n", cpu);
+			continue;
+		}
+		if (sscanf(line, "PRF %31s %lu %lu %lu %lu%n", name, &count, &min, &avg,
+				&max, &pos) != 5)
+			continue;
+		for (k = 0; k < PRF_BUCKETS; k++) {
+			if (sscanf(line + pos, "%lu%n", &hist[k], &n) != 1)
+				break;
+			pos += n;
+		}
+		if (k < PRF_BUCKETS)
+			continue;
+		printf("%-12s %8lu mal, min. %6lu us, Mittel %6lu us, max. %6lu us\n",
+				name, count, min, avg, max);
+		if (count > 0)
+			printHistogram(hist);
+		scopes++;
+	}
+	if (scopes == 0)
+		fprintf(stderr, "Keine PRF-Zeilen gefunden\n");
+	return scopes == 0;
+}
+
+#endif /* TEST_ON */
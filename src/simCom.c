@@ -0,0 +1,358 @@
+/**
+ * \file	simCom.c
+ *
+ * \brief	Simulation von Master und beiden Slaves auf dem Host (Linux).
+ *
+ * 			Startet je einen Prozess für COM_SLAVE1B und COM_SLAVE3F und führt den
+ * 			Master im eigenen Prozess aus. Jeder Controller hat seine sechs Servos
+ * 			am emulierten Servo-Bus (dnxEmulator.c, Echtzeitbetrieb). Die
+ * 			Controller sind wie auf dem Roboter verbunden:
+ *
+ * 			Master XM_com_data1 <-> XM_com_data3 Slave 1B
+ * 			Master XM_com_data3 <-> XM_com_data3 Slave 3F
+ *
+ * 			Die Verbindungen übertragen Halbduplex mit 1 Mbps (10 us je Byte), eine
+ * 			Übertragung beginnt erst, wenn die Leitung frei ist. Optional werden
+ * 			nach der Alive-Prüfung Bitfehler und zusätzliche Latenz eingestreut.
+ *
+ * 			Der Master prüft mit MV_masterCheckAlive(), ob die Slaves laufen, und
+ * 			startet dann in jeder Runde die Bewegung aller Controller mit
+ * 			MV_masterAction() (COM_ACTION_AT, MV_actionAt()). Gemessen wird die
+ * 			Zeit vom Aufruf bis zur ACTION-Instruktion jedes Servos aller drei
+ * 			Controller und je Runde die Streuung zwischen der ersten und der
+ * 			letzten ACTION.
+ *
+ * 			Die drei Prozesse warten aktiv. Mit weniger als drei CPUs teilt der
+ * 			Host die Rechenzeit in Zeitscheiben von einigen ms, die Streuung zeigt
+ * 			dann vor allem das Scheduling des Hosts und nicht MV_actionAt().
+ *
+ * 			Mit Protokoll sendet der Master vor jeder ACTION einen Punkt an jeden
+ * 			Slave und alle Controller geben am Ende ihr Ereignisprotokoll (trace.h)
+ * 			auf stdout aus, das traceMerge zusammenführt. Ohne Antwort wartet
+ * 			COM_sendPoint() unbegrenzt, daher nur ohne Bitfehler verwenden.
+ *
+ * 			simCom [Runden] [Bitfehlerrate] [Latenz in us] [Jitter in us] [Protokoll]
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "include/xmega.h"
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/trace.h"
+
+#define ROUNDS 20
+#define ROUND_TIMEOUT_US 200000
+#define ROUND_PAUSE_US 20000
+#define SERVOS_PER_CPU 6
+#define SLAVES 2
+#define NODES (SLAVES + 1)
+
+/** \brief Gemeinsamer Zustand einer Verbindung (Shared Memory). */
+typedef struct {
+	volatile uint64_t busyUntil; /**< Leitung belegt bis (us). */
+	volatile DT_bool inject; /**< Fehler und Latenz einstreuen. */
+} DT_simLink;
+
+/** \brief Ende einer Verbindung in einem Prozess. */
+typedef struct {
+	USART_data_t* usart;
+	DT_int fd;
+	DT_simLink* link;
+} DT_simEnd;
+
+/** \brief Kopf einer Übertragung auf dem Socket. */
+typedef struct {
+	uint64_t deliver; /**< Zeitpunkt, zu dem das letzte Byte empfangen ist. */
+	uint16_t bytes;
+} DT_simFrame;
+
+/** \brief Meldung eines Slaves über eine ACTION-Instruktion. */
+typedef struct {
+	DT_byte cpuID;
+	DT_byte id;
+	uint64_t t;
+} DT_simAction;
+
+DT_simEnd ends[2];
+DT_int endCnt = 0;
+DT_int reportFd;
+DT_byte cpuID;
+DT_leg leg_r, leg_l;
+
+DT_real ber = 0;
+uint32_t latency_us = 0, jitter_us = 0;
+DT_bool trace = false;
+unsigned int seed;
+
+/**
+ * \brief	Monotone Zeit in us (für alle Prozesse gleich).
+ */
+uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void sleepUntil(uint64_t t) {
+	uint64_t n = now();
+	if (t > n) {
+		struct timespec ts = { (t - n) / 1000000, ((t - n) % 1000000) * 1000 };
+		nanosleep(&ts, NULL);
+	}
+}
+
+/**
+ * \brief	Sendet ein Paket auf der Verbindung einer USART (DT_txHook).
+ *
+ * 			Die Übertragung beginnt, wenn die Leitung in beiden Richtungen frei
+ * 			ist. Bitfehler werden mit der Rate ber je Bit eingestreut.
+ */
+void linkSend(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_simEnd* end = NULL;
+	DT_byte buf[sizeof(DT_simFrame) + 256];
+	DT_simFrame* const frame = (DT_simFrame*) buf;
+	uint64_t start, busy;
+	DT_int i, b;
+
+	for (i = 0; i < endCnt; i++)
+		if (ends[i].usart == usart_data)
+			end = &ends[i];
+	if (end == NULL || l > 256)
+		return;
+
+	do {
+		busy = end->link->busyUntil;
+		start = now() > busy ? now() : busy;
+	} while (!__sync_bool_compare_and_swap(&end->link->busyUntil, busy, start
+			+ l * DNE_BYTE_US));
+
+	memcpy(&buf[sizeof(DT_simFrame)], data, l);
+	frame->deliver = start + l * DNE_BYTE_US;
+	frame->bytes = l;
+	if (end->link->inject) {
+		frame->deliver += latency_us + (jitter_us ? rand_r(&seed) % jitter_us
+				: 0);
+		for (i = 0; i < l; i++)
+			for (b = 0; b < 8; b++)
+				if (ber > 0 && rand_r(&seed) < ber * RAND_MAX)
+					buf[sizeof(DT_simFrame) + i] ^= 1 << b;
+	}
+	if (write(end->fd, buf, sizeof(DT_simFrame) + l) < 0)
+		perror("write");
+}
+
+/**
+ * \brief	Empfangsthread einer Verbindung, ersetzt die RXC-ISR.
+ */
+void* linkReceive(void* arg) {
+	DT_simEnd* const end = arg;
+	DT_byte buf[sizeof(DT_simFrame) + 256];
+	DT_simFrame frame;
+	DT_int i;
+	ssize_t n;
+
+	while ((n = read(end->fd, buf, sizeof(buf))) > 0) {
+		memcpy(&frame, buf, sizeof(DT_simFrame));
+		sleepUntil(frame.deliver);
+		for (i = 0; i < frame.bytes; i++)
+			XM_receiveByte(end->usart, buf[sizeof(DT_simFrame) + i]);
+	}
+	return NULL;
+}
+
+void attach(USART_data_t* const usart, DT_int fd, DT_simLink* link) {
+	pthread_t thread;
+	DT_simEnd* const end = &ends[endCnt++];
+	end->usart = usart;
+	end->fd = fd;
+	end->link = link;
+	XM_setTxHook(usart, linkSend);
+	pthread_create(&thread, NULL, linkReceive, end);
+}
+
+void reportAction(DT_byte id) {
+	DT_simAction a = { cpuID, id, now() };
+	if (write(reportFd, &a, sizeof(a)) < 0)
+		perror("write");
+}
+
+/**
+ * \brief	Gibt das Ereignisprotokoll im Format von TRC_dump() aus.
+ */
+void printTrace() {
+	DT_byte i;
+	for (i = 0; i < TRC_count(); i++) {
+		const DT_trcEvent* const e = TRC_get(i);
+		printf("TRC %u %u %u %u %lu\n", cpuID, e->corr, e->event, e->arg,
+				(unsigned long) e->t);
+	}
+	fflush(stdout);
+}
+
+void stopSlave(int sig) {
+	(void) sig;
+	if (trace)
+		printTrace();
+	_exit(0);
+}
+
+/**
+ * \brief	Startet einen Controller wie main() der Gangprogramme.
+ *
+ * \param	ids	Bitmaske der Servos dieses Controllers
+ */
+void boot(uint32_t ids) {
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(ids);
+	DNE_setRealTime(true);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	cpuID = COM_getCpuID(&leg_l);
+	XM_init_com(cpuID);
+	TRC_init(cpuID);
+}
+
+/**
+ * \brief	Prozess eines Slaves.
+ */
+void slave(uint32_t ids, DT_int fd, DT_simLink* link) {
+	boot(ids);
+	attach(&XM_com_data3, fd, link);
+	DNE_setActionHook(reportAction);
+	signal(SIGTERM, stopSlave);
+	MV_slave(cpuID, &leg_r, &leg_l);
+}
+
+int main(int argc, char** argv) {
+	const uint32_t slaveIds[SLAVES] = { 0x7E000, 0x7E };
+	const DT_byte slaveCpu[SLAVES] = { COM_SLAVE1B, COM_SLAVE3F };
+	DT_int sv[SLAVES][2], rp[2], s, r, errors = 0;
+	const char* const nodeName[NODES] = { "Master", "Slave 1B", "Slave 3F" };
+	pid_t pid[SLAVES];
+	DT_simLink* links;
+	DT_int rounds = argc > 1 ? atoi(argv[1]) : ROUNDS;
+	uint64_t sum[NODES] = { 0 }, min[NODES], max[NODES] = { 0 };
+	uint64_t spreadSum = 0, spreadMax = 0;
+	DT_int received[NODES] = { 0 }, lost[NODES] = { 0 }, spreadRounds = 0;
+
+	ber = argc > 2 ? atof(argv[2]) : 0;
+	latency_us = argc > 3 ? atoi(argv[3]) : 0;
+	jitter_us = argc > 4 ? atoi(argv[4]) : 0;
+	trace = argc > 5 && atoi(argv[5]) != 0;
+	seed = 1;
+
+	links = mmap(NULL, SLAVES * sizeof(DT_simLink), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	memset(links, 0, SLAVES * sizeof(DT_simLink));
+	if (pipe(rp) < 0)
+		return 1;
+	for (s = 0; s < NODES; s++)
+		min[s] = UINT64_MAX;
+	for (s = 0; s < SLAVES; s++) {
+		socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv[s]);
+		pid[s] = fork();
+		if (pid[s] == 0) {
+			close(rp[0]);
+			reportFd = rp[1];
+			seed = 2 + s;
+			slave(slaveIds[s], sv[s][1], &links[s]);
+			_exit(0);
+		}
+	}
+
+	// Der Master meldet seine ACTIONs über dieselbe Pipe
+	reportFd = rp[1];
+	boot(0x1F80);
+	if (cpuID != COM_MASTER)
+		errors++;
+	DNE_setActionHook(reportAction);
+	attach(&XM_com_data1, sv[0][0], &links[0]);
+	attach(&XM_com_data3, sv[1][0], &links[1]);
+	MV_masterCheckAlive();
+	for (s = 0; s < SLAVES; s++)
+		links[s].inject = true;
+
+	for (r = 0; r < rounds; r++) {
+		DT_int cnt[NODES] = { 0 };
+		struct pollfd pfd = { rp[0], POLLIN, 0 };
+		const DT_point p = { 77.8553, 77.8553, -129.1041 };
+		uint64_t t0, first = UINT64_MAX, last = 0;
+		if (trace)
+			for (s = 0; s < SLAVES; s++)
+				COM_sendPoint(slaveCpu[s], &p, COM_CONF_LEFT | COM_CONF_RIGHT);
+		t0 = now();
+		MV_masterAction(&leg_r, &leg_l);
+		while (cnt[0] + cnt[1] + cnt[2] < NODES * SERVOS_PER_CPU && now() < t0
+				+ ROUND_TIMEOUT_US) {
+			DT_simAction a;
+			if (poll(&pfd, 1, 10) <= 0 || read(rp[0], &a, sizeof(a))
+					!= sizeof(a))
+				continue;
+			s = a.cpuID == COM_MASTER ? 0 : a.cpuID == COM_SLAVE1B ? 1 : 2;
+			cnt[s]++;
+			received[s]++;
+			sum[s] += a.t - t0;
+			if (a.t - t0 < min[s])
+				min[s] = a.t - t0;
+			if (a.t - t0 > max[s])
+				max[s] = a.t - t0;
+			if (a.t < first)
+				first = a.t;
+			if (a.t > last)
+				last = a.t;
+		}
+		for (s = 0; s < NODES; s++)
+			lost[s] += SERVOS_PER_CPU - cnt[s];
+		// Streuung nur aus Runden, in denen alle Servos die ACTION erhielten
+		if (cnt[0] + cnt[1] + cnt[2] == NODES * SERVOS_PER_CPU) {
+			spreadRounds++;
+			spreadSum += last - first;
+			if (last - first > spreadMax)
+				spreadMax = last - first;
+		}
+		sleepUntil(now() + ROUND_PAUSE_US);
+	}
+
+	if (trace)
+		printTrace();
+	for (s = 0; s < SLAVES; s++) {
+		kill(pid[s], SIGTERM);
+		waitpid(pid[s], NULL, 0);
+	}
+
+	printf("%d Runden, Bitfehlerrate %g, Latenz %u us, Jitter %u us\n", rounds,
+			ber, latency_us, jitter_us);
+	for (s = 0; s < NODES; s++) {
+		printf("%s: Servo-ACTION nach min. %lu us, Mittel %lu us, max. %lu us,"
+			" %d von %d verloren\n", nodeName[s],
+				(unsigned long) (received[s] ? min[s] : 0),
+				(unsigned long) (received[s] ? sum[s] / received[s] : 0),
+				(unsigned long) max[s], lost[s], rounds * SERVOS_PER_CPU);
+		if (ber == 0 && lost[s] > 0)
+			errors++;
+	}
+	printf("Streuung der ACTION über alle Controller: Mittel %lu us, max. %lu us"
+		" (%d Runden, %ld CPUs)\n", (unsigned long) (spreadRounds ? spreadSum
+			/ spreadRounds : 0), (unsigned long) spreadMax, spreadRounds,
+			sysconf(_SC_NPROCESSORS_ONLN));
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
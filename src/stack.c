@@ -0,0 +1,202 @@
+/**
+ * \file	stack.c
+ *
+ * \brief	Überwachung des höchsten Stands von Stack und RAM.
+ */
+
+#include "include/stack.h"
+#include "include/utils.h"
+#include "include/xmega.h"
+#ifdef __AVR__
+#include <avr/io.h>
+
+extern DT_byte __data_start; /**< Anfang von .data (Linker). */
+extern DT_byte __bss_end; /**< Ende von .bss (Linker). */
+extern DT_byte __heap_start; /**< Erstes freies Byte hinter .bss (Linker). */
+#endif
+
+DT_byte* STK_bottom = NULL; /**< Erstes überwachtes Byte. */
+DT_byte* STK_top = NULL; /**< Erstes Byte hinter dem Stack. */
+DT_byte* STK_mark = NULL; /**< Niedrigstes bekannt überschriebenes Byte. */
+DT_byte* STK_scanPos = NULL; /**< Position von STK_poll(). */
+DT_byte* STK_base = NULL; /**< Basis der aktiven Kette. */
+DT_byte STK_chain = STK_CHAINS;
+DT_bool STK_overBudget = false;
+
+const DT_size STK_BUDGETS[STK_CHAINS] = { STK_BUDGET_MASTER, STK_BUDGET_SLAVE };
+
+// lokale Methoden
+DT_byte* STK_getStackPointer();
+void STK_checkBudget();
+
+DT_byte* STK_getStackPointer() {
+#ifdef __AVR__
+	return (DT_byte*) SP;
+#else
+	return __builtin_frame_address(0);
+#endif
+}
+
+#ifndef __AVR__
+/**
+ * \brief	Setzt den überwachten Bereich (nur Host).
+ *
+ * \param	bottom	erstes Byte
+ * \param	top		erstes Byte hinter dem Bereich
+ */
+void STK_setRegion(DT_byte* const bottom, DT_byte* const top) {
+	STK_bottom = bottom;
+	STK_top = top;
+	STK_mark = top;
+	STK_scanPos = bottom;
+	STK_chain = STK_CHAINS;
+}
+#endif
+
+/**
+ * \brief	Füllt den freien RAM unter dem Stack mit STK_PATTERN.
+ *
+ * 			Möglichst früh in main() aufrufen. Die obersten STK_GUARD Bytes
+ * 			unter dem Stackpointer bleiben frei.
+ */
+void STK_paint() {
+	DT_byte* const sp = STK_getStackPointer();
+	DT_byte* p;
+
+#ifdef __AVR__
+	STK_bottom = &__heap_start;
+	STK_top = (DT_byte*) RAMEND + 1;
+#endif
+	if (STK_bottom == NULL)
+		return;
+	STK_mark = STK_top;
+	if (sp > STK_bottom && sp <= STK_top)
+		STK_mark = sp - STK_GUARD > STK_bottom ? sp - STK_GUARD : STK_bottom;
+	for (p = STK_bottom; p < STK_mark; p++)
+		*p = STK_PATTERN;
+	STK_scanPos = STK_bottom;
+	STK_overBudget = false;
+}
+
+/**
+ * \brief	Prüft die nächsten STK_SCAN Bytes unter der Marke des höchsten Stands.
+ *
+ * 			Für den Aufruf in jedem Durchlauf einer Hauptschleife.
+ */
+void STK_poll() {
+	DT_byte i;
+
+	if (STK_bottom == NULL)
+		return;
+	for (i = 0; i < STK_SCAN && STK_scanPos < STK_mark; i++, STK_scanPos++)
+		if (*STK_scanPos != STK_PATTERN) {
+			STK_mark = STK_scanPos;
+			break;
+		}
+	if (STK_scanPos >= STK_mark)
+		STK_scanPos = STK_bottom;
+	STK_checkBudget();
+}
+
+void STK_checkBudget() {
+	if (STK_chain == STK_CHAINS || STK_overBudget || STK_base <= STK_mark)
+		return;
+	if (STK_base - STK_mark > STK_BUDGETS[STK_chain]) {
+		DEBUG_P("STK_bdg")
+		STK_overBudget = true;
+	}
+}
+
+/**
+ * \brief	Setzt die Basis einer Aufrufkette auf den aktuellen Stackpointer.
+ *
+ * \param	chain	STK_MASTER oder STK_SLAVE
+ */
+void STK_begin(DT_byte chain) {
+	STK_chain = chain;
+	STK_base = STK_getStackPointer();
+	STK_overBudget = false;
+}
+
+/**
+ * \brief	Liefert den aktuellen Stand nach einer vollständigen Prüfung.
+ *
+ * \param	info	Ziel
+ */
+void STK_getInfo(DT_stkInfo* const info) {
+	if (STK_bottom != NULL) {
+		while (STK_scanPos < STK_mark && *STK_scanPos == STK_PATTERN)
+			STK_scanPos++;
+		STK_mark = STK_scanPos;
+		STK_scanPos = STK_bottom;
+		STK_checkBudget();
+	}
+#ifdef __AVR__
+	info->staticRam = &__bss_end - &__data_start;
+#else
+	info->staticRam = 0;
+#endif
+	info->used = STK_top - STK_mark;
+	info->free = STK_mark - STK_bottom;
+	info->chain = STK_chain;
+	info->chainUsed = (STK_chain != STK_CHAINS && STK_base > STK_mark) ? STK_base
+			- STK_mark : 0;
+	info->chainBudget = STK_chain != STK_CHAINS ? STK_BUDGETS[STK_chain] : 0;
+}
+
+/**
+ * \brief	Schreibt den Stand in ein Byte-Array (Little Endian).
+ *
+ * \param	info	Stand
+ * \param	array	Ziel mit STK_SIZE Bytes
+ */
+void STK_toByteArray(const DT_stkInfo* const info, DT_byte* const array) {
+	array[0] = info->staticRam;
+	array[1] = info->staticRam >> 8;
+	array[2] = info->used;
+	array[3] = info->used >> 8;
+	array[4] = info->free;
+	array[5] = info->free >> 8;
+	array[6] = info->chain;
+	array[7] = info->chainUsed;
+	array[8] = info->chainUsed >> 8;
+	array[9] = info->chainBudget;
+	array[10] = info->chainBudget >> 8;
+}
+
+/**
+ * \brief	Liest den Stand aus einem Byte-Array.
+ *
+ * \param	info	Ziel
+ * \param	array	Byte-Array aus STK_toByteArray()
+ */
+void STK_fromByteArray(DT_stkInfo* const info, const DT_byte* const array) {
+	info->staticRam = array[0] | array[1] << 8;
+	info->used = array[2] | array[3] << 8;
+	info->free = array[4] | array[5] << 8;
+	info->chain = array[6];
+	info->chainUsed = array[7] | array[8] << 8;
+	info->chainBudget = array[9] | array[10] << 8;
+}
+
+/**
+ * \brief	Gibt den Stand eines Controllers auf der Debug-USART aus.
+ *
+ * 			Format: STK cpuID static used free chain chainUsed chainBudget
+ *
+ * \param	cpuID	ID des Controllers
+ * \param	info	Stand
+ */
+void STK_dump(DT_byte cpuID, const DT_stkInfo* const info) {
+	const uint32_t values[] = { cpuID, info->staticRam, info->used, info->free,
+			info->chain, info->chainUsed, info->chainBudget };
+	DT_byte i;
+	XM_debugPutChar('S');
+	XM_debugPutChar('T');
+	XM_debugPutChar('K');
+	for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		XM_debugPutChar(' ');
+		UTL_printNumber(values[i]);
+	}
+	XM_debugPutChar('\n');
+}
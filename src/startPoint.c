@@ -0,0 +1,317 @@
+/**
+ * \file	startPoint.c
+ *
+ * \brief	Analytische Startpunktfindung.
+ *
+ * 			Bestimmt für eine Bewegungsrichtung die längste Sehne des Arbeitsraums
+ * 			direkt aus den Randfunktionen AB, CD, CEA und DFB.
+ *
+ * 			Die Sehnen werden über ihren Normalenabstand c zum Ursprung parametrisiert.
+ * 			Die Sehnenlänge L(c) ist stückweise glatt, ihr Maximum liegt daher an
+ * 			einer Knickstelle (Schnittpunkte der Randfunktionen, Tangente an CEA)
+ * 			oder an einem stationären Punkt eines Geraden-Kreis-Abschnitts.
+ * 			Diese Kandidaten werden direkt berechnet und ausgewertet.
+ */
+
+#include "include/startPoint.h"
+#include "include/evolutionaryHelper.h"
+#include <math.h>
+
+/**
+ * \def	SP_MARGIN
+ * \brief	Abstand des Startpunkts vom Rand des Arbeitsraums.
+ *
+ * 			Nur gegen Rundungsfehler in isInArea(), jeder Abstand verkürzt die
+ * 			Strecke.
+ *
+ * \def	SP_TANGENT
+ * \brief	Faktor für die Tangente an CEA, damit die Sehne den inneren Kreis nicht schneidet.
+ *
+ * \def	SP_MAX_CANDIDATES
+ * \brief	Maximale Anzahl der Kandidaten für c.
+ */
+#define SP_MARGIN			0.01
+#define SP_TANGENT			1.00001
+#define SP_MAX_CANDIDATES	24
+
+// lokale Methoden
+DT_bool SP_clipHalfPlane(const DT_lin_func* const, const DT_vector* const,
+		const DT_vector* const, const DT_real, DT_real*, DT_real*);
+DT_bool SP_getInterval(const DT_vector* const, const DT_vector* const,
+		const DT_real, DT_real*, DT_real*);
+DT_real SP_getChord(const DT_vector* const, const DT_vector* const,
+		const DT_real, DT_real*, DT_real*);
+DT_real SP_getDirection(const DT_vector* const, DT_vector*, DT_vector*);
+void SP_setIsect(DT_point*, const DT_vector* const, const DT_vector* const,
+		const DT_real, const DT_real);
+DT_byte SP_addLinCircCandidates(const DT_lin_func* const,
+		const DT_half_circle* const, const DT_vector* const,
+		const DT_vector* const, DT_real*);
+
+/**
+ * \brief	Beschränkt eine Sehne auf die Halbebene y >= mx + n.
+ *
+ * \param	f	Randgerade
+ * \param	d	Richtung der Sehne (normiert)
+ * \param	n	Normale der Sehne (normiert)
+ * \param	c	Normalenabstand der Sehne
+ * \param	lo	untere Grenze des Sehnenparameters
+ * \param	hi	obere Grenze des Sehnenparameters
+ *
+ * \return	false, wenn die Sehne vollständig außerhalb der Halbebene liegt
+ */
+DT_bool SP_clipHalfPlane(const DT_lin_func* const f, const DT_vector* const d,
+		const DT_vector* const n, const DT_real c, DT_real* lo,
+		DT_real* hi) {
+	DT_real ad = d->y - f->m * d->x;
+	DT_real rest = f->n - c * (n->y - f->m * n->x);
+	if (ad > 0)
+		*lo = max(*lo, rest / ad);
+	else if (ad < 0)
+		*hi = min(*hi, rest / ad);
+	else if (rest > 0)
+		return false;
+	return true;
+}
+
+/**
+ * \brief	Schneidet eine Gerade mit dem Arbeitsraum ohne den inneren Kreis.
+ *
+ * 			Die Gerade ist c * n + t * d. Ergebnis ist das Intervall von t
+ * 			innerhalb der seitlichen Geraden und des äußeren Kreises.
+ *
+ * \param	d	Richtung der Sehne (normiert)
+ * \param	n	Normale der Sehne (normiert)
+ * \param	c	Normalenabstand der Sehne
+ * \param	lo	untere Grenze des Sehnenparameters
+ * \param	hi	obere Grenze des Sehnenparameters
+ *
+ * \return	false, wenn die Gerade den Arbeitsraum nicht schneidet
+ */
+DT_bool SP_getInterval(const DT_vector* const d, const DT_vector* const n,
+		const DT_real c, DT_real* lo, DT_real* hi) {
+	DT_real w;
+	if (c * c >= DFB.sqr_r)
+		return false;
+	// Äußerer Kreis
+	w = sqrt(DFB.sqr_r - c * c);
+	*lo = -w;
+	*hi = w;
+	// Seitliche Geraden
+	if (!SP_clipHalfPlane(&AB, d, n, c, lo, hi))
+		return false;
+	if (!SP_clipHalfPlane(&CD, d, n, c, lo, hi))
+		return false;
+	return *lo < *hi;
+}
+
+/**
+ * \brief	Berechnet die längste zusammenhängende Sehne im Arbeitsraum.
+ *
+ * 			Die Sehne liegt auf der Geraden c * n + t * d.
+ *
+ * \param	d	Richtung der Sehne (normiert)
+ * \param	n	Normale der Sehne (normiert)
+ * \param	c	Normalenabstand der Sehne
+ * \param	start	Sehnenparameter des Anfangspunkts
+ * \param	end	Sehnenparameter des Endpunkts
+ *
+ * \return	Länge der Sehne, 0 wenn die Gerade den Arbeitsraum nicht schneidet
+ */
+DT_real SP_getChord(const DT_vector* const d, const DT_vector* const n,
+		const DT_real c, DT_real* start, DT_real* end) {
+	DT_real lo, hi, w, l1, l2;
+	if (!SP_getInterval(d, n, c, &lo, &hi))
+		return 0.0;
+	*start = lo;
+	*end = hi;
+	// Innerer Kreis teilt die Sehne in zwei Abschnitte
+	if (c * c < CEA.sqr_r) {
+		w = sqrt(CEA.sqr_r - c * c);
+		l1 = min(hi, -w) - lo;
+		l2 = hi - max(lo, w);
+		if (l1 <= 0 && l2 <= 0)
+			return 0.0;
+		if (l1 >= l2)
+			*end = lo + l1;
+		else
+			*start = hi - l2;
+	}
+	return *end - *start;
+}
+
+/**
+ * \brief	Berechnet Richtung und Normale im Koordinatensystem des EA.
+ *
+ * \param	v	Bewegungsrichtung
+ * \param	d	Zielvektor für die Richtung (normiert)
+ * \param	n	Zielvektor für die Normale (normiert)
+ *
+ * \return	Länge von v
+ */
+DT_real SP_getDirection(const DT_vector* const v, DT_vector* d, DT_vector* n) {
+	// Drehen des Koordinatensystems
+	d->x = v->y;
+	d->y = v->x;
+	DT_real len = sqrt(d->x * d->x + d->y * d->y);
+	if (len == 0)
+		return 0.0;
+	d->x /= len;
+	d->y /= len;
+	n->x = -d->y;
+	n->y = d->x;
+	return len;
+}
+
+/**
+ * \brief	Setzt den Endpunkt wie in scorePoint() leicht in den Arbeitsraum.
+ *
+ * \param	s	Zielpunkt
+ * \param	d	Richtung der Sehne (normiert)
+ * \param	n	Normale der Sehne (normiert)
+ * \param	c	Normalenabstand der Sehne
+ * \param	t	Sehnenparameter des Schnittpunkts mit dem Rand
+ */
+void SP_setIsect(DT_point* s, const DT_vector* const d,
+		const DT_vector* const n, const DT_real c, const DT_real t) {
+	DT_real x = c * n->x + t * d->x;
+	DT_real y = c * n->y + t * d->y;
+	s->x = (x > 0) ? x - 1 : x + 1;
+	s->y = (y > 0) ? y - 1 : y + 1;
+	s->z = Z;
+}
+
+/**
+ * \brief	Fügt die Kandidaten eines Geraden-Kreis-Paares hinzu.
+ *
+ * 			Kandidaten sind die Schnittpunkte der Geraden mit dem Kreis und die
+ * 			stationären Punkte der Sehnenlänge zwischen Gerade und Kreis.
+ *
+ * \param	f	Randgerade
+ * \param	h	Randkreis
+ * \param	d	Richtung der Sehne (normiert)
+ * \param	n	Normale der Sehne (normiert)
+ * \param	cand	Zielfeld für die Kandidaten (min. 4 Einträge)
+ *
+ * \return	Anzahl der hinzugefügten Kandidaten
+ */
+DT_byte SP_addLinCircCandidates(const DT_lin_func* const f,
+		const DT_half_circle* const h, const DT_vector* const d,
+		const DT_vector* const n, DT_real* cand) {
+	DT_byte cnt = 0;
+	// Schnittpunkte: x² + (mx + n)² = r²
+	DT_real a = f->m * f->m + 1;
+	DT_real p = 2 * f->m * f->n;
+	DT_real disc = p * p - 4 * a * (f->n * f->n - h->sqr_r);
+	if (disc >= 0) {
+		DT_real x = (-p + sqrt(disc)) / (2 * a);
+		cand[cnt++] = n->x * x + n->y * f_lin(f, x);
+		x = (-p - sqrt(disc)) / (2 * a);
+		cand[cnt++] = n->x * x + n->y * f_lin(f, x);
+	}
+	// Stationäre Punkte: t_Gerade(c) hat die Steigung k, t_Kreis(c) = +-sqrt(r² - c²)
+	DT_real ad = d->y - f->m * d->x;
+	if (ad != 0) {
+		DT_real k = -(n->y - f->m * n->x) / ad;
+		DT_real c = k * sqrt(h->sqr_r / (1 + k * k));
+		cand[cnt++] = c;
+		cand[cnt++] = -c;
+	}
+	return cnt;
+}
+
+/**
+ * \brief	Analytische Startpunktfindung.
+ *
+ * 			Bestimmt den Startpunkt, von dem aus in Richtung v die längste Strecke
+ * 			im Arbeitsraum zurückgelegt werden kann. Das Ergebnis entspricht dem
+ * 			besten Individuum von evolutionaryAlgorithm(): G ist der Startpunkt,
+ * 			S der Endpunkt und F die Länge der Strecke.
+ *
+ * \param	v	Bewegungsrichtung
+ *
+ * \return	Individuum mit Startpunkt, Endpunkt und Güte
+ */
+DT_individuum SP_calcStartPoint(DT_vector* const v) {
+	DT_individuum I;
+	DT_vector d, n;
+	DT_real cand[SP_MAX_CANDIDATES];
+	DT_real start, end, bestStart = 0, bestEnd = 0, bestC = 0, bestLen = -1;
+	DT_byte cnt = 0, i;
+
+	initEvoAlg();
+
+	if (SP_getDirection(v, &d, &n) == 0) {
+		// Keine Bewegung: Mittelpunkt des Arbeitsraums
+		I.G.x = 0;
+		I.G.y = 100;
+		I.G.z = Z;
+		I.S = I.G;
+		I.F = 0.0;
+		return I;
+	}
+
+	// Knickstellen und stationäre Punkte von L(c)
+	cand[cnt++] = 0.0;
+	cand[cnt++] = SP_TANGENT * sqrt(CEA.sqr_r);
+	cand[cnt++] = -SP_TANGENT * sqrt(CEA.sqr_r);
+	cnt += SP_addLinCircCandidates(&AB, &CEA, &d, &n, &cand[cnt]);
+	cnt += SP_addLinCircCandidates(&AB, &DFB, &d, &n, &cand[cnt]);
+	cnt += SP_addLinCircCandidates(&CD, &CEA, &d, &n, &cand[cnt]);
+	cnt += SP_addLinCircCandidates(&CD, &DFB, &d, &n, &cand[cnt]);
+
+	for (i = 0; i < cnt; i++) {
+		DT_real l = SP_getChord(&d, &n, cand[i], &start, &end);
+		if (l > bestLen) {
+			bestLen = l;
+			bestC = cand[i];
+			bestStart = start;
+			bestEnd = end;
+		}
+	}
+
+	// Startpunkt leicht in den Arbeitsraum verschieben
+	bestStart += min(SP_MARGIN, bestLen / 2);
+	I.G.x = bestC * n.x + bestStart * d.x;
+	I.G.y = bestC * n.y + bestStart * d.y;
+	I.G.z = Z;
+	I.F = bestEnd - bestStart;
+	SP_setIsect(&I.S, &d, &n, bestC, bestEnd);
+	return I;
+}
+
+/**
+ * \brief	Exakte Bewertung eines Startpunkts.
+ *
+ * 			Berechnet wie scorePoint() die Strecke, die von p aus in Richtung v
+ * 			im Arbeitsraum zurückgelegt werden kann. Die Richtung wird wie in
+ * 			evolutionaryAlgorithm() gedreht übergeben. Liegt p außerhalb des
+ * 			Arbeitsraums, ist die Güte 0.
+ *
+ * \param	v	Bewegungsrichtung
+ * \param	p	Startpunkt (Koordinatensystem des EA)
+ * \param	s	Zielpunkt für den Endpunkt
+ *
+ * \return	Güte des Startpunkts
+ */
+DT_real SP_scorePoint(DT_vector* const v, const DT_point* const p,
+		DT_point* s) {
+	DT_vector d, n;
+	DT_real lo, hi, w;
+	*s = *p;
+	if (SP_getDirection(v, &d, &n) == 0)
+		return 0.0;
+	DT_real c = n.x * p->x + n.y * p->y;
+	DT_real t = d.x * p->x + d.y * p->y;
+	if (!SP_getInterval(&d, &n, c, &lo, &hi) || t < lo || t > hi)
+		return 0.0;
+	if (c * c < CEA.sqr_r) {
+		w = sqrt(CEA.sqr_r - c * c);
+		if (t > -w && t < w)
+			return 0.0;
+		if (t <= -w)
+			hi = min(hi, -w);
+	}
+	SP_setIsect(s, &d, &n, c, hi);
+	return hi - t;
+}
@@ -0,0 +1,123 @@
+/**
+ * \file	startPointSearch.c
+ *
+ * \brief	Unterbrechbare Startpunktsuche mit Zeitbudget.
+ *
+ * 			Nach SPS_init() liefert SPS_best() sofort das beste Individuum der
+ * 			Startpopulation. Jeder Aufruf von SPS_step() berechnet so viele
+ * 			Generationen, wie in das Zeitbudget passen, und verbessert das Ergebnis
+ * 			schrittweise. Das beste gefundene Individuum wird gesondert gehalten,
+ * 			da die Mutation auch die Eltern verändert. Das Ergebnis wird daher nie
+ * 			schlechter. Die Suche endet, wenn sich die Güte über SPS_MAX_STALL
+ * 			Generationen nicht verbessert hat.
+ */
+
+#include "include/startPointSearch.h"
+#include "include/evolutionaryAlgorithm.h"
+#include "include/evolutionaryHelper.h"
+#include "include/xmega.h"
+#include "include/profiler.h"
+#include <stdio.h>
+
+/**
+ * \def	SPS_SEED
+ * \brief	Startwert des Zufallszahlengenerators.
+ *
+ * \def	SPS_MAX_STALL
+ * \brief	Anzahl der Generationen ohne Verbesserung, nach der die Suche endet.
+ *
+ * \def	SPS_MAX_GENERATIONS
+ * \brief	Maximale Anzahl der Generationen.
+ *
+ * \def	SPS_MIN_GAIN
+ * \brief	Mindestverbesserung der Güte, die als Fortschritt zählt.
+ */
+#define SPS_SEED			211
+#define SPS_MAX_STALL		20
+#define SPS_MAX_GENERATIONS	200
+#define SPS_MIN_GAIN		0.01
+
+// lokale Methoden
+DT_bool SPS_isDone(const DT_sps* const);
+
+DT_bool SPS_isDone(const DT_sps* const sps) {
+	return sps->stall >= SPS_MAX_STALL || sps->evo.generation
+			>= SPS_MAX_GENERATIONS;
+}
+
+/**
+ * \brief	Startet eine neue Suche für eine Bewegungsrichtung.
+ *
+ * 			Erzeugt und bewertet die Startpopulation. Danach liefert SPS_best()
+ * 			bereits ein gültiges Ergebnis.
+ *
+ * \param	sps	Zustand der Suche
+ * \param	v	Bewegungsrichtung
+ */
+void SPS_init(DT_sps* const sps, const DT_vector* const v) {
+	DT_size t0 = XM_getTimeUs();
+	EVO_init(&sps->evo, sps->buffer, sps->index, DT_SPS_POPSIZE,
+			DT_SPS_PARENT_CNT, SPS_SEED);
+	EVO_start(&sps->evo, v);
+	sps->best = EVO_best(&sps->evo);
+	sps->bestF = sps->best.F;
+	sps->stall = 0;
+	sps->generation_us = 0;
+	sps->elapsed_us = (DT_size) (XM_getTimeUs() - t0);
+}
+
+/**
+ * \brief	Setzt die Suche für höchstens budget_us Mikrosekunden fort.
+ *
+ * 			Eine weitere Generation wird nur begonnen, wenn sie nach der bisher
+ * 			längsten gemessenen Dauer noch in das Budget passt. Die erste
+ * 			Generation wird immer berechnet, damit die Suche auch bei zu kleinem
+ * 			Budget fortschreitet.
+ *
+ * \param	sps	Zustand der Suche
+ * \param	budget_us	Zeitbudget in us
+ *
+ * \return	true, wenn weitere Schritte das Ergebnis noch verbessern können
+ */
+DT_bool SPS_step(DT_sps* const sps, const DT_size budget_us) {
+	DT_size start = XM_getTimeUs(), t0, t1;
+	uint32_t used = 0;
+	DT_bool first = true;
+	PRF_BEGIN(PRF_PLANNER)
+	while (!SPS_isDone(sps) && (first || used + sps->generation_us <= budget_us)) {
+		first = false;
+		t0 = XM_getTimeUs();
+		EVO_generation(&sps->evo);
+		t1 = XM_getTimeUs();
+		if ((DT_size) (t1 - t0) > sps->generation_us)
+			sps->generation_us = (DT_size) (t1 - t0);
+		used = (DT_size) (t1 - start);
+
+		DT_individuum A = EVO_best(&sps->evo);
+		if (A.F <= 1000 && (sps->best.F > 1000 || A.F > sps->best.F))
+			sps->best = A;
+		if (sps->best.F > sps->bestF + SPS_MIN_GAIN) {
+			sps->bestF = sps->best.F;
+			sps->stall = 0;
+		} else
+			sps->stall++;
+	}
+	sps->elapsed_us += used;
+	PRF_END(PRF_PLANNER)
+#ifdef SPS_LOG_ON
+	printf("SPS: gen = %d\tt = %lu us\tF = %f\n", sps->evo.generation,
+			(unsigned long) sps->elapsed_us, sps->bestF);
+#endif
+	return !SPS_isDone(sps);
+}
+
+/**
+ * \brief	Liefert das beste bisher gefundene Individuum.
+ *
+ * \param	sps	Zustand der Suche
+ *
+ * \return	Bestes Individuum
+ */
+DT_individuum SPS_best(const DT_sps* const sps) {
+	return sps->best;
+}
@@ -14,9 +14,9 @@
 #include <stdlib.h>
 #include <math.h>
 
-const DT_double EPS = 0.0001;
+const DT_real EPS = 0.0001;
 
-DT_bool equalsDouble(DT_double val1, DT_double val2) {
+DT_bool equalsDouble(DT_real val1, DT_real val2) {
 	if (fabs(val1 - val2) < EPS) {
 		return true;
 	} else
@@ -34,7 +34,7 @@ int main() {
 	XM_init_cpu();
 
 	DT_int iRes;
-	DT_double dRes;
+	DT_real dRes;
 
 	iRes = 123 + 321;
 	if (equalsInteger(iRes, 444) == false) {
@@ -0,0 +1,196 @@
+/**
+ * \file	testBoot.c
+ *
+ * \brief	Testprogramm für den Start eines Controllers (Host).
+ *
+ * 			Prüft die Ermittlung der Servos mit der Liste im EEPROM
+ * 			(DNX_getConnectedIDs()), die gleichzeitige Alive-Prüfung beider Slaves
+ * 			mit einem verspätet startenden Slave, die Abfrage der Startzeiten, das
+ * 			Warten auf die Servos in MV_doInitPosition() und die Abfrage mit
+ * 			COM_pollReady() bei einem stummen Slave. Beide Slaves werden
+ * 			über die Sende-Empfänger von XM_com_data1 und XM_com_data3 im selben
+ * 			Prozess bedient: Status-Anfragen mit MV_slaveStep(), Winkel und
+ * 			COM_IS_READY direkt mit ACK, da ein Slave im Sende-Empfänger die Pakete
+ * 			des Masters aus demselben Pool (packetPool.h) nicht zusätzlich für den
+ * 			Servo-Bus bekommt. Die Servos am emulierten Bus sind die des Masters.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define MASTER_IDS	0x1F80 /**< Servos 7 - 12 */
+
+DT_leg leg_r, leg_l;
+USART_data_t* replyLink = NULL;
+DT_int dropAlive3F = 0; /**< Anzahl der Alive-Anfragen, die Slave 3F noch nicht hört. */
+DT_int aliveRequests[COM_SLAVE3F + 1];
+DT_int readyRequests = 0;
+DT_int dropReady3F = 0; /**< Anzahl der COM_IS_READY-Anfragen, die Slave 3F nicht beantwortet. */
+
+/**
+ * \brief	Bedient beide Slaves und gibt ihre Antworten an die Verbindung des Masters zurück.
+ */
+void slaves(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	const DT_byte cpuID = usart_data == &XM_com_data1 ? COM_SLAVE1B
+			: COM_SLAVE3F;
+	DT_size i;
+
+	if (data[2] == COM_MASTER) {
+		for (i = 0; i < l; i++)
+			XM_receiveByte(replyLink, data[i]);
+		return;
+	}
+	if (data[4] == COM_STATUS && data[5] == COM_IS_ALIVE) {
+		aliveRequests[cpuID]++;
+		if (cpuID == COM_SLAVE3F && dropAlive3F > 0) {
+			dropAlive3F--;
+			return;
+		}
+	}
+	replyLink = usart_data;
+	if (data[4] == COM_STATUS && data[5] == COM_IS_READY) {
+		readyRequests++;
+		if (cpuID == COM_SLAVE3F && dropReady3F > 0) {
+			dropReady3F--;
+			return;
+		}
+		COM_sendACK(COM_MASTER);
+	} else if (data[4] == COM_ANGLE)
+		COM_sendACK(COM_MASTER);
+	else if (data[4] == COM_STATUS) {
+		for (i = 0; i < l; i++)
+			XM_receiveByte(&XM_com_data3, data[i]);
+		MV_slaveStep(cpuID, &leg_r, &leg_l);
+	}
+}
+
+/**
+ * \brief	Startet die Ermittlung der Servos mit leeren Beinen.
+ *
+ * \return	Instruktionspakete je Bus (rechts + 256 * links)
+ */
+DT_int scan() {
+	DT_leg empty = { 0 };
+	leg_r = empty;
+	leg_l = empty;
+	DNE_resetStats();
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	return DNE_getStats(&XM_servo_data_R)->transactions + 256 * DNE_getStats(
+			&XM_servo_data_L)->transactions;
+}
+
+int main() {
+	DT_int errors = 0, t;
+	uint32_t us = 0;
+	DT_byte result[DT_RESULT_BUFFER_SIZE];
+	DT_byte id, data = 0;
+
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(MASTER_IDS);
+
+	// Erster Start: keine Liste im EEPROM, alle IDs, beide Busse gleichzeitig
+	t = scan();
+	printf("Erster Start: %d/%d Pakete rechts/links\n", t % 256, t / 256);
+	CHECK(t == 22 + 256 * 22) // 9 PING je Bus + LED als Broadcast, je 3 READ und WRITE von Return Delay Time und Status Return Level
+	CHECK(DNE_readByte(9, DNX_RT_DLY) == DNX_RETURN_DELAY && DNE_readByte(12,
+			DNX_STS_RT_LVL) == DNX_STATUS_LEVEL)
+	CHECK(leg_r.hip.id == 7 && leg_r.knee.id == 8 && leg_r.foot.id == 9)
+	CHECK(leg_l.hip.id == 10 && leg_l.knee.id == 11 && leg_l.foot.id == 12)
+	CHECK(COM_getCpuID(&leg_l) == COM_MASTER)
+	CHECK(DNE_readByte(7, DNX_LED) == 1 && DNE_readByte(12, DNX_LED) == 1)
+
+	// Weitere Starts: nur die bekannten Servos
+	t = scan();
+	printf("Liste aus dem EEPROM: %d/%d Pakete rechts/links\n", t % 256, t / 256);
+	CHECK(t == 10 + 256 * 10) // EEPROM der Servos wird nicht beschrieben
+	CHECK(leg_r.hip.id == 7 && leg_l.foot.id == 12)
+
+	// Servo 12 fehlt: Liste ungültig, alle IDs, Liste erneuert
+	DNE_init(MASTER_IDS & ~(1UL << 12));
+	t = scan();
+	CHECK(t == 25 + 256 * 21)
+	CHECK(leg_l.knee.id == 11 && leg_l.foot.id == 0)
+	t = scan();
+	CHECK(t == 16 + 256 * 14) // Liste unvollständig: alle IDs
+
+	// Servo 12 wieder angeschlossen: wird beim nächsten Start gefunden
+	DNE_init(MASTER_IDS);
+	t = scan();
+	CHECK(t == 22 + 256 * 22)
+	CHECK(leg_l.foot.id == 12)
+	t = scan();
+	CHECK(t == 10 + 256 * 10)
+
+	// Zerstörte Liste im EEPROM
+	DNE_init(MASTER_IDS);
+	XM_eepromWrite(DNX_EEPROM_ADDR, &data, 1);
+	t = scan();
+	CHECK(t == 22 + 256 * 22)
+	CHECK(leg_l.foot.id == 12)
+	t = scan();
+	CHECK(t == 10 + 256 * 10)
+
+	// Alive-Prüfung: Slave 3F hört die erste Anfrage nicht
+	XM_init_com(COM_MASTER);
+	XM_setTxHook(&XM_com_data1, slaves);
+	XM_setTxHook(&XM_com_data3, slaves);
+	MV_bootUs[COM_SLAVE1B] = 1234;
+	MV_bootUs[COM_SLAVE3F] = 567890;
+	dropAlive3F = 1;
+	MV_masterCheckAlive();
+	CHECK(aliveRequests[COM_SLAVE1B] == 1 && aliveRequests[COM_SLAVE3F] == 2)
+	CHECK(MV_bootUs[COM_MASTER] > 0)
+	CHECK(COM_requestBoot(COM_SLAVE1B, &us) && us == 1234)
+	CHECK(COM_requestBoot(COM_SLAVE3F, &us) && us == 567890)
+	CHECK(!COM_requestBoot(COM_BRDCAST_ID, &us))
+	CHECK(COM_pollAlive(1 << COM_SLAVE1B | 1 << COM_SLAVE3F) == (1
+			<< COM_SLAVE1B | 1 << COM_SLAVE3F))
+
+	// Startposition: wartet auf die Servos statt einer festen Pause
+	DNE_resetStats();
+	MV_doInitPosition(&leg_r, &leg_l);
+	printf("Startposition: %d Abfragen der Slaves, %lu us\n", readyRequests,
+			(unsigned long) DNE_getTimeUs());
+	CHECK(readyRequests >= 4)
+	for (id = 7; id <= 12; id++)
+		CHECK(DNE_readWord(id, DNX_PRT_POS) == DNE_readWord(id, DNX_GL_POS)
+				&& DNE_readByte(id, DNX_MOVING) == 0)
+	CHECK(DNE_readWord(8, DNX_GL_POS) != 511) // Knie auf 45 Grad
+	CHECK(MV_isReady(&leg_r, &leg_l))
+
+	// Stummer Slave: COM_pollReady() kehrt nach COM_ALIVE_TIMEOUT_US zurück
+	dropReady3F = 1;
+	CHECK(COM_pollReady(1 << COM_SLAVE1B | 1 << COM_SLAVE3F) == 1
+			<< COM_SLAVE1B)
+	CHECK(COM_pollReady(1 << COM_SLAVE3F) == 1 << COM_SLAVE3F)
+
+	// Antwort eines Slaves auf COM_IS_READY
+	replyLink = &XM_com_data1;
+	MV_slaveReady(&leg_r, &leg_l);
+	CHECK(COM_receive(&XM_com_data1, result) == 7 && result[4] == COM_ACK)
+	DNX_setAngle(leg_r.knee.id, -45, false);
+	MV_slaveReady(&leg_r, &leg_l);
+	CHECK(COM_receive(&XM_com_data1, result) == 8 && result[4] == COM_NAK
+			&& result[5] == COM_ERR_MOVING)
+	CHECK(!MV_isReady(&leg_r, &leg_l))
+
+	// Ein Servo ohne Antwort gilt nicht als bereit
+	DNE_init(MASTER_IDS & ~(1UL << 12));
+	CHECK(!MV_isReady(&leg_r, &leg_l))
+	CHECK(DNX_getMoving(1UL << 12) == 1UL << 12)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
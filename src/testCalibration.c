@@ -0,0 +1,121 @@
+/**
+ * \file	testCalibration.c
+ *
+ * \brief	Testprogramm für die Kalibrierung der Servos (Host).
+ *
+ * 			Vergleicht die ganzzahlige Umrechnung CAL_toTicks() mit den Vorgaben
+ * 			gegen die frühere Rechnung mit double, prüft Grenzen, das Speichern
+ * 			im nachgebildeten EEPROM und den Befehl COM_CALIBRATE über den
+ * 			Sende-Empfänger von XM_com_data3.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include "include/calibration.h"
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+/**
+ * \brief	Frühere Rechnung aus DNX_correctAngles(), DNX_convertAngle() und DNX_setAngle().
+ */
+DT_int legacyTicks(DT_byte id, double value) {
+	if ((id - 1) % 6 != 1 && (id - 1) % 6 != 5)
+		value = 360 - value;
+	value += 150;
+	if (value >= 360)
+		value -= 360;
+	return floor(3.41 * value);
+}
+
+/**
+ * \brief	Beantwortet COM_CALIBRATE als Slave und gibt Antworten an den Master zurück.
+ */
+void loopback(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_size i;
+	if (data[4] == COM_CALIBRATE)
+		MV_slaveCalibration(data, l);
+	else
+		for (i = 0; i < l; i++)
+			XM_receiveByte(usart_data, data[i]);
+}
+
+int main() {
+	DT_calServo cal, read;
+	DT_byte array[CAL_SIZE];
+	DT_leg leg_r, leg_l;
+	DT_int errors = 0, diff = 0;
+	DT_byte id;
+	DT_int a;
+
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(DNE_ALL_IDS);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+
+	// Leeres EEPROM: Vorgaben, gleiche Zielpositionen wie mit double
+	CHECK(!CAL_init())
+	for (id = 1; id <= CAL_SERVOS; id++)
+		for (a = -1200; a <= 1200; a++)
+			if (CAL_toTicks(id, a * 10) != legacyTicks(id, a / 10.0))
+				diff++;
+	CHECK(diff == 0)
+	CHECK(CAL_degToTicks(2, 30) == 613 && CAL_degToTicks(5, 30) == 409)
+	CHECK(CAL_degToTicks(DNX_BRDCAST_ID, 0) == 511)
+	// Außerhalb des Bereichs wird begrenzt statt übergelaufen
+	CHECK(CAL_degToTicks(2, 200) == CAL_TICKS_MAX && CAL_degToTicks(2, -200) == 0)
+
+	// Byte-Array
+	cal.flags = CAL_MIRRORED;
+	cal.offset = -7;
+	cal.min = 100;
+	cal.max = 900;
+	CAL_toByteArray(&cal, array);
+	CAL_fromByteArray(&read, array);
+	CHECK(read.flags == cal.flags && read.offset == -7 && read.min == 100
+			&& read.max == 900)
+
+	// Speichern und erneutes Laden
+	cal.offset = 10;
+	CHECK(CAL_set(5, &cal))
+	CHECK(CAL_init())
+	CAL_get(5, &read);
+	CHECK(read.offset == 10 && read.min == 100 && read.max == 900)
+	CHECK(CAL_degToTicks(5, 30) == 419 && CAL_degToTicks(5, 140) == 100)
+	CHECK(DNX_setAngle(5, 30, false))
+	CHECK(DNE_readWord(5, DNX_GL_POS) == 419)
+	cal.min = 901;
+	CHECK(!CAL_set(5, &cal) && !CAL_set(0, &cal) && !CAL_set(CAL_SERVOS + 1,
+			&cal))
+
+	// COM_CALIBRATE vom Master an Slave 3F
+	XM_init_com(COM_MASTER);
+	XM_setTxHook(&XM_com_data3, loopback);
+	cal.flags = 0;
+	cal.offset = -3;
+	cal.min = 0;
+	cal.max = CAL_TICKS_MAX;
+	CHECK(COM_sendCalibration(COM_SLAVE3F, 14, &cal))
+	CAL_get(14, &read);
+	CHECK(read.flags == 0 && read.offset == -3)
+	CHECK(CAL_degToTicks(14, 30) == 610)
+	cal.min = 1000;
+	cal.max = 10;
+	CHECK(!COM_sendCalibration(COM_SLAVE3F, 14, &cal))
+	CHECK(!COM_sendCalibration(COM_BRDCAST_ID, 14, &cal))
+	CHECK(CAL_init())
+	CAL_get(14, &read);
+	CHECK(read.offset == -3 && read.max == CAL_TICKS_MAX)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
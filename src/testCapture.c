@@ -0,0 +1,145 @@
+/**
+ * \file	testCapture.c
+ *
+ * \brief	Testprogramm für den Mitschnitt der Pakete (Host).
+ *
+ * 			Prüft den Aufbau der Einträge und das Verwerfen bei vollem Puffer.
+ * 			Danach wird ein Slave 3F mit emulierten Servos im selben Prozess
+ * 			betrieben (MV_slaveStep()) und sein Mitschnitt in eine Datei
+ * 			geschrieben, die busTrace abspielen kann.
+ *
+ * 			testCapture [Datei]
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <string.h>
+#include "include/capture.h"
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/trace.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define OUT_SIZE 4096
+
+DT_byte out[OUT_SIZE];
+DT_size outLen = 0;
+DT_leg leg_r, leg_l;
+
+/**
+ * \brief	Empfänger der Debug-USART.
+ */
+void collect(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_size i;
+	(void) usart_data;
+	for (i = 0; i < l && outLen < OUT_SIZE; i++)
+		out[outLen++] = data[i];
+}
+
+/**
+ * \brief	Empfängt ein Paket des Masters auf dem Slave und bearbeitet es.
+ *
+ * \param	packet	Paket ab der Instruktion, ohne Korrelations-ID und Prüfsumme
+ * \param	l		Länge
+ * \param	corr	Korrelations-ID
+ */
+void masterSends(const DT_byte* const packet, DT_size l, DT_byte corr) {
+	DT_byte frame[DT_RESULT_BUFFER_SIZE];
+	DT_byte chksm = 0;
+	DT_size i, len = 0;
+
+	frame[len++] = 0xFF;
+	frame[len++] = 0xFF;
+	frame[len++] = COM_SLAVE3F;
+	frame[len++] = l + 2;
+	for (i = 0; i < l; i++)
+		frame[len++] = packet[i];
+	frame[len++] = corr;
+	for (i = 2; i < len; i++)
+		chksm += frame[i];
+	frame[len++] = ~chksm;
+	for (i = 0; i < len; i++)
+		XM_receiveByte(&XM_com_data3, frame[i]);
+	MV_slaveStep(COM_SLAVE3F, &leg_r, &leg_l);
+}
+
+int main(int argc, char** argv) {
+	const DT_byte packet[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+	const DT_point p = { 77.8553, 77.8553, -129.1041 };
+	DT_byte status[] = { COM_STATUS, COM_IS_ALIVE };
+	DT_byte point[2 + 3 * COM_REAL_SIZE] = { COM_POINT, COM_CONF_LEFT
+			| COM_CONF_RIGHT };
+	DT_byte action[] = { COM_ACTION };
+	const char* const file = argc > 1 ? argv[1] : "capture.bin";
+	FILE* f;
+	DT_size i, records;
+	DT_int errors = 0;
+
+	XM_setTxHook(&XM_debug_data, collect);
+
+	// Aufbau eines Eintrags, nur gewählte Kanäle
+	CAP_enable(1 << CAP_COM3);
+	CAP_frame(&XM_servo_data_L, true, packet, sizeof(packet));
+	CAP_frame(&XM_com_data3, true, packet, sizeof(packet));
+	CAP_frame(&XM_com_data3, false, packet, 2);
+	CHECK(outLen == 2 * CAP_HEADER + sizeof(packet) + 2)
+	CHECK(out[0] == CAP_SYNC && out[1] == sizeof(packet))
+	CHECK(out[2] == (CAP_COM3 | CAP_TX))
+	CHECK(memcmp(&out[CAP_HEADER], packet, sizeof(packet)) == 0)
+	CHECK(out[CAP_HEADER + sizeof(packet) + 2] == CAP_COM3)
+
+	// Belegte Debug-USART: Puffer läuft voll, weitere Pakete werden gezählt
+	XM_setTxHook(&XM_debug_data, NULL);
+	CAP_enable(CAP_ALL);
+	for (i = 0; i < 100; i++)
+		CAP_frame(&XM_servo_data_R, true, packet, sizeof(packet));
+	records = (CAP_BUFFER_SIZE - 1) / (CAP_HEADER + sizeof(packet));
+	CHECK(CAP_getDropped() == 100 - records)
+	outLen = 0;
+	XM_setTxHook(&XM_debug_data, collect);
+	CAP_poll();
+	CHECK(outLen == records * (CAP_HEADER + sizeof(packet)))
+	CHECK(out[2] == (CAP_SERVO_R | CAP_TX))
+
+	// Mitschnitt eines Slaves 3F für busTrace
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(0x7E);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	CHECK(COM_getCpuID(&leg_l) == COM_SLAVE3F)
+	XM_init_com(COM_SLAVE3F);
+	TRC_init(COM_SLAVE3F);
+	XM_setTxHook(&XM_com_data3, XM_ignoreTx); // Antworten an den Master werden nur mitgeschnitten
+
+	outLen = 0;
+	CAP_enable(CAP_ALL);
+	masterSends(status, sizeof(status), 1);
+	COM_realToByteArray(p.x, &point[2 + 0 * COM_REAL_SIZE]);
+	COM_realToByteArray(p.y, &point[2 + 1 * COM_REAL_SIZE]);
+	COM_realToByteArray(p.z, &point[2 + 2 * COM_REAL_SIZE]);
+	for (i = 0; i < 3; i++) {
+		masterSends(point, sizeof(point), 2 + i);
+		masterSends(action, sizeof(action), 2 + i);
+	}
+	CHECK(CAP_getDropped() == 0)
+	CHECK(outLen > 0 && out[0] == CAP_SYNC)
+
+	f = fopen(file, "wb");
+	CHECK(f != NULL)
+	if (f != NULL) {
+		fwrite(out, 1, outLen, f);
+		fclose(f);
+		printf("%u Bytes nach %s geschrieben\n", outLen, file);
+	}
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,133 @@
+/**
+ * \file	testDnxEmulator.c
+ *
+ * \brief	Testprogramm für die DNX_*-Methoden am emulierten Servo-Bus (Host).
+ *
+ * 			Prüft Erkennung, REG_WRITE/ACTION, READ, Status Return Level,
+ * 			Auswertung des Fehlerbytes und die
+ * 			Bewegung der Servos und vergleicht die Busbelegung für das Setzen
+ * 			aller 18 Winkel mit WRITE, REG_WRITE + ACTION und SYNC_WRITE.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+/**
+ * \brief	Gibt die Belegung beider Busse seit dem letzten Aufruf aus.
+ */
+void printBusy(const char* name) {
+	const DT_dneStats* const r = DNE_getStats(&XM_servo_data_R);
+	const DT_dneStats* const l = DNE_getStats(&XM_servo_data_L);
+	printf("%-16s %3lu Transaktionen, belegt R %6lu us, L %6lu us\n", name,
+			(unsigned long) (r->transactions + l->transactions),
+			(unsigned long) r->busy_us, (unsigned long) l->busy_us);
+	DNE_resetStats();
+}
+
+int main() {
+	DT_leg leg_r, leg_l;
+	DT_byte packet[7 + 3 * DNE_SERVOS], result[DT_RESULT_BUFFER_SIZE];
+	DT_byte id, len;
+	DT_int errors = 0;
+
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(DNE_ALL_IDS);
+
+	// Erkennung über DNX_setLed()
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	CHECK(leg_r.hip.id == 13 && leg_r.knee.id == 14 && leg_r.foot.id == 15)
+	CHECK(leg_l.hip.id == 16 && leg_l.knee.id == 17 && leg_l.foot.id == 18)
+	for (id = 1; id <= DNE_SERVOS; id++)
+		CHECK(DNE_readByte(id, DNX_LED) == 1)
+
+	// REG_WRITE wird erst mit ACTION übernommen, 30 Grad -> 613 (ID 2)
+	CHECK(DNX_setAngle(2, 30, true))
+	CHECK(DNE_readWord(2, DNX_GL_POS) == 512 && DNE_readByte(2, DNX_REG_INST) == 1)
+	DNX_sendAction(DNX_BRDCAST_ID);
+	CHECK(DNE_readWord(2, DNX_GL_POS) == 613 && DNE_readByte(2, DNX_REG_INST) == 0)
+
+	// Echo des Broadcasts darf die nächste Antwort nicht verfälschen
+	CHECK(DNX_setAngle(5, 30, false))
+	CHECK(DNE_readWord(5, DNX_GL_POS) == 409)
+
+	// Bewegung: 101 Einheiten bei 114 U/min dauern ca. 44 ms
+	DNE_advance(20000);
+	CHECK(DNE_readByte(2, DNX_MOVING) == 1 && DNE_readWord(2, DNX_PRT_POS) > 512
+			&& DNE_readWord(2, DNX_PRT_POS) < 613)
+	DNE_advance(40000);
+	CHECK(DNE_readByte(2, DNX_MOVING) == 0 && DNE_readWord(2, DNX_PRT_POS) == 613)
+
+	// READ der Istposition
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = 2;
+	packet[3] = 4;
+	packet[4] = DNX_RD_DATA;
+	packet[5] = DNX_PRT_POS;
+	packet[6] = 2;
+	len = DNX_send(packet, 8, result, true);
+	CHECK(len == 8 && result[2] == 2 && result[4] == 0 && result[5]
+			+ (result[6] << 8) == 613)
+
+	// Status Return Level 1 nach dem Start: WRITE ohne Antwort gilt als angenommen
+	CHECK(DNE_readByte(2, DNX_STS_RT_LVL) == DNX_STATUS_LEVEL && DNE_readByte(2,
+			DNX_RT_DLY) == DNX_RETURN_DELAY)
+	CHECK(DNX_getStatusLevel(2) == 1 && !DNX_expectsReply(2, DNX_WR_DATA)
+			&& DNX_expectsReply(2, DNX_RD_DATA) && DNX_expectsReply(2, DNX_PING))
+	DNE_resetStats();
+	CHECK(DNX_setLed(2, 0x00) && DNE_readByte(2, DNX_LED) == 0)
+	CHECK(DNE_getStats(&XM_servo_data_R)->replies == 0)
+
+	// Level 2 (Diagnose): Fehlerbyte der Antwort wird ausgewertet
+	DNX_setStatusLevel(2, 2);
+	CHECK(DNE_readByte(2, DNX_STS_RT_LVL) == 2 && DNX_expectsReply(2, DNX_WR_DATA))
+	DNX_resetErrors();
+	CHECK(DNX_setLed(2, 0x01) && DNX_getError(2) == 0)
+	packet[3] = 5;
+	packet[4] = DNX_WR_DATA;
+	packet[5] = 0x31; // zwei Bytes ab dem Ende der Control Table
+	packet[6] = 0;
+	packet[7] = 0;
+	CHECK(DNX_send(packet, 9, result, true) == 6 && result[4] == DNX_ERR_RANGE)
+	CHECK(DNX_getError(2) == DNX_ERR_RANGE && DNX_getErrorCount(3) == 1)
+	CHECK(DNX_setLed(2, 0x00) && DNX_getError(2) == 0)
+	CHECK(DNX_getErrorCount(3) == 1 && DNX_getErrorCount(0) == 0)
+	DNX_setStatusLevel(2, 1);
+	CHECK(DNE_readByte(2, DNX_STS_RT_LVL) == 1 && !DNX_expectsReply(2, DNX_WR_DATA))
+
+	// Busbelegung für 18 Winkel
+	DNE_resetStats();
+	for (id = 1; id <= DNE_SERVOS; id++)
+		DNX_setAngle(id, 10, false);
+	printBusy("WRITE");
+	for (id = 1; id <= DNE_SERVOS; id++)
+		DNX_setAngle(id, 20, true);
+	DNX_sendAction(DNX_BRDCAST_ID);
+	printBusy("REG_WRITE+ACTION");
+	packet[2] = DNX_BRDCAST_ID;
+	packet[3] = 4 + 3 * DNE_SERVOS;
+	packet[4] = DNX_SYC_WR;
+	packet[5] = DNX_GL_POS;
+	packet[6] = 2;
+	for (id = 1; id <= DNE_SERVOS; id++) {
+		packet[4 + 3 * id] = id;
+		packet[5 + 3 * id] = 0x00;
+		packet[6 + 3 * id] = 0x02;
+	}
+	DNX_send(packet, 8 + 3 * DNE_SERVOS, result, false);
+	printBusy("SYNC_WRITE");
+	for (id = 1; id <= DNE_SERVOS; id++)
+		CHECK(DNE_readWord(id, DNX_GL_POS) == 0x200)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
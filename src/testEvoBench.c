@@ -0,0 +1,131 @@
+/**
+ * \file	testEvoBench.c
+ *
+ * \brief	Benchmark für den Evolutionären Algorithmus zur Startpunktfindung (Host).
+ *
+ * 			Misst Generationen pro Sekunde und die exakte Güte des besten Individuums
+ * 			(SP_scorePoint) im Verhältnis zum Optimum (SP_calcStartPoint).
+ * 			Vergleicht außerdem die Selektion mit bubblesort() und selectBest()
+ * 			und den EA-Kern mit Populationsgrößen von 10 bis 10000.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "include/evolutionaryHelper.h"
+#include "include/evolutionaryAlgorithm.h"
+#include "include/startPoint.h"
+
+#define DIRECTIONS 16
+#define POPSIZE 10
+#define RUNS 20
+#define PARENT_CNT 10
+
+/**
+ * \brief	Vergleicht bubblesort() und selectBest() für eine Populationsgröße.
+ */
+void benchSelection(const DT_size popsize) {
+	const DT_size n = popsize + 2 * PARENT_CNT;
+	DT_individuum* P = malloc(n * sizeof(DT_individuum));
+	DT_individuum* Q = malloc(n * sizeof(DT_individuum));
+	DT_size* index = malloc(popsize * sizeof(DT_size));
+	DT_size i, j, cnt, runs = popsize >= 1000 ? 1 : 100;
+	DT_rng rng;
+	double tBubble = 0, tSelect = 0;
+	DT_bool equal = true;
+	clock_t t0;
+
+	rngSeed(&rng, popsize);
+	for (i = 0; i < n; i++)
+		P[i].F = rngUniform(&rng) < 0.05 ? 10000 : rngRange(&rng, 0, 160);
+
+	for (j = 0; j < runs; j++) {
+		for (i = 0; i < n; i++)
+			Q[i] = P[i];
+		t0 = clock();
+		bubblesort(Q, n);
+		tBubble += (double) (clock() - t0) / CLOCKS_PER_SEC;
+		t0 = clock();
+		cnt = selectBest(P, n, index, popsize);
+		tSelect += (double) (clock() - t0) / CLOCKS_PER_SEC;
+	}
+	// Gleiche Güte wie die sortierten gültigen Individuen
+	for (i = 0, j = 0; i < n && j < cnt; i++)
+		if (Q[i].F <= 1000)
+			equal = equal && (Q[i].F == P[index[j++]].F);
+	printf("%u\t%12.3f\t%12.3f\t%s\n", popsize, 1e6 * tBubble / runs, 1e6
+			* tSelect / runs, equal ? "OK" : "FEHLER");
+	free(P);
+	free(Q);
+	free(index);
+}
+
+/**
+ * \brief	Misst Generationen pro Sekunde des EA-Kerns für eine Populationsgröße.
+ */
+void benchCore(const DT_size popsize) {
+	DT_individuum* buffer = malloc(EVO_BUFFER_SIZE(popsize, PARENT_CNT)
+			* sizeof(DT_individuum));
+	DT_size* index = malloc(popsize * sizeof(DT_size));
+	DT_evo evo;
+	DT_vector v = { 3, 7 };
+	DT_point S;
+	DT_int gens = 0;
+
+	EVO_init(&evo, buffer, index, popsize, PARENT_CNT, 1);
+	EVO_start(&evo, &v);
+	clock_t t0 = clock();
+	do {
+		EVO_generation(&evo);
+		gens++;
+	} while (clock() - t0 < CLOCKS_PER_SEC / 10);
+	double t = (double) (clock() - t0) / CLOCKS_PER_SEC;
+	DT_individuum A = EVO_best(&evo);
+	DT_individuum B = SP_calcStartPoint(&v);
+	printf("%u\t%10.0f\t%f\n", popsize, gens / t, SP_scorePoint(&v, &A.G, &S)
+			/ B.F);
+	free(buffer);
+	free(index);
+}
+
+int main() {
+	const DT_int generations[] = { 5, 20, 50 };
+	const DT_size popsizes[] = { 10, 100, 1000, 10000 };
+	DT_vector v;
+	DT_individuum A, B;
+	DT_point S;
+	DT_size p;
+	DT_int i, r;
+
+	printf("gen\tgen/s\t\tGüte/Optimum\n");
+	for (p = 0; p < sizeof(generations) / sizeof(generations[0]); p++) {
+		double t = 0, quality = 0;
+		for (i = 0; i < DIRECTIONS; i++) {
+			v.x = 10 * cos(2 * M_PI * i / DIRECTIONS);
+			v.y = 10 * sin(2 * M_PI * i / DIRECTIONS);
+			B = SP_calcStartPoint(&v);
+			clock_t t0 = clock();
+			for (r = 0; r < RUNS; r++)
+				A = evolutionaryAlgorithm(POPSIZE, generations[p], &v);
+			t += (double) (clock() - t0) / CLOCKS_PER_SEC;
+			quality += SP_scorePoint(&v, &A.G, &S) / B.F;
+		}
+		printf("%d\t%10.0f\t%f\n", generations[p], DIRECTIONS * RUNS
+				* generations[p] / t, quality / DIRECTIONS);
+	}
+
+	printf("\npopsize\tbubblesort [us]\tselectBest [us]\n");
+	for (p = 0; p < sizeof(popsizes) / sizeof(popsizes[0]); p++)
+		benchSelection(popsizes[p]);
+
+	printf("\npopsize\tgen/s\t\tGüte/Optimum\n");
+	for (p = 0; p < sizeof(popsizes) / sizeof(popsizes[0]); p++)
+		benchCore(popsizes[p]);
+	return 0;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,195 @@
+/**
+ * \file	testEvoSweep.c
+ *
+ * \brief	Parameterstudie für den Evolutionären Algorithmus (Host).
+ *
+ * 			Variiert popsize, Generationen, px, pm, parentCnt und smax und bewertet
+ * 			jede Einstellung über alle Bewegungsrichtungen und mehrere Startwerte
+ * 			mit der exakten Güte im Verhältnis zum Optimum (SP_calcStartPoint).
+ * 			Die Einstellungen werden mit einem Thread je Prozessorkern abgearbeitet.
+ * 			Die Schnittfläche wird vorher einmal geladen (initEvoAlg()), mit
+ * 			EVO_FAST_SCORE_ON läuft die Studie in einem Thread, da SG_scorePointFast()
+ * 			die Richtung in globalen Variablen hält. Ausgegeben wird die
+ * 			Pareto-Front aus Güte und gezählten Bewertungen (DT_evo.evaluations)
+ * 			als CSV, die aktuelle Einstellung von evolutionaryAlgorithm() auf stderr.
+ *
+ * 			gcc -DTEST_ON -pthread testEvoSweep.c evolutionaryAlgorithm.c ... -lm
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "include/evolutionaryHelper.h"
+#include "include/evolutionaryAlgorithm.h"
+#include "include/startPoint.h"
+
+#define DIRECTIONS 16
+#define SEEDS 4
+#define MAX_THREADS 64
+
+#define COUNT(a) ((DT_int) (sizeof(a) / sizeof(a[0])))
+
+const DT_int popsizes[] = { 5, 10, 20, 40 };
+const DT_int generations[] = { 2, 5, 10, 20, 40 };
+const DT_real pxs[] = { 0.6, 0.8, 1.0 };
+const DT_real pms[] = { 0.05, 0.1, 0.2, 0.4 };
+const DT_int parentCnts[] = { 2, 5, 10, 20 };
+const DT_real smaxs[] = { 2, 5, 10, 20 };
+
+/**
+ * \brief	Indizes der aktuellen Einstellung von evolutionaryAlgorithm().
+ *
+ * 			popsize 10, 5 Generationen, Standardparameter von EVO_init()
+ * 			(px = 1.0, pm = 0.2, smax = 10) und EVO_PARENT_CNT = 10.
+ */
+#define CUR_POPSIZE		1
+#define CUR_GENERATIONS	1
+#define CUR_PX			2
+#define CUR_PM			2
+#define CUR_PARENT_CNT	2
+#define CUR_SMAX		2
+
+/** \brief Einstellung und Ergebnis eines Laufs der Parameterstudie. */
+typedef struct {
+	DT_int popsize, generations, parentCnt;
+	DT_real px, pm, smax;
+	long evaluations; /**< Bewertungen je Richtung. */
+	DT_real quality; /**< Mittlere Güte im Verhältnis zum Optimum. */
+	DT_bool current; /**< Aktuelle Einstellung von evolutionaryAlgorithm(). */
+} DT_sweep;
+
+DT_sweep* configs;
+DT_int configCnt;
+DT_int nextConfig = 0;
+DT_individuum optimum[DIRECTIONS];
+DT_vector directions[DIRECTIONS];
+
+/**
+ * \brief	Bewertet eine Einstellung über alle Richtungen und Startwerte.
+ */
+void evaluate(DT_sweep* const c) {
+	DT_individuum* buffer = malloc(EVO_BUFFER_SIZE(c->popsize, c->parentCnt)
+			* sizeof(DT_individuum));
+	DT_size* index = malloc(c->popsize * sizeof(DT_size));
+	DT_evo evo;
+	DT_individuum A;
+	DT_point S;
+	DT_int i, s, t;
+	DT_real sum = 0;
+	long evaluations = 0;
+
+	for (i = 0; i < DIRECTIONS; i++) {
+		for (s = 0; s < SEEDS; s++) {
+			EVO_init(&evo, buffer, index, c->popsize, c->parentCnt, 211 + s);
+			evo.px = c->px;
+			evo.pm = c->pm;
+			evo.smax = c->smax;
+			EVO_start(&evo, &directions[i]);
+			for (t = 0; t < c->generations; t++)
+				EVO_generation(&evo);
+			A = EVO_best(&evo);
+			evaluations += evo.evaluations;
+			sum += SP_scorePoint(&directions[i], &A.G, &S) / optimum[i].F;
+		}
+	}
+	c->quality = sum / (DIRECTIONS * SEEDS);
+	c->evaluations = evaluations / (DIRECTIONS * SEEDS);
+	free(buffer);
+	free(index);
+}
+
+/**
+ * \brief	Arbeitsthread: holt Einstellungen, bis alle bewertet sind.
+ */
+void* worker(void* arg) {
+	DT_int i;
+	(void) arg;
+	while ((i = __sync_fetch_and_add(&nextConfig, 1)) < configCnt)
+		evaluate(&configs[i]);
+	return NULL;
+}
+
+/**
+ * \brief	Sortiert nach Bewertungen aufsteigend, bei Gleichstand nach Güte absteigend.
+ */
+int compareSweep(const void* a, const void* b) {
+	const DT_sweep* x = a;
+	const DT_sweep* y = b;
+	if (x->evaluations != y->evaluations)
+		return x->evaluations < y->evaluations ? -1 : 1;
+	return x->quality > y->quality ? -1 : (x->quality < y->quality);
+}
+
+int main() {
+	pthread_t threads[MAX_THREADS];
+	DT_int a, b, c, d, e, f, i, threadCnt;
+	DT_real best = -1;
+
+	initEvoAlg(); // vor den Threads, danach nur noch gelesen
+	for (i = 0; i < DIRECTIONS; i++) {
+		directions[i].x = 10 * cos(2 * M_PI * i / DIRECTIONS);
+		directions[i].y = 10 * sin(2 * M_PI * i / DIRECTIONS);
+		optimum[i] = SP_calcStartPoint(&directions[i]);
+	}
+
+	configCnt = COUNT(popsizes) * COUNT(generations) * COUNT(pxs) * COUNT(pms)
+			* COUNT(parentCnts) * COUNT(smaxs);
+	configs = malloc(configCnt * sizeof(DT_sweep));
+	i = 0;
+	for (a = 0; a < COUNT(popsizes); a++)
+		for (b = 0; b < COUNT(generations); b++)
+			for (c = 0; c < COUNT(pxs); c++)
+				for (d = 0; d < COUNT(pms); d++)
+					for (e = 0; e < COUNT(parentCnts); e++)
+						for (f = 0; f < COUNT(smaxs); f++, i++) {
+							configs[i].popsize = popsizes[a];
+							configs[i].generations = generations[b];
+							configs[i].px = pxs[c];
+							configs[i].pm = pms[d];
+							configs[i].parentCnt = parentCnts[e];
+							configs[i].smax = smaxs[f];
+							configs[i].current = a == CUR_POPSIZE && b
+									== CUR_GENERATIONS && c == CUR_PX && d
+									== CUR_PM && e == CUR_PARENT_CNT && f
+									== CUR_SMAX;
+						}
+
+	threadCnt = sysconf(_SC_NPROCESSORS_ONLN);
+	threadCnt = threadCnt < 1 ? 1 : (threadCnt > MAX_THREADS ? MAX_THREADS
+			: threadCnt);
+#ifdef EVO_FAST_SCORE_ON
+	threadCnt = 1;
+#endif
+	for (i = 0; i < threadCnt; i++)
+		pthread_create(&threads[i], NULL, worker, NULL);
+	for (i = 0; i < threadCnt; i++)
+		pthread_join(threads[i], NULL);
+
+	for (i = 0; i < configCnt; i++)
+		if (configs[i].current)
+			fprintf(stderr, "aktuell: %ld Bewertungen, Güte %f\n",
+					configs[i].evaluations, configs[i].quality);
+	fprintf(stderr, "%d Einstellungen, %d Threads\n", configCnt, threadCnt);
+
+	// Pareto-Front: jede Einstellung, die besser als alle billigeren ist
+	qsort(configs, configCnt, sizeof(DT_sweep), compareSweep);
+	printf("evaluations;quality;popsize;generations;px;pm;parentCnt;smax\n");
+	for (i = 0; i < configCnt; i++) {
+		if (configs[i].quality <= best)
+			continue;
+		best = configs[i].quality;
+		printf("%ld;%f;%d;%d;%.2f;%.2f;%d;%.0f\n", configs[i].evaluations,
+				configs[i].quality, configs[i].popsize, configs[i].generations,
+				configs[i].px, configs[i].pm, configs[i].parentCnt,
+				configs[i].smax);
+	}
+	free(configs);
+	return 0;
+}
+
+#endif /* TEST_ON */
@@ -96,9 +96,9 @@ void initConf() {
 	SlavesInactive = COM_CONF_LEFT;
 }
 
-void TripodGaitMove(DT_point* pM, DT_point* pS, const DT_double speed,
-		const DT_double offset) {
-	DT_double z;
+void TripodGaitMove(DT_point* pM, DT_point* pS, const DT_real speed,
+		const DT_real offset) {
+	DT_real z;
 	z = pM->z;
 	if (MasterActive == COM_CONF_LEFT) {
 		MV_pointAndSpeed(&leg_l, pM, speed, false);
@@ -135,16 +135,16 @@ void init_pMpSpMiddle() {
 	pMiddle.z = Z;
 }
 
-DT_double getAbsolutValue(const DT_vector * const v) {
+DT_real getAbsolutValue(const DT_vector * const v) {
 	return sqrt(v->x * v->x + v->y * v->y);
 }
 
 void calculateMovementPoints(DT_vector * v) {
-	DT_double distM = getDistance(&pM, &isectM);
-	DT_double distS = getDistance(&pS, &isectS);
+	DT_real distM = getDistance(&pM, &isectM);
+	DT_real distS = getDistance(&pS, &isectS);
 	// Bewegung anhand von 3 Punkten auf einer geraden
 
-	DT_double ratio;
+	DT_real ratio;
 	DT_point distV;
 	if (distM <= distS) {
 		if (getAbsolutValue(v) < distM) {
@@ -199,7 +199,7 @@ void calculateMovementPoints(DT_vector * v) {
 	}
 }
 
-void doStepMove(DT_point* pM, DT_point* pS, const DT_double speed) {
+void doStepMove(DT_point* pM, DT_point* pS, const DT_real speed) {
 	if (MasterActive == COM_CONF_LEFT) {
 		MV_pointAndSpeed(&leg_l, pM, speed, false);
 	} else {
@@ -211,9 +211,9 @@ void doStepMove(DT_point* pM, DT_point* pS, const DT_double speed) {
 	MV_action(&leg_r, &leg_l);
 }
 
-void prepareStepMove(DT_point* pM, DT_point* pS, const DT_double speed,
-		const DT_double offset) {
-	DT_double z;
+void prepareStepMove(DT_point* pM, DT_point* pS, const DT_real speed,
+		const DT_real offset) {
+	DT_real z;
 	z = pM->z;
 	if (MasterInactive == COM_CONF_LEFT) {
 		pM->z += offset;
@@ -232,11 +232,11 @@ void prepareStepMove(DT_point* pM, DT_point* pS, const DT_double speed,
 	MV_action(&leg_r, &leg_l);
 }
 
-void doStep(const DT_double speed) {
+void doStep(const DT_real speed) {
 
 }
 
-void evolutionaryCalculation(DT_vector * v, const DT_double speed) {
+void evolutionaryCalculation(DT_vector * v, const DT_real speed) {
 	DT_individuum A, B;
 	if (MasterActive == COM_CONF_LEFT)
 		invertVector(v);
@@ -270,7 +270,7 @@ DT_bool movedToPoint(DT_vector * v) {
 void master() {
 	DT_cmd cmd;
 	DT_vector v;
-	DT_double speed = 200;
+	DT_real speed = 200;
 	init_pMpSpMiddle();
 	initConf();
 	DT_point pM_old, pS_old;
@@ -0,0 +1,162 @@
+/**
+ * \file	testPacketPool.c
+ *
+ * \brief	Testprogramm für die gemeinsamen Paketpuffer (Host).
+ *
+ * 			Prüft Holen, Zurückgeben und Erschöpfung der Pools. Danach werden
+ * 			Befehle des Masters von einem Slave 3F mit emulierten Servos auf einem
+ * 			eigenen, mit einem Muster gefüllten Stack bearbeitet. Ausgegeben wird
+ * 			der höchste Stand des Stacks und der Pools je Befehl.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <string.h>
+#include <ucontext.h>
+#include "include/packetPool.h"
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/trace.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define STACK_SIZE		16384
+#define STACK_PATTERN	0xA5
+
+DT_byte stack[STACK_SIZE];
+ucontext_t mainContext, slaveContext;
+DT_leg leg_r, leg_l;
+DT_byte frame[DT_RESULT_BUFFER_SIZE];
+DT_size frameLen;
+DT_bool handled;
+
+/**
+ * \brief	Empfängt das Paket in frame auf dem Slave und bearbeitet es.
+ */
+void slaveStep() {
+	DT_size i;
+	for (i = 0; i < frameLen; i++)
+		XM_receiveByte(&XM_com_data3, frame[i]);
+	handled = MV_slaveStep(COM_SLAVE3F, &leg_r, &leg_l);
+}
+
+/**
+ * \brief	Bearbeitet einen Befehl des Masters auf dem Slave.
+ *
+ * \param	packet	Paket ab der Instruktion, ohne Korrelations-ID und Prüfsumme
+ * \param	l		Länge
+ *
+ * \return	höchster Stand des Stacks in Bytes
+ */
+DT_size measure(const DT_byte* const packet, DT_size l) {
+	DT_byte chksm = 0;
+	DT_size i;
+
+	frameLen = 0;
+	frame[frameLen++] = 0xFF;
+	frame[frameLen++] = 0xFF;
+	frame[frameLen++] = COM_SLAVE3F;
+	frame[frameLen++] = l + 2;
+	for (i = 0; i < l; i++)
+		frame[frameLen++] = packet[i];
+	frame[frameLen++] = 0;
+	for (i = 2; i < frameLen; i++)
+		chksm += frame[i];
+	frame[frameLen++] = ~chksm;
+
+	memset(stack, STACK_PATTERN, STACK_SIZE);
+	getcontext(&slaveContext);
+	slaveContext.uc_stack.ss_sp = stack;
+	slaveContext.uc_stack.ss_size = STACK_SIZE;
+	slaveContext.uc_link = &mainContext;
+	makecontext(&slaveContext, slaveStep, 0);
+	swapcontext(&mainContext, &slaveContext);
+
+	// Der Stack wächst nach unten
+	for (i = 0; i < STACK_SIZE && stack[i] == STACK_PATTERN; i++)
+		;
+	return STACK_SIZE - i;
+}
+
+int main() {
+	const DT_point p = { 77.8553, 77.8553, -129.1041 };
+	const DT_byte status[] = { COM_STATUS, COM_IS_ALIVE };
+	const DT_byte action[] = { COM_ACTION };
+	DT_byte point[2 + 3 * COM_REAL_SIZE] = { COM_POINT, COM_CONF_LEFT
+			| COM_CONF_RIGHT };
+	DT_byte* tx[PKT_TX_COUNT + 1];
+	DT_byte* rx;
+	DT_size i, used;
+	DT_int errors = 0;
+
+	// Pools: verschiedene Puffer, Erschöpfung, Rückgabe in beliebiger Reihenfolge
+	for (i = 0; i < PKT_TX_COUNT; i++) {
+		tx[i] = PKT_acquire(PKT_TX);
+		CHECK(tx[i] != NULL)
+	}
+	CHECK(tx[0] != tx[1] && tx[1] != tx[2] && tx[0] != tx[2])
+	CHECK(PKT_getFree(PKT_TX) == 0 && PKT_getMinFree(PKT_TX) == 0)
+	CHECK(PKT_acquire(PKT_TX) == NULL && PKT_getFailed(PKT_TX) == 1)
+	rx = PKT_acquire(PKT_RX);
+	CHECK(rx != NULL && PKT_getFree(PKT_RX) == PKT_RX_COUNT - 1)
+	memset(rx, 0, DT_RESULT_BUFFER_SIZE);
+	PKT_release(tx[1]);
+	PKT_release(tx[0]);
+	PKT_release(tx[2]);
+	PKT_release(rx);
+	PKT_release(NULL);
+	CHECK(PKT_getFree(PKT_TX) == PKT_TX_COUNT && PKT_getFree(PKT_RX)
+			== PKT_RX_COUNT)
+	CHECK(PKT_acquire(PKT_TX) == tx[2])
+	PKT_release(tx[2]);
+
+	// Doppelte Rückgabe wird abgewiesen und gezählt
+	PKT_release(tx[2]);
+	CHECK(PKT_getFree(PKT_TX) == PKT_TX_COUNT && PKT_getFailed(PKT_TX) == 2)
+	tx[0] = PKT_acquire(PKT_TX);
+	PKT_release(tx[1]);
+	CHECK(PKT_getFree(PKT_TX) == PKT_TX_COUNT - 1 && PKT_getFailed(PKT_TX) == 3)
+	PKT_release(tx[0]);
+	CHECK(PKT_getFree(PKT_TX) == PKT_TX_COUNT)
+	PKT_resetStats();
+	CHECK(PKT_getMinFree(PKT_TX) == PKT_TX_COUNT && PKT_getFailed(PKT_TX) == 0)
+
+	// Slave 3F mit emulierten Servos
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(0x7E);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	XM_init_com(COM_SLAVE3F);
+	TRC_init(COM_SLAVE3F);
+	XM_setTxHook(&XM_com_data3, XM_ignoreTx); // Antworten an den Master verwerfen
+	COM_realToByteArray(p.x, &point[2 + 0 * COM_REAL_SIZE]);
+	COM_realToByteArray(p.y, &point[2 + 1 * COM_REAL_SIZE]);
+	COM_realToByteArray(p.z, &point[2 + 2 * COM_REAL_SIZE]);
+
+	used = measure(status, sizeof(status));
+	CHECK(handled)
+	printf("Stack COM_STATUS: %u Bytes\n", used);
+	used = measure(point, sizeof(point));
+	CHECK(handled)
+	printf("Stack COM_POINT:  %u Bytes\n", used);
+	used = measure(action, sizeof(action));
+	CHECK(handled)
+	printf("Stack COM_ACTION: %u Bytes\n", used);
+	printf("Pools: TX %u/%u, RX %u/%u Puffer höchstens belegt\n", PKT_TX_COUNT
+			- PKT_getMinFree(PKT_TX), PKT_TX_COUNT, PKT_RX_COUNT
+			- PKT_getMinFree(PKT_RX), PKT_RX_COUNT);
+
+	// Alle Puffer zurückgegeben, kein weiterer Fehlschlag
+	CHECK(PKT_getFree(PKT_TX) == PKT_TX_COUNT && PKT_getFree(PKT_RX)
+			== PKT_RX_COUNT)
+	CHECK(PKT_getFailed(PKT_TX) == 0 && PKT_getFailed(PKT_RX) == 0)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,92 @@
+/**
+ * \file	testProfiler.c
+ *
+ * \brief	Testprogramm für den Profiler (Host).
+ *
+ * 			Prüft Statistik und Histogrammklassen, die Umwandlung in ein Byte-Array
+ * 			und die Abfrage mit COM_PROFILE. Der Slave wird dabei über den
+ * 			Sende-Empfänger von XM_com_data3 direkt mit MV_slaveStatus() bedient.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include "include/profiler.h"
+#include "include/communication.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+/**
+ * \brief	Beantwortet Anfragen als Slave und gibt Antworten an den Master zurück.
+ */
+void loopback(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_size i;
+	if (data[4] == COM_STATUS)
+		MV_slaveStatus(data, l);
+	else
+		for (i = 0; i < l; i++)
+			XM_receiveByte(usart_data, data[i]);
+}
+
+int main() {
+	const DT_size times[] = { 0, 1, 3, 100, 40000, 100 };
+	DT_byte array[PRF_SIZE];
+	DT_prfScope copy;
+	const DT_prfScope* s;
+	DT_size i;
+	uint32_t start;
+	DT_int errors = 0;
+
+	// Klassen: Anzahl der signifikanten Bits
+	CHECK(PRF_getBucket(0) == 0 && PRF_getBucket(1) == 1)
+	CHECK(PRF_getBucket(2) == 2 && PRF_getBucket(3) == 2)
+	CHECK(PRF_getBucket(1024) == 11 && PRF_getBucket(0xFFFF) == 16)
+	CHECK(PRF_getBucket(100000) == 16)
+
+	// Statistik
+	PRF_reset();
+	for (i = 0; i < sizeof(times) / sizeof(DT_size); i++)
+		PRF_record(PRF_KIN, times[i]);
+	s = PRF_get(PRF_KIN);
+	CHECK(s->count == 6 && s->sum_us == 40204)
+	CHECK(s->min_us == 0 && s->max_us == 40000)
+	CHECK(s->hist[0] == 1 && s->hist[1] == 1 && s->hist[2] == 1)
+	CHECK(s->hist[7] == 2 && s->hist[16] == 1)
+	CHECK(PRF_get(PRF_DNX_WAIT)->count == 0)
+
+	// Messung über den Überlauf der 16-Bit-Zeitbasis hinaus
+	PRF_enter(PRF_PLANNER);
+	start = XM_getUptimeUs();
+	while ((uint32_t) (XM_getUptimeUs() - start) < 70000)
+		;
+	PRF_exit(PRF_PLANNER);
+	CHECK(PRF_get(PRF_PLANNER)->count == 1)
+	CHECK(PRF_get(PRF_PLANNER)->max_us >= 70000)
+	CHECK(PRF_get(PRF_PLANNER)->hist[PRF_BUCKETS - 1] == 1)
+
+	// Byte-Array
+	CHECK(PRF_toByteArray(PRF_KIN, array) == PRF_SIZE)
+	PRF_fromByteArray(&copy, array);
+	CHECK(copy.count == s->count && copy.sum_us == s->sum_us)
+	CHECK(copy.min_us == s->min_us && copy.max_us == s->max_us)
+	for (i = 0; i < PRF_BUCKETS; i++)
+		CHECK(copy.hist[i] == s->hist[i])
+
+	// Abfrage mit COM_PROFILE
+	XM_init_com(COM_MASTER);
+	XM_setTxHook(&XM_com_data3, loopback);
+	CHECK(COM_requestProfile(COM_SLAVE3F, PRF_KIN, &copy))
+	CHECK(copy.count == 6 && copy.max_us == 40000 && copy.hist[7] == 2)
+	CHECK(COM_requestProfile(COM_SLAVE3F, PRF_DNX_WAIT, &copy))
+	CHECK(copy.count == 0)
+
+	PRF_dump();
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
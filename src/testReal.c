@@ -0,0 +1,139 @@
+/**
+ * \file	testReal.c
+ *
+ * \brief	Genauigkeit und Laufzeit der Zahlendarstellung DT_real (Host).
+ *
+ * 			Rechnet für ein Raster von Punkten die inverse Kinematik
+ * 			KIN_calcServos() und zurück mit KIN_calcDH() und vergleicht mit dem
+ * 			Ausgangspunkt. Prüft außerdem die Umrechnung von Winkeln und die
+ * 			Übertragung als DT_q16. Wird für jede Zahlendarstellung übersetzt
+ * 			(testReal, testRealFloat32), die Schranken gelten je Darstellung.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "include/communication.h"
+#include "include/kinematics.h"
+#include "include/utils.h"
+#include "include/test.h"
+
+#define ROUNDS 200
+#define MIN_RADIUS 60 /**< KIN_calcServos() setzt den Fuß außerhalb von DIST_HK voraus. */
+
+/**
+ * \def	MAX_KIN_ERROR
+ * \brief	Erlaubter Abstand nach KIN_calcServos() und KIN_calcDH() in mm.
+ *
+ * \def	MAX_ANGLE_ERROR
+ * \brief	Erlaubter Fehler von UTL_getDegree(UTL_getRadiant()) in Grad.
+ */
+#if DT_REAL == DT_REAL_FLOAT32
+#define BACKEND "float32"
+#define MAX_KIN_ERROR 0.01
+#define MAX_ANGLE_ERROR 1e-4
+#else
+#define BACKEND "float64"
+#define MAX_KIN_ERROR 1e-9
+#define MAX_ANGLE_ERROR 1e-12
+#endif
+
+/**
+ * \brief	Rechnet einen Punkt hin und zurück.
+ *
+ * \return	Abstand zum Ausgangspunkt oder -1, wenn der Punkt nicht erreichbar ist
+ */
+double roundTrip(const DT_point* const p) {
+	DT_real rows[KIN_ROWS][KIN_COLUMNS];
+	DT_real* dh[KIN_ROWS] = { rows[0], rows[1], rows[2], rows[3] };
+	DT_leg leg;
+	DT_point q;
+
+	if (!KIN_calcServos(p, &leg))
+		return -1;
+	KIN_calcDH(&leg, dh);
+	q = UTL_getPointOfDH((const DT_real**) dh);
+	return sqrt((double) (q.x - p->x) * (q.x - p->x) + (double) (q.y - p->y)
+			* (q.y - p->y) + (double) (q.z - p->z) * (q.z - p->z));
+}
+
+int main() {
+	const DT_real values[] = { 0, 1, -1.5, 77.8553, -129.1041, 1023, 0.000015 };
+	DT_byte array[COM_REAL_SIZE];
+	DT_point p;
+	DT_leg leg;
+	DT_real angle;
+	double e, maxKin = 0, maxAngle = 0, sum = 0;
+	DT_int errors = 0, points = 0, unreachable = 0, i, r;
+	clock_t t0;
+
+	printf("DT_real: %s (%u Bytes)\n", BACKEND, (unsigned) sizeof(DT_real));
+
+	// Inverse Kinematik und zurück im Arbeitsraum eines Beines
+	for (p.x = 40; p.x <= 140; p.x += 5)
+		for (p.y = -80; p.y <= 80; p.y += 5)
+			for (p.z = -150.25; p.z <= -60; p.z += 7.5) {
+				if (p.x * p.x + p.y * p.y < MIN_RADIUS * MIN_RADIUS)
+					continue;
+				e = roundTrip(&p);
+				if (e < 0) {
+					unreachable++;
+					continue;
+				}
+				points++;
+				if (e > maxKin)
+					maxKin = e;
+			}
+	p.x = 77.8553;
+	p.y = 77.8553;
+	p.z = -129.1041;
+	e = roundTrip(&p);
+	if (e > maxKin)
+		maxKin = e;
+	printf("Kinematik: %d Punkte (%d nicht erreichbar), größter Fehler %g mm\n",
+			points, unreachable, maxKin);
+	CHECK(points > 1000)
+	CHECK(maxKin >= 0 && maxKin < MAX_KIN_ERROR)
+
+	// Umrechnung von Winkeln
+	for (i = -360; i <= 360; i++) {
+		angle = UTL_getDegree(UTL_getRadiant(i * (DT_real) 0.5));
+		e = fabs(angle - i * 0.5);
+		if (e > maxAngle)
+			maxAngle = e;
+	}
+	printf("Winkel: größter Fehler %g Grad\n", maxAngle);
+	CHECK(maxAngle < MAX_ANGLE_ERROR)
+
+	// Übertragung als DT_q16, unabhängig von DT_real
+	COM_realToByteArray(-1.5, array);
+	CHECK(array[0] == 0x00 && array[1] == 0x80 && array[2] == 0xFE && array[3]
+			== 0xFF)
+	for (i = 0; i < (DT_int) (sizeof(values) / sizeof(values[0])); i++) {
+		COM_realToByteArray(values[i], array);
+		CHECK(fabs(COM_byteArrayToReal(array) - values[i]) <= 0.5 / 65536
+				+ fabs(values[i]) * 1e-7)
+	}
+	CHECK(UTL_realToQ16(40000) == INT32_MAX && UTL_realToQ16(-40000) == INT32_MIN)
+	CHECK(UTL_q16ToReal(UTL_realToQ16(-0.25)) == (DT_real) -0.25)
+
+	// Laufzeit je Punkt
+	t0 = clock();
+	for (r = 0; r < ROUNDS; r++)
+		for (p.x = 40; p.x <= 140; p.x += 5)
+			for (p.y = -80; p.y <= 80; p.y += 5) {
+				p.z = -120;
+				KIN_calcServos(&p, &leg);
+				sum += leg.foot.set_value;
+			}
+	printf("KIN_calcServos: %.1f ns je Punkt (%g)\n", (double) (clock() - t0)
+			/ CLOCKS_PER_SEC * 1e9 / (ROUNDS * 21 * 33), sum);
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,153 @@
+/**
+ * \file	testSchedule.c
+ *
+ * \brief	Testprogramm für den gleichzeitigen Betrieb beider Servo-Busse (Host).
+ *
+ * 			Prüft DNX_submit() und DNX_run() am emulierten Servo-Bus: Warteschlange
+ * 			je Bus, Zähler, Timeout eines fehlenden Servos und die Zuordnung der
+ * 			Antworten. Vergleicht die virtuelle Zeit für die Abfrage beider Beine
+ * 			(DNX_getMoving()) und für REG_WRITE an alle Servos (DNX_flush()) mit
+ * 			der Belegung beider Busse nacheinander. Mit Status Return Level 1 wird
+ * 			auf REG_WRITE nicht geantwortet.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define LEG_IDS		0x0000007E /**< Servos 1 - 6 */
+#define MISSING_ID	19 /**< Nicht angeschlossen, rechter Bus. */
+
+/**
+ * \brief	Schreibt ein READ-Paket für zwei Bytes ab einer Adresse.
+ */
+void readPacket(DT_dnxRequest* const request, DT_byte* const packet,
+		DT_byte id, DT_byte addr) {
+	packet[0] = DNX_START_BYTE;
+	packet[1] = DNX_START_BYTE;
+	packet[2] = id;
+	packet[3] = 4;
+	packet[4] = DNX_RD_DATA;
+	packet[5] = addr;
+	packet[6] = 2;
+	request->packet = packet;
+	request->length = 8;
+	request->hasResponse = true;
+	request->result = NULL;
+}
+
+/**
+ * \brief	Summe der Belegung beider Busse seit DNE_resetStats().
+ */
+uint32_t busySum() {
+	return DNE_getStats(&XM_servo_data_R)->busy_us + DNE_getStats(
+			&XM_servo_data_L)->busy_us;
+}
+
+int main() {
+	const DT_dnxBusStats* const r = DNX_getBusStats(&XM_servo_data_R);
+	const DT_dnxBusStats* const l = DNX_getBusStats(&XM_servo_data_L);
+	DT_dnxRequest requests[DNX_QUEUE_SIZE + 1];
+	DT_byte packets[DNX_QUEUE_SIZE + 1][8];
+	DT_leg leg_r, leg_l;
+	uint32_t t, seq, par;
+	DT_int errors = 0, i;
+	DT_byte id;
+
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(DNE_ALL_IDS);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+
+	// Beide Beine abfragen: einzeln nacheinander und beide Busse gleichzeitig
+	DNE_resetStats();
+	t = DNE_getTimeUs();
+	for (id = 1; id <= 6; id++)
+		DNX_isMoving(id);
+	seq = DNE_getTimeUs() - t;
+	CHECK(seq >= busySum())
+	t = DNE_getTimeUs();
+	CHECK(DNX_getMoving(LEG_IDS) == 0)
+	par = DNE_getTimeUs() - t;
+	printf("MOVING von 6 Servos: %lu us nacheinander, %lu us gleichzeitig\n",
+			(unsigned long) seq, (unsigned long) par);
+	CHECK(par * 10 <= seq * 6)
+	DNX_setTicks(2, 700, false);
+	CHECK(DNX_getMoving(LEG_IDS) == 1 << 2)
+
+	// Warteschlange: READ an 7 - 9 (rechts) und 10, 11 (links)
+	DNX_resetBusStats();
+	for (i = 0; i < 5; i++) {
+		readPacket(&requests[i], packets[i], 7 + i, DNX_GL_POS);
+		CHECK(DNX_submit(&requests[i]))
+	}
+	CHECK(r->maxDepth == 3 && l->maxDepth == 2)
+	DNX_run();
+	for (i = 0; i < 5; i++) {
+		CHECK(requests[i].received == 8 && requests[i].error == 0)
+		CHECK(requests[i].value == DNE_readWord(7 + i, DNX_GL_POS))
+	}
+	CHECK(r->transactions == 3 && l->transactions == 2)
+	CHECK(r->overlapped + l->overlapped >= 3)
+	CHECK(r->timeouts == 0 && l->timeouts == 0)
+	CHECK(r->max_us >= r->last_us && r->sum_us >= r->max_us)
+
+	// Volle Warteschlange und Broadcast werden abgewiesen
+	for (i = 0; i <= DNX_QUEUE_SIZE; i++) {
+		readPacket(&requests[i], packets[i], 1, DNX_PRT_POS);
+		CHECK(DNX_submit(&requests[i]) == (i < DNX_QUEUE_SIZE))
+	}
+	DNX_run();
+	packets[0][2] = DNX_BRDCAST_ID;
+	CHECK(!DNX_submit(&requests[0]))
+
+	// Fehlender Servo läuft ab, der andere Bus antwortet
+	DNX_resetBusStats();
+	readPacket(&requests[0], packets[0], MISSING_ID, DNX_PRT_POS);
+	readPacket(&requests[1], packets[1], 4, DNX_PRT_POS);
+	CHECK(DNX_submit(&requests[0]) && DNX_submit(&requests[1]))
+	DNX_run();
+	CHECK(requests[0].received == 0 && r->timeouts == 1)
+	CHECK(requests[1].received == 8 && l->timeouts == 0)
+	CHECK(DNX_ping(DNX_ALL_IDS | (uint32_t) 1 << MISSING_ID) == DNX_ALL_IDS)
+
+	// REG_WRITE an alle 18 Servos, je ein Servo beider Busse gleichzeitig,
+	// mit Antworten (Status Return Level 2)
+	DNX_setStatusLevel(DNX_BRDCAST_ID, 2);
+	DNX_ping(1 << 1 | 1 << 4); // Broadcasts ohne Antwort ablaufen lassen
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		DNX_stage(id, 400 + id, DNX_SPEED_KEEP);
+	DNE_resetStats();
+	t = DNE_getTimeUs();
+	CHECK(DNX_flush(true) == DNX_MAX_ID)
+	par = DNE_getTimeUs() - t;
+	printf("REG_WRITE an %d Servos: %lu us belegt, %lu us gleichzeitig\n",
+			DNX_MAX_ID, (unsigned long) busySum(), (unsigned long) par);
+	CHECK(par * 10 <= busySum() * 6)
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		CHECK(DNE_readByte(id, DNX_REG_INST) == 1)
+	DNX_sendAction(DNX_BRDCAST_ID);
+	CHECK(DNE_readWord(18, DNX_GL_POS) == 418)
+
+	// Status Return Level 1: REG_WRITE ohne Warten auf Antworten
+	DNX_setStatusLevel(DNX_BRDCAST_ID, 1);
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		DNX_stage(id, 500 + id, DNX_SPEED_KEEP);
+	DNE_resetStats();
+	CHECK(DNX_flush(true) == DNX_MAX_ID)
+	CHECK(DNE_getStats(&XM_servo_data_R)->replies == 0
+			&& DNE_getStats(&XM_servo_data_L)->replies == 0)
+	DNX_sendAction(DNX_BRDCAST_ID);
+	CHECK(DNE_readWord(18, DNX_GL_POS) == 518)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
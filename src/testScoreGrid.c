@@ -0,0 +1,90 @@
+/**
+ * \file	testScoreGrid.c
+ *
+ * \brief	Testprogramm für die tabellenbasierte Bewertung (Host).
+ *
+ * 			Vergleicht SG_scorePointFast() mit der exakten Bewertung
+ * 			SP_scorePoint() für zufällige Startpunkte im Arbeitsraum und
+ * 			zufällige Richtungen und misst die Laufzeit gegenüber scorePoint().
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "include/evolutionaryHelper.h"
+#include "include/startPoint.h"
+#include "include/scoreGrid.h"
+
+#define SAMPLES 100000
+#define RUNS 20
+#define MAX_MEAN_ERROR 1.5
+
+int main() {
+	static DT_point P[SAMPLES];
+	DT_vector v, v_inv;
+	DT_point S;
+	DT_rng rng;
+	DT_int i, r, outliers = 0;
+	DT_real err, sumErr = 0, maxErr = 0, sumF = 0;
+	clock_t t0;
+	double tExact = 0, tFast = 0;
+
+	initEvoAlg();
+	rngSeed(&rng, 1);
+	// Startpunkte im Arbeitsraum (exakte Güte > 0)
+	v.x = 1;
+	v.y = 0;
+	for (i = 0; i < SAMPLES; i++) {
+		do {
+			P[i].x = rngRange(&rng, -83, 83);
+			P[i].y = rngRange(&rng, 42, 129);
+			P[i].z = Z;
+		} while (SP_scorePoint(&v, &P[i], &S) == 0);
+	}
+
+	for (i = 0; i < SAMPLES; i++) {
+		DT_real a = rngRange(&rng, 0, 2 * M_PI);
+		v.x = 10 * cos(a);
+		v.y = 10 * sin(a);
+		// SP_scorePoint() erwartet die ungedrehte Richtung
+		v_inv.x = v.y;
+		v_inv.y = v.x;
+		DT_real fExact = SP_scorePoint(&v_inv, &P[i], &S);
+		if (fExact == 0)
+			continue;
+		err = fabs(SG_scorePointFast(&v, &P[i], &S) - fExact);
+		sumErr += err;
+		sumF += fExact;
+		maxErr = max(maxErr, err);
+		if (err > 10)
+			outliers++;
+	}
+
+	v.x = 3;
+	v.y = 7;
+	t0 = clock();
+	for (r = 0; r < RUNS; r++)
+		for (i = 0; i < SAMPLES; i++)
+			sumF += scorePoint(&v, &P[i], &S);
+	tExact = (double) (clock() - t0) / CLOCKS_PER_SEC;
+	t0 = clock();
+	for (r = 0; r < RUNS; r++)
+		for (i = 0; i < SAMPLES; i++)
+			sumF += SG_scorePointFast(&v, &P[i], &S);
+	tFast = (double) (clock() - t0) / CLOCKS_PER_SEC;
+
+	printf("Tabelle: %d Richtungen, %d x %d Punkte, %u Byte\n", SG_DIRECTIONS,
+			SG_COLS, SG_ROWS, (unsigned) sizeof(SG_grid));
+	printf("Fehler: mittel %f, max %f, > 10: %d von %d\n", sumErr / SAMPLES,
+			maxErr, outliers, SAMPLES);
+	printf("Laufzeit scorePoint: %f us, SG_scorePointFast: %f us, Faktor: %.1f\n",
+			1e6 * tExact / (RUNS * SAMPLES), 1e6 * tFast / (RUNS * SAMPLES), tExact
+					/ tFast);
+	printf("%s\n", sumErr / SAMPLES <= MAX_MEAN_ERROR ? "OK" : "FEHLER");
+	return sumErr / SAMPLES <= MAX_MEAN_ERROR ? 0 : 1;
+}
+
+#endif /* TEST_ON */
@@ -79,7 +79,7 @@ void init_pMpS() {
 }
 
 void move(DT_point * p) {
-	DT_double speed = 100;
+	DT_real speed = 100;
 	MV_pointAndSpeed(&leg_l, p, speed, false);
 	MV_pointAndSpeed(&leg_r, p, speed, false);
 	DT_byte config = COM_CONF_LEFT | COM_CONF_RIGHT;
@@ -0,0 +1,183 @@
+/**
+ * \file	testStack.c
+ *
+ * \brief	Testprogramm für die Überwachung von Stack und RAM (Host).
+ *
+ * 			Prüft die schrittweise Suche von STK_poll(), den Verbrauch einer
+ * 			Aufrufkette des Slaves auf einem eigenen Stack (ucontext) und die
+ * 			Abfrage mit COM_STACK. Der Slave 3F wird über den Sende-Empfänger von
+ * 			XM_com_data3 im selben Prozess bedient.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <string.h>
+#include <ucontext.h>
+#include "include/stack.h"
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/trace.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define STACK_SIZE	16384
+
+DT_byte stack[STACK_SIZE];
+ucontext_t mainContext, slaveContext;
+DT_leg leg_r, leg_l;
+DT_byte frame[DT_RESULT_BUFFER_SIZE];
+DT_size frameLen;
+DT_bool handled;
+DT_int stackRequests = 0;
+
+/**
+ * \brief	Beantwortet Anfragen als Slave und gibt Antworten an den Master zurück.
+ */
+void loopback(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_size i;
+	if (data[4] == COM_STATUS && data[5] == COM_STACK)
+		stackRequests++;
+	if (data[4] == COM_STATUS)
+		MV_slaveStatus(data, l);
+	else
+		for (i = 0; i < l; i++)
+			XM_receiveByte(usart_data, data[i]);
+}
+
+/**
+ * \brief	Leitet die Antwort eines Slaves an XM_com_data1 zurück.
+ */
+void toLink1(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_size i;
+	(void) usart_data;
+	for (i = 0; i < l; i++)
+		XM_receiveByte(&XM_com_data1, data[i]);
+}
+
+/**
+ * \brief	Wie loopback(), als Slave 1B an XM_com_data1.
+ */
+void loopback1B(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	XM_setTxHook(&XM_com_data3, toLink1);
+	loopback(usart_data, data, l);
+	XM_setTxHook(&XM_com_data3, loopback);
+}
+
+DT_bool sameInfo(const DT_stkInfo* const a, const DT_stkInfo* const b) {
+	return a->staticRam == b->staticRam && a->used == b->used && a->free
+			== b->free && a->chain == b->chain && a->chainUsed == b->chainUsed
+			&& a->chainBudget == b->chainBudget;
+}
+
+/**
+ * \brief	Kette des Slaves: ein COM_POINT in MV_slaveStep().
+ */
+void slaveChain() {
+	DT_size i;
+	STK_begin(STK_SLAVE);
+	for (i = 0; i < frameLen; i++)
+		XM_receiveByte(&XM_com_data3, frame[i]);
+	handled = MV_slaveStep(COM_SLAVE3F, &leg_r, &leg_l);
+}
+
+int main() {
+	const DT_point p = { 77.8553, 77.8553, -129.1041 };
+	DT_byte region[1024];
+	DT_byte array[STK_SIZE];
+	DT_stkInfo info, remote;
+	DT_byte chksm = 0;
+	DT_size i, polls;
+	// volatile, da getcontext()/swapcontext() wie setjmp() mehrfach zurückkehren
+	volatile DT_int errors = 0;
+
+	// Schrittweise Suche in einem Bereich außerhalb des Stacks
+	STK_setRegion(region, region + sizeof(region));
+	STK_paint();
+	CHECK(region[0] == STK_PATTERN && region[sizeof(region) - 1] == STK_PATTERN)
+	region[sizeof(region) - 100] = 0x00;
+	for (polls = 0; polls < sizeof(region) / STK_SCAN + 1; polls++)
+		STK_poll();
+	STK_getInfo(&info);
+	CHECK(info.used == 100 && info.free == sizeof(region) - 100)
+	CHECK(info.chain == STK_CHAINS && info.chainUsed == 0)
+	region[10] = 0x00;
+	STK_getInfo(&info);
+	CHECK(info.used == sizeof(region) - 10 && info.free == 10)
+
+	// Byte-Array
+	info.chain = STK_SLAVE;
+	info.chainUsed = 300;
+	info.chainBudget = STK_BUDGET_SLAVE;
+	STK_toByteArray(&info, array);
+	STK_fromByteArray(&remote, array);
+	CHECK(sameInfo(&info, &remote))
+
+	// Kette des Slaves auf eigenem Stack
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(0x7E);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	XM_init_com(COM_SLAVE3F);
+	TRC_init(COM_SLAVE3F);
+	XM_setTxHook(&XM_com_data3, XM_ignoreTx);
+
+	frameLen = 0;
+	frame[frameLen++] = 0xFF;
+	frame[frameLen++] = 0xFF;
+	frame[frameLen++] = COM_SLAVE3F;
+	frame[frameLen++] = 4 + 3 * COM_REAL_SIZE;
+	frame[frameLen++] = COM_POINT;
+	frame[frameLen++] = COM_CONF_LEFT | COM_CONF_RIGHT;
+	COM_realToByteArray(p.x, &frame[frameLen + 0 * COM_REAL_SIZE]);
+	COM_realToByteArray(p.y, &frame[frameLen + 1 * COM_REAL_SIZE]);
+	COM_realToByteArray(p.z, &frame[frameLen + 2 * COM_REAL_SIZE]);
+	frameLen += 3 * COM_REAL_SIZE;
+	frame[frameLen++] = 0;
+	for (i = 2; i < frameLen; i++)
+		chksm += frame[i];
+	frame[frameLen++] = ~chksm;
+
+	STK_setRegion(stack, stack + STACK_SIZE);
+	STK_paint();
+	getcontext(&slaveContext);
+	slaveContext.uc_stack.ss_sp = stack;
+	slaveContext.uc_stack.ss_size = STACK_SIZE;
+	slaveContext.uc_link = &mainContext;
+	makecontext(&slaveContext, slaveChain, 0);
+	swapcontext(&mainContext, &slaveContext);
+	CHECK(handled)
+	STK_getInfo(&info);
+	CHECK(info.chain == STK_SLAVE && info.chainBudget == STK_BUDGET_SLAVE)
+	CHECK(info.chainUsed > 0 && info.chainUsed < info.used)
+	CHECK(info.used + info.free == STACK_SIZE)
+	printf("Kette Slave (COM_POINT): %u Bytes, Stack gesamt %u Bytes\n",
+			info.chainUsed, info.used);
+
+	// Abfrage mit COM_STACK
+	XM_init_com(COM_MASTER);
+	XM_setTxHook(&XM_com_data3, loopback);
+	CHECK(COM_requestStack(COM_SLAVE3F, &remote))
+	STK_getInfo(&info);
+	CHECK(sameInfo(&info, &remote))
+	CHECK(!COM_requestStack(COM_BRDCAST_ID, &remote))
+
+	// Regelmäßige Abfrage aus der Hauptschleife des Masters
+	XM_setTxHook(&XM_com_data1, loopback1B);
+	stackRequests = 0;
+	MV_masterPollStack();
+	CHECK(stackRequests == 2)
+	MV_masterPollStack();
+	CHECK(stackRequests == 2)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,167 @@
+/**
+ * \file	testStage.c
+ *
+ * \brief	Testprogramm für vorgemerkte Zielpositionen (Host).
+ *
+ * 			Prüft am emulierten Servo-Bus, dass MV_point() und MV_action() nur
+ * 			geänderte Zielpositionen senden (REG_WRITE je Servo), unveränderte
+ * 			zählen und Geschwindigkeiten mitsenden. Jeder Servo muss seine
+ * 			Zielposition vor der ACTION gespeichert haben und erst mit ihr
+ * 			übernehmen. Außerdem das Zusammenspiel mit direkt gesendeten Werten
+ * 			(DNX_setTicks()) und DNX_flush() ohne REG_WRITE (SYNC_WRITE). Gibt die
+ * 			Busbelegung einer Wiederholung desselben Punktes aus.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+uint32_t registered = 0; /**< Servos mit gespeichertem Wert bei ACTION. */
+uint32_t early = 0; /**< Servos, deren Zielposition vor ACTION schon galt. */
+uint16_t expected[DNX_MAX_ID + 1]; /**< Zielpositionen für onAction(). */
+
+/**
+ * \brief	Merkt sich den Zustand eines Servos unmittelbar vor ACTION.
+ */
+void onAction(DT_byte id) {
+	if (DNE_readByte(id, DNX_REG_INST))
+		registered |= (uint32_t) 1 << id;
+	else if (DNE_readWord(id, DNX_GL_POS) == expected[id])
+		early |= (uint32_t) 1 << id;
+}
+
+/**
+ * \brief	Merkt die Zielpositionen eines Beines für onAction() vor.
+ */
+void expect(const DT_leg* const leg) {
+	expected[leg->hip.id] = leg->hip.ticks;
+	expected[leg->knee.id] = leg->knee.ticks;
+	expected[leg->foot.id] = leg->foot.ticks;
+}
+
+/**
+ * \brief	Bitmaske der Servos eines Beines.
+ */
+uint32_t ids(const DT_leg* const leg) {
+	return (uint32_t) 1 << leg->hip.id | (uint32_t) 1 << leg->knee.id
+			| (uint32_t) 1 << leg->foot.id;
+}
+
+/**
+ * \brief	Instruktionspakete je Bus seit DNE_resetStats() (rechts + 256 * links).
+ */
+DT_int frames() {
+	return DNE_getStats(&XM_servo_data_R)->transactions + 256 * DNE_getStats(
+			&XM_servo_data_L)->transactions;
+}
+
+/**
+ * \brief	Prüft, ob die Servos eines Beines die Zielpositionen des Beines haben.
+ */
+DT_bool hasTicks(const DT_leg* const leg) {
+	return DNE_readWord(leg->hip.id, DNX_GL_POS) == leg->hip.ticks
+			&& DNE_readWord(leg->knee.id, DNX_GL_POS) == leg->knee.ticks
+			&& DNE_readWord(leg->foot.id, DNX_GL_POS) == leg->foot.ticks;
+}
+
+int main() {
+	DT_leg leg_r, leg_l;
+	DT_point p1 = { 100, 0, -100 }, p2 = { 110, 10, -90 };
+	const DT_dnxStats* const stats = DNX_getStats();
+	DT_int errors = 0;
+
+	XM_init_cpu();
+	XM_init_dnx();
+	DNE_init(DNE_ALL_IDS);
+	DNE_setActionHook(onAction);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+
+	// Erster Punkt: alle Servos unbekannt, REG_WRITE je Servo, dann ACTION
+	DNE_resetStats();
+	DNX_resetStats();
+	CHECK(MV_point(&leg_r, &p1, false) && MV_point(&leg_l, &p1, false))
+	CHECK(frames() == 0)
+	expect(&leg_r);
+	expect(&leg_l);
+	MV_action(&leg_r, &leg_l);
+	CHECK(frames() == 4 + 256 * 4)
+	CHECK(hasTicks(&leg_r) && hasTicks(&leg_l))
+	CHECK(registered == (ids(&leg_r) | ids(&leg_l)) && early == 0)
+	CHECK(stats->staged == 6 && stats->skipped == 0 && stats->frames == 6)
+
+	// Gleicher Punkt: nur ACTION
+	DNE_resetStats();
+	MV_point(&leg_r, &p1, false);
+	MV_point(&leg_l, &p1, false);
+	MV_action(&leg_r, &leg_l);
+	printf("Gleicher Punkt: %lu Bytes rechts, %lu us belegt\n",
+			(unsigned long) DNE_getStats(&XM_servo_data_R)->txBytes,
+			(unsigned long) DNE_getStats(&XM_servo_data_R)->busy_us);
+	CHECK(frames() == 1 + 256 * 1)
+	CHECK(stats->staged == 12 && stats->skipped == 6 && stats->frames == 6)
+
+	// Nur das linke Bein ändert sich
+	DNE_resetStats();
+	registered = early = 0;
+	MV_point(&leg_r, &p1, false);
+	MV_point(&leg_l, &p2, false);
+	expect(&leg_l);
+	MV_action(&leg_r, &leg_l);
+	CHECK(frames() == 1 + 256 * 4)
+	CHECK(hasTicks(&leg_r) && hasTicks(&leg_l))
+	CHECK(registered == ids(&leg_l) && (early & ids(&leg_l)) == 0)
+	CHECK(stats->skipped == 9 && stats->frames == 9)
+
+	// Geschwindigkeit: Zielposition und Geschwindigkeit in einem REG_WRITE
+	DNE_resetStats();
+	MV_pointAndSpeed(&leg_r, &p1, 100, false);
+	MV_action(&leg_r, &leg_l);
+	CHECK(frames() == 4 + 256 * 1)
+	CHECK(DNE_readWord(leg_r.hip.id, DNX_MV_SPEED) == 100 && DNE_readWord(
+			leg_r.foot.id, DNX_MV_SPEED) == 100)
+	MV_pointAndSpeed(&leg_r, &p1, 100, false);
+	MV_pointAndSpeed(&leg_r, &p1, 200, false);
+	MV_action(&leg_r, &leg_l);
+	CHECK(DNE_readWord(leg_r.knee.id, DNX_MV_SPEED) == 200 && hasTicks(&leg_r))
+	CHECK(frames() == 8 + 256 * 2)
+
+	// Direkt gesendete Werte werden übernommen
+	CHECK(DNX_setTicks(leg_r.hip.id, 300, false))
+	DNX_resetStats();
+	DNX_stage(leg_r.hip.id, 300, DNX_SPEED_KEEP);
+	CHECK(stats->skipped == 1 && DNX_flush(false) == 0)
+
+	// Mit REG_WRITE gespeicherter Wert überschreibt keinen neueren
+	CHECK(DNX_setTicks(leg_r.hip.id, 400, true))
+	DNX_stage(leg_r.hip.id, 500, DNX_SPEED_KEEP);
+	MV_action(&leg_r, &leg_l);
+	CHECK(DNE_readWord(leg_r.hip.id, DNX_GL_POS) == 500)
+
+	// DNX_flush() mit REG_WRITE: ein Paket je geändertem Servo
+	DNX_stage(leg_l.hip.id, 450, DNX_SPEED_KEEP);
+	DNX_stage(leg_l.knee.id, 460, 50);
+	DNX_stage(leg_l.foot.id, leg_l.foot.ticks, DNX_SPEED_KEEP);
+	CHECK(DNX_flush(true) == 2)
+	CHECK(DNE_readByte(leg_l.hip.id, DNX_REG_INST) == 1
+			&& DNE_readByte(leg_l.foot.id, DNX_REG_INST) == 0)
+	DNX_sendAction(DNX_BRDCAST_ID);
+	CHECK(DNE_readWord(leg_l.hip.id, DNX_GL_POS) == 450 && DNE_readWord(
+			leg_l.knee.id, DNX_MV_SPEED) == 50)
+
+	// Nach dem Start der Servos wird wieder gesendet
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	DNX_resetStats();
+	MV_point(&leg_r, &p1, false);
+	CHECK(stats->skipped == 0 && DNX_flush(false) == 1)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
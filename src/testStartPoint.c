@@ -0,0 +1,66 @@
+/**
+ * \file	testStartPoint.c
+ *
+ * \brief	Testprogramm für die analytische Startpunktfindung (Host).
+ *
+ * 			Vergleicht SP_calcStartPoint() mit evolutionaryAlgorithm() für
+ * 			verschiedene Bewegungsrichtungen in Güte und Laufzeit. Die Startpunkte
+ * 			beider Verfahren werden zusätzlich exakt mit SP_scorePoint() bewertet.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "include/evolutionaryHelper.h"
+#include "include/evolutionaryAlgorithm.h"
+#include "include/startPoint.h"
+
+#define DIRECTIONS 32
+#define RUNS 100
+
+int main() {
+	DT_vector v;
+	DT_individuum A, B;
+	DT_point S;
+	DT_int i, r, worse = 0;
+	clock_t t0;
+	double tEvo = 0, tSp = 0;
+
+	printf("dir\tv.x\tv.y\tF(EA)\tF(EA,exakt)\tF(SP)\tF(SP,exakt)\n");
+	for (i = 0; i < DIRECTIONS; i++) {
+		v.x = 10 * cos(2 * M_PI * i / DIRECTIONS);
+		v.y = 10 * sin(2 * M_PI * i / DIRECTIONS);
+
+		t0 = clock();
+		for (r = 0; r < RUNS; r++)
+			A = evolutionaryAlgorithm(10, 5, &v);
+		tEvo += (double) (clock() - t0) / CLOCKS_PER_SEC;
+
+		t0 = clock();
+		for (r = 0; r < RUNS; r++)
+			B = SP_calcStartPoint(&v);
+		tSp += (double) (clock() - t0) / CLOCKS_PER_SEC;
+
+		DT_real fA = SP_scorePoint(&v, &A.G, &S);
+		DT_real fB = SP_scorePoint(&v, &B.G, &S);
+
+		printf("%d\t%6.2f\t%6.2f\t%7.3f\t%7.3f\t\t%7.3f\t%7.3f\n", i, v.x, v.y,
+				A.F, fA, B.F, fB);
+		if (fB < fA || fabs(fB - B.F) > 0.01)
+			worse++;
+	}
+	printf("\nLaufzeit EA: %f s, SP: %f s, Faktor: %.0f\n", tEvo, tSp, tEvo
+			/ tSp);
+	if (evolutionaryAlgorithm(EVO_MAX_POPSIZE + 1, 5, &v).F >= 0) {
+		printf("FEHLER: Population über EVO_MAX_POPSIZE angenommen\n");
+		worse++;
+	}
+	printf("%s (%d von %d Richtungen schlechter)\n", worse == 0 ? "OK"
+			: "FEHLER", worse, DIRECTIONS);
+	return worse;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,53 @@
+/**
+ * \file	testStartPointSearch.c
+ *
+ * \brief	Testprogramm für die unterbrechbare Startpunktsuche (Host).
+ *
+ * 			Führt die Suche für verschiedene Bewegungsrichtungen in Zeitscheiben
+ * 			aus und protokolliert nach jeder Scheibe Rechenzeit, Generation und
+ * 			exakte Güte im Verhältnis zum Optimum (SP_calcStartPoint) als CSV.
+ * 			Prüft, dass das Ergebnis zwischen den Scheiben nie schlechter wird.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include "include/evolutionaryHelper.h"
+#include "include/startPoint.h"
+#include "include/startPointSearch.h"
+
+#define DIRECTIONS 8
+#define SLICE_US 20
+
+int main() {
+	DT_sps sps;
+	DT_vector v;
+	DT_individuum A, B;
+	DT_point S;
+	DT_int i, errors = 0;
+	DT_bool running;
+
+	printf("dir;t_us;gen;quality\n");
+	for (i = 0; i < DIRECTIONS; i++) {
+		v.x = 10 * cos(2 * M_PI * i / DIRECTIONS);
+		v.y = 10 * sin(2 * M_PI * i / DIRECTIONS);
+		B = SP_calcStartPoint(&v);
+		SPS_init(&sps, &v);
+		DT_real last = -1;
+		do {
+			running = SPS_step(&sps, SLICE_US);
+			A = SPS_best(&sps);
+			if (A.F < last)
+				errors++;
+			last = A.F;
+			printf("%d;%lu;%d;%f\n", i, (unsigned long) sps.elapsed_us,
+					sps.evo.generation, SP_scorePoint(&v, &A.G, &S) / B.F);
+		} while (running);
+	}
+	printf("%s (%d Verschlechterungen)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,190 @@
+/**
+ * \file	testSync.c
+ *
+ * \brief	Testprogramm für den Abgleich der Uhren und COM_ACTION_AT (Host).
+ *
+ * 			Prüft die Pakete von COM_syncClocks() und COM_sendActionAt(), die
+ * 			Schätzung von Versatz und Gang aus Paketen mit bekannter Verzögerung
+ * 			(COM_onSync(), COM_toLocalUs()), XM_setAlarm() und MV_actionAt() am
+ * 			emulierten Servo-Bus: alle Servos führen ACTION nach dem Zeitpunkt aus.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <string.h>
+#include "include/communication.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define OFFSET		5000 /**< Zeit des Masters - Zeit des Slaves beim ersten Abgleich. */
+#define DRIFT		50 /**< Gang der Uhr des Masters in ppm. */
+#define LATE_US		1000 /**< Größte Verspätung einer ACTION auf dem Host. */
+
+DT_byte sent[COM_SYNC_BURST + 1][16];
+DT_int sentCnt = 0;
+DT_int fired = 0;
+uint32_t fired_us;
+DT_int actions = 0;
+uint32_t firstAction_us, lastAction_us;
+
+/**
+ * \brief	Merkt sich die Pakete des Masters an Slave 3F.
+ */
+void capture(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	(void) usart_data;
+	if (sentCnt <= COM_SYNC_BURST && l <= sizeof(sent[0]))
+		memcpy(sent[sentCnt++], data, l);
+}
+
+void onAlarm() {
+	fired++;
+	fired_us = XM_getUptimeUs();
+}
+
+void onAction(DT_byte id) {
+	const uint32_t us = XM_getUptimeUs();
+	(void) id;
+	if (actions++ == 0)
+		firstAction_us = us;
+	lastAction_us = us;
+}
+
+/**
+ * \brief	Übergibt einen Abgleich an COM_onSync().
+ *
+ * 			Paket seq wird zur eigenen Zeit local_us + seq * COM_SYNC_GAP_US mit
+ * 			der Verzögerung delays[seq] ausgewertet.
+ *
+ * \param	local_us	eigene Zeit des ersten Pakets
+ * \param	offset	Versatz der Uhr des Masters
+ * \param	delays	Verzögerung je Paket in us
+ * \param	skip	Folgenummer eines verlorenen Pakets oder COM_SYNC_BURST
+ */
+void burst(uint32_t local_us, int32_t offset, const uint32_t* const delays,
+		DT_byte skip) {
+	DT_byte packet[12], seq;
+	for (seq = 0; seq < COM_SYNC_BURST; seq++) {
+		const uint32_t local = local_us + seq * COM_SYNC_GAP_US;
+		const uint32_t master = local + offset - delays[seq];
+		if (seq == skip)
+			continue;
+		packet[0] = 0xFF;
+		packet[1] = 0xFF;
+		packet[2] = COM_BRDCAST_ID;
+		packet[3] = 8;
+		packet[4] = COM_SYNC;
+		packet[5] = master;
+		packet[6] = master >> 8;
+		packet[7] = master >> 16;
+		packet[8] = master >> 24;
+		packet[9] = seq;
+		COM_onSync(packet, sizeof(packet), local);
+	}
+}
+
+int main() {
+	const uint32_t delays[COM_SYNC_BURST] = { 40, 7, 90, 15 };
+	const DT_comClock* const clock = COM_getClock();
+	DT_leg leg_r, leg_l;
+	uint32_t t, local, master;
+	DT_int errors = 0, i;
+	DT_byte id;
+
+	XM_init_cpu();
+	XM_init_com(COM_MASTER);
+	XM_init_dnx();
+
+	// Pakete des Masters
+	XM_setTxHook(&XM_com_data3, capture);
+	t = XM_getUptimeUs();
+	COM_syncClocks();
+	CHECK(sentCnt == COM_SYNC_BURST)
+	for (i = 0; i < sentCnt; i++) {
+		CHECK(sent[i][2] == COM_BRDCAST_ID && sent[i][3] == 8 && sent[i][4]
+				== COM_SYNC && sent[i][9] == i)
+		if (i > 0)
+			CHECK(COM_getTimeFromPacket(sent[i]) - COM_getTimeFromPacket(
+					sent[i - 1]) >= COM_SYNC_GAP_US)
+	}
+	CHECK(COM_getTimeFromPacket(sent[0]) >= t + 12 * COM_BYTE_US)
+	sentCnt = 0;
+	COM_sendActionAt(COM_BRDCAST_ID, 0x12345678);
+	CHECK(sentCnt == 1 && sent[0][3] == 7 && sent[0][4] == COM_ACTION_AT)
+	CHECK(COM_getTimeFromPacket(sent[0]) == 0x12345678)
+	XM_setTxHook(&XM_com_data3, NULL);
+
+	// Ohne Abgleich gilt die eigene Zeit
+	CHECK(clock->syncs == 0 && COM_toLocalUs(123456) == 123456)
+
+	// Erster Abgleich: Paket mit der kleinsten Verzögerung
+	burst(1000000, OFFSET, delays, COM_SYNC_BURST);
+	CHECK(clock->syncs == 1 && clock->offset == OFFSET - 7 && clock->drift == 0)
+	CHECK(COM_toLocalUs(1500000 + OFFSET - 7) == 1500000)
+
+	// Unvollständiger Abgleich und falsche Länge werden verworfen
+	burst(1500000, OFFSET + 1000, delays, 2);
+	CHECK(clock->syncs == 1 && clock->offset == OFFSET - 7)
+	burst(1500000, OFFSET + 1000, delays, 0);
+	CHECK(clock->syncs == 1)
+	COM_onSync(sent[0], 11, 1600000);
+	CHECK(clock->syncs == 1 && clock->next == COM_SYNC_BURST)
+
+	// Zweiter Abgleich eine Sekunde später: Gang aus der Änderung des Versatzes
+	burst(2000000, OFFSET + DRIFT, delays, COM_SYNC_BURST);
+	CHECK(clock->syncs == 2 && clock->offset == OFFSET + DRIFT - 7)
+	CHECK(clock->drift == DRIFT)
+	local = 3000000;
+	master = local + clock->offset + DRIFT * (local - clock->local_us) / 1000000;
+	t = COM_toLocalUs(master);
+	printf("Versatz %ld us, Gang %ld ppm, Zeitpunkt %lu -> %lu (erwartet %lu)\n",
+			(long) clock->offset, (long) clock->drift, (unsigned long) master,
+			(unsigned long) t, (unsigned long) local);
+	CHECK(t - local + 1 <= 2)
+
+	// Zeitpunkt des Timers
+	t = XM_getUptimeUs() + 2000;
+	XM_setAlarm(t, onAlarm);
+	CHECK(fired == 0 && XM_isAlarmPending())
+	while (XM_isAlarmPending())
+		;
+	CHECK(fired == 1 && (int32_t) (fired_us - t) >= 0)
+	XM_setAlarm(XM_getUptimeUs() - 10, onAlarm);
+	CHECK(fired == 2 && !XM_isAlarmPending())
+
+	// ACTION an alle Servos zum Zeitpunkt, Zielpositionen vorher mit REG_WRITE
+	DNE_init(DNE_ALL_IDS);
+	DNE_setActionHook(onAction);
+	DNX_getConnectedIDs(&leg_r, &leg_l);
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		DNX_stage(id, 300 + id, DNX_SPEED_KEEP);
+	DNE_resetStats();
+	t = XM_getUptimeUs() + 3000;
+	MV_actionAt(&leg_r, &leg_l, t);
+	printf("ACTION an %d Servos: %ld bis %ld us nach dem Zeitpunkt\n", actions,
+			(long) (firstAction_us - t), (long) (lastAction_us - t));
+	CHECK(actions == DNX_MAX_ID)
+	CHECK((int32_t) (firstAction_us - t) >= 0 && (int32_t) (lastAction_us - t)
+			< LATE_US)
+	CHECK(DNE_getStats(&XM_servo_data_R)->replies == 0
+			&& DNE_getStats(&XM_servo_data_L)->replies == 0)
+	for (id = 1; id <= DNX_MAX_ID; id++)
+		CHECK(DNE_readWord(id, DNX_GL_POS) == 300 + id && DNE_readByte(id,
+				DNX_REG_INST) == 0)
+
+	// Zeitpunkt zu weit entfernt (Uhr nicht abgeglichen): sofort
+	actions = 0;
+	t = XM_getUptimeUs();
+	MV_actionAt(&leg_r, &leg_l, t + 60000000);
+	CHECK(actions == DNX_MAX_ID && XM_getUptimeUs() - t < 60000000)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
@@ -0,0 +1,118 @@
+/**
+ * \file	testTicks.c
+ *
+ * \brief	Vergleich der Zielpositionen aus der inversen Kinematik (Host).
+ *
+ * 			Rechnet für ein Raster von Punkten im Arbeitsraum eines Beines die
+ * 			Winkel mit KIN_calcServos() und vergleicht für alle 18 Servos
+ * 			CAL_radToTicks() mit der Rechnung vor der Kalibrierung
+ * 			(floor(3.41 * x) nach DNX_correctAngles() und DNX_convertAngle()).
+ * 			Beide müssen bitgleich sein. Zum Schluss wird geprüft, dass MV_point() diese
+ * 			Positionen unverändert an die emulierten Servos sendet. Wird für jede
+ * 			Zahlendarstellung übersetzt (testTicks, testTicksFloat32).
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include "include/calibration.h"
+#include "include/dynamixel.h"
+#include "include/dnxEmulator.h"
+#include "include/kinematics.h"
+#include "include/movement.h"
+#include "include/utils.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+#define MIN_RADIUS 60 /**< KIN_calcServos() setzt den Fuß außerhalb von DIST_HK voraus. */
+
+/**
+ * \brief	Rechnung aus DNX_correctAngles(), DNX_convertAngle() und DNX_setAngle() vor calibration.c.
+ */
+DT_int legacyTicks(DT_byte id, DT_real value) {
+	if ((id - 1) % 6 != 1 && (id - 1) % 6 != 5)
+		value = 360 - value;
+	value += 150;
+	if (value >= 360)
+		value -= 360;
+	return floor(3.41 * ((double) value));
+}
+
+/**
+ * \brief	Setzt die IDs eines Beines ab der Hüfte.
+ */
+void setIds(DT_leg* const leg, DT_byte hip) {
+	leg->hip.id = hip;
+	leg->knee.id = hip + 1;
+	leg->foot.id = hip + 2;
+}
+
+int main() {
+	const DT_servo* servos[3];
+	DT_leg leg;
+	DT_point p;
+	DT_byte hip, j;
+	DT_int errors = 0, points = 0, angles = 0, legacyDiffs = 0, sent = 0,
+			sentDiffs = 0;
+
+	XM_init_cpu();
+	XM_init_dnx();
+	CAL_init();
+
+	for (p.x = 40; p.x <= 140; p.x += 2.5)
+		for (p.y = -80; p.y <= 80; p.y += 2.5)
+			for (p.z = -150.25; p.z <= -60; p.z += 3.75) {
+				if (p.x * p.x + p.y * p.y < MIN_RADIUS * MIN_RADIUS
+						|| !KIN_calcServos(&p, &leg))
+					continue;
+				points++;
+				servos[0] = &leg.hip;
+				servos[1] = &leg.knee;
+				servos[2] = &leg.foot;
+				for (hip = 1; hip <= CAL_SERVOS; hip += 3) {
+					for (j = 0; j < 3; j++) {
+						const DT_byte id = hip + j;
+						const DT_real rad = servos[j]->set_value;
+						const uint16_t ticks = CAL_radToTicks(id, rad);
+						angles++;
+						if (ticks != legacyTicks(id, UTL_getDegree(rad)))
+							legacyDiffs++;
+					}
+				}
+			}
+	printf("%d Punkte, %d Winkel: %d abweichend von floor(3.41 * x)\n", points,
+			angles, legacyDiffs);
+	CHECK(points > 10000)
+	CHECK(legacyDiffs == 0)
+
+	// MV_point() sendet die Positionen unverändert
+	DNE_init(DNE_ALL_IDS);
+	for (hip = 1; hip <= CAL_SERVOS; hip += 3) {
+		setIds(&leg, hip);
+		for (p.x = 40; p.x <= 140; p.x += 10)
+			for (p.y = -80; p.y <= 80; p.y += 10)
+				for (p.z = -150.25; p.z <= -60; p.z += 15) {
+					if (p.x * p.x + p.y * p.y < MIN_RADIUS * MIN_RADIUS
+							|| !MV_point(&leg, &p, false))
+						continue;
+					MV_action(&leg, &leg);
+					sent++;
+					if (DNE_readWord(leg.hip.id, DNX_GL_POS) != CAL_degToTicks(
+							leg.hip.id, UTL_getDegree(leg.hip.set_value))
+							|| DNE_readWord(leg.knee.id, DNX_GL_POS)
+									!= leg.knee.ticks || DNE_readWord(
+							leg.foot.id, DNX_GL_POS) != leg.foot.ticks)
+						sentDiffs++;
+				}
+	}
+	printf("MV_point(): %d Punkte, %d abweichend\n", sent, sentDiffs);
+	CHECK(sent > 1000)
+	CHECK(sentDiffs == 0)
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
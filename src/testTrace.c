@@ -0,0 +1,94 @@
+/**
+ * \file	testTrace.c
+ *
+ * \brief	Testprogramm für das Ereignisprotokoll (Host).
+ *
+ * 			Prüft den Ringpuffer und die Weitergabe der Korrelations-ID in den
+ * 			COM-Paketen, Zeitstempel über den Überlauf der 16-Bit-Zeitbasis hinaus
+ * 			und die Ausgabe mit COM_TRACE. Der Slave wird über den Sende-Empfänger
+ * 			von XM_com_data3 im selben Prozess mit COM_receive() und
+ * 			MV_slaveStatus() bedient.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include "include/trace.h"
+#include "include/communication.h"
+#include "include/movement.h"
+#include "include/xmega.h"
+#include "include/test.h"
+
+DT_byte sentCorr;
+
+/**
+ * \brief	Empfängt Anfragen als Slave und gibt Antworten an den Master zurück.
+ */
+void loopback(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	DT_byte result[DT_RESULT_BUFFER_SIZE];
+	DT_size i, len;
+	sentCorr = data[l - 2];
+	for (i = 0; i < l; i++)
+		XM_receiveByte(usart_data, data[i]);
+	if (data[4] == COM_STATUS) {
+		len = COM_receive(usart_data, result);
+		MV_slaveStatus(result, len);
+	}
+}
+
+int main() {
+	const DT_byte expected[][2] = { { TRC_CMD_BUILT, COM_SLAVE3F }, {
+			TRC_FRAME_SENT, COM_SLAVE3F }, { TRC_FRAME_RECEIVED, COM_MASTER }, {
+			TRC_CMD_BUILT, COM_MASTER }, { TRC_FRAME_SENT, COM_MASTER }, {
+			TRC_FRAME_RECEIVED, COM_SLAVE3F } };
+	DT_size i;
+	uint32_t start;
+	DT_int errors = 0;
+
+	// Ringpuffer: älteste Ereignisse werden überschrieben
+	TRC_init(COM_MASTER);
+	CHECK(TRC_count() == 0 && TRC_getCorrelation() == 0)
+	for (i = 0; i < TRC_SIZE + 10; i++)
+		TRC_event(TRC_SERVO_SENT, i);
+	CHECK(TRC_count() == TRC_SIZE)
+	CHECK(TRC_get(0)->arg == 10 && TRC_get(TRC_SIZE - 1)->arg == TRC_SIZE + 9)
+
+	// Korrelations-ID in Anfrage und Antwort
+	TRC_init(COM_MASTER);
+	XM_init_com(COM_MASTER);
+	XM_setTxHook(&XM_com_data3, loopback);
+	TRC_setCorrelation(7);
+	CHECK(COM_isAlive(COM_SLAVE3F))
+	CHECK(sentCorr == 7 && TRC_getCorrelation() == 7)
+	CHECK(TRC_count() == 6)
+	for (i = 0; i < 6 && i < TRC_count(); i++) {
+		CHECK(TRC_get(i)->corr == 7)
+		CHECK(TRC_get(i)->event == expected[i][0] && TRC_get(i)->arg
+				== expected[i][1])
+	}
+
+	// Ausgabe des Slaves mit COM_TRACE, vor dem Broadcast, dessen Echo
+	// niemand abholt
+	CHECK(COM_requestTrace(COM_SLAVE3F))
+
+	// ACTION beendet den Schritt
+	COM_sendAction(COM_BRDCAST_ID);
+	CHECK(sentCorr == 7 && TRC_getCorrelation() == 8)
+
+	// 32-Bit-Zeitstempel
+	TRC_init(COM_MASTER);
+	TRC_event(TRC_ACTION, 0);
+	start = XM_getUptimeUs();
+	while ((uint32_t) (XM_getUptimeUs() - start) < 70000)
+		;
+	TRC_event(TRC_ACTION, 0);
+	CHECK(TRC_get(1)->t - TRC_get(0)->t >= 70000)
+	TRC_dump();
+
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
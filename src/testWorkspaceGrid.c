@@ -0,0 +1,96 @@
+/**
+ * \file	testWorkspaceGrid.c
+ *
+ * \brief	Testprogramm für das Belegungsraster des Arbeitsraums (Host).
+ *
+ * 			Prüft WS_isInAreaFast() gegen WS_isInAreaExact() für zufällige Punkte,
+ * 			zählt die Abweichungen von isInArea() und misst die Laufzeiten.
+ * 			Prüft außerdem, dass WS_samplePoint() nur gültige Punkte liefert und
+ * 			denselben Schwerpunkt wie Verwerfungsstichproben hat.
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "include/evolutionaryHelper.h"
+#include "include/workspaceGrid.h"
+
+#define SAMPLES 1000000
+#define MAX_CENTER_ERROR 0.2
+
+int main() {
+	static DT_point P[SAMPLES];
+	DT_rng rng;
+	DT_point p;
+	DT_int i, errors = 0, diffLegacy = 0, cnt = 0;
+	DT_real sx = 0, sy = 0, rx = 0, ry = 0;
+	clock_t t0;
+	double tLegacy, tExact, tFast, tSample, tReject;
+
+	initEvoAlg();
+	rngSeed(&rng, 1);
+	for (i = 0; i < SAMPLES; i++) {
+		P[i].x = rngRange(&rng, -90, 90);
+		P[i].y = rngRange(&rng, 35, 135);
+		P[i].z = Z;
+		if (WS_isInAreaFast(&P[i]) != WS_isInAreaExact(&P[i]))
+			errors++;
+		if (isInArea(&P[i]) != WS_isInAreaExact(&P[i]))
+			diffLegacy++;
+	}
+
+	t0 = clock();
+	for (i = 0; i < SAMPLES; i++)
+		cnt += isInArea(&P[i]);
+	tLegacy = (double) (clock() - t0) / CLOCKS_PER_SEC;
+	t0 = clock();
+	for (i = 0; i < SAMPLES; i++)
+		cnt += WS_isInAreaExact(&P[i]);
+	tExact = (double) (clock() - t0) / CLOCKS_PER_SEC;
+	t0 = clock();
+	for (i = 0; i < SAMPLES; i++)
+		cnt += WS_isInAreaFast(&P[i]);
+	tFast = (double) (clock() - t0) / CLOCKS_PER_SEC;
+
+	// Stichproben: Raster gegen Verwerfen im Rechteck wie generatePoint()
+	t0 = clock();
+	for (i = 0; i < SAMPLES; i++) {
+		p = WS_samplePoint(&rng);
+		if (!WS_isInAreaExact(&p))
+			errors++;
+		sx += p.x;
+		sy += p.y;
+	}
+	tSample = (double) (clock() - t0) / CLOCKS_PER_SEC;
+	t0 = clock();
+	for (i = 0; i < SAMPLES; i++) {
+		do {
+			p.x = rngRange(&rng, WS_X_MIN, WS_X_MIN + WS_COLS * WS_CELL);
+			p.y = rngRange(&rng, WS_Y_MIN, WS_Y_MIN + WS_ROWS * WS_CELL);
+		} while (!isInArea(&p));
+		rx += p.x;
+		ry += p.y;
+	}
+	tReject = (double) (clock() - t0) / CLOCKS_PER_SEC;
+	DT_real centerError = hypot((sx - rx) / SAMPLES, (sy - ry) / SAMPLES);
+	if (centerError > MAX_CENTER_ERROR)
+		errors++;
+
+	printf("Raster: %d x %d Zellen, %u Byte\n", WS_COLS, WS_ROWS,
+			(unsigned) (sizeof(WS_inside) + sizeof(WS_boundary)
+					+ sizeof(WS_rowStart)));
+	printf("Abweichungen isInArea(): %d von %d\n", diffLegacy, SAMPLES);
+	printf("Laufzeit isInArea: %f us, exakt: %f us, Raster: %f us\n", 1e6
+			* tLegacy / SAMPLES, 1e6 * tExact / SAMPLES, 1e6 * tFast / SAMPLES);
+	printf("Laufzeit Stichprobe Raster: %f us, Verwerfen: %f us\n", 1e6
+			* tSample / SAMPLES, 1e6 * tReject / SAMPLES);
+	printf("Schwerpunkt Raster (%f, %f), Verwerfen (%f, %f)\n", sx / SAMPLES, sy
+			/ SAMPLES, rx / SAMPLES, ry / SAMPLES);
+	printf("%s (%d Fehler)\n", errors == 0 ? "OK" : "FEHLER", errors);
+	return errors;
+}
+
+#endif /* TEST_ON */
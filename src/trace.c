@@ -0,0 +1,119 @@
+/**
+ * \file	trace.c
+ *
+ * \brief	Ereignisprotokoll mit Korrelations-ID für die Latenz eines Schritts.
+ *
+ * 			Ausgabe von TRC_dump() je Ereignis als eine Zeile, älteste zuerst:
+ *
+ * 			TRC <Controller> <Korrelations-ID> <Ereignis> <Argument> <Zeit in us>
+ */
+
+#include "include/trace.h"
+#include "include/xmega.h"
+#include "include/utils.h"
+
+DT_trcEvent TRC_ring[TRC_SIZE];
+DT_byte TRC_head = 0;
+DT_byte TRC_cnt = 0;
+DT_byte TRC_corr = 0;
+DT_byte TRC_cpuID = 0;
+
+/**
+ * \brief	Leert den Ringpuffer.
+ *
+ * \param	cpuID	ID des Controllers für TRC_dump()
+ */
+void TRC_init(DT_byte cpuID) {
+	TRC_cpuID = cpuID;
+	TRC_head = 0;
+	TRC_cnt = 0;
+	TRC_corr = 0;
+}
+
+/**
+ * \brief	Liefert die Korrelations-ID des aktuellen Schritts.
+ *
+ * \return	Korrelations-ID
+ */
+DT_byte TRC_getCorrelation() {
+	return TRC_corr;
+}
+
+/**
+ * \brief	Übernimmt die Korrelations-ID eines empfangenen Pakets.
+ *
+ * \param	corr	Korrelations-ID
+ */
+void TRC_setCorrelation(DT_byte corr) {
+	TRC_corr = corr;
+}
+
+/**
+ * \brief	Beginnt einen neuen Schritt (Master).
+ */
+void TRC_next() {
+	TRC_corr++;
+}
+
+/**
+ * \brief	Schreibt ein Ereignis mit der aktuellen Korrelations-ID in den Ringpuffer.
+ *
+ * 			Ist der Ringpuffer voll, wird das älteste Ereignis überschrieben.
+ *
+ * \param	event	Ereignis (TRC_CMD_BUILT, ...)
+ * \param	arg		Argument
+ */
+void TRC_event(DT_byte event, DT_byte arg) {
+	DT_trcEvent* const e = &TRC_ring[TRC_head];
+	e->t = XM_getUptimeUs();
+	e->corr = TRC_corr;
+	e->event = event;
+	e->arg = arg;
+	TRC_head = (TRC_head + 1) & (TRC_SIZE - 1);
+	if (TRC_cnt < TRC_SIZE)
+		TRC_cnt++;
+}
+
+/**
+ * \brief	Liefert die Anzahl der Ereignisse im Ringpuffer.
+ *
+ * \return	Anzahl (max. TRC_SIZE)
+ */
+DT_byte TRC_count() {
+	return TRC_cnt;
+}
+
+/**
+ * \brief	Liefert ein Ereignis aus dem Ringpuffer.
+ *
+ * \param	i	Index, 0 ist das älteste Ereignis
+ *
+ * \return	Ereignis
+ */
+const DT_trcEvent* TRC_get(DT_byte i) {
+	return &TRC_ring[(TRC_head - TRC_cnt + i) & (TRC_SIZE - 1)];
+}
+
+/**
+ * \brief	Gibt alle Ereignisse auf der Debug-USART aus.
+ */
+void TRC_dump() {
+	DT_byte i;
+	for (i = 0; i < TRC_cnt; i++) {
+		const DT_trcEvent* const e = TRC_get(i);
+		XM_debugPutChar('T');
+		XM_debugPutChar('R');
+		XM_debugPutChar('C');
+		XM_debugPutChar(' ');
+		UTL_printNumber(TRC_cpuID);
+		XM_debugPutChar(' ');
+		UTL_printNumber(e->corr);
+		XM_debugPutChar(' ');
+		UTL_printNumber(e->event);
+		XM_debugPutChar(' ');
+		UTL_printNumber(e->arg);
+		XM_debugPutChar(' ');
+		UTL_printNumber(e->t);
+		XM_debugPutChar('\n');
+	}
+}
@@ -0,0 +1,181 @@
+/**
+ * \file	traceMerge.c
+ *
+ * \brief	Zusammenführung der Ereignisprotokolle von Master und Slaves (Host).
+ *
+ * 			Liest die Ausgabe von TRC_dump() aller Controller von stdin (andere
+ * 			Zeilen werden ignoriert) und gibt je Korrelations-ID eine Zeitleiste
+ * 			in der Zeitbasis des Masters aus.
+ *
+ * 			Der Versatz der Uhr eines Slaves wird aus den Paketen in beiden
+ * 			Richtungen geschätzt: d1 = Empfang Slave - Senden Master und
+ * 			d2 = Empfang Master - Senden Slave. Mit den kleinsten Werten (geringste
+ * 			Wartezeit) ist der Versatz (d1 - d2) / 2 und die Laufzeit (d1 + d2) / 2.
+ * 			Die Zeitstempel sind die Zeit seit dem Start des Controllers
+ * 			(XM_getUptimeUs()), der Versatz enthält daher auch den Unterschied der
+ * 			Startzeiten.
+ *
+ * 			traceMerge < master.log slave1B.log slave3F.log
+ * 			simCom 5 0 0 0 1 | traceMerge
+ */
+
+#define TEST_OFF
+#ifdef TEST_ON
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "include/communication.h"
+#include "include/trace.h"
+
+#define MAX_EVENTS 1024
+#define CPUS 4
+
+/** \brief Ereignis mit fortlaufender Zeit eines Controllers. */
+typedef struct {
+	int cpu, corr, event, arg;
+	int64_t t; /**< Zeit in us ohne Überlauf, später in der Zeitbasis des Masters. */
+} DT_mergeEvent;
+
+DT_mergeEvent events[MAX_EVENTS];
+int eventCnt = 0;
+
+const char* const EVENT_NAMES[] = { "?", "CMD_BUILT", "FRAME_SENT",
+		"FRAME_RECEIVED", "IK_DONE", "SERVO_SENT", "ACTION" };
+
+const char* cpuName(int cpu) {
+	switch (cpu) {
+	case COM_MASTER:
+		return "Master";
+	case COM_SLAVE1B:
+		return "1B";
+	case COM_SLAVE3F:
+		return "3F";
+	case COM_BRDCAST_ID:
+		return "alle";
+	default:
+		return "?";
+	}
+}
+
+/**
+ * \brief	Liefert das k-te Ereignis eines Controllers mit Korrelations-ID und Filter.
+ *
+ * \return	Index oder -1
+ */
+int findEvent(int cpu, int corr, int event, int arg1, int arg2, int k) {
+	int i;
+	for (i = 0; i < eventCnt; i++)
+		if (events[i].cpu == cpu && events[i].corr == corr && events[i].event
+				== event && (events[i].arg == arg1 || events[i].arg == arg2)
+				&& k-- == 0)
+			return i;
+	return -1;
+}
+
+/**
+ * \brief	Schätzt den Versatz der Uhr eines Slaves zur Uhr des Masters.
+ *
+ * \return	Versatz in us (Slave - Master)
+ */
+int64_t estimateOffset(int slave) {
+	int64_t d1 = INT64_MAX, d2 = INT64_MAX, d;
+	int corr, k, m, s;
+	for (corr = 0; corr < 256; corr++) {
+		// Master -> Slave (auch Broadcasts)
+		for (k = 0; (m = findEvent(COM_MASTER, corr, TRC_FRAME_SENT, slave,
+				COM_BRDCAST_ID, k)) >= 0 && (s = findEvent(slave, corr,
+				TRC_FRAME_RECEIVED, COM_MASTER, COM_MASTER, k)) >= 0; k++) {
+			d = events[s].t - events[m].t;
+			if (d < d1)
+				d1 = d;
+		}
+		// Slave -> Master
+		for (k = 0; (s = findEvent(slave, corr, TRC_FRAME_SENT, COM_MASTER,
+				COM_MASTER, k)) >= 0 && (m = findEvent(COM_MASTER, corr,
+				TRC_FRAME_RECEIVED, slave, slave, k)) >= 0; k++) {
+			d = events[m].t - events[s].t;
+			if (d < d2)
+				d2 = d;
+		}
+	}
+	if (d1 != INT64_MAX && d2 != INT64_MAX) {
+		printf("Slave %s: Versatz %lld us, Laufzeit %lld us\n", cpuName(slave),
+				(long long) (d1 - d2) / 2, (long long) (d1 + d2) / 2);
+		return (d1 - d2) / 2;
+	} else if (d1 != INT64_MAX) {
+		printf("Slave %s: Versatz %lld us (ohne Antworten, Laufzeit 0 angenommen)\n",
+				cpuName(slave), (long long) d1);
+		return d1;
+	}
+	printf("Slave %s: kein gemeinsames Paket, Versatz 0\n", cpuName(slave));
+	return 0;
+}
+
+int compareEvents(const void* a, const void* b) {
+	const DT_mergeEvent* const x = a;
+	const DT_mergeEvent* const y = b;
+	if (x->corr != y->corr)
+		return x->corr - y->corr;
+	return x->t < y->t ? -1 : x->t > y->t;
+}
+
+int main() {
+	char line[128];
+	unsigned int cpu, corr, event, arg;
+	unsigned long t;
+	int64_t unwrapped[CPUS] = { 0 }, offset[CPUS] = { 0 }, start = 0;
+	uint32_t last[CPUS] = { 0 };
+	int seen[CPUS] = { 0 };
+	int i, c;
+
+	while (fgets(line, sizeof(line), stdin) != NULL && eventCnt < MAX_EVENTS) {
+		if (sscanf(line, "TRC %u %u %u %u %lu", &cpu, &corr, &event, &arg, &t)
+				!= 5 || cpu >= CPUS || event > TRC_ACTION)
+			continue;
+		// Überlauf der 32-Bit-Zeitbasis je Controller entfernen
+		if (!seen[cpu])
+			unwrapped[cpu] = t;
+		else
+			unwrapped[cpu] += (uint32_t) (t - last[cpu]);
+		seen[cpu] = 1;
+		last[cpu] = t;
+		events[eventCnt].cpu = cpu;
+		events[eventCnt].corr = corr;
+		events[eventCnt].event = event;
+		events[eventCnt].arg = arg;
+		events[eventCnt].t = unwrapped[cpu];
+		eventCnt++;
+	}
+	if (eventCnt == 0 || !seen[COM_MASTER]) {
+		fprintf(stderr, "Keine TRC-Zeilen des Masters gefunden\n");
+		return 1;
+	}
+
+	// In die Zeitbasis des Masters umrechnen
+	for (c = 0; c < CPUS; c++)
+		if (c != COM_MASTER && seen[c])
+			offset[c] = estimateOffset(c);
+	for (i = 0; i < eventCnt; i++)
+		events[i].t -= offset[events[i].cpu];
+
+	qsort(events, eventCnt, sizeof(DT_mergeEvent), compareEvents);
+
+	for (i = 0; i < eventCnt; i++) {
+		if (i == 0 || events[i].corr != events[i - 1].corr) {
+			start = events[i].t;
+			printf("\nSchritt %d\n", events[i].corr);
+		}
+		printf("  %+8lld us  %-6s  %-14s", (long long) (events[i].t - start),
+				cpuName(events[i].cpu), EVENT_NAMES[events[i].event]);
+		if (events[i].event == TRC_IK_DONE || events[i].event == TRC_SERVO_SENT)
+			printf("  Servo %d\n", events[i].arg);
+		else if (events[i].event == TRC_ACTION)
+			printf("\n");
+		else
+			printf("  %s\n", cpuName(events[i].arg));
+	}
+	return 0;
+}
+
+#endif /* TEST_ON */
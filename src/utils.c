@@ -25,7 +25,7 @@
  * \param	rows	Zeilenanzahl
  * \param	columns	Spaltenanzahl
  */
-void UTL_printMatrix(const DT_double** const mat, DT_size rows, DT_size columns) {
+void UTL_printMatrix(const DT_real** const mat, DT_size rows, DT_size columns) {
 	DT_size r, c;
 	DT_char sep;
 	printf("> DH04:\n");
@@ -76,8 +76,8 @@ void UTL_printPoint(const DT_point* const p) {
  *
  * \return	In das Bogenmaß umgerechneter Winkel
  */
-DT_double UTL_getRadiant(DT_double angle) {
-	return angle * (M_PI / 180);
+DT_real UTL_getRadiant(DT_real angle) {
+	return angle * UTL_RAD_PER_DEG;
 }
 
 /**
@@ -89,8 +89,8 @@ DT_double UTL_getRadiant(DT_double angle) {
  *
  * \return	In das Gradmaß umgerechneter Winkel
  */
-DT_double UTL_getDegree(DT_double radiant) {
-	return (radiant * 180) / M_PI;
+DT_real UTL_getDegree(DT_real radiant) {
+	return radiant * UTL_DEG_PER_RAD;
 }
 
 /**
@@ -102,7 +102,7 @@ DT_double UTL_getDegree(DT_double radiant) {
  *
  * \return	Extrahierter Punkt
  */
-DT_point UTL_getPointOfDH(const DT_double** const dh) {
+DT_point UTL_getPointOfDH(const DT_real** const dh) {
 	DT_point p;
 	p.x = dh[0][3];
 	p.y = dh[1][3];
@@ -110,6 +110,36 @@ DT_point UTL_getPointOfDH(const DT_double** const dh) {
 	return p;
 }
 
+/**
+ * \brief	Umrechnung in Festkomma Q16.16.
+ *
+ * 			Rundet auf das nächste Vielfache von 1/65536 und begrenzt auf den
+ * 			Wertebereich von DT_q16.
+ *
+ * \param	value	Wert
+ *
+ * \return	Wert in Q16.16
+ */
+DT_q16 UTL_realToQ16(DT_real value) {
+	const DT_real scaled = value * 65536;
+	if (scaled >= (DT_real) INT32_MAX)
+		return INT32_MAX;
+	if (scaled <= (DT_real) INT32_MIN)
+		return INT32_MIN;
+	return (DT_q16) (scaled < 0 ? scaled - (DT_real) 0.5 : scaled + (DT_real) 0.5);
+}
+
+/**
+ * \brief	Umrechnung aus Festkomma Q16.16.
+ *
+ * \param	value	Wert in Q16.16
+ *
+ * \return	Wert
+ */
+DT_real UTL_q16ToReal(DT_q16 value) {
+	return value / (DT_real) 65536;
+}
+
 /**
  * \brief	Debug-Ausgabe.
  *
@@ -121,25 +151,59 @@ DT_point UTL_getPointOfDH(const DT_double** const dh) {
 void UTL_printDebug(const DT_char* const msg, DT_size size) {
 	DT_size i;
 #ifdef USART_ON
-	while (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
-		;
-	for (i = 0; i < size; i++) {
-		USART_PutChar(XM_debug_data.usart, msg[i]);
-		while (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
-			;
-	}
-	USART_PutChar(XM_debug_data.usart, ';');
-	while (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
-				;
-	USART_PutChar(XM_debug_data.usart, 0x00);
-	while (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
-		;
+	for (i = 0; i < size; i++)
+		XM_debugPutChar(msg[i]);
+	XM_debugPutChar(';');
+	XM_debugPutChar(0x00);
 #else
 	for (i = 0; i < size; i++)
 	printf("%c;", msg[i]);
 #endif
 }
 
+/**
+ * \brief	Debug-Ausgabe eines Textes aus dem Flash.
+ *
+ * 			Wie UTL_printDebug(), der Text wird zeichenweise aus dem Flash gelesen
+ * 			(DEBUG_P).
+ *
+ * \param	msg	Text im Flash (PSTR)
+ * \param	size	Länge des Textes
+ */
+void UTL_printDebugP(const DT_char* const msg, DT_size size) {
+	DT_size i;
+#ifdef USART_ON
+	for (i = 0; i < size; i++)
+		XM_debugPutChar(FL_readByte(&msg[i]));
+	XM_debugPutChar(';');
+	XM_debugPutChar(0x00);
+#else
+	for (i = 0; i < size; i++)
+	printf("%c;", FL_readByte(&msg[i]));
+#endif
+}
+
+/**
+ * \brief	Debug-Ausgabe einer Zahl in Dezimal ohne Trennzeichen.
+ *
+ * \param	n	Zahl
+ */
+void UTL_printNumber(uint32_t n) {
+	DT_char buf[11];
+	DT_byte i = sizeof(buf) - 1;
+	buf[i] = 0x00;
+	do {
+		buf[--i] = '0' + n % 10;
+		n /= 10;
+	} while (n > 0);
+#ifdef USART_ON
+	while (buf[i])
+		XM_debugPutChar(buf[i++]);
+#else
+	printf("%s", &buf[i]);
+#endif
+}
+
 /**
  * \brief	Debug-Ausgabe von Bytes.
  *
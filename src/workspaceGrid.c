@@ -0,0 +1,112 @@
+/**
+ * \file	workspaceGrid.c
+ *
+ * \brief	Belegungsraster des Arbeitsraums.
+ *
+ * 			WS_isInAreaFast() entscheidet für Zellen im Inneren oder außerhalb
+ * 			über ein Bit im Flash und rechnet nur in Randzellen exakt nach.
+ * 			WS_samplePoint() zieht gleichverteilt aus den inneren Zellen, ohne
+ * 			Punkte verwerfen zu müssen.
+ */
+
+#include "include/workspaceGrid.h"
+#include "include/evolutionaryHelper.h"
+#include <math.h>
+
+// lokale Methoden
+DT_bool WS_getBit(const uint8_t (*)[WS_ROW_BYTES], const DT_int, const DT_int);
+DT_byte WS_bitCount(uint8_t);
+
+/**
+ * \brief	Anzahl der gesetzten Bits je Halbbyte.
+ */
+const DT_byte WS_nibbleBits[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3,
+		3, 4 };
+
+DT_byte WS_bitCount(uint8_t bits) {
+	return WS_nibbleBits[bits & 0x0F] + WS_nibbleBits[bits >> 4];
+}
+
+DT_bool WS_getBit(const uint8_t(*bits)[WS_ROW_BYTES], const DT_int row,
+		const DT_int col) {
+	return (pgm_read_byte(&bits[row][col >> 3]) >> (col & 7)) & 1;
+}
+
+/**
+ * \brief	Exakte Prüfung, ob ein Punkt im Arbeitsraum liegt.
+ *
+ * 			Der Punkt muss oberhalb der Geraden AB und CD und zwischen den Kreisen
+ * 			CEA und DFB liegen. initEvoAlg() muss aufgerufen worden sein.
+ *
+ * \param	p	Punkt (Koordinatensystem des EA)
+ *
+ * \return	true, wenn p im Arbeitsraum liegt
+ */
+DT_bool WS_isInAreaExact(const DT_point* const p) {
+	DT_real sqr = p->x * p->x + p->y * p->y;
+	return p->y >= f_lin(&AB, p->x) && p->y >= f_lin(&CD, p->x) && sqr
+			>= CEA.sqr_r && sqr <= DFB.sqr_r;
+}
+
+/**
+ * \brief	Prüft über das Belegungsraster, ob ein Punkt im Arbeitsraum liegt.
+ *
+ * \param	p	Punkt (Koordinatensystem des EA)
+ *
+ * \return	true, wenn p im Arbeitsraum liegt
+ */
+DT_bool WS_isInAreaFast(const DT_point* const p) {
+	DT_real gx = (p->x - WS_X_MIN) / WS_CELL;
+	DT_real gy = (p->y - WS_Y_MIN) / WS_CELL;
+	if (gx < 0 || gx >= WS_COLS || gy < 0 || gy >= WS_ROWS)
+		return false;
+	DT_int col = (DT_int) gx;
+	DT_int row = (DT_int) gy;
+	if (WS_getBit(WS_inside, row, col))
+		return true;
+	if (WS_getBit(WS_boundary, row, col))
+		return WS_isInAreaExact(p);
+	return false;
+}
+
+/**
+ * \brief	Zieht einen gleichverteilten Punkt aus den inneren Zellen.
+ *
+ * 			Die Zeile wird über eine binäre Suche in WS_rowStart bestimmt, die
+ * 			Spalte durch Abzählen der Bits dieser Zeile. Randzellen werden nicht
+ * 			gezogen, der äußerste Saum des Arbeitsraums (< WS_CELL) fehlt daher.
+ *
+ * \param	rng	Zufallszahlengenerator
+ *
+ * \return	Punkt im Arbeitsraum (Koordinatensystem des EA)
+ */
+DT_point WS_samplePoint(DT_rng* const rng) {
+	DT_point p;
+	DT_int lo = 0, hi = WS_ROWS, mid, col = 0, byte;
+	uint16_t k = rngInt(rng, pgm_read_word(&WS_rowStart[WS_ROWS]));
+	// Letzte Zeile mit WS_rowStart[row] <= k
+	while (hi - lo > 1) {
+		mid = (lo + hi) / 2;
+		if (pgm_read_word(&WS_rowStart[mid]) <= k)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	k -= pgm_read_word(&WS_rowStart[lo]);
+	// k-te innere Zelle der Zeile, ganze Bytes werden übersprungen
+	for (byte = 0; byte < WS_ROW_BYTES; byte++) {
+		uint8_t bits = pgm_read_byte(&WS_inside[lo][byte]);
+		DT_byte cnt = WS_bitCount(bits);
+		if (k >= cnt) {
+			k -= cnt;
+			continue;
+		}
+		for (col = byte * 8; !(bits & 1) || k-- != 0; col++)
+			bits >>= 1;
+		break;
+	}
+	p.x = WS_X_MIN + (col + rngUniform(rng)) * WS_CELL;
+	p.y = WS_Y_MIN + (lo + rngUniform(rng)) * WS_CELL;
+	p.z = Z;
+	return p;
+}
@@ -11,8 +11,30 @@
 #include "include/avr_compiler.h"
 #include "include/communication.h"
 #include <avr/io.h>
+#include <avr/eeprom.h>
 #include <stdlib.h>
 
+/**
+ * \def	XM_TICK_US
+ * \brief	Dauer eines Ticks von TCC0 in us (Vorteiler 64 bei 32MHz).
+ *
+ * \def	XM_TICK_HIGH_MASK
+ * \brief	Gültige Bit von TCC1 in XM_getUptimeUs(), die Zeit in us hat 32 Bit.
+ */
+#define XM_TICK_US			2
+#define XM_TICK_HIGH_MASK	0x7FFF
+
+USART_data_t XM_servo_data_L;
+USART_data_t XM_servo_data_R;
+USART_data_t XM_debug_data;
+USART_data_t XM_remote_data;
+USART_data_t XM_com_data1;
+USART_data_t XM_com_data3;
+
+DT_alarmHook XM_alarmHook = NULL; /**< Methode von XM_setAlarm(). */
+volatile uint16_t XM_alarmHigh; /**< Obere 15 Bit des Zeitpunkts in Ticks (TCC1). */
+volatile DT_bool XM_alarmArmed = false;
+
 /**
  * \brief 	Initialisierung der CPU.
  */
@@ -99,7 +121,7 @@ void XM_init_cpu() {
 	USART_Tx_Enable(XM_debug_data.usart);
 
 	USART_GetChar(XM_debug_data.usart); // Flush Receive Buffer
-	DEBUG(("DEBUG-USART ... ON", sizeof("DEBUG-USART ... ON")));
+	DEBUG_P("DEBUG-USART ... ON")
 
 	// Init LED
 	XM_PORT_LED.DIRSET = XM_LED_MASK;
@@ -109,9 +131,154 @@ void XM_init_cpu() {
 	SWITCHPORT.DIRCLR = SWITCHMASK;
 	SWITCHPORT.PIN2CTRL |= (0b011 << 3); // Pullup PQ2 aktivieren
 
+	// Zeitbasis: TCC0 freilaufend mit 32MHz / 64 = 500kHz (1 Tick = XM_TICK_US),
+	// TCC1 zählt über Ereigniskanal 0 die Überläufe von TCC0 (obere 16 Bit)
+	EVSYS.CH0MUX = EVSYS_CHMUX_TCC0_OVF_gc;
+	TCC1.PER = 0xFFFF;
+	TCC1.CTRLA = TC_CLKSEL_EVCH0_gc;
+	TCC0.PER = 0xFFFF;
+	TCC0.CTRLA = TC_CLKSEL_DIV64_gc;
+
 	sei();
 }
 
+/**
+ * \brief 	Liefert die Zeitbasis in Mikrosekunden.
+ *
+ * 			Auflösung XM_TICK_US. Der Wert läuft alle 65,536ms über, Differenzen
+ * 			sind daher modulo 2^16 zu bilden (DT_size).
+ *
+ * \return	Zählerstand in us
+ */
+DT_size XM_getTimeUs() {
+	return TCC0.CNT * XM_TICK_US;
+}
+
+/**
+ * \brief 	Liefert die Zeit seit XM_init_cpu() in Mikrosekunden.
+ *
+ * 			Setzt TCC1 (Überläufe) und TCC0 zusammen und rechnet die Ticks in us
+ * 			um. Läuft ein Überlauf zwischen den beiden Lesezugriffen auf, wird
+ * 			erneut gelesen.
+ *
+ * \return	Zeit in us modulo 2^32 (ca. 71 Minuten)
+ */
+uint32_t XM_getUptimeUs() {
+	uint16_t high, low;
+	do {
+		high = TCC1.CNT;
+		low = TCC0.CNT;
+	} while (high != TCC1.CNT);
+	return (((uint32_t) high << 16) | low) * XM_TICK_US;
+}
+
+/**
+ * \brief 	Ruft eine Methode zu einem Zeitpunkt von XM_getUptimeUs() auf.
+ *
+ * 			Vergleichskanal A von TCC0 löst bei den unteren 16 Bit des Zeitpunkts
+ * 			in Ticks aus, die ISR prüft die oberen Bit (TCC1) und ruft die Methode
+ * 			auf. Der Zeitpunkt wird auf XM_TICK_US aufgerundet.
+ * 			Ein bereits vergangener Zeitpunkt löst sofort aus. Ein noch
+ * 			ausstehender Aufruf wird ersetzt.
+ *
+ * \param	us		Zeitpunkt in us (XM_getUptimeUs())
+ * \param	hook	Methode, wird in der ISR aufgerufen
+ */
+void XM_setAlarm(uint32_t us, DT_alarmHook hook) {
+	const uint8_t sreg = SREG;
+	const uint32_t ticks = (us + XM_TICK_US - 1) / XM_TICK_US;
+	DT_bool due;
+
+	cli();
+	XM_alarmHook = hook;
+	XM_alarmHigh = (ticks >> 16) & XM_TICK_HIGH_MASK;
+	TCC0.CCA = ticks & 0xFFFF;
+	TCC0.INTFLAGS = TC0_CCAIF_bm;
+	TCC0.CTRLB |= TC0_CCAEN_bm;
+	TCC0.INTCTRLB = (TCC0.INTCTRLB & ~TC0_CCAINTLVL_gm) | TC_CCAINTLVL_HI_gc;
+	PMIC.CTRL |= PMIC_HILVLEX_bm;
+	XM_alarmArmed = true;
+	// Vergleich kann kurz vor dem Zeitpunkt verpasst worden sein
+	due = (int32_t) (us - XM_getUptimeUs()) <= 0;
+	if (due) {
+		TCC0.INTCTRLB &= ~TC0_CCAINTLVL_gm;
+		XM_alarmArmed = false;
+	}
+	SREG = sreg;
+	if (due)
+		hook();
+}
+
+/**
+ * \brief 	Prüft, ob der Aufruf von XM_setAlarm() noch aussteht.
+ */
+DT_bool XM_isAlarmPending() {
+	return XM_alarmArmed;
+}
+
+/**
+ * \brief 	ISR für Vergleichskanal A von TCC0 (XM_setAlarm()).
+ */
+ISR(TCC0_CCA_vect)
+{
+	if ((TCC1.CNT & XM_TICK_HIGH_MASK) != XM_alarmHigh)
+		return;
+	TCC0.INTCTRLB &= ~TC0_CCAINTLVL_gm;
+	XM_alarmArmed = false;
+	XM_alarmHook();
+}
+
+/**
+ * \brief 	Gibt ein Zeichen blockierend auf der Debug-USART aus.
+ *
+ * \param	c	Zeichen
+ */
+void XM_debugPutChar(DT_char c) {
+	while (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
+		;
+	USART_PutChar(XM_debug_data.usart, c);
+	while (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
+		;
+}
+
+/**
+ * \brief 	Gibt ein Byte auf der Debug-USART aus, ohne zu warten.
+ *
+ * \param	c	Byte
+ *
+ * \return	false, wenn das Senderegister noch belegt ist
+ */
+DT_bool XM_debugTryPutChar(DT_byte c) {
+	if (!USART_IsTXDataRegisterEmpty(XM_debug_data.usart))
+		return false;
+	USART_PutChar(XM_debug_data.usart, c);
+	return true;
+}
+
+/**
+ * \brief 	Liest Bytes aus dem EEPROM.
+ *
+ * \param	addr	Adresse im EEPROM
+ * \param	dest	Ziel
+ * \param	l	Anzahl der Bytes
+ */
+void XM_eepromRead(DT_size addr, DT_byte* const dest, DT_size l) {
+	eeprom_read_block(dest, (const void*) addr, l);
+}
+
+/**
+ * \brief 	Schreibt Bytes in das EEPROM.
+ *
+ * 			Nur geänderte Bytes werden geschrieben (eeprom_update_block()).
+ *
+ * \param	addr	Adresse im EEPROM
+ * \param	src	Quelle
+ * \param	l	Anzahl der Bytes
+ */
+void XM_eepromWrite(DT_size addr, const DT_byte* const src, DT_size l) {
+	eeprom_update_block(src, (void*) addr, l);
+}
+
 /**
  * \brief 	Initialisiert den Zigbee-Fernsteuerung.
  */
@@ -309,8 +476,14 @@ void XM_USART_send(USART_data_t* const usart_data, const DT_byte* const txData,
 	if (usart_data->usart == &XM_USART_DEBUG)
 		return;
 
-	// Paketgröße, die später beim Empfangen abgezogen werden muss
-	usart_data->lastPacketLength = bytes;
+	// Echo, das beim Empfangen verworfen werden muss (nur Halbduplex-Servo-Bus).
+	// Aufaddiert, da das Echo eines Pakets ohne Antwort (Broadcast) noch im
+	// Puffer liegen kann; bei 0xFF gesättigt, ein Rest wird von DNX_receive()
+	// als ungültiges Paket verworfen.
+	if (usart_data == &XM_servo_data_R || usart_data == &XM_servo_data_L)
+		usart_data->lastPacketLength =
+				bytes > 0xFF - usart_data->lastPacketLength ?
+						0xFF : usart_data->lastPacketLength + bytes;
 	// Set OE to 0 -> Enable Send
 	usart_data->port->OUTCLR = XM_OE_MASK;
 
@@ -327,6 +500,30 @@ void XM_USART_send(USART_data_t* const usart_data, const DT_byte* const txData,
 	USART_TxdInterruptLevel_Set(usart_data->usart, USART_TXCINTLVL_HI_gc);
 }
 
+/**
+ * \brief 	Sendet ein Paket wie XM_USART_send(), ohne auf Platz im Puffer zu warten.
+ *
+ * 			Für ISRs: Die DRE-ISR leert den Puffer auf derselben Stufe nicht,
+ * 			solange eine HI-ISR wartet. Passt das Paket nicht vollständig in den
+ * 			TX-Puffer, wird nichts gesendet.
+ *
+ * \param	usart_data	USART-Datenstruktur der zu benutzenden USART
+ * \param	txData		Byte-Array mit zu sendendem Paket
+ * \param	bytes 		Länge des zu sendenden Pakets
+ *
+ * \return	true, wenn das Paket im TX-Puffer liegt
+ */
+DT_bool XM_USART_trySend(USART_data_t* const usart_data,
+		const DT_byte* const txData, DT_size bytes) {
+	USART_Buffer_t* const buffer = &usart_data->buffer;
+	uint8_t room = (buffer->TX_Tail - buffer->TX_Head - 1) & USART_TX_BUFFER_MASK;
+
+	if (usart_data->usart == &XM_USART_DEBUG || bytes > room)
+		return false;
+	XM_USART_send(usart_data, txData, bytes);
+	return true;
+}
+
 
 /**
  * \brief 	ISR für abgeschlossenen Sendevorgang der USARTC0 (SERVO L).
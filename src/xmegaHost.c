@@ -0,0 +1,455 @@
+/**
+ * \file 	xmegaHost.c
+ *
+ * \brief 	Nachbildung der XMEGA-spezifischen Funktionen auf dem Host (Linux).
+ *
+ * 			Ersetzt xmega.c, damit die Firmware nativ übersetzt, getestet und mit
+ * 			normalen Profilern vermessen werden kann. Die USARTs werden über die
+ * 			Software-Ringpuffer des usart_driver betrieben: XM_USART_send() reicht
+ * 			jedes Paket an einen Empfänger (DT_txHook) weiter, XM_receiveByte()
+ * 			übernimmt die Rolle der RXC-ISR. Auf den Servo-USARTs wird wie am
+ * 			Halbduplex-Bus jedes gesendete Byte zusätzlich empfangen (Phantom-Paket).
+ *
+ * 			Debug-Ausgaben erscheinen auf stderr, wenn die Umgebungsvariable
+ * 			CMBOT_DEBUG gesetzt ist.
+ *
+ * 			Auf einem AVR-Kern ohne XMEGA-Peripherie (simavr, siehe benchAvr.c)
+ * 			zählt Timer1 die Taktzyklen (XM_getCycles()) und Debug-Ausgaben
+ * 			werden in GPIOR0 geschrieben, das simavr als Konsole ausgibt.
+ */
+
+#include "include/xmega.h"
+#include "include/communication.h"
+#include "include/utils.h"
+#include <stdlib.h>
+#ifdef __AVR__
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#else
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#endif
+
+/**
+ * \brief	Nachgebildete USART mit Empfänger der gesendeten Pakete.
+ */
+typedef struct {
+	USART_data_t* data;
+	USART_t usart;
+	DT_txHook hook;
+	DT_bool echo; /**< Gesendete Bytes werden wieder empfangen (Halbduplex). */
+} DT_hostUsart;
+
+USART_data_t XM_servo_data_L;
+USART_data_t XM_servo_data_R;
+USART_data_t XM_debug_data;
+USART_data_t XM_remote_data;
+USART_data_t XM_com_data1;
+USART_data_t XM_com_data3;
+
+DT_hostUsart XM_host_usart[] = { { &XM_servo_data_L }, { &XM_servo_data_R }, {
+		&XM_debug_data }, { &XM_remote_data }, { &XM_com_data1 }, {
+		&XM_com_data3 } };
+
+DT_alarmHook XM_alarmHook = NULL; /**< Ausstehender Aufruf von XM_setAlarm(). */
+uint32_t XM_alarm_us;
+DT_bool XM_led = false;
+DT_bool XM_switch = false;
+DT_int XM_debug = -1;
+#ifdef __AVR__
+volatile uint16_t XM_cycleHigh = 0; /**< Überläufe von Timer1. */
+#else
+struct timespec XM_start; /**< Zeitpunkt von XM_init_cpu(). */
+DT_byte XM_eeprom[XM_EEPROM_SIZE]; /**< Nachgebildetes EEPROM, gelöscht 0xFF. */
+DT_bool XM_eepromErased = false;
+#endif
+
+// lokale Methoden
+DT_hostUsart* XM_getHostUsart(const USART_data_t* const);
+void XM_initUsart(USART_data_t* const, USART_DREINTLVL_t, DT_bool);
+#ifndef __AVR__
+void XM_eepromErase();
+#endif
+
+DT_hostUsart* XM_getHostUsart(const USART_data_t* const usart_data) {
+	DT_size i;
+	for (i = 0; i < sizeof(XM_host_usart) / sizeof(DT_hostUsart); i++)
+		if (XM_host_usart[i].data == usart_data)
+			return &XM_host_usart[i];
+	return NULL;
+}
+
+void XM_initUsart(USART_data_t* const usart_data,
+		USART_DREINTLVL_t dreIntLevel, DT_bool echo) {
+	DT_hostUsart* const host = XM_getHostUsart(usart_data);
+	USART_InterruptDriver_Initialize(usart_data, &host->usart, dreIntLevel);
+	usart_data->lastPacketLength = 0;
+	host->echo = echo;
+}
+
+/**
+ * \brief 	Initialisierung der CPU.
+ */
+void XM_init_cpu() {
+	XM_initUsart(&XM_debug_data, USART_DREINTLVL_OFF_gc, false);
+#ifdef __AVR__
+	// Timer1 ohne Vorteiler als Zyklenzähler
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	TIMSK1 = _BV(TOIE1);
+	sei();
+#else
+	clock_gettime(CLOCK_MONOTONIC, &XM_start);
+#endif
+	DEBUG_P("DEBUG-USART ... ON")
+	XM_LED_ON
+}
+
+#ifdef __AVR__
+
+ISR(TIMER1_OVF_vect) {
+	XM_cycleHigh++;
+}
+
+/**
+ * \brief 	Liefert die seit XM_init_cpu() vergangenen Taktzyklen.
+ *
+ * 			Ein noch nicht behandelter Überlauf wird mitgezählt, damit die Methode
+ * 			auch bei gesperrten Interrupts monoton ist.
+ *
+ * \return	Taktzyklen modulo 2^32
+ */
+uint32_t XM_getCycles() {
+	const uint8_t sreg = SREG;
+	uint16_t high, low;
+	cli();
+	low = TCNT1;
+	high = XM_cycleHigh;
+	if ((TIFR1 & _BV(TOV1)) && low < 0x8000)
+		high++;
+	SREG = sreg;
+	return ((uint32_t) high << 16) | low;
+}
+
+/**
+ * \brief 	Liefert die Zeitbasis in Mikrosekunden.
+ *
+ * \return	Zeit in us modulo 2^16
+ */
+DT_size XM_getTimeUs() {
+	return (DT_size) (XM_getCycles() / (F_CPU / 1000000UL));
+}
+
+/**
+ * \brief 	Liefert die Zeit seit XM_init_cpu() in Mikrosekunden.
+ *
+ * \return	Zeit in us modulo 2^32
+ */
+uint32_t XM_getUptimeUs() {
+	return XM_getCycles() / (F_CPU / 1000000UL);
+}
+
+/**
+ * \brief 	Gibt ein Zeichen auf der Konsole von simavr aus.
+ *
+ * \param	c	Zeichen
+ */
+void XM_debugPutChar(DT_char c) {
+	if (c == 0x00)
+		return;
+	GPIOR0 = c;
+}
+
+#else
+
+/**
+ * \brief 	Liefert die Zeitbasis in Mikrosekunden.
+ *
+ * 			Wie auf dem XMEGA modulo 2^16, Differenzen sind mit DT_size zu bilden.
+ *
+ * \return	Monotone Zeit in us
+ */
+DT_size XM_getTimeUs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (DT_size) (ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**
+ * \brief 	Liefert die Zeit seit XM_init_cpu() in Mikrosekunden.
+ *
+ * \return	Zeit in us modulo 2^32
+ */
+uint32_t XM_getUptimeUs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t) ((ts.tv_sec - XM_start.tv_sec) * 1000000L
+			+ (ts.tv_nsec - XM_start.tv_nsec) / 1000);
+}
+
+/**
+ * \brief 	Gibt ein Zeichen auf stderr aus, wenn CMBOT_DEBUG gesetzt ist.
+ *
+ * \param	c	Zeichen
+ */
+void XM_debugPutChar(DT_char c) {
+	if (XM_debug < 0)
+		XM_debug = getenv("CMBOT_DEBUG") != NULL;
+	if (!XM_debug || c == 0x00)
+		return;
+	fputc(c, stderr);
+	if (c == ';')
+		fputc('\n', stderr);
+}
+
+#endif /* __AVR__ */
+
+/**
+ * \brief 	Gibt ein Byte an den Empfänger der Debug-USART weiter.
+ *
+ * 			Ohne Empfänger (XM_setTxHook()) verhält sich die USART wie ein
+ * 			dauerhaft belegtes Senderegister.
+ *
+ * \param	c	Byte
+ *
+ * \return	false, wenn kein Empfänger gesetzt ist
+ */
+DT_bool XM_debugTryPutChar(DT_byte c) {
+	DT_hostUsart* const host = XM_getHostUsart(&XM_debug_data);
+	if (host->hook == NULL)
+		return false;
+	host->hook(&XM_debug_data, &c, 1);
+	return true;
+}
+
+/**
+ * \brief 	Initialisiert den Zigbee-Fernsteuerung.
+ */
+void XM_init_remote() {
+	XM_initUsart(&XM_remote_data, USART_DREINTLVL_OFF_gc, false);
+}
+
+/**
+ * \brief 	Initialisiert die Servo-USARTs.
+ */
+void XM_init_dnx() {
+	XM_initUsart(&XM_servo_data_R, USART_DREINTLVL_HI_gc, true);
+	XM_initUsart(&XM_servo_data_L, USART_DREINTLVL_HI_gc, true);
+}
+
+/**
+ * \brief 	Initialisiert USARTs für die CPU-Kommunikation.
+ *
+ * \param	cpuID	ID des Controllers
+ */
+void XM_init_com(DT_byte cpuID) {
+	XM_initUsart(&XM_com_data3, USART_DREINTLVL_MED_gc, false);
+	if (cpuID == COM_MASTER)
+		XM_initUsart(&XM_com_data1, USART_DREINTLVL_MED_gc, false);
+}
+
+/**
+ * \brief 	USART-Sendemethode.
+ *
+ * 			Auf den Servo-USARTs wird das Paket zuerst selbst empfangen, danach
+ * 			erhält der Empfänger der USART das vollständige Paket.
+ *
+ * \param	usart_data	USART-Datenstruktur der zu benutzenden USART
+ * \param	txData		Byte-Array mit zu sendendem Paket
+ * \param	bytes 		Länge des zu sendenden Pakets
+ */
+void XM_USART_send(USART_data_t* const usart_data, const DT_byte* const txData,
+		DT_size bytes) {
+	DT_hostUsart* const host = XM_getHostUsart(usart_data);
+	DT_size i;
+
+	if (usart_data == &XM_debug_data || host == NULL)
+		return;
+
+	// Echo, das beim Empfangen verworfen werden muss (nur Halbduplex-Servo-Bus).
+	// Aufaddiert, da das Echo eines Pakets ohne Antwort (Broadcast) noch im
+	// Puffer liegen kann; bei 0xFF gesättigt, ein Rest wird von DNX_receive()
+	// als ungültiges Paket verworfen.
+	if (host->echo)
+		usart_data->lastPacketLength =
+				bytes > 0xFF - usart_data->lastPacketLength ?
+						0xFF : usart_data->lastPacketLength + bytes;
+
+	if (host->echo)
+		for (i = 0; i < bytes; i++)
+			XM_receiveByte(usart_data, txData[i]);
+	if (host->hook != NULL)
+		host->hook(usart_data, txData, bytes);
+}
+
+/**
+ * \brief 	Sendet ein Paket wie XM_USART_send(), ohne auf Platz im Puffer zu warten.
+ *
+ * 			Auf dem Host gibt es keinen TX-Puffer, das Paket wird immer gesendet.
+ *
+ * \param	usart_data	USART-Datenstruktur der zu benutzenden USART
+ * \param	txData		Byte-Array mit zu sendendem Paket
+ * \param	bytes 		Länge des zu sendenden Pakets
+ *
+ * \return	true, wenn das Paket gesendet wurde
+ */
+DT_bool XM_USART_trySend(USART_data_t* const usart_data,
+		const DT_byte* const txData, DT_size bytes) {
+	if (usart_data == &XM_debug_data || XM_getHostUsart(usart_data) == NULL)
+		return false;
+	XM_USART_send(usart_data, txData, bytes);
+	return true;
+}
+
+/**
+ * \brief 	Empfängt ein Byte wie die RXC-ISR der USART.
+ *
+ * \param	usart_data	USART-Datenstruktur
+ * \param	data		empfangenes Byte
+ */
+void XM_receiveByte(USART_data_t* const usart_data, DT_byte data) {
+	usart_data->usart->DATA = data;
+	USART_RXComplete(usart_data);
+}
+
+/**
+ * \brief 	Ruft eine Methode zu einem Zeitpunkt von XM_getUptimeUs() auf.
+ *
+ * 			Ohne Timer-Interrupt wird der Zeitpunkt in XM_isAlarmPending()
+ * 			abgefragt und die Methode dort aufgerufen. Ein bereits vergangener
+ * 			Zeitpunkt löst sofort aus.
+ *
+ * \param	us		Zeitpunkt in us (XM_getUptimeUs())
+ * \param	hook	Methode
+ */
+void XM_setAlarm(uint32_t us, DT_alarmHook hook) {
+	XM_alarm_us = us;
+	XM_alarmHook = hook;
+	XM_isAlarmPending();
+}
+
+/**
+ * \brief 	Prüft, ob der Aufruf von XM_setAlarm() noch aussteht.
+ *
+ * 			Ist der Zeitpunkt erreicht, wird die Methode hier aufgerufen.
+ */
+DT_bool XM_isAlarmPending() {
+	const DT_alarmHook hook = XM_alarmHook;
+	if (hook == NULL)
+		return false;
+	if ((int32_t) (XM_alarm_us - XM_getUptimeUs()) > 0)
+		return true;
+	XM_alarmHook = NULL;
+	hook();
+	return false;
+}
+
+/**
+ * \brief 	Setzt den Empfänger der gesendeten Pakete einer USART.
+ *
+ * \param	usart_data	USART-Datenstruktur
+ * \param	hook		Empfänger oder NULL
+ */
+void XM_setTxHook(USART_data_t* const usart_data, DT_txHook hook) {
+	DT_hostUsart* const host = XM_getHostUsart(usart_data);
+	if (host != NULL)
+		host->hook = hook;
+}
+
+/**
+ * \brief 	Empfänger für XM_setTxHook(), der die gesendeten Pakete verwirft.
+ *
+ * 			Anders als ohne Empfänger gilt die USART damit als frei.
+ *
+ * \param	usart_data	USART-Datenstruktur
+ * \param	data		Paket
+ * \param	l			Größe des Pakets
+ */
+void XM_ignoreTx(USART_data_t* const usart_data, const DT_byte* const data,
+		DT_size l) {
+	(void) usart_data;
+	(void) data;
+	(void) l;
+}
+
+#ifndef __AVR__
+void XM_eepromErase() {
+	if (!XM_eepromErased) {
+		memset(XM_eeprom, 0xFF, XM_EEPROM_SIZE);
+		XM_eepromErased = true;
+	}
+}
+#endif
+
+/**
+ * \brief 	Liest Bytes aus dem EEPROM.
+ *
+ * 			Auf dem Host aus XM_eeprom, das beim ersten Zugriff gelöscht (0xFF)
+ * 			wird.
+ *
+ * \param	addr	Adresse im EEPROM
+ * \param	dest	Ziel
+ * \param	l	Anzahl der Bytes
+ */
+void XM_eepromRead(DT_size addr, DT_byte* const dest, DT_size l) {
+#ifdef __AVR__
+	eeprom_read_block(dest, (const void*) addr, l);
+#else
+	XM_eepromErase();
+	memcpy(dest, &XM_eeprom[addr], l);
+#endif
+}
+
+/**
+ * \brief 	Schreibt Bytes in das EEPROM.
+ *
+ * \param	addr	Adresse im EEPROM
+ * \param	src	Quelle
+ * \param	l	Anzahl der Bytes
+ */
+void XM_eepromWrite(DT_size addr, const DT_byte* const src, DT_size l) {
+#ifdef __AVR__
+	eeprom_update_block(src, (void*) addr, l);
+#else
+	XM_eepromErase();
+	memcpy(&XM_eeprom[addr], src, l);
+#endif
+}
+
+/**
+ * \brief 	Schaltet die LED.
+ *
+ * \param	on	true für an
+ */
+void XM_setLed(DT_bool on) {
+	XM_led = on;
+}
+
+/**
+ * \brief 	Liefert den Zustand der LED.
+ *
+ * \return	true, wenn die LED an ist
+ */
+DT_bool XM_getLed() {
+	return XM_led;
+}
+
+/**
+ * \brief 	Liefert den Zustand des Tasters.
+ *
+ * \return	true, wenn der Taster gedrückt ist
+ */
+DT_bool XM_isSwitchPressed() {
+	return XM_switch;
+}
+
+/**
+ * \brief 	Setzt den Zustand des Tasters.
+ *
+ * \param	pressed	true für gedrückt
+ */
+void XM_setSwitch(DT_bool pressed) {
+	XM_switch = pressed;
+}